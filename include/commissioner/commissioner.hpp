@@ -46,6 +46,8 @@
 #include <commissioner/error.hpp>
 #include <commissioner/network_data.hpp>
 
+struct event_base;
+
 namespace ot {
 
 namespace commissioner {
@@ -93,6 +95,92 @@ public:
     virtual void Log(LogLevel aLevel, const std::string &aRegion, const std::string &aMsg) = 0;
 };
 
+/**
+ * @brief Emulated network impairments of the border agent link.
+ *
+ * Impairments are applied to both directions of the UDP link between the
+ * commissioner and the border agent. This is for reproducing lossy, high
+ * latency networks in test environments and must not be enabled in production.
+ * No impairment is enabled by default, and the link is not emulated at all then.
+ *
+ */
+struct ImpairmentConfig
+{
+    uint32_t mSeed = 0; ///< The seed of the random generator. The same seed reproduces the same impairments.
+
+    // Allowed range: [0.0, 1.0].
+    double mLossRate      = 0.0; ///< The probability of dropping a datagram.
+    double mDuplicateRate = 0.0; ///< The probability of delivering a datagram twice.
+    double mReorderRate   = 0.0; ///< The probability of holding a datagram back by 'mReorderDelay'.
+
+    uint32_t mDelay        = 0;   ///< The one-way base delay of each datagram. In milliseconds.
+    uint32_t mDelayJitter  = 0;   ///< The max random delay added to 'mDelay'. In milliseconds.
+    uint32_t mReorderDelay = 100; ///< The extra delay of a reordered datagram. In milliseconds.
+
+    uint32_t mRateLimit = 0; ///< The link rate in bytes per second. Zero means unlimited.
+
+    /**
+     * @brief The function tells whether any impairment is configured.
+     */
+    bool IsEnabled() const
+    {
+        return mLossRate > 0 || mDuplicateRate > 0 || mReorderRate > 0 || mDelay > 0 || mDelayJitter > 0 ||
+               mRateLimit > 0;
+    }
+};
+
+/**
+ * @brief Thresholds of the overload controller.
+ *
+ * The commissioner is overloaded when its event loop lags behind or the
+ * queued work grows past these thresholds, and recovers when both drop
+ * to half of the thresholds. While overloaded, low-priority work is shed:
+ * new joiners are not admitted, energy reports are acknowledged but not
+ * reported, dataset change notifications are coalesced and reported after
+ * recovery, and debug logs are suppressed. Keep-alive, petition and joiner
+ * sessions in progress are not affected.
+ *
+ */
+struct OverloadConfig
+{
+    uint32_t mMaxLoopLag    = 200; ///< The max lag of the event loop. In milliseconds. Zero disables the check.
+    uint32_t mMaxQueueDepth = 256; ///< The max number of queued requests and joiner sessions. Zero disables the check.
+};
+
+/**
+ * @brief Metrics of the overload controller.
+ */
+struct OverloadMetrics
+{
+    bool     mOverloaded    = false; ///< If the commissioner is overloaded now.
+    uint32_t mOverloadCount = 0;     ///< The number of times the commissioner became overloaded.
+
+    uint32_t mLoopLag       = 0; ///< The last sampled lag of the event loop. In milliseconds.
+    uint32_t mMaxLoopLag    = 0; ///< The max sampled lag of the event loop. In milliseconds.
+    uint32_t mQueueDepth    = 0; ///< The last sampled number of queued requests and joiner sessions.
+    uint32_t mMaxQueueDepth = 0; ///< The max sampled number of queued requests and joiner sessions.
+
+    uint64_t mShedJoiners       = 0; ///< The number of new joiners not admitted.
+    uint64_t mShedEnergyReports = 0; ///< The number of energy reports not reported.
+    uint64_t mShedNotifications = 0; ///< The number of dataset change notifications coalesced.
+};
+
+/**
+ * @brief CPU time used by a commissioner on the event loop thread.
+ *
+ * Only the time of callbacks dispatched for the commissioner is counted,
+ * so commissioners sharing an event loop can be told apart. All times are
+ * of the thread CPU clock, in microseconds.
+ */
+struct CpuUsage
+{
+    uint64_t mSocketTime  = 0; ///< Handling messages of the border agent, including DTLS and CoAP.
+    uint64_t mJoinerTime  = 0; ///< Handling DTLS records of joiner sessions.
+    uint64_t mTimerTime   = 0; ///< Handling timers, such as retransmissions and keep-alive.
+    uint64_t mRequestTime = 0; ///< Running requests made from other threads.
+    uint64_t mHandlerTime = 0; ///< Running CommissionerHandler callbacks.
+};
+
 /**
  * @brief Configuration of a commissioner.
  */
@@ -107,6 +195,11 @@ struct Config
     std::shared_ptr<Logger> mLogger;
     bool                    mEnableDtlsDebugLogging = false;
 
+    // Encode extended TLVs (UDP Encapsulation, Joiner DTLS Encapsulation)
+    // shorter than 255 bytes in the base TLV format. Enable only if the
+    // border agent accepts it (Thread 1.2 or later).
+    bool mEnableCompactExtendedTlv = false;
+
     // Mandatory for CCM Thread network.
     std::string mDomainName = "Thread"; ///< The domain name of connecting Thread network.
 
@@ -124,8 +217,66 @@ struct Config
 
     // Mandatory for CCM Thread network.
     ByteArray mTrustAnchor; ///< The trust anchor of 'mCertificate'.
+
+    OverloadConfig mOverload; ///< The thresholds of shedding low-priority work.
+
+    // The metrics are mapped to this file for external monitoring,
+    // see the `commissioner-metrics` tool. Empty disables the metrics.
+    std::string mMetricsFile;
+
+    // The commissioning events of joiners are journaled to this file,
+    // see the `commissioner-journal` tool. Empty disables the journal.
+    std::string mJournalFile;
+
+    // For testing only.
+    ImpairmentConfig mImpairment; ///< The emulated impairments of the border agent link. Disabled by default.
+};
+
+/**
+ * @brief The result of probing the link to the border agent or a mesh node.
+ *
+ * Round-trip times are measured from sending a probe to the kernel receive
+ * timestamp of the answer where available, so that they exclude the time the
+ * answer waited for this host. That waiting time is reported separately as
+ * the host delay.
+ *
+ */
+struct LinkProbeResult
+{
+    uint16_t mSent     = 0; ///< The number of probes sent.
+    uint16_t mReceived = 0; ///< The number of probes answered before timeout.
+    uint32_t mDuration = 0; ///< The time from sending the first probe to the last answer or timeout. In milliseconds.
+
+    // Round-trip times of answered probes. In microseconds.
+    uint32_t mMinRtt = 0;
+    uint32_t mP50Rtt = 0;
+    uint32_t mP90Rtt = 0;
+    uint32_t mP99Rtt = 0;
+    uint32_t mMaxRtt = 0;
+
+    // Time between receiving an answer and handling it. In microseconds.
+    uint32_t mP50HostDelay = 0;
+    uint32_t mMaxHostDelay = 0;
+
+    /**
+     * @brief The fraction of probes not answered before timeout.
+     */
+    double GetLossRate() const { return mSent == 0 ? 0 : 1.0 - static_cast<double>(mReceived) / mSent; }
+
+    /**
+     * @brief The answered probes per second.
+     */
+    double GetThroughput() const { return mDuration == 0 ? 0 : mReceived * 1000.0 / mDuration; }
 };
 
+/**
+ * @brief The completion of an asynchronous decision on a joiner.
+ *
+ * @param[in] aAccepted  Whether the joiner is accepted.
+ *
+ */
+using JoinerFinalizeCompletion = std::function<void(bool aAccepted)>;
+
 /**
  * @brief The base class defines Handlers of commissioner events.
  *
@@ -133,7 +284,8 @@ struct Config
  * functions to provide specific handler.
  *
  * @note Those handlers will be called in another threads and synchronization
- *       is needed if user data is accessed there.
+ *       is needed if user data is accessed there. For a commissioner created
+ *       on a host event loop, they are called in the thread running that loop.
  * @note No more than one handler will be called concurrently.
  * @note Keep the handlers simple and light, no heavy jobs or blocking operations
  *       (e.g. those synchronized APIs provided by the Commissioner) should be
@@ -213,6 +365,46 @@ public:
         return false;
     }
 
+    /**
+     * This function notifies the receiving of JOIN_FIN.req message and lets the
+     * user decide on the joiner asynchronously, e.g. after asking for approval.
+     *
+     * The JOIN_FIN.req has been acknowledged when this is called, the JOIN_FIN.rsp
+     * is sent as a separate response once @p aCompletion is called. By default, it
+     * completes right away with the result of the synchronous OnJoinerFinalize().
+     *
+     * @param[in]  aJoinerId           The joiner ID.
+     * @param[in]  aVendorName         A human-readable product vendor name string in utf-8 format.
+     * @param[in]  aVendorModel        A human-readable product model string.
+     * @param[in]  aVendorSwVersion    A utf-8 string that specifies the product software version.
+     * @param[in]  aVendorStackVersion A vendor stack version of fixed length (5 bytes).
+     * @param[in]  aProvisioningUrl    A provisioning URL. Empty if the joiner doesn't provide it.
+     * @param[in]  aVendorData         Vendor-defined data. Empty if the joiner doesn't provide it.
+     * @param[in]  aCompletion         The completion to be called once with whether the
+     *                                 joiner is accepted. It can be called from any thread
+     *                                 as long as the commissioner is alive, and is ignored
+     *                                 if the joiner session has been closed by then.
+     *
+     * @note The joiner session is closed if @p aCompletion is not called
+     *       within kJoinerTimeout (20) seconds.
+     * @note For a commissioner created on a host event loop, calling @p aCompletion
+     *       from another thread requires the event loop to be thread-safe
+     *       (see evthread_use_pthreads()).
+     *
+     */
+    virtual void OnJoinerFinalize(const ByteArray &        aJoinerId,
+                                  const std::string &      aVendorName,
+                                  const std::string &      aVendorModel,
+                                  const std::string &      aVendorSwVersion,
+                                  const ByteArray &        aVendorStackVersion,
+                                  const std::string &      aProvisioningUrl,
+                                  const ByteArray &        aVendorData,
+                                  JoinerFinalizeCompletion aCompletion)
+    {
+        aCompletion(OnJoinerFinalize(aJoinerId, aVendorName, aVendorModel, aVendorSwVersion, aVendorStackVersion,
+                                     aProvisioningUrl, aVendorData));
+    }
+
     /**
      * This funtions notifies the response of a keep-alive message.
      *
@@ -324,6 +516,22 @@ public:
      */
     using PetitionHandler = std::function<void(const std::string *aExistingCommissionerId, Error aError)>;
 
+    /**
+     * The handler of UDP datagrams received from mesh nodes.
+     *
+     * @param[in] aPeerAddr  The source address of the datagram.
+     * @param[in] aPeerPort  The source port of the datagram.
+     * @param[in] aData      The UDP payload, only valid during the call.
+     * @param[in] aLength    The length of the UDP payload.
+     *
+     * @note Those handlers will be called in another threads and synchronization
+     *       is needed if user data is accessed there.
+     * @note No more than one handler will be called concurrently.
+     *
+     */
+    using UdpReceiveHandler =
+        std::function<void(const std::string &aPeerAddr, uint16_t aPeerPort, const uint8_t *aData, size_t aLength)>;
+
     /**
      * @brief Create an instance of the commissioner.
      *
@@ -337,6 +545,27 @@ public:
      */
     static std::shared_ptr<Commissioner> Create(CommissionerHandler &aHandler);
 
+    /**
+     * @brief Create an instance of the commissioner running on a host event loop.
+     *
+     * The returned commissioner is driven by the given libevent event_base and
+     * owns no thread of its own. Requests are executed directly in the caller's
+     * thread and handlers are called in the thread running @p aEventBase.
+     *
+     * @param[in]  aHandler    A handler of commissioner events.
+     * @param[in]  aEventBase  The libevent event_base of the application.
+     *
+     * @return A shared_ptr of the created Commissioner instance, or nullptr if
+     *         @p aEventBase is null.
+     *
+     * @note The instance is not thread safe. All APIs must be called in the thread
+     *       running @p aEventBase and @p aEventBase must outlive the instance.
+     * @note Only the asynchronous APIs are supported, the synchronous APIs return
+     *       Error::kUnimplemented since they would block the event loop.
+     *
+     */
+    static std::shared_ptr<Commissioner> Create(CommissionerHandler &aHandler, struct event_base *aEventBase);
+
     virtual ~Commissioner() = default;
 
     /**
@@ -433,6 +662,22 @@ public:
      */
     virtual const std::string &GetDomainName() const = 0;
 
+    /**
+     * @brief Get the metrics of the overload controller.
+     *
+     * @return The overload metrics.
+     *
+     * @sa OverloadConfig
+     */
+    virtual OverloadMetrics GetOverloadMetrics() const = 0;
+
+    /**
+     * @brief Get the CPU time used by the commissioner.
+     *
+     * @return The CPU usage.
+     */
+    virtual CpuUsage GetCpuUsage() const = 0;
+
     /**
      * @brief Cancel all outstanding requests.
      *
@@ -1116,6 +1361,110 @@ public:
      */
     virtual Error SetToken(const ByteArray &aSignedToken, const ByteArray &aSignerCert) = 0;
 
+    /**
+     * @brief Asynchronously probe the performance of the link to the border agent or a mesh node.
+     *
+     * This method sends @p aCount CoAP pings, keeping up to @p aWindow of them
+     * outstanding at a time, and measures round-trip time, loss and throughput.
+     * A ping is never retransmitted; it counts as lost if it is not answered
+     * within the CoAP ACK timeout. Pings to a mesh node are sent through the
+     * UDP proxy of the border agent, which requires an active commissioner.
+     * It always returns immediately without waiting for the completion.
+     *
+     * @param[in, out] aHandler  A handler of the probe result; Guaranteed to be called.
+     * @param[in]      aDstAddr  A mesh node address. The border agent is probed if empty.
+     * @param[in]      aCount    The number of pings.
+     * @param[in]      aWindow   The max number of outstanding pings.
+     *
+     */
+    virtual void ProbeLink(Handler<LinkProbeResult> aHandler,
+                           const std::string &      aDstAddr,
+                           uint16_t                 aCount,
+                           uint16_t                 aWindow) = 0;
+
+    /**
+     * @brief Synchronously probe the performance of the link to the border agent or a mesh node.
+     *
+     * This method sends @p aCount CoAP pings, keeping up to @p aWindow of them
+     * outstanding at a time, and measures round-trip time, loss and throughput.
+     * It will not return until errors happened or all pings are answered or timeout.
+     *
+     * @param[out] aResult   The probe result.
+     * @param[in]  aDstAddr  A mesh node address. The border agent is probed if empty.
+     * @param[in]  aCount    The number of pings.
+     * @param[in]  aWindow   The max number of outstanding pings.
+     *
+     * @return Error::kNone, succeed; Otherwise, failed.
+     */
+    virtual Error ProbeLink(LinkProbeResult &  aResult,
+                            const std::string &aDstAddr,
+                            uint16_t           aCount,
+                            uint16_t           aWindow) = 0;
+
+    /**
+     * @brief Bind a UDP port of the commissioner for datagrams to and from mesh nodes.
+     *
+     * Datagrams are carried by the UDP proxy of the border agent, in UDP_TX.ntf
+     * and UDP_RX.ntf messages. Datagrams received on @p aLocalPort are passed to
+     * @p aHandler.
+     *
+     * @param[in] aLocalPort  A UDP port, not zero.
+     * @param[in] aHandler    A handler of received datagrams.
+     *
+     * @return Error::kNone, succeed; Error::kAlreadyExists, the port is already bound;
+     *         Otherwise, failed.
+     */
+    virtual Error BindUdpProxyPort(uint16_t aLocalPort, UdpReceiveHandler aHandler) = 0;
+
+    /**
+     * @brief Unbind a UDP port bound by BindUdpProxyPort.
+     *
+     * Datagrams from the port which have not been sent are cancelled.
+     *
+     * @param[in] aLocalPort  A UDP port bound by BindUdpProxyPort.
+     */
+    virtual void UnbindUdpProxyPort(uint16_t aLocalPort) = 0;
+
+    /**
+     * @brief Asynchronously send a UDP datagram to a mesh node.
+     *
+     * The datagram is queued in the send window of @p aLocalPort and sent with
+     * other queued datagrams as fast as the link to the border agent allows,
+     * which requires an active commissioner. @p aHandler is called with
+     * Error::kBusy right away if the send window is full, or with Error::kNone
+     * once the datagram is sent, which leaves room for another datagram.
+     * It always returns immediately without waiting for the completion.
+     *
+     * @param[in, out] aHandler    A handler of the send result; Guaranteed to be called.
+     * @param[in]      aLocalPort  A UDP port bound by BindUdpProxyPort.
+     * @param[in]      aDstAddr    A mesh node address.
+     * @param[in]      aDstPort    The destination UDP port.
+     * @param[in]      aData       The UDP payload.
+     *
+     */
+    virtual void SendUdpProxy(ErrorHandler       aHandler,
+                              uint16_t           aLocalPort,
+                              const std::string &aDstAddr,
+                              uint16_t           aDstPort,
+                              const ByteArray &  aData) = 0;
+
+    /**
+     * @brief Synchronously send a UDP datagram to a mesh node.
+     *
+     * It will not return until the datagram is sent or errors happened.
+     *
+     * @param[in] aLocalPort  A UDP port bound by BindUdpProxyPort.
+     * @param[in] aDstAddr    A mesh node address.
+     * @param[in] aDstPort    The destination UDP port.
+     * @param[in] aData       The UDP payload.
+     *
+     * @return Error::kNone, succeed; Error::kBusy, the send window is full; Otherwise, failed.
+     */
+    virtual Error SendUdpProxy(uint16_t           aLocalPort,
+                               const std::string &aDstAddr,
+                               uint16_t           aDstPort,
+                               const ByteArray &  aData) = 0;
+
     /**
      * @brief Generate PSKc by given passphrase, networkname and extended PAN ID.
      *
@@ -35,6 +35,7 @@
 #define OT_COMM_NETWORK_DATA_HPP_
 
 #include <string>
+#include <utility>
 
 #include <stdint.h>
 
@@ -243,6 +244,48 @@ struct ActiveOperationalDataset
     }
 };
 
+/**
+ * @brief A lazily decoded Active Operational Dataset.
+ *
+ * It keeps the raw TLVs of the dataset (see Commissioner::GetRawActiveDataset)
+ * and decodes a field only when it is accessed, which is cheaper than decoding
+ * the whole ActiveOperationalDataset when only a few fields are read.
+ *
+ * The getters return ERROR_NOT_FOUND if the field is not present and
+ * ERROR_BAD_FORMAT if the dataset or the field is malformed.
+ */
+class LazyActiveDataset
+{
+public:
+    LazyActiveDataset() = default;
+    explicit LazyActiveDataset(ByteArray aRawDataset)
+        : mRawDataset(std::move(aRawDataset))
+    {
+    }
+
+    const ByteArray &GetRaw() const { return mRawDataset; }
+
+    Error GetActiveTimestamp(Timestamp &aTimestamp) const;
+    Error GetChannel(Channel &aChannel) const;
+    Error GetNetworkName(std::string &aNetworkName) const;
+    Error GetPanId(uint16_t &aPanId) const;
+
+    // Byte fields are not copied: `aData` points into the raw dataset and
+    // is valid as long as this object is neither modified nor destroyed.
+    Error GetExtendedPanId(const uint8_t *&aData, size_t &aLength) const;
+    Error GetMeshLocalPrefix(const uint8_t *&aData, size_t &aLength) const;
+    Error GetNetworkMasterKey(const uint8_t *&aData, size_t &aLength) const;
+    Error GetPSKc(const uint8_t *&aData, size_t &aLength) const;
+
+    /**
+     * Decode all fields into an ActiveOperationalDataset.
+     */
+    Error ToActiveDataset(ActiveOperationalDataset &aDataset) const;
+
+private:
+    ByteArray mRawDataset;
+};
+
 /**
  * @brief The Pending Operational Dataset of the Thread Network Data.
  *
@@ -33,47 +33,63 @@
 
 #include "app/cli/console.hpp"
 
+#include <algorithm>
 #include <iostream>
+#include <mutex>
+#include <vector>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/select.h>
+#include <unistd.h>
 
 #include <readline/history.h>
 #include <readline/readline.h>
 
+#include "common/utils.hpp"
+
 namespace ot {
 
 namespace commissioner {
 
-std::string Console::Read()
-{
-    const char *line = "";
+static std::mutex                                          sMutex;
+static bool                                                sIsReading = false;
+static std::vector<std::pair<std::string, Console::Color>> sPendingLines;
 
-    while (line == nullptr || strlen(line) == 0)
-    {
-        line = readline("> ");
-    }
+// Wakes up the reading thread to print pending lines.
+static int sNotifyPipe[2] = {-1, -1};
 
-    add_history(line);
+static char *sLine    = nullptr;
+static bool  sHasLine = false;
 
-    return line;
+static void HandleLine(char *aLine)
+{
+    sLine    = aLine;
+    sHasLine = true;
+
+    // Don't show the prompt again until the next read.
+    rl_callback_handler_remove();
 }
 
-void Console::Write(const std::string &aLine, Color aColor)
+static void WriteLine(const std::string &aLine, Console::Color aColor)
 {
     static const std::string kResetCode = "\u001b[0m";
     std::string              colorCode;
 
     switch (aColor)
     {
-    case Color::kDefault:
-    case Color::kWhite:
+    case Console::Color::kDefault:
+    case Console::Color::kWhite:
         colorCode = "\u001b[37m";
         break;
-    case Color::kRed:
+    case Console::Color::kRed:
         colorCode = "\u001b[31m";
         break;
-    case Color::kGreen:
+    case Console::Color::kGreen:
         colorCode = "\u001b[32m";
         break;
-    case Color::kBlue:
+    case Console::Color::kBlue:
         colorCode = "\u001b[34m";
         break;
     }
@@ -81,6 +97,156 @@ void Console::Write(const std::string &aLine, Color aColor)
     std::cout << colorCode << aLine << kResetCode << std::endl;
 }
 
+static void InitNotifyPipe()
+{
+    VerifyOrExit(sNotifyPipe[0] < 0);
+
+    VerifyOrDie(pipe(sNotifyPipe) == 0);
+    for (auto fd : sNotifyPipe)
+    {
+        VerifyOrDie(fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) == 0);
+    }
+
+exit:
+    return;
+}
+
+static std::vector<std::pair<std::string, Console::Color>> TakePendingLines()
+{
+    std::vector<std::pair<std::string, Console::Color>> lines;
+    char                                                buf[64];
+
+    while (read(sNotifyPipe[0], buf, sizeof(buf)) > 0)
+    {
+    }
+
+    std::lock_guard<std::mutex> lock(sMutex);
+    lines.swap(sPendingLines);
+    return lines;
+}
+
+static void PrintPendingLines()
+{
+    auto  lines      = TakePendingLines();
+    int   savedPoint = rl_point;
+    char *savedLine  = nullptr;
+
+    VerifyOrExit(!lines.empty());
+
+    // Clear the prompt and the line being edited, print and restore them.
+    savedLine = rl_copy_text(0, rl_end);
+    rl_save_prompt();
+    rl_replace_line("", 0);
+    rl_redisplay();
+
+    for (const auto &line : lines)
+    {
+        WriteLine(line.first, line.second);
+    }
+
+    rl_restore_prompt();
+    rl_replace_line(savedLine, 0);
+    rl_point = savedPoint;
+    rl_redisplay();
+
+    free(savedLine);
+
+exit:
+    return;
+}
+
+std::string Console::Read()
+{
+    std::string line;
+
+    InitNotifyPipe();
+
+    {
+        std::lock_guard<std::mutex> lock(sMutex);
+        sIsReading = true;
+    }
+
+    while (line.empty())
+    {
+        sLine    = nullptr;
+        sHasLine = false;
+
+        rl_callback_handler_install("> ", HandleLine);
+        while (!sHasLine)
+        {
+            fd_set readFds;
+
+            FD_ZERO(&readFds);
+            FD_SET(STDIN_FILENO, &readFds);
+            FD_SET(sNotifyPipe[0], &readFds);
+
+            if (select(std::max(STDIN_FILENO, sNotifyPipe[0]) + 1, &readFds, nullptr, nullptr, nullptr) < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                rl_callback_handler_remove();
+                break;
+            }
+
+            if (FD_ISSET(sNotifyPipe[0], &readFds))
+            {
+                PrintPendingLines();
+            }
+            if (FD_ISSET(STDIN_FILENO, &readFds))
+            {
+                rl_callback_read_char();
+            }
+        }
+
+        if (sLine == nullptr)
+        {
+            // End of input.
+            line = "exit";
+        }
+        else
+        {
+            line = sLine;
+            free(sLine);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(sMutex);
+
+        // Lines written after the last wakeup.
+        for (const auto &pendingLine : sPendingLines)
+        {
+            WriteLine(pendingLine.first, pendingLine.second);
+        }
+        sPendingLines.clear();
+        sIsReading = false;
+    }
+
+    add_history(line.c_str());
+
+    return line;
+}
+
+void Console::Write(const std::string &aLine, Color aColor)
+{
+    std::lock_guard<std::mutex> lock(sMutex);
+
+    if (sIsReading)
+    {
+        sPendingLines.emplace_back(aLine, aColor);
+        if (write(sNotifyPipe[1], "", 1) < 0)
+        {
+            // The pipe is full, the reader is going to wake up anyway.
+        }
+    }
+    else
+    {
+        WriteLine(aLine, aColor);
+    }
+}
+
 } // namespace commissioner
 
 } // namespace ot
@@ -57,9 +57,12 @@ public:
     Console()  = default;
     ~Console() = default;
 
+    // Read a line from the console. Lines written by other threads
+    // while reading are printed above the prompt, leaving the line
+    // being edited intact. Returns "exit" at the end of input.
     static std::string Read();
 
-    // Write to the console
+    // Write to the console. This is thread safe.
     static void Write(const std::string &aLine, Color aColor = Color::kDefault);
 };
 
@@ -33,6 +33,8 @@
 
 #include "app/cli/interpreter.hpp"
 
+#include <set>
+
 #include <string.h>
 
 #include "app/file_util.hpp"
@@ -63,6 +65,10 @@ const std::map<std::string, Interpreter::Evaluator> &Interpreter::mEvaluatorMap
     {"announce", &Interpreter::ProcessAnnounce},
     {"panid", &Interpreter::ProcessPanId},
     {"energy", &Interpreter::ProcessEnergy},
+    {"probe", &Interpreter::ProcessProbe},
+    {"jobs", &Interpreter::ProcessJobs},
+    {"wait", &Interpreter::ProcessWait},
+    {"cancel", &Interpreter::ProcessCancel},
     {"exit", &Interpreter::ProcessExit},
     {"help", &Interpreter::ProcessHelp},
 };
@@ -85,7 +91,8 @@ const std::map<std::string, std::string> &Interpreter::mUsageMap = *new std::map
                "joiner disable (meshcop|ae|nmkp) <joiner-eui64>\n"
                "joiner disableall (meshcop|ae|nmkp)\n"
                "joiner getport (meshcop|ae|nmkp)\n"
-               "joiner setport (meshcop|ae|nmkp) <joiner-udp-port>"},
+               "joiner setport (meshcop|ae|nmkp) <joiner-udp-port>\n"
+               "joiner watch <joiner-list-file>"},
     {"commdataset", "commdataset get\n"
                     "commdataset set '<commissioner-dataset-in-json-string>'"},
     {"opdataset", "opdataset get activetimestamp\n"
@@ -127,9 +134,23 @@ const std::map<std::string, std::string> &Interpreter::mUsageMap = *new std::map
               "panid conflict <panid>"},
     {"energy", "energy scan <channel-mask> <count> <period> <scan-duration> <dst-addr>\n"
                "energy report [<dst-addr>]"},
+    {"probe", "probe borderagent [<count>] [<window>]\n"
+              "probe <dst-addr> [<count>] [<window>]"},
+    {"jobs", "jobs"},
+    {"wait", "wait <job-id>"},
+    {"cancel", "cancel <job-id>"},
     {"help", "help [<command>]"},
 };
 
+// Job control commands never run in the background and never wait for other commands.
+static const std::set<std::string> &kJobControlCommands =
+    *new std::set<std::string>{"jobs", "wait", "cancel", "exit", "help"};
+
+// Commands which only send requests through the thread-safe commissioner
+// may run concurrently, other commands are serialized.
+static const std::set<std::string> &kConcurrentCommands =
+    *new std::set<std::string>{"announce", "borderagent", "energy", "mlr", "panid", "probe"};
+
 template <typename T> static std::string ToHex(T aInteger)
 {
     return "0x" + utils::Hex(utils::Encode(aInteger));
@@ -152,6 +173,11 @@ exit:
     return error;
 }
 
+template <typename T> static bool IsReady(const std::future<T> &aFuture)
+{
+    return aFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
 std::string ToLower(const std::string &aStr)
 {
     std::string ret = aStr;
@@ -193,6 +219,17 @@ void Interpreter::Run()
         Print(Eval(Read()));
     }
 
+    {
+        std::map<uint32_t, Job> jobs;
+
+        // Wait for background jobs outside of the lock, they are
+        // cancelled by stopping the commissioner.
+        {
+            std::lock_guard<std::mutex> lock(mJobsMutex);
+            jobs.swap(mJobs);
+        }
+    }
+
 exit:
     return;
 }
@@ -218,9 +255,15 @@ Interpreter::Value Interpreter::Eval(const Expression &aExpr)
 {
     Value                                            value;
     std::map<std::string, Evaluator>::const_iterator evaluator;
+    std::unique_lock<std::mutex>                     evalLock{mEvalMutex, std::defer_lock};
 
     VerifyOrExit(!aExpr.empty(), value = ERROR_NONE);
 
+    if (aExpr.back() == "&")
+    {
+        ExitNow(value = RunInBackground({aExpr.begin(), aExpr.end() - 1}));
+    }
+
     evaluator = mEvaluatorMap.find(ToLower(aExpr.front()));
     if (evaluator == mEvaluatorMap.end())
     {
@@ -228,16 +271,27 @@ Interpreter::Value Interpreter::Eval(const Expression &aExpr)
                                               aExpr.front()));
     }
 
+    // Watching a joiner list lasts until cancelled, the watcher locks for each sync instead.
+    if (kJobControlCommands.count(evaluator->first) == 0 && kConcurrentCommands.count(evaluator->first) == 0 &&
+        !(evaluator->first == "joiner" && aExpr.size() >= 2 && CaseInsensitiveEqual(aExpr[1], "watch")))
+    {
+        evalLock.lock();
+    }
+
     value = evaluator->second(this, aExpr);
 
 exit:
     return value;
 }
 
-void Interpreter::Print(const Value &aValue)
+void Interpreter::Print(const Value &aValue, const std::string &aHeading)
 {
     std::string output = aValue.ToString();
 
+    if (!aHeading.empty())
+    {
+        output = output.empty() ? aHeading : aHeading + "\n" + output;
+    }
     if (!output.empty())
     {
         output += "\n";
@@ -466,6 +520,20 @@ Interpreter::Value Interpreter::ProcessJoiner(const Expression &aExpr)
     JoinerType type;
 
     VerifyOrExit(aExpr.size() >= 3, value = ERROR_INVALID_ARGS("too few arguments"));
+
+    if (CaseInsensitiveEqual(aExpr[1], "watch"))
+    {
+        std::string heading = "joiner watch " + aExpr[2];
+
+        // Only failed syncs are printed, the file is usually edited continuously.
+        ExitNow(value = mCommissioner->WatchJoiners(aExpr[2], mEvalMutex, [this, heading](Error aError) {
+            if (aError != ErrorCode::kNone)
+            {
+                Print(aError, heading);
+            }
+        }));
+    }
+
     SuccessOrExit(value = GetJoinerType(type, aExpr[2]));
 
     if (CaseInsensitiveEqual(aExpr[1], "enable"))
@@ -953,6 +1021,39 @@ exit:
     return value;
 }
 
+Interpreter::Value Interpreter::ProcessProbe(const Expression &aExpr)
+{
+    static constexpr uint16_t kDefaultProbeCount  = 100;
+    static constexpr uint16_t kDefaultProbeWindow = 1;
+
+    Value           value;
+    std::string     dstAddr;
+    uint16_t        count  = kDefaultProbeCount;
+    uint16_t        window = kDefaultProbeWindow;
+    LinkProbeResult result;
+
+    VerifyOrExit(aExpr.size() >= 2, value = ERROR_INVALID_ARGS("too few arguments"));
+
+    if (!CaseInsensitiveEqual(aExpr[1], "borderagent"))
+    {
+        dstAddr = aExpr[1];
+    }
+    if (aExpr.size() >= 3)
+    {
+        SuccessOrExit(value = ParseInteger(count, aExpr[2]));
+    }
+    if (aExpr.size() >= 4)
+    {
+        SuccessOrExit(value = ParseInteger(window, aExpr[3]));
+    }
+
+    SuccessOrExit(value = mCommissioner->ProbeLink(result, dstAddr, count, window));
+    value = LinkProbeResultToJson(result);
+
+exit:
+    return value;
+}
+
 Interpreter::Value Interpreter::ProcessEnergy(const Expression &aExpr)
 {
     Value value;
@@ -997,6 +1098,151 @@ exit:
     return value;
 }
 
+Interpreter::Value Interpreter::ProcessJobs(const Expression &)
+{
+    std::string                 data;
+    std::lock_guard<std::mutex> lock(mJobsMutex);
+
+    auto job = mJobs.begin();
+    while (job != mJobs.end())
+    {
+        std::string state  = "running";
+        bool        isDone = IsReady(job->second.mResult);
+
+        if (isDone)
+        {
+            state = job->second.mResult.get().HasNoError() ? "done" : "failed";
+        }
+        if (job->second.mIsCancelled)
+        {
+            state = "cancelled";
+        }
+
+        data += "[" + std::to_string(job->first) + "] " + state + " " + job->second.mCommand + "\n";
+
+        // Finished jobs are reported only once.
+        job = isDone ? mJobs.erase(job) : std::next(job);
+    }
+
+    if (!data.empty())
+    {
+        data.pop_back();
+    }
+
+    return data;
+}
+
+Interpreter::Value Interpreter::ProcessWait(const Expression &aExpr)
+{
+    Value              value;
+    uint32_t           jobId;
+    std::future<Value> result;
+
+    VerifyOrExit(aExpr.size() >= 2, value = ERROR_INVALID_ARGS("too few arguments"));
+    SuccessOrExit(value = ParseInteger(jobId, aExpr[1]));
+
+    {
+        std::lock_guard<std::mutex> lock(mJobsMutex);
+        auto                        job = mJobs.find(jobId);
+
+        VerifyOrExit(job != mJobs.end(), value = ERROR_NOT_FOUND("job {} not found", jobId));
+
+        // The result is printed here instead of when the job is done.
+        result = std::move(job->second.mResult);
+        mJobs.erase(job);
+    }
+
+    value = result.get();
+
+exit:
+    return value;
+}
+
+Interpreter::Value Interpreter::ProcessCancel(const Expression &aExpr)
+{
+    Error    error;
+    uint32_t jobId;
+
+    VerifyOrExit(aExpr.size() >= 2, error = ERROR_INVALID_ARGS("too few arguments"));
+    SuccessOrExit(error = ParseInteger(jobId, aExpr[1]));
+
+    {
+        std::lock_guard<std::mutex> lock(mJobsMutex);
+        auto                        job = mJobs.find(jobId);
+
+        VerifyOrExit(job != mJobs.end(), error = ERROR_NOT_FOUND("job {} not found", jobId));
+        VerifyOrExit(!IsReady(job->second.mResult), error = ERROR_INVALID_STATE("job {} has already finished", jobId));
+
+        // Requests cannot be cancelled one by one, cancelling the requests
+        // of this job would cancel the requests of other jobs as well.
+        for (auto &other : mJobs)
+        {
+            VerifyOrExit(other.first == jobId || IsReady(other.second.mResult),
+                         error = ERROR_INVALID_STATE("job {} cannot be cancelled while job {} is running", jobId,
+                                                     other.first));
+        }
+
+        job->second.mIsCancelled = true;
+    }
+
+    CancelCommand();
+
+exit:
+    return error;
+}
+
+Interpreter::Value Interpreter::RunInBackground(const Expression &aExpr)
+{
+    Value       value;
+    uint32_t    jobId;
+    std::string command;
+
+    VerifyOrExit(!aExpr.empty(), value = ERROR_INVALID_COMMAND("no command to run in background"));
+    VerifyOrExit(mEvaluatorMap.count(ToLower(aExpr.front())) != 0,
+                 value = ERROR_INVALID_COMMAND("'{}' is not a valid command, type 'help' to list all commands",
+                                               aExpr.front()));
+    VerifyOrExit(kJobControlCommands.count(ToLower(aExpr.front())) == 0,
+                 value = ERROR_INVALID_COMMAND("'{}' cannot run in background", aExpr.front()));
+
+    for (const auto &word : aExpr)
+    {
+        command += (command.empty() ? "" : " ") + word;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mJobsMutex);
+
+        jobId = mNextJobId++;
+
+        auto &job    = mJobs[jobId];
+        job.mCommand = command;
+        job.mResult  = std::async(std::launch::async, [this, jobId, aExpr]() {
+            Value result = Eval(aExpr);
+            HandleJobDone(jobId, result);
+            return result;
+        });
+    }
+
+    value = "[" + std::to_string(jobId) + "] " + command;
+
+exit:
+    return value;
+}
+
+void Interpreter::HandleJobDone(uint32_t aJobId, const Value &aValue)
+{
+    std::lock_guard<std::mutex> lock(mJobsMutex);
+    auto                        job = mJobs.find(aJobId);
+
+    // Nothing to print if the job is cancelled or someone is waiting for it.
+    VerifyOrExit(job != mJobs.end() && !job->second.mIsCancelled);
+
+    Print(aValue, "[" + std::to_string(aJobId) + "] " + job->second.mCommand);
+
+exit:
+    return;
+}
+
 Interpreter::Value Interpreter::ProcessExit(const Expression &)
 {
     mCommissioner->Stop();
@@ -1018,6 +1264,7 @@ Interpreter::Value Interpreter::ProcessHelp(const Expression &aExpr)
             data += kv.first + "\n";
         }
         data += "\ntype 'help <command>' for help of specific command.";
+        data += "\nappend '&' to a command to run it in the background.";
         value = data;
     }
     else
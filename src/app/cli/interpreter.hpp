@@ -34,7 +34,9 @@
 #ifndef OT_COMM_APP_CLI_INTERPRETER_HPP_
 #define OT_COMM_APP_CLI_INTERPRETER_HPP_
 
+#include <future>
 #include <map>
+#include <mutex>
 
 #include "app/border_agent.hpp"
 #include "app/cli/console.hpp"
@@ -97,7 +99,7 @@ private:
 
     Value Eval(const Expression &aExpr);
 
-    void Print(const Value &aValue);
+    void Print(const Value &aValue, const std::string &aHeading = "");
 
     Expression ParseExpression(const std::string &aLiteral);
 
@@ -119,9 +121,16 @@ private:
     Value ProcessAnnounce(const Expression &aExpr);
     Value ProcessPanId(const Expression &aExpr);
     Value ProcessEnergy(const Expression &aExpr);
+    Value ProcessProbe(const Expression &aExpr);
+    Value ProcessJobs(const Expression &aExpr);
+    Value ProcessWait(const Expression &aExpr);
+    Value ProcessCancel(const Expression &aExpr);
     Value ProcessExit(const Expression &aExpr);
     Value ProcessHelp(const Expression &aExpr);
 
+    Value RunInBackground(const Expression &aExpr);
+    void  HandleJobDone(uint32_t aJobId, const Value &aValue);
+
     static void BorderAgentHandler(const BorderAgent *aBorderAgent, const Error &aError);
 
     static const std::string Usage(Expression aExpr);
@@ -139,12 +148,27 @@ private:
     static std::string       BaAvailabilityToString(uint32_t aAvailability);
 
 private:
+    // A command running in the background.
+    struct Job
+    {
+        std::string        mCommand;
+        std::future<Value> mResult;
+        bool               mIsCancelled = false;
+    };
+
     Config                           mConfig;
     std::shared_ptr<CommissionerApp> mCommissioner = nullptr;
     Console                          mConsole;
 
     bool mShouldExit = false;
 
+    // Serializes commands which update the state of the commissioner app.
+    std::mutex mEvalMutex;
+
+    std::mutex              mJobsMutex;
+    std::map<uint32_t, Job> mJobs;
+    uint32_t                mNextJobId = 1;
+
     static const std::map<std::string, std::string> &mUsageMap;
     static const std::map<std::string, Evaluator> &  mEvaluatorMap;
 };
@@ -34,6 +34,14 @@
 #include "app/commissioner_app.hpp"
 
 #include <algorithm>
+#include <future>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/inotify.h>
+#include <unistd.h>
 
 #include "app/file_util.hpp"
 #include "app/json.hpp"
@@ -70,16 +78,39 @@ Error CommissionerApp::Init(const Config &aConfig)
 {
     Error error;
 
-    mCommissioner = Commissioner::Create(*this);
+    mCommissioner = CreateCommissioner();
     VerifyOrExit(mCommissioner != nullptr, error = ERROR_OUT_OF_MEMORY("Commissioner::Create"));
     SuccessOrExit(error = mCommissioner->Init(aConfig));
 
     mCommDataset = MakeDefaultCommissionerDataset();
 
+    VerifyOrExit(pipe(mWatchStopPipe) == 0, error = ERROR_IO_ERROR("pipe() failed: {}", strerror(errno)));
+    for (auto fd : mWatchStopPipe)
+    {
+        VerifyOrExit(fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) == 0 && fcntl(fd, F_SETFD, FD_CLOEXEC) == 0,
+                     error = ERROR_IO_ERROR("fcntl() failed: {}", strerror(errno)));
+    }
+
 exit:
     return error;
 }
 
+std::shared_ptr<Commissioner> CommissionerApp::CreateCommissioner()
+{
+    return Commissioner::Create(*this);
+}
+
+CommissionerApp::~CommissionerApp()
+{
+    for (auto fd : mWatchStopPipe)
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+    }
+}
+
 Error CommissionerApp::Start(std::string &      aExistingCommissionerId,
                              const std::string &aBorderAgentAddr,
                              uint16_t           aBorderAgentPort)
@@ -87,6 +118,8 @@ Error CommissionerApp::Start(std::string &      aExistingCommissionerId,
     Error error;
 
     // We need to report the already active commissioner ID if one exists.
+    // The petition is sent as soon as the DTLS handshake completes, and
+    // the network data is synced as soon as the petition is accepted.
     SuccessOrExit(error = mCommissioner->Petition(aExistingCommissionerId, aBorderAgentAddr, aBorderAgentPort));
     SuccessOrExit(error = SyncNetworkData());
 
@@ -100,6 +133,7 @@ exit:
 
 void CommissionerApp::Stop()
 {
+    StopWatchingJoiners();
     IgnoreError(mCommissioner->Resign());
 
     mJoiners.clear();
@@ -113,6 +147,7 @@ void CommissionerApp::Stop()
 
 void CommissionerApp::CancelRequests()
 {
+    StopWatchingJoiners();
     mCommissioner->CancelRequests();
 }
 
@@ -130,14 +165,29 @@ Error CommissionerApp::SaveNetworkData(const std::string &aFilename)
 {
     Error       error;
     NetworkData networkData;
+    int         fd;
 
     networkData.mActiveDataset  = mActiveDataset;
     networkData.mPendingDataset = mPendingDataset;
     networkData.mCommDataset    = mCommDataset;
     networkData.mBbrDataset     = mBbrDataset;
-    auto jsonString             = NetworkDataToJson(networkData);
 
-    SuccessOrExit(error = WriteFile(jsonString, aFilename));
+    fd = open(aFilename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+    if (fd < 0)
+    {
+        if (errno == ENOENT)
+        {
+            ExitNow(error = ERROR_NOT_FOUND("cannot open file '{}', {}", aFilename, strerror(errno)));
+        }
+        else
+        {
+            ExitNow(error = ERROR_IO_ERROR("cannot open file '{}', {}", aFilename, strerror(errno)));
+        }
+    }
+
+    // Stream the JSON to the file rather than holding it all in memory.
+    error = NetworkDataToJson(JsonWriter::FdSink(fd), networkData);
+    close(fd);
 
 exit:
     return error;
@@ -149,15 +199,63 @@ Error CommissionerApp::SyncNetworkData(void)
     ActiveOperationalDataset  activeDataset;
     PendingOperationalDataset pendingDataset;
     BbrDataset                bbrDataset;
-
-    SuccessOrExit(error = mCommissioner->SetCommissionerDataset(mCommDataset));
+    std::promise<Error>       commSet;
+    std::promise<Error>       bbrGet;
+    std::promise<Error>       activeGet;
+    std::promise<Error>       pendingGet;
+    Error                     commSetError;
+    Error                     bbrGetError;
+    Error                     activeGetError;
+    Error                     pendingGetError;
+
+    // The requests don't depend on each other, so they are sent at once
+    // and take one round trip instead of one each.
+    mCommissioner->SetCommissionerDataset([&commSet](Error aError) { commSet.set_value(aError); }, mCommDataset);
     if (IsCcmMode())
     {
-        SuccessOrExit(error = mCommissioner->GetBbrDataset(bbrDataset, 0xFFFF));
+        mCommissioner->GetBbrDataset(
+            [&bbrGet, &bbrDataset](const BbrDataset *aDataset, Error aError) {
+                if (aDataset != nullptr)
+                {
+                    bbrDataset = *aDataset;
+                }
+                bbrGet.set_value(aError);
+            },
+            0xFFFF);
+    }
+    else
+    {
+        bbrGet.set_value(ERROR_NONE);
     }
+    mCommissioner->GetActiveDataset(
+        [&activeGet, &activeDataset](const ActiveOperationalDataset *aDataset, Error aError) {
+            if (aDataset != nullptr)
+            {
+                activeDataset = *aDataset;
+            }
+            activeGet.set_value(aError);
+        },
+        0xFFFF);
+    mCommissioner->GetPendingDataset(
+        [&pendingGet, &pendingDataset](const PendingOperationalDataset *aDataset, Error aError) {
+            if (aDataset != nullptr)
+            {
+                pendingDataset = *aDataset;
+            }
+            pendingGet.set_value(aError);
+        },
+        0xFFFF);
 
-    SuccessOrExit(error = mCommissioner->GetActiveDataset(activeDataset, 0xFFFF));
-    SuccessOrExit(error = mCommissioner->GetPendingDataset(pendingDataset, 0xFFFF));
+    // All handlers refer to local variables, wait for each of them before exiting.
+    commSetError    = commSet.get_future().get();
+    bbrGetError     = bbrGet.get_future().get();
+    activeGetError  = activeGet.get_future().get();
+    pendingGetError = pendingGet.get_future().get();
+
+    SuccessOrExit(error = commSetError);
+    SuccessOrExit(error = bbrGetError);
+    SuccessOrExit(error = activeGetError);
+    SuccessOrExit(error = pendingGetError);
 
     if (IsCcmMode())
     {
@@ -337,6 +435,251 @@ exit:
     return error;
 }
 
+Error CommissionerApp::SyncJoiners(const std::vector<JoinerInfo> &aJoiners)
+{
+    Error                           error;
+    std::map<JoinerKey, JoinerInfo> joiners;
+    std::set<JoinerType>            removedTypes;
+    std::set<JoinerType>            changedTypes;
+    auto                            commDataset = mCommDataset;
+    commDataset.mPresentFlags &= ~CommissionerDataset::kSessionIdBit;
+    commDataset.mPresentFlags &= ~CommissionerDataset::kBorderAgentLocatorBit;
+
+    for (const auto &joiner : aJoiners)
+    {
+        if (joiner.mType == JoinerType::kMeshCoP)
+        {
+            SuccessOrExit(error = ValidatePSKd(joiner.mPSKd));
+        }
+
+        JoinerKey key{joiner.mType, Commissioner::ComputeJoinerId(joiner.mEui64)};
+
+        VerifyOrExit(joiners.emplace(key, joiner).second,
+                     error = ERROR_INVALID_ARGS("joiner(type={}, EUI64={:X}) is listed more than once",
+                                                utils::to_underlying(joiner.mType), joiner.mEui64));
+    }
+
+    VerifyOrExit(IsActive(), error = ERROR_INVALID_STATE("the commissioner is not active"));
+
+    for (const auto &kv : mJoiners)
+    {
+        if (joiners.count(kv.first) == 0)
+        {
+            removedTypes.insert(kv.first.mType);
+        }
+    }
+
+    // Joiners cannot be removed from the bloom filter, so the steering data of a type
+    // with removed joiners is rebuilt, while added joiners are added to the current one.
+    for (auto type : removedTypes)
+    {
+        auto &steeringData = GetSteeringData(commDataset, type);
+
+        steeringData = {0x00};
+        for (const auto &kv : joiners)
+        {
+            if (kv.first.mType == type)
+            {
+                Commissioner::AddJoiner(steeringData, kv.first.mId);
+            }
+        }
+        changedTypes.insert(type);
+    }
+
+    for (const auto &kv : joiners)
+    {
+        if (mJoiners.count(kv.first) == 0 && removedTypes.count(kv.first.mType) == 0)
+        {
+            Commissioner::AddJoiner(GetSteeringData(commDataset, kv.first.mType), kv.first.mId);
+            changedTypes.insert(kv.first.mType);
+        }
+    }
+
+    for (auto type : changedTypes)
+    {
+        // Set steering data to all 1 to enable all joiners.
+        if (joiners.count({type, Commissioner::ComputeJoinerId(0)}) != 0)
+        {
+            GetSteeringData(commDataset, type) = {0xFF};
+        }
+    }
+
+    // Joiners with only a changed PSKd or provisioning URL don't change the steering data.
+    if (!changedTypes.empty())
+    {
+        SuccessOrExit(error = mCommissioner->SetCommissionerDataset(commDataset));
+        MergeDataset(mCommDataset, commDataset);
+    }
+
+    mJoiners.swap(joiners);
+
+exit:
+    return error;
+}
+
+Error CommissionerApp::SyncJoinersFromFile(const std::string &aFilename)
+{
+    Error                   error;
+    std::string             json;
+    std::vector<JoinerInfo> joiners;
+
+    SuccessOrExit(error = ReadFile(json, aFilename));
+    SuccessOrExit(error = JoinerListFromJson(joiners, json));
+    SuccessOrExit(error = SyncJoiners(joiners));
+
+exit:
+    return error;
+}
+
+// Reads all pending inotify events and tells if the file @p aName in the watched directory is
+// written or replaced.
+static Error ReadWatchEvents(bool &aIsChanged, int aNotifyFd, const std::string &aName)
+{
+    Error   error;
+    ssize_t len;
+    alignas(struct inotify_event) char buf[4096];
+
+    while ((len = read(aNotifyFd, buf, sizeof(buf))) > 0)
+    {
+        const char *event = buf;
+
+        while (event < buf + len)
+        {
+            auto notifyEvent = reinterpret_cast<const struct inotify_event *>(event);
+
+            VerifyOrExit((notifyEvent->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) == 0,
+                         error = ERROR_NOT_FOUND("the directory of joiner list {} is removed", aName));
+            if (notifyEvent->len > 0 && aName == notifyEvent->name)
+            {
+                aIsChanged = true;
+            }
+            event += sizeof(struct inotify_event) + notifyEvent->len;
+        }
+    }
+
+    VerifyOrExit(len == 0 || errno == EAGAIN || errno == EINTR,
+                 error = ERROR_IO_ERROR("failed to read inotify events: {}", strerror(errno)));
+
+exit:
+    return error;
+}
+
+Error CommissionerApp::WatchJoiners(const std::string &aFilename, std::mutex &aMutex, const JoinerSyncHandler &aHandler)
+{
+    // Changes within this time after the first one are synced as one batch, so
+    // that a list being written by several writes is not synced half-written.
+    static constexpr MilliSeconds kSyncDelay{100};
+    static constexpr MilliSeconds kActiveCheckInterval{1000};
+
+    Error                                 error;
+    auto                                  slash      = aFilename.rfind('/');
+    std::string                           directory  = ".";
+    std::string                           name       = aFilename;
+    int                                   notifyFd   = -1;
+    bool                                  isWatching = false;
+    bool                                  isPending  = false;
+    std::chrono::steady_clock::time_point syncTime;
+    char                                  discard[16];
+
+    if (slash != std::string::npos)
+    {
+        directory = slash == 0 ? "/" : aFilename.substr(0, slash);
+        name      = aFilename.substr(slash + 1);
+    }
+
+    VerifyOrExit(IsActive(), error = ERROR_INVALID_STATE("the commissioner is not active"));
+    VerifyOrExit(!mIsWatchingJoiners, error = ERROR_INVALID_STATE("a joiner list is being watched"));
+
+    // Drops stop requests left by a previous watch. This is done before the
+    // watch is visible to StopWatchingJoiners(), so no stop of this one is lost.
+    while (read(mWatchStopPipe[0], discard, sizeof(discard)) > 0)
+    {
+    }
+
+    VerifyOrExit(!mIsWatchingJoiners.exchange(true), error = ERROR_INVALID_STATE("a joiner list is being watched"));
+    isWatching = true;
+
+    // The directory is watched, because an editor or generator may replace the
+    // file by renaming a new one, which is not seen by watching the file.
+    notifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    VerifyOrExit(notifyFd >= 0, error = ERROR_IO_ERROR("inotify_init1() failed: {}", strerror(errno)));
+    VerifyOrExit(inotify_add_watch(notifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) >= 0,
+                 error = ERROR_IO_ERROR("cannot watch directory '{}': {}", directory, strerror(errno)));
+
+    // Reading the file after it is watched misses no change.
+    {
+        std::lock_guard<std::mutex> lock(aMutex);
+
+        SuccessOrExit(error = SyncJoinersFromFile(aFilename));
+    }
+
+    while (true)
+    {
+        struct pollfd fds[] = {{mWatchStopPipe[0], POLLIN, 0}, {notifyFd, POLLIN, 0}};
+        MilliSeconds  timeout = kActiveCheckInterval;
+        int           events;
+
+        if (isPending)
+        {
+            auto now = std::chrono::steady_clock::now();
+
+            timeout = syncTime > now ? std::chrono::duration_cast<MilliSeconds>(syncTime - now) : MilliSeconds(0);
+        }
+
+        events = poll(fds, 2, static_cast<int>(timeout.count()));
+        VerifyOrExit(events >= 0 || errno == EINTR, error = ERROR_IO_ERROR("poll() failed: {}", strerror(errno)));
+
+        // Stopped by StopWatchingJoiners().
+        VerifyOrExit(events <= 0 || (fds[0].revents & POLLIN) == 0);
+
+        if (events > 0 && (fds[1].revents & POLLIN))
+        {
+            bool isChanged = false;
+
+            SuccessOrExit(error = ReadWatchEvents(isChanged, notifyFd, name));
+            if (isChanged && !isPending)
+            {
+                isPending = true;
+                syncTime  = std::chrono::steady_clock::now() + kSyncDelay;
+            }
+        }
+
+        VerifyOrExit(IsActive(), error = ERROR_INVALID_STATE("the commissioner is not active"));
+
+        if (isPending && std::chrono::steady_clock::now() >= syncTime)
+        {
+            std::lock_guard<std::mutex> lock(aMutex);
+
+            isPending = false;
+            aHandler(SyncJoinersFromFile(aFilename));
+        }
+    }
+
+exit:
+    if (notifyFd >= 0)
+    {
+        close(notifyFd);
+    }
+    if (isWatching)
+    {
+        mIsWatchingJoiners = false;
+    }
+    return error;
+}
+
+void CommissionerApp::StopWatchingJoiners()
+{
+    VerifyOrExit(mIsWatchingJoiners);
+
+    if (write(mWatchStopPipe[1], "", 1) < 0)
+    {
+        // The pipe is full, the watcher is going to stop anyway.
+    }
+
+exit:
+    return;
+}
+
 Error CommissionerApp::GetJoinerUdpPort(uint16_t &aJoinerUdpPort, JoinerType aJoinerType) const
 {
     Error error;
@@ -421,7 +764,8 @@ exit:
 
 Error CommissionerApp::GetChannel(Channel &aChannel)
 {
-    Error error;
+    Error     error;
+    ByteArray rawDataset;
 
     VerifyOrExit(IsActive(), error = ERROR_INVALID_STATE("the commissioner is not active"));
 
@@ -429,11 +773,11 @@ Error CommissionerApp::GetChannel(Channel &aChannel)
     // we need to pull the active operational dataset.
 
     // TODO(wgtdkp): should we send MGMT_ACTIVE_GET.req for all GetXXX APIs ?
-    SuccessOrExit(error = mCommissioner->GetActiveDataset(mActiveDataset, 0xFFFF));
+    SuccessOrExit(error = mCommissioner->GetRawActiveDataset(rawDataset, ActiveOperationalDataset::kChannelBit));
 
-    VerifyOrDie(mActiveDataset.mPresentFlags & ActiveOperationalDataset::kChannelBit);
-
-    aChannel = mActiveDataset.mChannel;
+    // Decode only the channel rather than the whole dataset.
+    VerifyOrExit(LazyActiveDataset{std::move(rawDataset)}.GetChannel(aChannel) == ErrorCode::kNone,
+                 error = ERROR_NOT_FOUND("cannot find valid Channel in Active Operational Dataset"));
 
 exit:
     return error;
@@ -633,15 +977,15 @@ exit:
 
 Error CommissionerApp::GetPanId(uint16_t &aPanId)
 {
-    Error error;
+    Error     error;
+    ByteArray rawDataset;
 
     VerifyOrExit(IsActive(), error = ERROR_INVALID_STATE("the commissioner is not active"));
 
-    SuccessOrExit(error = mCommissioner->GetActiveDataset(mActiveDataset, 0xFFFF));
+    SuccessOrExit(error = mCommissioner->GetRawActiveDataset(rawDataset, ActiveOperationalDataset::kPanIdBit));
 
-    VerifyOrExit(mActiveDataset.mPresentFlags & ActiveOperationalDataset::kPanIdBit,
+    VerifyOrExit(LazyActiveDataset{std::move(rawDataset)}.GetPanId(aPanId) == ErrorCode::kNone,
                  error = ERROR_NOT_FOUND("cannot find valid PAN ID in Active Operational Dataset"));
-    aPanId = mActiveDataset.mPanId;
 
 exit:
     return error;
@@ -979,6 +1323,14 @@ exit:
     return error;
 }
 
+Error CommissionerApp::ProbeLink(LinkProbeResult &  aResult,
+                                 const std::string &aDstAddr,
+                                 uint16_t           aCount,
+                                 uint16_t           aWindow)
+{
+    return mCommissioner->ProbeLink(aResult, aDstAddr, aCount, aWindow);
+}
+
 const ByteArray &CommissionerApp::GetToken() const
 {
     return mSignedToken;
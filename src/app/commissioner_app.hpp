@@ -38,12 +38,16 @@
 #ifndef OT_COMM_APP_COMMISSIONER_APP_HPP_
 #define OT_COMM_APP_COMMISSIONER_APP_HPP_
 
+#include <atomic>
 #include <chrono>
 #include <fstream>
+#include <functional>
 #include <list>
 #include <map>
+#include <mutex>
 #include <set>
 #include <unordered_set>
+#include <vector>
 
 #include <commissioner/commissioner.hpp>
 #include <commissioner/network_data.hpp>
@@ -97,14 +101,18 @@ public:
     using MilliSeconds = std::chrono::milliseconds;
     using Seconds      = std::chrono::seconds;
 
+    // Called with the result of each sync of a watched joiner list.
+    using JoinerSyncHandler = std::function<void(Error aError)>;
+
     static Error Create(std::shared_ptr<CommissionerApp> &aCommApp, const Config &aConfig);
-    ~CommissionerApp() = default;
+    ~CommissionerApp();
 
     // Handle commissioner events.
     std::string OnJoinerRequest(const ByteArray &aJoinerId) override;
 
     void OnJoinerConnected(const ByteArray &aJoinerId, Error aError) override;
 
+    using CommissionerHandler::OnJoinerFinalize;
     bool OnJoinerFinalize(const ByteArray &  aJoinerId,
                           const std::string &aVendorName,
                           const std::string &aVendorModel,
@@ -155,6 +163,19 @@ public:
     Error EnableAllJoiners(JoinerType aType, const std::string &aPSKd, const std::string &aProvisioningUrl);
     Error DisableAllJoiners(JoinerType aType);
 
+    // Enables exactly the joiners in @p aJoiners, a joiner with EUI-64 0 enables all joiners
+    // of its type. Only the steering data of types with added or removed joiners is updated,
+    // with a single MGMT_COMMISSIONER_SET.req.
+    Error SyncJoiners(const std::vector<JoinerInfo> &aJoiners);
+
+    // Syncs the joiners with the JSON joiner list in @p aFilename, and again each time the
+    // file is written or replaced, until StopWatchingJoiners() is called or the commissioner
+    // is stopped. Blocks the caller. @p aMutex is locked while syncing, so that callers which
+    // serialize calls to the app can make other calls meanwhile. @p aHandler is called with
+    // the result of each sync after the first one.
+    Error WatchJoiners(const std::string &aFilename, std::mutex &aMutex, const JoinerSyncHandler &aHandler);
+    void  StopWatchingJoiners();
+
     Error GetJoinerUdpPort(uint16_t &aJoinerUdpPort, JoinerType aJoinerType) const;
     Error SetJoinerUdpPort(JoinerType aType, uint16_t aUdpPort);
 
@@ -251,10 +272,19 @@ public:
     const std::string &GetDomainName() const;
     Error              GetPrimaryBbrAddr(std::string &aAddr);
 
-private:
+    // Probe the border agent if @p aDstAddr is empty.
+    Error ProbeLink(LinkProbeResult &aResult, const std::string &aDstAddr, uint16_t aCount, uint16_t aWindow);
+
+protected:
+    // For subclasses observing the events handled by the app,
+    // which must call the handlers of this class.
     CommissionerApp() = default;
     Error Init(const Config &aConfig);
 
+    // Creates the commissioner driven by this app.
+    virtual std::shared_ptr<Commissioner> CreateCommissioner();
+
+private:
     struct JoinerKey
     {
         JoinerType mType;
@@ -277,12 +307,18 @@ private:
 
     static Error ValidatePSKd(const std::string &aPSKd);
 
+    Error SyncJoinersFromFile(const std::string &aFilename);
+
     const JoinerInfo *GetJoinerInfo(JoinerType aType, const ByteArray &aJoinerId);
 
     std::shared_ptr<Commissioner> mCommissioner;
 
     ByteArray mSignedToken;
 
+    // Wakes up the joiner list watcher to stop it.
+    int               mWatchStopPipe[2] = {-1, -1};
+    std::atomic<bool> mIsWatchingJoiners{false};
+
 private:
     /*
      * Below are data associated with the connected Thread Network.
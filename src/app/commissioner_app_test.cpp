@@ -35,6 +35,7 @@
 #include <catch2/catch.hpp>
 
 #include "app/commissioner_app.hpp"
+#include "common/error_macros.hpp"
 #include "common/utils.hpp"
 
 namespace ot {
@@ -90,6 +91,246 @@ TEST_CASE("pskd-validation", "[pskd]")
     }
 }
 
+TEST_CASE("joiner-list-sync", "[joiner]")
+{
+    Config config;
+    config.mEnableCcm = false;
+    config.mPSKc = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff};
+
+    std::shared_ptr<CommissionerApp> commApp;
+    REQUIRE(CommissionerApp::Create(commApp, config) == ErrorCode::kNone);
+
+    SECTION("A joiner list with an invalid PSKd should be rejected")
+    {
+        REQUIRE(commApp->SyncJoiners({{JoinerType::kMeshCoP, 0x0011223344556677, "00001", ""}}) ==
+                ErrorCode::kInvalidArgs);
+    }
+
+    SECTION("A joiner list cannot be synced if the commissioner is not active")
+    {
+        REQUIRE(commApp->SyncJoiners({{JoinerType::kMeshCoP, 0x0011223344556677, "PSKD01", ""},
+                                      {JoinerType::kAE, 0x0011223344556677, "", ""}}) == ErrorCode::kInvalidState);
+    }
+
+    SECTION("Watching a joiner list returns if the commissioner is not active")
+    {
+        std::mutex mutex;
+
+        REQUIRE(commApp->WatchJoiners("/tmp/joiners.json", mutex, [](Error) {}) == ErrorCode::kInvalidState);
+    }
+}
+
+
+// Records the Commissioner Datasets set by the app, instead of sending them.
+class MockCommissioner : public Commissioner
+{
+public:
+    std::vector<CommissionerDataset> mCommDatasets;
+
+    Error Init(const Config &aConfig) override
+    {
+        mConfig = aConfig;
+        return ERROR_NONE;
+    }
+    const Config &     GetConfig() const override { return mConfig; }
+    bool               IsActive() const override { return true; }
+    const std::string &GetDomainName() const override { return mConfig.mDomainName; }
+
+    void SetCommissionerDataset(ErrorHandler aHandler, const CommissionerDataset &aDataset) override
+    {
+        aHandler(SetCommissionerDataset(aDataset));
+    }
+    Error SetCommissionerDataset(const CommissionerDataset &aDataset) override
+    {
+        mCommDatasets.push_back(aDataset);
+        return ERROR_NONE;
+    }
+
+    void Connect(ErrorHandler, const std::string &, uint16_t) override {}
+    Error Connect(const std::string &, uint16_t) override { return {}; }
+    void Disconnect() override {}
+    uint16_t GetSessionId() const override { return {}; }
+    State GetState() const override { return {}; }
+    bool IsCcmMode() const override { return {}; }
+    OverloadMetrics GetOverloadMetrics() const override { return {}; }
+    CpuUsage GetCpuUsage() const override { return {}; }
+    void CancelRequests() override {}
+    void Petition(PetitionHandler, const std::string &, uint16_t) override {}
+    Error Petition(std::string &, const std::string &, uint16_t) override { return {}; }
+    void Resign(ErrorHandler) override {}
+    Error Resign() override { return {}; }
+    void GetCommissionerDataset(Handler<CommissionerDataset>, uint16_t) override {}
+    Error GetCommissionerDataset(CommissionerDataset &, uint16_t) override { return {}; }
+    void SetBbrDataset(ErrorHandler, const BbrDataset &) override {}
+    Error SetBbrDataset(const BbrDataset &) override { return {}; }
+    void GetBbrDataset(Handler<BbrDataset>, uint16_t) override {}
+    Error GetBbrDataset(BbrDataset &, uint16_t) override { return {}; }
+    void GetActiveDataset(Handler<ActiveOperationalDataset>, uint16_t) override {}
+    Error GetActiveDataset(ActiveOperationalDataset &, uint16_t) override { return {}; }
+    void GetRawActiveDataset(Handler<ByteArray>, uint16_t) override {}
+    Error GetRawActiveDataset(ByteArray &, uint16_t) override { return {}; }
+    void SetActiveDataset(ErrorHandler, const ActiveOperationalDataset &) override {}
+    Error SetActiveDataset(const ActiveOperationalDataset &) override { return {}; }
+    void GetPendingDataset(Handler<PendingOperationalDataset>, uint16_t) override {}
+    Error GetPendingDataset(PendingOperationalDataset &, uint16_t) override { return {}; }
+    void SetPendingDataset(ErrorHandler, const PendingOperationalDataset &) override {}
+    Error SetPendingDataset(const PendingOperationalDataset &) override { return {}; }
+    void SetSecurePendingDataset(ErrorHandler,
+                                 const std::string &,
+                                 uint32_t,
+                                 const PendingOperationalDataset &) override
+    {
+    }
+    Error SetSecurePendingDataset(const std::string &, uint32_t, const PendingOperationalDataset &) override
+    {
+        return {};
+    }
+    void CommandReenroll(ErrorHandler, const std::string &) override {}
+    Error CommandReenroll(const std::string &) override { return {}; }
+    void CommandDomainReset(ErrorHandler, const std::string &) override {}
+    Error CommandDomainReset(const std::string &) override { return {}; }
+    void CommandMigrate(ErrorHandler, const std::string &, const std::string &) override {}
+    Error CommandMigrate(const std::string &, const std::string &) override { return {}; }
+    void AnnounceBegin(ErrorHandler, uint32_t, uint8_t, uint16_t, const std::string &) override {}
+    Error AnnounceBegin(uint32_t, uint8_t, uint16_t, const std::string &) override { return {}; }
+    void PanIdQuery(ErrorHandler, uint32_t, uint16_t, const std::string &) override {}
+    Error PanIdQuery(uint32_t, uint16_t, const std::string &) override { return {}; }
+    void EnergyScan(ErrorHandler, uint32_t, uint8_t, uint16_t, uint16_t, const std::string &) override {}
+    Error EnergyScan(uint32_t, uint8_t, uint16_t, uint16_t, const std::string &) override { return {}; }
+    void RegisterMulticastListener(Handler<uint8_t>,
+                                   const std::string &,
+                                   const std::vector<std::string> &,
+                                   uint32_t) override
+    {
+    }
+    Error RegisterMulticastListener(uint8_t &, const std::string &, const std::vector<std::string> &, uint32_t) override
+    {
+        return {};
+    }
+    void RequestToken(Handler<ByteArray>, const std::string &, uint16_t) override {}
+    Error RequestToken(ByteArray &, const std::string &, uint16_t) override { return {}; }
+    Error SetToken(const ByteArray &, const ByteArray &) override { return {}; }
+    void ProbeLink(Handler<LinkProbeResult>, const std::string &, uint16_t, uint16_t) override {}
+    Error ProbeLink(LinkProbeResult &, const std::string &, uint16_t, uint16_t) override { return {}; }
+    Error BindUdpProxyPort(uint16_t, UdpReceiveHandler) override { return {}; }
+    void UnbindUdpProxyPort(uint16_t) override {}
+    void SendUdpProxy(ErrorHandler, uint16_t, const std::string &, uint16_t, const ByteArray &) override {}
+    Error SendUdpProxy(uint16_t, const std::string &, uint16_t, const ByteArray &) override { return {}; }
+
+private:
+    Config mConfig;
+};
+
+class MockCommissionerApp : public CommissionerApp
+{
+public:
+    static Error Create(std::shared_ptr<MockCommissionerApp> &aCommApp, const Config &aConfig)
+    {
+        Error error;
+        auto  app = std::shared_ptr<MockCommissionerApp>(new MockCommissionerApp());
+
+        SuccessOrExit(error = app->Init(aConfig));
+
+        aCommApp = app;
+
+    exit:
+        return error;
+    }
+
+    MockCommissioner &GetCommissioner() { return *mMockCommissioner; }
+
+private:
+    std::shared_ptr<Commissioner> CreateCommissioner() override { return mMockCommissioner; }
+
+    std::shared_ptr<MockCommissioner> mMockCommissioner = std::make_shared<MockCommissioner>();
+};
+
+static ByteArray MakeSteeringData(const std::vector<uint64_t> &aEui64s)
+{
+    ByteArray steeringData;
+
+    for (auto eui64 : aEui64s)
+    {
+        Commissioner::AddJoiner(steeringData, Commissioner::ComputeJoinerId(eui64));
+    }
+
+    return steeringData;
+}
+
+TEST_CASE("joiner-list-sync-steering-data", "[joiner]")
+{
+    constexpr uint64_t kEui64A = 0x0011223344556677;
+    constexpr uint64_t kEui64B = 0x1122334455667788;
+    constexpr uint64_t kEui64C = 0x2233445566778899;
+
+    Config config;
+    config.mEnableCcm = false;
+    config.mPSKc = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff};
+
+    std::shared_ptr<MockCommissionerApp> commApp;
+    REQUIRE(MockCommissionerApp::Create(commApp, config) == ErrorCode::kNone);
+
+    auto &    commDatasets = commApp->GetCommissioner().mCommDatasets;
+    ByteArray steeringData;
+
+    REQUIRE(commApp->SyncJoiners({{JoinerType::kMeshCoP, kEui64A, "PSKD01", ""},
+                                  {JoinerType::kMeshCoP, kEui64B, "PSKD01", ""}}) == ErrorCode::kNone);
+    REQUIRE(commDatasets.size() == 1);
+    REQUIRE((commDatasets.back().mPresentFlags & CommissionerDataset::kSteeringDataBit) != 0);
+    REQUIRE(commDatasets.back().mSteeringData == MakeSteeringData({kEui64A, kEui64B}));
+    REQUIRE(commApp->GetSteeringData(steeringData, JoinerType::kMeshCoP) == ErrorCode::kNone);
+    REQUIRE(steeringData == MakeSteeringData({kEui64A, kEui64B}));
+    REQUIRE(commApp->OnJoinerRequest(Commissioner::ComputeJoinerId(kEui64A)) == "PSKD01");
+
+    SECTION("Changing only PSKds doesn't set the Commissioner Dataset")
+    {
+        REQUIRE(commApp->SyncJoiners({{JoinerType::kMeshCoP, kEui64A, "PSKD02", ""},
+                                      {JoinerType::kMeshCoP, kEui64B, "PSKD01", ""}}) == ErrorCode::kNone);
+        REQUIRE(commDatasets.size() == 1);
+        REQUIRE(commApp->OnJoinerRequest(Commissioner::ComputeJoinerId(kEui64A)) == "PSKD02");
+    }
+
+    SECTION("Added joiners are added to the current steering data")
+    {
+        REQUIRE(commApp->SyncJoiners({{JoinerType::kMeshCoP, kEui64A, "PSKD01", ""},
+                                      {JoinerType::kMeshCoP, kEui64B, "PSKD01", ""},
+                                      {JoinerType::kMeshCoP, kEui64C, "PSKD01", ""},
+                                      {JoinerType::kAE, kEui64C, "", ""}}) == ErrorCode::kNone);
+
+        // Both joiner types are changed with a single COMM_SET.
+        REQUIRE(commDatasets.size() == 2);
+        REQUIRE(commDatasets.back().mSteeringData == MakeSteeringData({kEui64A, kEui64B, kEui64C}));
+        REQUIRE((commDatasets.back().mPresentFlags & CommissionerDataset::kAeSteeringDataBit) != 0);
+        REQUIRE(commDatasets.back().mAeSteeringData == MakeSteeringData({kEui64C}));
+    }
+
+    SECTION("The steering data of removed joiners is rebuilt")
+    {
+        REQUIRE(commApp->SyncJoiners({{JoinerType::kMeshCoP, kEui64A, "PSKD01", ""},
+                                      {JoinerType::kMeshCoP, kEui64C, "PSKD01", ""}}) == ErrorCode::kNone);
+        REQUIRE(commDatasets.size() == 2);
+        REQUIRE(commDatasets.back().mSteeringData == MakeSteeringData({kEui64A, kEui64C}));
+        REQUIRE(commApp->OnJoinerRequest(Commissioner::ComputeJoinerId(kEui64B)) == "");
+
+        REQUIRE(commApp->SyncJoiners({}) == ErrorCode::kNone);
+        REQUIRE(commDatasets.size() == 3);
+        REQUIRE(commDatasets.back().mSteeringData == ByteArray{0x00});
+    }
+
+    SECTION("A joiner with EUI-64 0 enables all joiners")
+    {
+        REQUIRE(commApp->SyncJoiners({{JoinerType::kMeshCoP, 0, "PSKD03", ""},
+                                      {JoinerType::kMeshCoP, kEui64A, "PSKD01", ""}}) == ErrorCode::kNone);
+        REQUIRE(commDatasets.size() == 2);
+        REQUIRE(commDatasets.back().mSteeringData == ByteArray{0xFF});
+        REQUIRE(commApp->OnJoinerRequest(Commissioner::ComputeJoinerId(kEui64C)) == "PSKD03");
+
+        REQUIRE(commApp->SyncJoiners({{JoinerType::kMeshCoP, kEui64A, "PSKD01", ""}}) == ErrorCode::kNone);
+        REQUIRE(commDatasets.size() == 3);
+        REQUIRE(commDatasets.back().mSteeringData == MakeSteeringData({kEui64A}));
+    }
+}
+
 } // namespace commissioner
 
 } // namespace ot
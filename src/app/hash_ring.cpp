@@ -0,0 +1,133 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the consistent hash ring.
+ *
+ */
+
+#include "app/hash_ring.hpp"
+
+#include "common/utils.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+static std::string GetVirtualNodeKey(size_t aNode, size_t aVirtualNode)
+{
+    return "worker-" + std::to_string(aNode) + "#" + std::to_string(aVirtualNode);
+}
+
+HashRing::HashRing(size_t aVirtualNodeNum)
+    : mVirtualNodeNum(aVirtualNodeNum)
+    , mNodeNum(0)
+{
+    VerifyOrDie(mVirtualNodeNum > 0);
+}
+
+void HashRing::AddNode(size_t aNode)
+{
+    bool added = false;
+
+    for (size_t i = 0; i < mVirtualNodeNum; ++i)
+    {
+        // On a (rare) hash collision, the first node keeps the point.
+        added = mRing.emplace(Hash(GetVirtualNodeKey(aNode, i)), aNode).second || added;
+    }
+
+    if (added)
+    {
+        ++mNodeNum;
+    }
+}
+
+void HashRing::RemoveNode(size_t aNode)
+{
+    bool removed = false;
+
+    for (size_t i = 0; i < mVirtualNodeNum; ++i)
+    {
+        auto point = mRing.find(Hash(GetVirtualNodeKey(aNode, i)));
+
+        if (point != mRing.end() && point->second == aNode)
+        {
+            mRing.erase(point);
+            removed = true;
+        }
+    }
+
+    if (removed)
+    {
+        --mNodeNum;
+    }
+}
+
+size_t HashRing::GetNode(const std::string &aKey) const
+{
+    VerifyOrDie(!mRing.empty());
+
+    auto point = mRing.lower_bound(Hash(aKey));
+
+    if (point == mRing.end())
+    {
+        point = mRing.begin();
+    }
+
+    return point->second;
+}
+
+uint32_t HashRing::Hash(const std::string &aKey)
+{
+    static constexpr uint32_t kOffsetBasis = 2166136261u;
+    static constexpr uint32_t kPrime       = 16777619u;
+
+    uint32_t hash = kOffsetBasis;
+
+    for (auto c : aKey)
+    {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= kPrime;
+    }
+
+    // FNV-1a alone does not avalanche well for keys which differ only in
+    // the last characters (for example "network-1" and "network-2"), the
+    // MurmurHash3 finalizer spreads them over the whole ring.
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6b;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35;
+    hash ^= hash >> 16;
+
+    return hash;
+}
+
+} // namespace commissioner
+
+} // namespace ot
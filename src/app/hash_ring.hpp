@@ -0,0 +1,87 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines the consistent hash ring which assigns Thread networks to supervisor workers.
+ *
+ */
+
+#ifndef OT_COMM_APP_HASH_RING_HPP_
+#define OT_COMM_APP_HASH_RING_HPP_
+
+#include <map>
+#include <string>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace ot {
+
+namespace commissioner {
+
+/**
+ * A consistent hash ring of worker nodes.
+ *
+ * Each node is placed at multiple virtual points of the ring so that keys
+ * are evenly distributed. Adding or removing a node only moves the keys
+ * which are owned by that node, other keys keep their assignment.
+ *
+ */
+class HashRing
+{
+public:
+    static constexpr size_t kDefaultVirtualNodeNum = 64;
+
+    explicit HashRing(size_t aVirtualNodeNum = kDefaultVirtualNodeNum);
+
+    // Adds node `aNode` to the ring, it is a no-op if the node already exists.
+    void AddNode(size_t aNode);
+
+    // Removes node `aNode` from the ring.
+    void RemoveNode(size_t aNode);
+
+    size_t GetNodeNum() const { return mNodeNum; }
+
+    // Returns the node which owns `aKey`. The ring must not be empty.
+    size_t GetNode(const std::string &aKey) const;
+
+    // The 32-bit FNV-1a hash with the MurmurHash3 finalizer, which is stable across processes and platforms.
+    static uint32_t Hash(const std::string &aKey);
+
+private:
+    size_t                     mVirtualNodeNum;
+    size_t                     mNodeNum;
+    std::map<uint32_t, size_t> mRing;
+};
+
+} // namespace commissioner
+
+} // namespace ot
+
+#endif // OT_COMM_APP_HASH_RING_HPP_
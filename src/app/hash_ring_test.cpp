@@ -0,0 +1,129 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines test cases for the consistent hash ring.
+ */
+
+#include "app/hash_ring.hpp"
+
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace ot {
+
+namespace commissioner {
+
+TEST_CASE("hash-ring-stable-hash", "[hash-ring]")
+{
+    REQUIRE(HashRing::Hash("") == 0xab3e7c0b);
+    REQUIRE(HashRing::Hash("a") == 0x1a80b1b3);
+    REQUIRE(HashRing::Hash("foobar") == 0x0c0da6dc);
+}
+
+TEST_CASE("hash-ring-distribution", "[hash-ring]")
+{
+    static constexpr size_t kNodeNum = 4;
+    static constexpr size_t kKeyNum  = 4000;
+
+    HashRing            ring;
+    std::vector<size_t> counts(kNodeNum, 0);
+
+    for (size_t i = 0; i < kNodeNum; ++i)
+    {
+        ring.AddNode(i);
+    }
+    REQUIRE(ring.GetNodeNum() == kNodeNum);
+
+    for (size_t i = 0; i < kKeyNum; ++i)
+    {
+        size_t node = ring.GetNode("network-" + std::to_string(i));
+
+        REQUIRE(node < kNodeNum);
+        REQUIRE(node == ring.GetNode("network-" + std::to_string(i)));
+        ++counts[node];
+    }
+
+    for (auto count : counts)
+    {
+        REQUIRE(count > kKeyNum / kNodeNum / 2);
+        REQUIRE(count < kKeyNum / kNodeNum * 2);
+    }
+}
+
+TEST_CASE("hash-ring-minimal-movement", "[hash-ring]")
+{
+    static constexpr size_t kKeyNum = 1000;
+
+    HashRing ring;
+
+    ring.AddNode(0);
+    ring.AddNode(1);
+    ring.AddNode(2);
+
+    std::vector<size_t> before;
+    for (size_t i = 0; i < kKeyNum; ++i)
+    {
+        before.push_back(ring.GetNode("network-" + std::to_string(i)));
+    }
+
+    SECTION("adding a node only moves keys to the new node")
+    {
+        ring.AddNode(3);
+        REQUIRE(ring.GetNodeNum() == 4);
+
+        for (size_t i = 0; i < kKeyNum; ++i)
+        {
+            size_t node = ring.GetNode("network-" + std::to_string(i));
+            REQUIRE((node == before[i] || node == 3));
+        }
+    }
+
+    SECTION("removing a node only moves keys of the removed node")
+    {
+        ring.RemoveNode(1);
+        REQUIRE(ring.GetNodeNum() == 2);
+
+        for (size_t i = 0; i < kKeyNum; ++i)
+        {
+            size_t node = ring.GetNode("network-" + std::to_string(i));
+
+            REQUIRE(node != 1);
+            if (before[i] != 1)
+            {
+                REQUIRE(node == before[i]);
+            }
+        }
+    }
+}
+
+} // namespace commissioner
+
+} // namespace ot
@@ -34,6 +34,7 @@
 
 #include "app/json.hpp"
 
+#include <algorithm>
 #include <exception>
 #include <iostream>
 
@@ -42,6 +43,8 @@
 #include "app/commissioner_app.hpp"
 #include "app/file_logger.hpp"
 #include "app/file_util.hpp"
+#include "app/json_writer.hpp"
+#include "common/error_macros.hpp"
 #include "common/utils.hpp"
 
 namespace ot {
@@ -188,6 +191,47 @@ NLOHMANN_JSON_SERIALIZE_ENUM(LogLevel,
                                  {LogLevel::kDebug, "debug"},
                              });
 
+NLOHMANN_JSON_SERIALIZE_ENUM(JoinerType,
+                             {
+                                 {JoinerType::kMeshCoP, "meshcop"},
+                                 {JoinerType::kAE, "ae"},
+                                 {JoinerType::kNMKP, "nmkp"},
+                             });
+
+static void from_json(const Json &aJson, ImpairmentConfig &aImpairment)
+{
+#define SET_IF_PRESENT(name)                \
+    if (aJson.contains(#name))              \
+    {                                       \
+        aImpairment.m##name = aJson[#name]; \
+    };
+
+    SET_IF_PRESENT(Seed);
+    SET_IF_PRESENT(LossRate);
+    SET_IF_PRESENT(DuplicateRate);
+    SET_IF_PRESENT(ReorderRate);
+    SET_IF_PRESENT(Delay);
+    SET_IF_PRESENT(DelayJitter);
+    SET_IF_PRESENT(ReorderDelay);
+    SET_IF_PRESENT(RateLimit);
+
+#undef SET_IF_PRESENT
+}
+
+static void from_json(const Json &aJson, OverloadConfig &aOverload)
+{
+#define SET_IF_PRESENT(name)              \
+    if (aJson.contains(#name))            \
+    {                                     \
+        aOverload.m##name = aJson[#name]; \
+    };
+
+    SET_IF_PRESENT(MaxLoopLag);
+    SET_IF_PRESENT(MaxQueueDepth);
+
+#undef SET_IF_PRESENT
+}
+
 static void from_json(const Json &aJson, Config &aConfig)
 {
 #define SET_IF_PRESENT(name)            \
@@ -199,9 +243,14 @@ static void from_json(const Json &aJson, Config &aConfig)
     SET_IF_PRESENT(Id);
     SET_IF_PRESENT(EnableCcm);
     SET_IF_PRESENT(EnableDtlsDebugLogging);
+    SET_IF_PRESENT(EnableCompactExtendedTlv);
 
     SET_IF_PRESENT(KeepAliveInterval);
     SET_IF_PRESENT(MaxConnectionNum);
+    SET_IF_PRESENT(Overload);
+    SET_IF_PRESENT(MetricsFile);
+    SET_IF_PRESENT(JournalFile);
+    SET_IF_PRESENT(Impairment);
 
 #undef SET_IF_PRESENT
 
@@ -242,26 +291,6 @@ static void from_json(const Json &aJson, Config &aConfig)
     }
 }
 
-static void to_json(Json &aJson, const CommissionerDataset &aDataset)
-{
-#define SET_IF_PRESENT(name)                                        \
-    if (aDataset.mPresentFlags & CommissionerDataset::k##name##Bit) \
-    {                                                               \
-        aJson[#name] = aDataset.m##name;                            \
-    };
-
-    SET_IF_PRESENT(BorderAgentLocator);
-    SET_IF_PRESENT(SessionId);
-    SET_IF_PRESENT(SteeringData);
-    SET_IF_PRESENT(AeSteeringData);
-    SET_IF_PRESENT(NmkpSteeringData);
-    SET_IF_PRESENT(JoinerUdpPort);
-    SET_IF_PRESENT(AeUdpPort);
-    SET_IF_PRESENT(NmkpUdpPort);
-
-#undef SET_IF_PRESENT
-}
-
 static void from_json(const Json &aJson, CommissionerDataset &aDataset)
 {
 #define SET_IF_PRESENT(name)                                                  \
@@ -283,21 +312,6 @@ static void from_json(const Json &aJson, CommissionerDataset &aDataset)
 #undef SET_IF_PRESENT
 }
 
-static void to_json(Json &aJson, const BbrDataset &aDataset)
-{
-#define SET_IF_PRESENT(name)                               \
-    if (aDataset.mPresentFlags & BbrDataset::k##name##Bit) \
-    {                                                      \
-        aJson[#name] = aDataset.m##name;                   \
-    };
-
-    SET_IF_PRESENT(TriHostname);
-    SET_IF_PRESENT(RegistrarHostname);
-    SET_IF_PRESENT(RegistrarIpv6Addr);
-
-#undef SET_IF_PRESENT
-}
-
 static void from_json(const Json &aJson, BbrDataset &aDataset)
 {
 #define SET_IF_PRESENT(name)                                                  \
@@ -314,17 +328,6 @@ static void from_json(const Json &aJson, BbrDataset &aDataset)
 #undef SET_IF_PRESENT
 }
 
-static void to_json(Json &aJson, const Timestamp &aTimestamp)
-{
-#define SET(name) aJson[#name] = aTimestamp.m##name;
-
-    SET(Seconds);
-    SET(Ticks);
-    SET(U);
-
-#undef SET
-}
-
 static void from_json(const Json &aJson, Timestamp &aTimestamp)
 {
 #define SET(name) aTimestamp.m##name = aJson.at(#name).get<uint64_t>();
@@ -336,16 +339,6 @@ static void from_json(const Json &aJson, Timestamp &aTimestamp)
 #undef SET
 }
 
-static void to_json(Json &aJson, const Channel &aChannel)
-{
-#define SET(name) aJson[#name] = aChannel.m##name;
-
-    SET(Page);
-    SET(Number);
-
-#undef SET
-}
-
 static void from_json(const Json &aJson, Channel &aChannel)
 {
 #define SET(name) aJson.at(#name).get_to(aChannel.m##name);
@@ -356,16 +349,6 @@ static void from_json(const Json &aJson, Channel &aChannel)
 #undef SET
 }
 
-static void to_json(Json &aJson, const ChannelMaskEntry &aChannelMaskEntry)
-{
-#define SET(name) aJson[#name] = aChannelMaskEntry.m##name;
-
-    SET(Page);
-    SET(Masks);
-
-#undef SET
-}
-
 static void from_json(const Json &aJson, ChannelMaskEntry &aChannelMaskEntry)
 {
 #define SET(name) aJson.at(#name).get_to(aChannelMaskEntry.m##name);
@@ -376,16 +359,6 @@ static void from_json(const Json &aJson, ChannelMaskEntry &aChannelMaskEntry)
 #undef SET
 }
 
-static void to_json(Json &aJson, const SecurityPolicy &aSecurityPolicy)
-{
-#define SET(name) aJson[#name] = aSecurityPolicy.m##name;
-
-    SET(RotationTime);
-    SET(Flags);
-
-#undef SET
-}
-
 static void from_json(const Json &aJson, SecurityPolicy &aSecurityPolicy)
 {
 #define SET(name) aJson.at(#name).get_to(aSecurityPolicy.m##name);
@@ -396,33 +369,6 @@ static void from_json(const Json &aJson, SecurityPolicy &aSecurityPolicy)
 #undef SET
 }
 
-static void to_json(Json &aJson, const ActiveOperationalDataset &aDataset)
-{
-#define SET_IF_PRESENT(name)                                             \
-    if (aDataset.mPresentFlags & ActiveOperationalDataset::k##name##Bit) \
-    {                                                                    \
-        aJson[#name] = aDataset.m##name;                                 \
-    };
-
-    SET_IF_PRESENT(ActiveTimestamp);
-    SET_IF_PRESENT(Channel);
-    SET_IF_PRESENT(ChannelMask);
-    SET_IF_PRESENT(ExtendedPanId);
-
-    if (aDataset.mPresentFlags & ActiveOperationalDataset::kMeshLocalPrefixBit)
-    {
-        aJson["MeshLocalPrefix"] = Ipv6PrefixToString(aDataset.mMeshLocalPrefix);
-    };
-
-    SET_IF_PRESENT(NetworkMasterKey);
-    SET_IF_PRESENT(NetworkName);
-    SET_IF_PRESENT(PanId);
-    SET_IF_PRESENT(PSKc);
-    SET_IF_PRESENT(SecurityPolicy);
-
-#undef SET_IF_PRESENT
-}
-
 static void from_json(const Json &aJson, ActiveOperationalDataset &aDataset)
 {
 #define SET_IF_PRESENT(name)                                                  \
@@ -454,22 +400,6 @@ static void from_json(const Json &aJson, ActiveOperationalDataset &aDataset)
 #undef SET_IF_PRESENT
 }
 
-static void to_json(Json &aJson, const PendingOperationalDataset &aDataset)
-{
-    to_json(aJson, static_cast<const ActiveOperationalDataset &>(aDataset));
-
-#define SET_IF_PRESENT(name)                                              \
-    if (aDataset.mPresentFlags & PendingOperationalDataset::k##name##Bit) \
-    {                                                                     \
-        aJson[#name] = aDataset.m##name;                                  \
-    };
-
-    SET_IF_PRESENT(PendingTimestamp);
-    SET_IF_PRESENT(DelayTimer);
-
-#undef SET_IF_PRESENT
-}
-
 static void from_json(const Json &aJson, PendingOperationalDataset &aDataset)
 {
     from_json(aJson, static_cast<ActiveOperationalDataset &>(aDataset));
@@ -487,18 +417,6 @@ static void from_json(const Json &aJson, PendingOperationalDataset &aDataset)
 #undef SET_IF_PRESENT
 }
 
-static void to_json(Json &aJson, const NetworkData &aNetworkData)
-{
-#define SET(name) aJson[#name] = aNetworkData.m##name
-
-    SET(ActiveDataset);
-    SET(PendingDataset);
-    SET(CommDataset);
-    SET(BbrDataset);
-
-#undef SET
-}
-
 static void from_json(const Json &aJson, NetworkData &aNetworkData)
 {
 #define SET_IF_PRESENT(name)                                                          \
@@ -515,14 +433,393 @@ static void from_json(const Json &aJson, NetworkData &aNetworkData)
 #undef SET_IF_PRESENT
 }
 
-static void to_json(Json &aJson, const EnergyReport &aEnergyReport)
+// Datasets and energy reports are written by JsonWriter without building a
+// document. Members are written in the sorted order of their names, and
+// an object without any member is written as null, so that the output is
+// the same as dumping a nlohmann::json object.
+
+static void WriteJson(JsonWriter &aWriter, uint64_t aValue)
 {
-#define SET(name) aJson[#name] = aEnergyReport.m##name
+    aWriter.Uint(aValue);
+}
 
-    SET(ChannelMask);
-    SET(EnergyList);
+static void WriteJson(JsonWriter &aWriter, const std::string &aValue)
+{
+    aWriter.String(aValue);
+}
+
+static void WriteJson(JsonWriter &aWriter, const ByteArray &aValue)
+{
+    aWriter.Hex(aValue);
+}
+
+static void WriteJson(JsonWriter &aWriter, const CommissionerDataset &aDataset)
+{
+    static constexpr uint16_t kPresentBits =
+        CommissionerDataset::kBorderAgentLocatorBit | CommissionerDataset::kSessionIdBit |
+        CommissionerDataset::kSteeringDataBit | CommissionerDataset::kAeSteeringDataBit |
+        CommissionerDataset::kNmkpSteeringDataBit | CommissionerDataset::kJoinerUdpPortBit |
+        CommissionerDataset::kAeUdpPortBit | CommissionerDataset::kNmkpUdpPortBit;
+
+    VerifyOrExit(aDataset.mPresentFlags & kPresentBits, aWriter.Null());
+
+#define WRITE_IF_PRESENT(name)                                      \
+    if (aDataset.mPresentFlags & CommissionerDataset::k##name##Bit) \
+    {                                                               \
+        aWriter.Key(#name);                                         \
+        WriteJson(aWriter, aDataset.m##name);                       \
+    };
+
+    aWriter.BeginObject();
+    WRITE_IF_PRESENT(AeSteeringData);
+    WRITE_IF_PRESENT(AeUdpPort);
+    WRITE_IF_PRESENT(BorderAgentLocator);
+    WRITE_IF_PRESENT(JoinerUdpPort);
+    WRITE_IF_PRESENT(NmkpSteeringData);
+    WRITE_IF_PRESENT(NmkpUdpPort);
+    WRITE_IF_PRESENT(SessionId);
+    WRITE_IF_PRESENT(SteeringData);
+    aWriter.EndObject();
+
+#undef WRITE_IF_PRESENT
+
+exit:
+    return;
+}
+
+static void WriteJson(JsonWriter &aWriter, const BbrDataset &aDataset)
+{
+    static constexpr uint16_t kPresentBits =
+        BbrDataset::kTriHostnameBit | BbrDataset::kRegistrarHostnameBit | BbrDataset::kRegistrarIpv6AddrBit;
+
+    VerifyOrExit(aDataset.mPresentFlags & kPresentBits, aWriter.Null());
+
+#define WRITE_IF_PRESENT(name)                             \
+    if (aDataset.mPresentFlags & BbrDataset::k##name##Bit) \
+    {                                                      \
+        aWriter.Key(#name);                                \
+        WriteJson(aWriter, aDataset.m##name);              \
+    };
+
+    aWriter.BeginObject();
+    WRITE_IF_PRESENT(RegistrarHostname);
+    WRITE_IF_PRESENT(RegistrarIpv6Addr);
+    WRITE_IF_PRESENT(TriHostname);
+    aWriter.EndObject();
+
+#undef WRITE_IF_PRESENT
+
+exit:
+    return;
+}
+
+static void WriteJson(JsonWriter &aWriter, const Timestamp &aTimestamp)
+{
+#define WRITE(name)     \
+    aWriter.Key(#name); \
+    WriteJson(aWriter, aTimestamp.m##name);
+
+    aWriter.BeginObject();
+    WRITE(Seconds);
+    WRITE(Ticks);
+    WRITE(U);
+    aWriter.EndObject();
+
+#undef WRITE
+}
+
+static void WriteJson(JsonWriter &aWriter, const Channel &aChannel)
+{
+#define WRITE(name)     \
+    aWriter.Key(#name); \
+    WriteJson(aWriter, aChannel.m##name);
+
+    aWriter.BeginObject();
+    WRITE(Number);
+    WRITE(Page);
+    aWriter.EndObject();
+
+#undef WRITE
+}
+
+static void WriteJson(JsonWriter &aWriter, const ChannelMask &aChannelMask)
+{
+    aWriter.BeginArray();
+    for (auto &entry : aChannelMask)
+    {
+        aWriter.BeginObject();
+        aWriter.Key("Masks");
+        WriteJson(aWriter, entry.mMasks);
+        aWriter.Key("Page");
+        WriteJson(aWriter, entry.mPage);
+        aWriter.EndObject();
+    }
+    aWriter.EndArray();
+}
+
+static void WriteJson(JsonWriter &aWriter, const SecurityPolicy &aSecurityPolicy)
+{
+#define WRITE(name)     \
+    aWriter.Key(#name); \
+    WriteJson(aWriter, aSecurityPolicy.m##name);
+
+    aWriter.BeginObject();
+    WRITE(Flags);
+    WRITE(RotationTime);
+    aWriter.EndObject();
+
+#undef WRITE
+}
+
+// The members of the Pending Operational Dataset are interleaved with those of
+// the Active Operational Dataset in the sorted order. `aPendingDataset` is null
+// when writing an Active Operational Dataset, otherwise it is `aDataset` itself.
+static void WriteOperationalDataset(JsonWriter &                     aWriter,
+                                    const ActiveOperationalDataset & aDataset,
+                                    const PendingOperationalDataset *aPendingDataset)
+{
+    static constexpr uint16_t kActivePresentBits =
+        ActiveOperationalDataset::kActiveTimestampBit | ActiveOperationalDataset::kChannelBit |
+        ActiveOperationalDataset::kChannelMaskBit | ActiveOperationalDataset::kExtendedPanIdBit |
+        ActiveOperationalDataset::kMeshLocalPrefixBit | ActiveOperationalDataset::kNetworkMasterKeyBit |
+        ActiveOperationalDataset::kNetworkNameBit | ActiveOperationalDataset::kPanIdBit |
+        ActiveOperationalDataset::kPSKcBit | ActiveOperationalDataset::kSecurityPolicyBit;
+    static constexpr uint16_t kPendingPresentBits =
+        PendingOperationalDataset::kDelayTimerBit | PendingOperationalDataset::kPendingTimestampBit;
+
+    uint16_t presentFlags = aDataset.mPresentFlags & kActivePresentBits;
+
+    if (aPendingDataset != nullptr)
+    {
+        presentFlags |= aPendingDataset->mPresentFlags & kPendingPresentBits;
+    }
+    VerifyOrExit(presentFlags != 0, aWriter.Null());
+
+#define WRITE_IF_PRESENT(name)                                           \
+    if (aDataset.mPresentFlags & ActiveOperationalDataset::k##name##Bit) \
+    {                                                                    \
+        aWriter.Key(#name);                                              \
+        WriteJson(aWriter, aDataset.m##name);                            \
+    };
+
+#define WRITE_PENDING_IF_PRESENT(name)                                                                            \
+    if (aPendingDataset != nullptr && (aPendingDataset->mPresentFlags & PendingOperationalDataset::k##name##Bit)) \
+    {                                                                                                             \
+        aWriter.Key(#name);                                                                                       \
+        WriteJson(aWriter, aPendingDataset->m##name);                                                             \
+    };
+
+    aWriter.BeginObject();
+    WRITE_IF_PRESENT(ActiveTimestamp);
+    WRITE_IF_PRESENT(Channel);
+    WRITE_IF_PRESENT(ChannelMask);
+    WRITE_PENDING_IF_PRESENT(DelayTimer);
+    WRITE_IF_PRESENT(ExtendedPanId);
+
+    if (aDataset.mPresentFlags & ActiveOperationalDataset::kMeshLocalPrefixBit)
+    {
+        aWriter.Key("MeshLocalPrefix");
+        aWriter.String(Ipv6PrefixToString(aDataset.mMeshLocalPrefix));
+    };
+
+    WRITE_IF_PRESENT(NetworkMasterKey);
+    WRITE_IF_PRESENT(NetworkName);
+    WRITE_IF_PRESENT(PSKc);
+    WRITE_IF_PRESENT(PanId);
+    WRITE_PENDING_IF_PRESENT(PendingTimestamp);
+    WRITE_IF_PRESENT(SecurityPolicy);
+    aWriter.EndObject();
+
+#undef WRITE_PENDING_IF_PRESENT
+#undef WRITE_IF_PRESENT
+
+exit:
+    return;
+}
+
+static void WriteJson(JsonWriter &aWriter, const ActiveOperationalDataset &aDataset)
+{
+    WriteOperationalDataset(aWriter, aDataset, nullptr);
+}
+
+static void WriteJson(JsonWriter &aWriter, const PendingOperationalDataset &aDataset)
+{
+    WriteOperationalDataset(aWriter, aDataset, &aDataset);
+}
+
+static void WriteJson(JsonWriter &aWriter, const NetworkData &aNetworkData)
+{
+#define WRITE(name)     \
+    aWriter.Key(#name); \
+    WriteJson(aWriter, aNetworkData.m##name);
+
+    aWriter.BeginObject();
+    WRITE(ActiveDataset);
+    WRITE(BbrDataset);
+    WRITE(CommDataset);
+    WRITE(PendingDataset);
+    aWriter.EndObject();
+
+#undef WRITE
+}
+
+static void WriteJson(JsonWriter &aWriter, const EnergyReport &aEnergyReport)
+{
+#define WRITE(name)     \
+    aWriter.Key(#name); \
+    WriteJson(aWriter, aEnergyReport.m##name);
+
+    aWriter.BeginObject();
+    WRITE(ChannelMask);
+    WRITE(EnergyList);
+    aWriter.EndObject();
+
+#undef WRITE
+}
+
+static void WriteJson(JsonWriter &aWriter, const EnergyReportMap &aEnergyReportMap)
+{
+    // Device addresses are object keys, which are sorted as strings
+    // rather than in the order of addresses.
+    std::vector<std::pair<std::string, const EnergyReport *>> reports;
+
+    VerifyOrExit(!aEnergyReportMap.empty(), aWriter.Null());
+
+    reports.reserve(aEnergyReportMap.size());
+    for (auto &kv : aEnergyReportMap)
+    {
+        auto &deviceAddr = kv.first;
+        auto &report     = kv.second;
+
+        VerifyOrDie(deviceAddr.IsValid());
+        reports.emplace_back(deviceAddr.ToString(), &report);
+    }
+    std::sort(reports.begin(), reports.end());
+
+    aWriter.BeginObject();
+    for (auto &report : reports)
+    {
+        aWriter.Key(report.first);
+        WriteJson(aWriter, *report.second);
+    }
+    aWriter.EndObject();
+
+exit:
+    return;
+}
+
+template <typename T> static Error ToJson(const JsonWriter::Sink &aSink, const T &aValue)
+{
+    JsonWriter writer(aSink);
+
+    WriteJson(writer, aValue);
+    return writer.Flush();
+}
+
+template <typename T> static std::string ToJsonString(const T &aValue)
+{
+    std::string json;
+
+    // Appending to a string never fails.
+    SuccessOrDie(ToJson(JsonWriter::StringSink(json), aValue));
+    return json;
+}
+
+static void to_json(Json &aJson, const LinkProbeResult &aResult)
+{
+#define SET(name) aJson[#name] = aResult.m##name
+
+    SET(Sent);
+    SET(Received);
+    SET(Duration);
+    SET(MinRtt);
+    SET(P50Rtt);
+    SET(P90Rtt);
+    SET(P99Rtt);
+    SET(MaxRtt);
+    SET(P50HostDelay);
+    SET(MaxHostDelay);
 
 #undef SET
+
+    aJson["LossRate"]   = aResult.GetLossRate();
+    aJson["Throughput"] = aResult.GetThroughput();
+}
+
+static JoinerInfo JoinerInfoFromJson(const Json &aJson)
+{
+    JoinerType  type = aJson.at("Type");
+    ByteArray   eui64;
+    std::string pskd;
+    std::string provisioningUrl;
+
+    SuccessOrThrow(utils::Hex(eui64, aJson.at("Eui64")));
+    if (eui64.size() != sizeof(uint64_t))
+    {
+        throw JsonException(ERROR_INVALID_ARGS("joiner EUI-64 {} is not 8 bytes", utils::Hex(eui64)));
+    }
+
+    if (aJson.contains("PSKd"))
+    {
+        pskd = aJson["PSKd"];
+    }
+
+    if (aJson.contains("ProvisioningUrl"))
+    {
+        provisioningUrl = aJson["ProvisioningUrl"];
+    }
+
+    return JoinerInfo(type, utils::Decode<uint64_t>(eui64), pskd, provisioningUrl);
+}
+
+static void from_json(const Json &aJson, SupervisedNetwork &aNetwork)
+{
+    aNetwork.mName            = aJson.at("Name");
+    aNetwork.mConfigFile      = aJson.at("ConfigFile");
+    aNetwork.mBorderAgentAddr = aJson.at("BorderAgentAddr");
+    aNetwork.mBorderAgentPort = aJson.at("BorderAgentPort");
+
+    if (aJson.contains("Joiners"))
+    {
+        for (auto &joiner : aJson["Joiners"])
+        {
+            aNetwork.mJoiners.push_back(JoinerInfoFromJson(joiner));
+        }
+    }
+}
+
+static void from_json(const Json &aJson, SupervisorConfig &aConfig)
+{
+#define SET_IF_PRESENT(name)            \
+    if (aJson.contains(#name))          \
+    {                                   \
+        aConfig.m##name = aJson[#name]; \
+    };
+
+    SET_IF_PRESENT(WorkerNum);
+    SET_IF_PRESENT(StateDir);
+
+#undef SET_IF_PRESENT
+
+    if (aConfig.mWorkerNum == 0)
+    {
+        throw JsonException(ERROR_INVALID_ARGS("WorkerNum must be greater than 0"));
+    }
+
+    aConfig.mNetworks = aJson.at("Networks").get<std::vector<SupervisedNetwork>>();
+}
+
+static void to_json(Json &aJson, const NetworkCheckpoint &aCheckpoint)
+{
+    aJson["CommissionedJoiners"] = aCheckpoint.mCommissionedJoiners;
+}
+
+static void from_json(const Json &aJson, NetworkCheckpoint &aCheckpoint)
+{
+    if (aJson.contains("CommissionedJoiners"))
+    {
+        aCheckpoint.mCommissionedJoiners = aJson["CommissionedJoiners"].get<std::set<ByteArray>>();
+    }
 }
 
 Error NetworkDataFromJson(NetworkData &aNetworkData, const std::string &aJson)
@@ -545,8 +842,12 @@ Error NetworkDataFromJson(NetworkData &aNetworkData, const std::string &aJson)
 
 std::string NetworkDataToJson(const NetworkData &aNetworkData)
 {
-    Json json = aNetworkData;
-    return json.dump(/* indent */ 4);
+    return ToJsonString(aNetworkData);
+}
+
+Error NetworkDataToJson(const JsonWriter::Sink &aSink, const NetworkData &aNetworkData)
+{
+    return ToJson(aSink, aNetworkData);
 }
 
 Error CommissionerDatasetFromJson(CommissionerDataset &aDataset, const std::string &aJson)
@@ -569,8 +870,7 @@ Error CommissionerDatasetFromJson(CommissionerDataset &aDataset, const std::stri
 
 std::string CommissionerDatasetToJson(const CommissionerDataset &aDataset)
 {
-    Json json = aDataset;
-    return json.dump(/* indent */ 4);
+    return ToJsonString(aDataset);
 }
 
 Error BbrDatasetFromJson(BbrDataset &aDataset, const std::string &aJson)
@@ -593,8 +893,7 @@ Error BbrDatasetFromJson(BbrDataset &aDataset, const std::string &aJson)
 
 std::string BbrDatasetToJson(const BbrDataset &aDataset)
 {
-    Json json = aDataset;
-    return json.dump(/* indent */ 4);
+    return ToJsonString(aDataset);
 }
 
 Error ActiveDatasetFromJson(ActiveOperationalDataset &aDataset, const std::string &aJson)
@@ -617,8 +916,7 @@ Error ActiveDatasetFromJson(ActiveOperationalDataset &aDataset, const std::strin
 
 std::string ActiveDatasetToJson(const ActiveOperationalDataset &aDataset)
 {
-    Json json = aDataset;
-    return json.dump(/* indent */ 4);
+    return ToJsonString(aDataset);
 }
 
 Error PendingDatasetFromJson(PendingOperationalDataset &aDataset, const std::string &aJson)
@@ -641,8 +939,7 @@ Error PendingDatasetFromJson(PendingOperationalDataset &aDataset, const std::str
 
 std::string PendingDatasetToJson(const PendingOperationalDataset &aDataset)
 {
-    Json json = aDataset;
-    return json.dump(/* indent */ 4);
+    return ToJsonString(aDataset);
 }
 
 Error ConfigFromJson(Config &aConfig, const std::string &aJson)
@@ -665,24 +962,95 @@ Error ConfigFromJson(Config &aConfig, const std::string &aJson)
 
 std::string EnergyReportToJson(const EnergyReport &aEnergyReport)
 {
-    Json json = aEnergyReport;
-    return json.dump(/* indent */ 4);
+    return ToJsonString(aEnergyReport);
 }
 
 std::string EnergyReportMapToJson(const EnergyReportMap &aEnergyReportMap)
 {
-    Json json;
+    return ToJsonString(aEnergyReportMap);
+}
 
-    // Manually create json object because the key is not std::string and
-    // the JSON library will map `aEnergyReportMap` into JSON array.
-    for (auto &kv : aEnergyReportMap)
+Error EnergyReportMapToJson(const JsonWriter::Sink &aSink, const EnergyReportMap &aEnergyReportMap)
+{
+    return ToJson(aSink, aEnergyReportMap);
+}
+
+std::string LinkProbeResultToJson(const LinkProbeResult &aResult)
+{
+    Json json = aResult;
+    return json.dump(/* indent */ 4);
+}
+
+Error SupervisorConfigFromJson(SupervisorConfig &aConfig, const std::string &aJson)
+{
+    Error error;
+
+    try
     {
-        auto &deviceAddr = kv.first;
-        auto &report     = kv.second;
+        aConfig = Json::parse(StripComments(aJson));
+    } catch (JsonException &e)
+    {
+        error = e.GetError();
+    } catch (std::exception &e)
+    {
+        error = {ErrorCode::kInvalidArgs, e.what()};
+    }
 
-        VerifyOrDie(deviceAddr.IsValid());
-        json[deviceAddr.ToString()] = report;
+    return error;
+}
+
+Error JoinerListFromJson(std::vector<JoinerInfo> &aJoiners, const std::string &aJson)
+{
+    Error                   error;
+    std::vector<JoinerInfo> joiners;
+
+    try
+    {
+        // Joiner lists are usually generated, comments are not stripped
+        // to keep provisioning URLs like "https://..." intact.
+        Json json = Json::parse(aJson);
+
+        if (!json.is_array())
+        {
+            throw JsonException(ERROR_INVALID_ARGS("a joiner list must be a JSON array"));
+        }
+        for (auto &joiner : json)
+        {
+            joiners.push_back(JoinerInfoFromJson(joiner));
+        }
+        aJoiners = std::move(joiners);
+    } catch (JsonException &e)
+    {
+        error = e.GetError();
+    } catch (std::exception &e)
+    {
+        error = {ErrorCode::kInvalidArgs, e.what()};
     }
+
+    return error;
+}
+
+Error NetworkCheckpointFromJson(NetworkCheckpoint &aCheckpoint, const std::string &aJson)
+{
+    Error error;
+
+    try
+    {
+        aCheckpoint = Json::parse(aJson);
+    } catch (JsonException &e)
+    {
+        error = e.GetError();
+    } catch (std::exception &e)
+    {
+        error = {ErrorCode::kInvalidArgs, e.what()};
+    }
+
+    return error;
+}
+
+std::string NetworkCheckpointToJson(const NetworkCheckpoint &aCheckpoint)
+{
+    Json json = aCheckpoint;
     return json.dump(/* indent */ 4);
 }
 
@@ -35,13 +35,16 @@
 #ifndef OT_COMM_APP_JSON_HPP_
 #define OT_COMM_APP_JSON_HPP_
 
+#include <set>
 #include <string>
+#include <vector>
 
 #include <commissioner/commissioner.hpp>
 #include <commissioner/error.hpp>
 #include <commissioner/network_data.hpp>
 
 #include "app/commissioner_app.hpp"
+#include "app/json_writer.hpp"
 
 namespace ot {
 
@@ -55,9 +58,43 @@ struct NetworkData
     BbrDataset                mBbrDataset;
 };
 
+/**
+ * A Thread network which is managed by a worker of the supervisor.
+ */
+struct SupervisedNetwork
+{
+    std::string             mName;                ///< The unique network name, it decides the owner worker.
+    std::string             mConfigFile;          ///< The commissioner configuration file.
+    std::string             mBorderAgentAddr;     ///< The address of the border agent to petition.
+    uint16_t                mBorderAgentPort = 0; ///< The port of the border agent to petition.
+    std::vector<JoinerInfo> mJoiners;             ///< The joiners enabled after petitioning.
+};
+
+/**
+ * Configuration of the multi-process supervisor.
+ */
+struct SupervisorConfig
+{
+    uint32_t                       mWorkerNum = 1;   ///< The number of worker processes.
+    std::string                    mStateDir  = "."; ///< The directory of checkpoints and metrics files.
+    std::vector<SupervisedNetwork> mNetworks;
+};
+
+/**
+ * The state of a supervised network which survives restarts of its worker.
+ */
+struct NetworkCheckpoint
+{
+    // Joiners that have been commissioned are not enabled again after a restart.
+    std::set<ByteArray> mCommissionedJoiners; ///< The joiner IDs accepted by the commissioner.
+};
+
 Error       NetworkDataFromJson(NetworkData &aNetworkData, const std::string &aJson);
 std::string NetworkDataToJson(const NetworkData &aNetworkData);
 
+// Streams the same JSON as NetworkDataToJson() to `aSink`, without holding it in memory.
+Error NetworkDataToJson(const JsonWriter::Sink &aSink, const NetworkData &aNetworkData);
+
 Error       CommissionerDatasetFromJson(CommissionerDataset &aDataset, const std::string &aJson);
 std::string CommissionerDatasetToJson(const CommissionerDataset &aDataset);
 
@@ -76,6 +113,19 @@ std::string EnergyReportToJson(const EnergyReport &aEnergyReport);
 
 std::string EnergyReportMapToJson(const EnergyReportMap &aEnergyReportMap);
 
+// Streams the same JSON as EnergyReportMapToJson() to `aSink`, without holding it in memory.
+Error EnergyReportMapToJson(const JsonWriter::Sink &aSink, const EnergyReportMap &aEnergyReportMap);
+
+std::string LinkProbeResultToJson(const LinkProbeResult &aResult);
+
+Error SupervisorConfigFromJson(SupervisorConfig &aConfig, const std::string &aJson);
+
+// Parses a JSON array of joiners in the format of the Joiners of a SupervisedNetwork.
+Error JoinerListFromJson(std::vector<JoinerInfo> &aJoiners, const std::string &aJson);
+
+Error       NetworkCheckpointFromJson(NetworkCheckpoint &aCheckpoint, const std::string &aJson);
+std::string NetworkCheckpointToJson(const NetworkCheckpoint &aCheckpoint);
+
 } // namespace commissioner
 
 } // namespace ot
@@ -37,6 +37,7 @@
 
 #include <commissioner/network_data.hpp>
 
+#include "common/address.hpp"
 #include "common/utils.hpp"
 
 namespace ot {
@@ -94,6 +95,205 @@ TEST_CASE("active-operational-dataset-encoding-decoding", "[json]")
     }
 }
 
+TEST_CASE("config-impairment-decoding", "[json]")
+{
+    SECTION("no impairment by default")
+    {
+        Config config;
+
+        REQUIRE(ConfigFromJson(config, R"({"Id": "test"})") == ErrorCode::kNone);
+        REQUIRE(!config.mImpairment.IsEnabled());
+    }
+
+    SECTION("opt-in impairment")
+    {
+        Config config;
+
+        REQUIRE(ConfigFromJson(config, R"({
+            // Impairments of the border agent link.
+            "Impairment": {
+                "Seed": 7,
+                "LossRate": 0.1,
+                "Delay": 100,
+                "DelayJitter": 20
+            }
+        })") == ErrorCode::kNone);
+        REQUIRE(config.mImpairment.IsEnabled());
+        REQUIRE(config.mImpairment.mSeed == 7);
+        REQUIRE(config.mImpairment.mLossRate == Approx(0.1));
+        REQUIRE(config.mImpairment.mDuplicateRate == 0);
+        REQUIRE(config.mImpairment.mDelay == 100);
+        REQUIRE(config.mImpairment.mDelayJitter == 20);
+        REQUIRE(config.mImpairment.mReorderDelay == 100);
+        REQUIRE(config.mImpairment.mRateLimit == 0);
+    }
+}
+
+TEST_CASE("supervisor-config-decoding", "[json]")
+{
+    const std::string kConfig = R"({
+        "WorkerNum": 2,
+        "StateDir": "/var/lib/commissioner",
+        "Networks": [
+            {
+                "Name": "building-1",
+                "ConfigFile": "building-1.json",
+                "BorderAgentAddr": "fdaa:bb::de6",
+                "BorderAgentPort": 49191,
+                "Joiners": [
+                    {"Type": "meshcop", "Eui64": "0011223344556677", "PSKd": "ABCDEF"}
+                ]
+            }
+        ]
+    })";
+
+    SECTION("valid configuration")
+    {
+        SupervisorConfig config;
+
+        REQUIRE(SupervisorConfigFromJson(config, kConfig) == ErrorCode::kNone);
+        REQUIRE(config.mWorkerNum == 2);
+        REQUIRE(config.mStateDir == "/var/lib/commissioner");
+        REQUIRE(config.mNetworks.size() == 1);
+        REQUIRE(config.mNetworks[0].mName == "building-1");
+        REQUIRE(config.mNetworks[0].mBorderAgentPort == 49191);
+        REQUIRE(config.mNetworks[0].mJoiners.size() == 1);
+        REQUIRE(config.mNetworks[0].mJoiners[0].mType == JoinerType::kMeshCoP);
+        REQUIRE(config.mNetworks[0].mJoiners[0].mEui64 == 0x0011223344556677ull);
+        REQUIRE(config.mNetworks[0].mJoiners[0].mPSKd == "ABCDEF");
+    }
+
+    SECTION("invalid joiner EUI-64")
+    {
+        SupervisorConfig config;
+        std::string      json = kConfig;
+
+        json.replace(json.find("0011223344556677"), 16, "001122");
+        REQUIRE(SupervisorConfigFromJson(config, json) == ErrorCode::kInvalidArgs);
+    }
+
+    SECTION("missing networks")
+    {
+        SupervisorConfig config;
+
+        REQUIRE(SupervisorConfigFromJson(config, R"({"WorkerNum": 2})") == ErrorCode::kInvalidArgs);
+    }
+}
+
+TEST_CASE("joiner-list-decoding", "[json]")
+{
+    SECTION("valid joiner list")
+    {
+        std::vector<JoinerInfo> joiners;
+
+        REQUIRE(JoinerListFromJson(joiners, R"([
+            {"Type": "meshcop", "Eui64": "0011223344556677", "PSKd": "ABCDEF", "ProvisioningUrl": "https://a.b"},
+            {"Type": "ae", "Eui64": "0000000000000000"}
+        ])") == ErrorCode::kNone);
+        REQUIRE(joiners.size() == 2);
+        REQUIRE(joiners[0].mType == JoinerType::kMeshCoP);
+        REQUIRE(joiners[0].mEui64 == 0x0011223344556677ull);
+        REQUIRE(joiners[0].mPSKd == "ABCDEF");
+        REQUIRE(joiners[0].mProvisioningUrl == "https://a.b");
+        REQUIRE(joiners[1].mType == JoinerType::kAE);
+        REQUIRE(joiners[1].mEui64 == 0);
+    }
+
+    SECTION("invalid joiner list is not decoded")
+    {
+        std::vector<JoinerInfo> joiners{{JoinerType::kNMKP, 1, "", ""}};
+
+        REQUIRE(JoinerListFromJson(joiners, R"({"Type": "meshcop", "Eui64": "0011223344556677"})") ==
+                ErrorCode::kInvalidArgs);
+        REQUIRE(JoinerListFromJson(joiners, R"([{"Type": "meshcop", "Eui64": "001122"}])") ==
+                ErrorCode::kInvalidArgs);
+        REQUIRE(JoinerListFromJson(joiners, R"([{"Type": "meshcop", "Eui64": "0011223344556677"},)") ==
+                ErrorCode::kInvalidArgs);
+        REQUIRE(joiners.size() == 1);
+        REQUIRE(joiners[0].mType == JoinerType::kNMKP);
+    }
+}
+
+TEST_CASE("network-checkpoint-encoding-decoding", "[json]")
+{
+    NetworkCheckpoint checkpoint;
+    NetworkCheckpoint checkpoint1;
+
+    checkpoint.mCommissionedJoiners.insert({0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08});
+
+    REQUIRE(NetworkCheckpointFromJson(checkpoint1, NetworkCheckpointToJson(checkpoint)) == ErrorCode::kNone);
+    REQUIRE(checkpoint1.mCommissionedJoiners == checkpoint.mCommissionedJoiners);
+}
+
+TEST_CASE("energy-report-map-encoding", "[json]")
+{
+    EnergyReportMap reports;
+    Address         addr;
+
+    REQUIRE(EnergyReportMapToJson(reports) == "null");
+
+    for (auto deviceAddr : {"fd00::2", "fd00::10"})
+    {
+        REQUIRE(addr.Set(deviceAddr) == ErrorCode::kNone);
+        reports[addr] = EnergyReport{{{0, {0x07, 0xff, 0xf8, 0x00}}}, {0xa0, 0xb0}};
+    }
+
+    // Device addresses are sorted as strings.
+    const std::string kJson = "{\n"
+                              "    \"fd00::10\": {\n"
+                              "        \"ChannelMask\": [\n"
+                              "            {\n"
+                              "                \"Masks\": \"07fff800\",\n"
+                              "                \"Page\": 0\n"
+                              "            }\n"
+                              "        ],\n"
+                              "        \"EnergyList\": \"a0b0\"\n"
+                              "    },\n"
+                              "    \"fd00::2\": {\n"
+                              "        \"ChannelMask\": [\n"
+                              "            {\n"
+                              "                \"Masks\": \"07fff800\",\n"
+                              "                \"Page\": 0\n"
+                              "            }\n"
+                              "        ],\n"
+                              "        \"EnergyList\": \"a0b0\"\n"
+                              "    }\n"
+                              "}";
+
+    REQUIRE(EnergyReportMapToJson(reports) == kJson);
+
+    SECTION("streaming to a sink")
+    {
+        std::string json;
+
+        REQUIRE(EnergyReportMapToJson(JsonWriter::StringSink(json), reports) == ErrorCode::kNone);
+        REQUIRE(json == kJson);
+    }
+}
+
+TEST_CASE("network-data-encoding-decoding", "[json]")
+{
+    NetworkData networkData;
+    NetworkData networkData1;
+    std::string json;
+
+    networkData.mActiveDataset.mNetworkName = "Open\"Thread\"\n";
+    networkData.mActiveDataset.mPresentFlags |= ActiveOperationalDataset::kNetworkNameBit;
+    networkData.mPendingDataset.mDelayTimer = 30000;
+    networkData.mPendingDataset.mPresentFlags |= PendingOperationalDataset::kDelayTimerBit;
+
+    REQUIRE(NetworkDataToJson(JsonWriter::StringSink(json), networkData) == ErrorCode::kNone);
+    REQUIRE(json == NetworkDataToJson(networkData));
+
+    // Datasets without any member are written as null.
+    REQUIRE(json.find("\"BbrDataset\": null") != std::string::npos);
+    REQUIRE(json.find("\"CommDataset\": null") != std::string::npos);
+
+    REQUIRE(NetworkDataFromJson(networkData1, json) == ErrorCode::kNone);
+    REQUIRE(networkData1.mActiveDataset.mNetworkName == networkData.mActiveDataset.mNetworkName);
+    REQUIRE(networkData1.mPendingDataset.mDelayTimer == networkData.mPendingDataset.mDelayTimer);
+}
+
 } // namespace commissioner
 
 } // namespace ot
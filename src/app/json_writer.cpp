@@ -0,0 +1,342 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the streaming JSON writer.
+ *
+ */
+
+#include "app/json_writer.hpp"
+
+#include <algorithm>
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "common/error_macros.hpp"
+#include "common/utils.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+static const char kHexDigits[] = "0123456789abcdef";
+
+constexpr size_t JsonWriter::kBufferSize;
+constexpr size_t JsonWriter::kIndent;
+
+JsonWriter::JsonWriter(Sink aSink)
+    : mSink(aSink)
+    , mLength(0)
+    , mAfterKey(false)
+{
+}
+
+void JsonWriter::BeginObject()
+{
+    Begin('{');
+}
+
+void JsonWriter::EndObject()
+{
+    End('}');
+}
+
+void JsonWriter::BeginArray()
+{
+    Begin('[');
+}
+
+void JsonWriter::EndArray()
+{
+    End(']');
+}
+
+void JsonWriter::Key(const std::string &aKey)
+{
+    BeginValue();
+    Quote(aKey);
+    Put(": ", 2);
+    mAfterKey = true;
+}
+
+void JsonWriter::String(const std::string &aValue)
+{
+    BeginValue();
+    Quote(aValue);
+}
+
+void JsonWriter::Hex(const ByteArray &aValue)
+{
+    BeginValue();
+    Put('"');
+    for (auto byte : aValue)
+    {
+        Put(kHexDigits[byte >> 4]);
+        Put(kHexDigits[byte & 0x0f]);
+    }
+    Put('"');
+}
+
+void JsonWriter::Uint(uint64_t aValue)
+{
+    char   digits[20];
+    size_t length = 0;
+
+    do
+    {
+        digits[length++] = '0' + aValue % 10;
+        aValue /= 10;
+    } while (aValue != 0);
+
+    BeginValue();
+    while (length > 0)
+    {
+        Put(digits[--length]);
+    }
+}
+
+void JsonWriter::Null()
+{
+    BeginValue();
+    Put("null", 4);
+}
+
+Error JsonWriter::Flush()
+{
+    Drain();
+    return mError;
+}
+
+JsonWriter::Sink JsonWriter::FdSink(int aFd)
+{
+    return [aFd](const char *aData, size_t aLength) -> Error {
+        while (aLength > 0)
+        {
+            ssize_t written = write(aFd, aData, aLength);
+
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                return ERROR_IO_ERROR("failed to write JSON: {}", strerror(errno));
+            }
+
+            aData += written;
+            aLength -= written;
+        }
+        return ERROR_NONE;
+    };
+}
+
+JsonWriter::Sink JsonWriter::StringSink(std::string &aString)
+{
+    return [&aString](const char *aData, size_t aLength) -> Error {
+        aString.append(aData, aLength);
+        return ERROR_NONE;
+    };
+}
+
+void JsonWriter::BeginValue()
+{
+    if (mAfterKey)
+    {
+        mAfterKey = false;
+    }
+    else if (!mHasMembers.empty())
+    {
+        if (mHasMembers.back())
+        {
+            Put(',');
+        }
+        mHasMembers.back() = true;
+        NewLine(mHasMembers.size());
+    }
+}
+
+void JsonWriter::Begin(char aBracket)
+{
+    BeginValue();
+    Put(aBracket);
+    mHasMembers.push_back(false);
+}
+
+void JsonWriter::End(char aBracket)
+{
+    bool hasMembers;
+
+    VerifyOrDie(!mHasMembers.empty() && !mAfterKey);
+
+    hasMembers = mHasMembers.back();
+    mHasMembers.pop_back();
+    if (hasMembers)
+    {
+        NewLine(mHasMembers.size());
+    }
+    Put(aBracket);
+}
+
+void JsonWriter::NewLine(size_t aDepth)
+{
+    Put('\n');
+    for (size_t i = 0; i < aDepth * kIndent; ++i)
+    {
+        Put(' ');
+    }
+}
+
+void JsonWriter::Quote(const std::string &aString)
+{
+    size_t i = 0;
+
+    Put('"');
+    while (i < aString.size())
+    {
+        uint8_t c      = aString[i];
+        size_t  length = 0;
+        uint8_t min    = 0x80;
+        uint8_t max    = 0xbf;
+
+        switch (c)
+        {
+        case '"':
+            Put("\\\"", 2);
+            break;
+        case '\\':
+            Put("\\\\", 2);
+            break;
+        case '\b':
+            Put("\\b", 2);
+            break;
+        case '\f':
+            Put("\\f", 2);
+            break;
+        case '\n':
+            Put("\\n", 2);
+            break;
+        case '\r':
+            Put("\\r", 2);
+            break;
+        case '\t':
+            Put("\\t", 2);
+            break;
+        default:
+            if (c < 0x20)
+            {
+                Put("\\u00", 4);
+                Put(kHexDigits[c >> 4]);
+                Put(kHexDigits[c & 0x0f]);
+            }
+            else if (c < 0x80)
+            {
+                Put(c);
+            }
+            else
+            {
+                // The ranges of well-formed UTF-8 sequences, which exclude
+                // overlong encodings, surrogates and code points above U+10FFFF.
+                if (c >= 0xc2 && c <= 0xdf)
+                {
+                    length = 2;
+                }
+                else if (c >= 0xe0 && c <= 0xef)
+                {
+                    length = 3;
+                    min    = (c == 0xe0) ? 0xa0 : 0x80;
+                    max    = (c == 0xed) ? 0x9f : 0xbf;
+                }
+                else if (c >= 0xf0 && c <= 0xf4)
+                {
+                    length = 4;
+                    min    = (c == 0xf0) ? 0x90 : 0x80;
+                    max    = (c == 0xf4) ? 0x8f : 0xbf;
+                }
+
+                for (size_t j = 1; j < length; ++j)
+                {
+                    uint8_t next = (i + j < aString.size()) ? aString[i + j] : 0;
+
+                    if (next < (j == 1 ? min : 0x80) || next > (j == 1 ? max : 0xbf))
+                    {
+                        length = 0;
+                        break;
+                    }
+                }
+
+                if (length == 0)
+                {
+                    Put("\xef\xbf\xbd", 3);
+                }
+                else
+                {
+                    Put(&aString[i], length);
+                    i += length - 1;
+                }
+            }
+            break;
+        }
+        ++i;
+    }
+    Put('"');
+}
+
+void JsonWriter::Put(const char *aData, size_t aLength)
+{
+    while (aLength > 0)
+    {
+        size_t length = std::min(aLength, kBufferSize - mLength);
+
+        if (length == 0)
+        {
+            Drain();
+            continue;
+        }
+
+        memcpy(mBuffer + mLength, aData, length);
+        mLength += length;
+        aData += length;
+        aLength -= length;
+    }
+}
+
+void JsonWriter::Drain()
+{
+    if (mError == ErrorCode::kNone && mLength > 0)
+    {
+        mError = mSink(mBuffer, mLength);
+    }
+    mLength = 0;
+}
+
+} // namespace commissioner
+
+} // namespace ot
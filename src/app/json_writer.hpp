@@ -0,0 +1,137 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines the streaming JSON writer.
+ *
+ */
+
+#ifndef OT_COMM_APP_JSON_WRITER_HPP_
+#define OT_COMM_APP_JSON_WRITER_HPP_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <commissioner/defines.hpp>
+#include <commissioner/error.hpp>
+
+namespace ot {
+
+namespace commissioner {
+
+/**
+ * A JSON writer which emits values as they are written, without building
+ * a document in memory.
+ *
+ * The output is pretty-printed with an indent of 4 spaces, the same as
+ * `nlohmann::json::dump(4)`, so that it is byte-identical to dumping the
+ * equivalent document if members are written in sorted order. Output is
+ * collected in a fixed-size buffer which is passed to the sink whenever it
+ * is full, so memory stays bounded regardless of the output size.
+ *
+ * The first error returned by the sink is kept and later output is dropped.
+ *
+ */
+class JsonWriter
+{
+public:
+    using Sink = std::function<Error(const char *aData, size_t aLength)>;
+
+    static constexpr size_t kBufferSize = 4096;
+    static constexpr size_t kIndent     = 4;
+
+    explicit JsonWriter(Sink aSink);
+
+    JsonWriter(const JsonWriter &) = delete;
+    JsonWriter &operator=(const JsonWriter &) = delete;
+
+    void BeginObject();
+    void EndObject();
+    void BeginArray();
+    void EndArray();
+
+    // Writes the name of the next member of the current object.
+    void Key(const std::string &aKey);
+
+    // Invalid UTF-8 sequences are replaced by U+FFFD.
+    void String(const std::string &aValue);
+
+    // Writes a ByteArray as a lower-case hex string.
+    void Hex(const ByteArray &aValue);
+
+    void Uint(uint64_t aValue);
+    void Null();
+
+    // Passes buffered output to the sink and returns the first error of the sink.
+    Error Flush();
+
+    // Writes to file descriptor `aFd`, which is not closed by the sink.
+    static Sink FdSink(int aFd);
+
+    // Appends to `aString`, which must outlive the sink.
+    static Sink StringSink(std::string &aString);
+
+private:
+    void BeginValue();
+    void Begin(char aBracket);
+    void End(char aBracket);
+    void NewLine(size_t aDepth);
+    void Quote(const std::string &aString);
+
+    void Put(char aChar)
+    {
+        if (mLength == kBufferSize)
+        {
+            Drain();
+        }
+        mBuffer[mLength++] = aChar;
+    }
+    void Put(const char *aData, size_t aLength);
+    void Drain();
+
+    Sink   mSink;
+    Error  mError;
+    char   mBuffer[kBufferSize];
+    size_t mLength;
+
+    // Whether each open container has members, for the separators and
+    // the empty containers `{}` and `[]`.
+    std::vector<bool> mHasMembers;
+    bool              mAfterKey;
+};
+
+} // namespace commissioner
+
+} // namespace ot
+
+#endif // OT_COMM_APP_JSON_WRITER_HPP_
@@ -0,0 +1,196 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines test cases for the streaming JSON writer.
+ */
+
+#include "app/json_writer.hpp"
+
+#include <vector>
+
+#include <stdio.h>
+
+#include <catch2/catch.hpp>
+
+#include "common/error_macros.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+TEST_CASE("json-writer-pretty-print", "[json-writer]")
+{
+    std::string json;
+    JsonWriter  writer(JsonWriter::StringSink(json));
+
+    writer.BeginObject();
+    writer.Key("Array");
+    writer.BeginArray();
+    writer.Uint(0);
+    writer.Uint(18446744073709551615ULL);
+    writer.BeginObject();
+    writer.EndObject();
+    writer.BeginArray();
+    writer.EndArray();
+    writer.EndArray();
+    writer.Key("Hex");
+    writer.Hex({0x00, 0xab, 0x0f});
+    writer.Key("Null");
+    writer.Null();
+    writer.Key("String");
+    writer.String("foo");
+    writer.EndObject();
+
+    REQUIRE(writer.Flush() == ErrorCode::kNone);
+    REQUIRE(json == "{\n"
+                    "    \"Array\": [\n"
+                    "        0,\n"
+                    "        18446744073709551615,\n"
+                    "        {},\n"
+                    "        []\n"
+                    "    ],\n"
+                    "    \"Hex\": \"00ab0f\",\n"
+                    "    \"Null\": null,\n"
+                    "    \"String\": \"foo\"\n"
+                    "}");
+}
+
+TEST_CASE("json-writer-string-escaping", "[json-writer]")
+{
+    std::string json;
+    JsonWriter  writer(JsonWriter::StringSink(json));
+
+    SECTION("control characters and quotes are escaped")
+    {
+        writer.String(std::string("\"\\/\b\f\n\r\t\x01\x1f\x7f", 11) + std::string(1, '\0'));
+        REQUIRE(writer.Flush() == ErrorCode::kNone);
+        REQUIRE(json == "\"\\\"\\\\/\\b\\f\\n\\r\\t\\u0001\\u001f\x7f\\u0000\"");
+    }
+
+    SECTION("valid UTF-8 is written as is")
+    {
+        writer.String("caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80");
+        REQUIRE(writer.Flush() == ErrorCode::kNone);
+        REQUIRE(json == "\"caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80\"");
+    }
+
+    SECTION("invalid UTF-8 is replaced")
+    {
+        // A truncated sequence, an overlong encoding and a surrogate.
+        writer.String("a\xc3" "b\xc0\xaf" "c\xed\xa0\x80");
+        REQUIRE(writer.Flush() == ErrorCode::kNone);
+        REQUIRE(json == "\"a\xef\xbf\xbd" "b\xef\xbf\xbd\xef\xbf\xbd" "c\xef\xbf\xbd\xef\xbf\xbd\xef\xbf\xbd\"");
+    }
+}
+
+TEST_CASE("json-writer-bounded-buffer", "[json-writer]")
+{
+    static constexpr size_t kValueNum = 4 * JsonWriter::kBufferSize;
+
+    std::vector<size_t> chunks;
+    std::string         json;
+    std::string         expected = "[";
+
+    JsonWriter writer([&chunks, &json](const char *aData, size_t aLength) {
+        chunks.push_back(aLength);
+        json.append(aData, aLength);
+        return ERROR_NONE;
+    });
+
+    writer.BeginArray();
+    for (size_t i = 0; i < kValueNum; ++i)
+    {
+        writer.Uint(i % 10);
+        expected += (i == 0 ? "\n    " : ",\n    ") + std::to_string(i % 10);
+    }
+    writer.EndArray();
+    expected += "\n]";
+
+    REQUIRE(writer.Flush() == ErrorCode::kNone);
+    REQUIRE(json == expected);
+    REQUIRE(chunks.size() > 1);
+    for (auto chunk : chunks)
+    {
+        REQUIRE(chunk <= JsonWriter::kBufferSize);
+    }
+}
+
+TEST_CASE("json-writer-sink-error", "[json-writer]")
+{
+    size_t     calls = 0;
+    JsonWriter writer([&calls](const char *, size_t) {
+        ++calls;
+        return ERROR_IO_ERROR("disk full");
+    });
+
+    writer.BeginArray();
+    for (size_t i = 0; i < 4 * JsonWriter::kBufferSize; ++i)
+    {
+        writer.Uint(i);
+    }
+    writer.EndArray();
+
+    // The output is dropped after the first error.
+    REQUIRE(writer.Flush() == ErrorCode::kIOError);
+    REQUIRE(calls == 1);
+}
+
+TEST_CASE("json-writer-fd-sink", "[json-writer]")
+{
+    FILE *      file = tmpfile();
+    std::string json;
+    char        buf[64];
+    size_t      length;
+
+    REQUIRE(file != nullptr);
+
+    {
+        JsonWriter writer(JsonWriter::FdSink(fileno(file)));
+
+        writer.BeginObject();
+        writer.Key("Name");
+        writer.String("OpenThread");
+        writer.EndObject();
+        REQUIRE(writer.Flush() == ErrorCode::kNone);
+    }
+
+    rewind(file);
+    while ((length = fread(buf, 1, sizeof(buf), file)) > 0)
+    {
+        json.append(buf, length);
+    }
+    fclose(file);
+
+    REQUIRE(json == "{\n    \"Name\": \"OpenThread\"\n}");
+}
+
+} // namespace commissioner
+
+} // namespace ot
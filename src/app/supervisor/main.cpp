@@ -0,0 +1,85 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   The file is the entrance of the commissioner supervisor.
+ */
+
+#include <iostream>
+
+#include "app/file_util.hpp"
+#include "app/json.hpp"
+#include "app/supervisor/supervisor.hpp"
+#include "common/utils.hpp"
+
+#ifndef OT_COMM_VERSION
+#error "OT_COMM_VERSION not defined"
+#endif
+
+using namespace ot::commissioner;
+
+static void PrintUsage(const std::string &aProgram)
+{
+    std::cout << "usage: " << std::endl << "    " << aProgram << " <supervisor-config-file>" << std::endl;
+}
+
+int main(int argc, const char *argv[])
+{
+    Error            error;
+    std::string      configJson;
+    SupervisorConfig config;
+
+    if (argc < 2 || std::string(argv[1]) == "-h" || std::string(argv[1]) == "--help")
+    {
+        PrintUsage(argv[0]);
+        ExitNow();
+    }
+    else if (std::string(argv[1]) == "-v" || std::string(argv[1]) == "--version")
+    {
+        std::cout << OT_COMM_VERSION << std::endl;
+        ExitNow();
+    }
+
+    SuccessOrExit(error = ReadFile(configJson, argv[1]));
+    SuccessOrExit(error = SupervisorConfigFromJson(config, configJson));
+
+    {
+        Supervisor supervisor(config);
+
+        SuccessOrExit(error = supervisor.Init());
+        SuccessOrExit(error = supervisor.Run());
+    }
+
+exit:
+    if (error != ErrorCode::kNone)
+    {
+        std::cerr << "OT-commissioner supervisor failed: " << error.ToString() << std::endl;
+    }
+    return error == ErrorCode::kNone ? 0 : -1;
+}
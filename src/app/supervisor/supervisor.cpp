@@ -0,0 +1,450 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the commissioner supervisor.
+ *
+ */
+
+#include "app/supervisor/supervisor.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <set>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <fmt/format.h>
+
+#include "app/hash_ring.hpp"
+#include "app/supervisor/worker.hpp"
+#include "common/error_macros.hpp"
+#include "common/utils.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+constexpr uint32_t Supervisor::kMinRestartBackoff;
+constexpr uint32_t Supervisor::kMaxRestartBackoff;
+constexpr uint32_t Supervisor::kHealthyUptime;
+constexpr uint32_t Supervisor::kStopTimeout;
+
+int Supervisor::sSignalPipe[2] = {-1, -1};
+
+static void Print(const std::string &aLine)
+{
+    std::cout << aLine << std::endl;
+}
+
+static std::string DescribeExitStatus(int aStatus)
+{
+    std::string ret;
+
+    if (WIFEXITED(aStatus))
+    {
+        ret = fmt::format("exited with status {}", WEXITSTATUS(aStatus));
+    }
+    else if (WIFSIGNALED(aStatus))
+    {
+        ret = fmt::format("killed by signal {} ({})", WTERMSIG(aStatus), strsignal(WTERMSIG(aStatus)));
+    }
+    else
+    {
+        ret = fmt::format("stopped with status {}", aStatus);
+    }
+
+    return ret;
+}
+
+static Error SetNonBlockingCloseOnExec(int aFd)
+{
+    Error error;
+
+    VerifyOrExit(fcntl(aFd, F_SETFL, fcntl(aFd, F_GETFL) | O_NONBLOCK) == 0 &&
+                     fcntl(aFd, F_SETFD, fcntl(aFd, F_GETFD) | FD_CLOEXEC) == 0,
+                 error = ERROR_IO_ERROR("fcntl() failed: {}", strerror(errno)));
+
+exit:
+    return error;
+}
+
+Supervisor::Supervisor(const SupervisorConfig &aConfig)
+    : mConfig(aConfig)
+{
+}
+
+Error Supervisor::Init()
+{
+    Error                 error;
+    HashRing              ring;
+    std::set<std::string> names;
+
+    VerifyOrExit(mConfig.mWorkerNum > 0, error = ERROR_INVALID_ARGS("the number of workers must be greater than 0"));
+    VerifyOrExit(mkdir(mConfig.mStateDir.c_str(), 0755) == 0 || errno == EEXIST,
+                 error = ERROR_IO_ERROR("cannot create state directory '{}', {}", mConfig.mStateDir, strerror(errno)));
+
+    mWorkers.resize(mConfig.mWorkerNum);
+    for (size_t i = 0; i < mWorkers.size(); ++i)
+    {
+        mWorkers[i].mBackoff = std::chrono::seconds(kMinRestartBackoff);
+        ring.AddNode(i);
+    }
+
+    for (auto &network : mConfig.mNetworks)
+    {
+        // The name is the key of consistent hashing and checkpoint files.
+        VerifyOrExit(!network.mName.empty() && network.mName.find('/') == std::string::npos,
+                     error = ERROR_INVALID_ARGS("network name '{}' is not a valid file name", network.mName));
+        VerifyOrExit(names.insert(network.mName).second,
+                     error = ERROR_INVALID_ARGS("network name '{}' is duplicated", network.mName));
+
+        mWorkers[ring.GetNode(network.mName)].mNetworks.push_back(network);
+    }
+
+exit:
+    return error;
+}
+
+Error Supervisor::Run()
+{
+    Error            error;
+    struct sigaction action;
+
+    VerifyOrExit(pipe(sSignalPipe) == 0, error = ERROR_IO_ERROR("pipe() failed: {}", strerror(errno)));
+    SuccessOrExit(error = SetNonBlockingCloseOnExec(sSignalPipe[0]));
+    SuccessOrExit(error = SetNonBlockingCloseOnExec(sSignalPipe[1]));
+
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = HandleSignal;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGTERM, &action, nullptr);
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGCHLD, &action, nullptr);
+
+    for (size_t i = 0; i < mWorkers.size(); ++i)
+    {
+        if (mWorkers[i].mNetworks.empty())
+        {
+            Print(fmt::format("worker {} has no networks, not started", i));
+            continue;
+        }
+
+        SuccessOrExit(error = StartWorker(i));
+    }
+
+    while (!Poll(/* aTimeout */ 1000))
+    {
+        ReapWorkers(/* aRestart */ true);
+        RestartWorkers();
+    }
+
+exit:
+    StopWorkers();
+    return error;
+}
+
+Error Supervisor::StartWorker(size_t aIndex)
+{
+    Error       error;
+    auto &      worker = mWorkers[aIndex];
+    int         output[2];
+    pid_t       pid;
+    std::string networkNames;
+
+    if (worker.mOutput >= 0)
+    {
+        // Print the remaining output of the previous process.
+        FlushWorkerOutput(aIndex, /* aFlushPartialLine */ true);
+        close(worker.mOutput);
+        worker.mOutput = -1;
+    }
+
+    VerifyOrExit(pipe(output) == 0, error = ERROR_IO_ERROR("pipe() failed: {}", strerror(errno)));
+
+    std::cout.flush();
+
+    pid = fork();
+    if (pid < 0)
+    {
+        close(output[0]);
+        close(output[1]);
+        ExitNow(error = ERROR_IO_ERROR("fork() failed: {}", strerror(errno)));
+    }
+
+    if (pid == 0)
+    {
+        // The worker process.
+        dup2(output[1], STDOUT_FILENO);
+        dup2(output[1], STDERR_FILENO);
+        close(output[0]);
+        close(output[1]);
+
+        close(sSignalPipe[0]);
+        close(sSignalPipe[1]);
+        for (auto &other : mWorkers)
+        {
+            if (other.mOutput >= 0)
+            {
+                close(other.mOutput);
+            }
+        }
+
+        signal(SIGTERM, SIG_DFL);
+        signal(SIGINT, SIG_DFL);
+        signal(SIGCHLD, SIG_DFL);
+
+        _exit(commissioner::Worker(aIndex, mConfig.mStateDir, worker.mNetworks).Run());
+    }
+
+    close(output[1]);
+    IgnoreError(SetNonBlockingCloseOnExec(output[0]));
+
+    worker.mPid       = pid;
+    worker.mOutput    = output[0];
+    worker.mStartTime = SteadyClock::now();
+    worker.mPendingOutput.clear();
+
+    for (auto &network : worker.mNetworks)
+    {
+        networkNames += (networkNames.empty() ? "" : ", ") + network.mName;
+    }
+    Print(fmt::format("started worker {} (pid {}) for networks: {}", aIndex, pid, networkNames));
+
+exit:
+    return error;
+}
+
+void Supervisor::ReadWorkerOutput(size_t aIndex)
+{
+    auto &  worker = mWorkers[aIndex];
+    char    buf[4096];
+    ssize_t len;
+
+    while ((len = read(worker.mOutput, buf, sizeof(buf))) > 0)
+    {
+        worker.mPendingOutput.append(buf, static_cast<size_t>(len));
+    }
+
+    if (len == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR))
+    {
+        // All processes writing to the pipe have exited.
+        FlushWorkerOutput(aIndex, /* aFlushPartialLine */ true);
+        close(worker.mOutput);
+        worker.mOutput = -1;
+    }
+    else
+    {
+        FlushWorkerOutput(aIndex, /* aFlushPartialLine */ false);
+    }
+}
+
+void Supervisor::FlushWorkerOutput(size_t aIndex, bool aFlushPartialLine)
+{
+    auto & pending = mWorkers[aIndex].mPendingOutput;
+    size_t begin   = 0;
+    size_t end;
+
+    while ((end = pending.find('\n', begin)) != std::string::npos)
+    {
+        Print(fmt::format("[worker {}] {}", aIndex, pending.substr(begin, end - begin)));
+        begin = end + 1;
+    }
+
+    pending.erase(0, begin);
+
+    if (aFlushPartialLine && !pending.empty())
+    {
+        Print(fmt::format("[worker {}] {}", aIndex, pending));
+        pending.clear();
+    }
+}
+
+void Supervisor::ReapWorkers(bool aRestart)
+{
+    pid_t pid;
+    int   status;
+
+    while ((pid = waitpid(-1, &status, WNOHANG)) > 0)
+    {
+        auto worker = std::find_if(mWorkers.begin(), mWorkers.end(),
+                                   [pid](const WorkerProcess &aWorker) { return aWorker.mPid == pid; });
+        auto index  = static_cast<size_t>(worker - mWorkers.begin());
+
+        if (worker == mWorkers.end())
+        {
+            continue;
+        }
+
+        worker->mPid = -1;
+
+        if (!aRestart)
+        {
+            Print(fmt::format("worker {} (pid {}) {}", index, pid, DescribeExitStatus(status)));
+            continue;
+        }
+
+        if (SteadyClock::now() - worker->mStartTime >= std::chrono::seconds(kHealthyUptime))
+        {
+            worker->mBackoff = std::chrono::seconds(kMinRestartBackoff);
+        }
+
+        worker->mRestartTime = SteadyClock::now() + worker->mBackoff;
+        ++worker->mRestartCount;
+
+        Print(fmt::format("worker {} (pid {}) {}, restart #{} in {} seconds", index, pid, DescribeExitStatus(status),
+                          worker->mRestartCount, worker->mBackoff.count()));
+
+        worker->mBackoff = std::min(worker->mBackoff * 2, std::chrono::seconds(kMaxRestartBackoff));
+    }
+}
+
+void Supervisor::RestartWorkers()
+{
+    for (size_t i = 0; i < mWorkers.size(); ++i)
+    {
+        auto &worker = mWorkers[i];
+
+        if (worker.mPid >= 0 || worker.mNetworks.empty() || SteadyClock::now() < worker.mRestartTime)
+        {
+            continue;
+        }
+
+        Error error = StartWorker(i);
+
+        if (error != ErrorCode::kNone)
+        {
+            Print(fmt::format("start worker {} failed: {}", i, error.ToString()));
+            worker.mRestartTime = SteadyClock::now() + worker.mBackoff;
+        }
+    }
+}
+
+void Supervisor::StopWorkers()
+{
+    auto deadline = SteadyClock::now() + std::chrono::seconds(kStopTimeout);
+    bool killed   = false;
+
+    for (auto &worker : mWorkers)
+    {
+        if (worker.mPid > 0)
+        {
+            kill(worker.mPid, SIGTERM);
+        }
+    }
+
+    while (std::any_of(mWorkers.begin(), mWorkers.end(), [](const WorkerProcess &aWorker) {
+        return aWorker.mPid > 0 || aWorker.mOutput >= 0;
+    }))
+    {
+        if (!killed && SteadyClock::now() >= deadline)
+        {
+            for (size_t i = 0; i < mWorkers.size(); ++i)
+            {
+                if (mWorkers[i].mPid > 0)
+                {
+                    Print(fmt::format("worker {} (pid {}) is not stopped in {} seconds, kill it", i, mWorkers[i].mPid,
+                                      kStopTimeout));
+                    kill(mWorkers[i].mPid, SIGKILL);
+                }
+            }
+            killed = true;
+        }
+
+        Poll(/* aTimeout */ 100);
+        ReapWorkers(/* aRestart */ false);
+    }
+}
+
+bool Supervisor::Poll(int aTimeout)
+{
+    std::vector<struct pollfd> fds;
+    std::vector<size_t>        indexes;
+    bool                       stop = false;
+
+    fds.push_back({sSignalPipe[0], POLLIN, 0});
+    for (size_t i = 0; i < mWorkers.size(); ++i)
+    {
+        if (mWorkers[i].mOutput >= 0)
+        {
+            fds.push_back({mWorkers[i].mOutput, POLLIN, 0});
+            indexes.push_back(i);
+        }
+    }
+
+    VerifyOrExit(poll(fds.data(), fds.size(), aTimeout) > 0);
+
+    if (fds[0].revents & POLLIN)
+    {
+        char signals[16];
+
+        // The SIGCHLD signal only wakes up the loop to reap workers.
+        ssize_t len = read(sSignalPipe[0], signals, sizeof(signals));
+
+        for (ssize_t i = 0; i < len; ++i)
+        {
+            stop = stop || signals[i] == SIGTERM || signals[i] == SIGINT;
+        }
+    }
+
+    for (size_t i = 0; i < indexes.size(); ++i)
+    {
+        if (fds[i + 1].revents & (POLLIN | POLLHUP | POLLERR))
+        {
+            ReadWorkerOutput(indexes[i]);
+        }
+    }
+
+exit:
+    return stop;
+}
+
+void Supervisor::HandleSignal(int aSignal)
+{
+    int  savedErrno = errno;
+    char signal     = static_cast<char>(aSignal);
+
+    if (write(sSignalPipe[1], &signal, 1) != 1)
+    {
+        // The pipe is full, the poll loop will be woken up anyway.
+    }
+
+    errno = savedErrno;
+}
+
+} // namespace commissioner
+
+} // namespace ot
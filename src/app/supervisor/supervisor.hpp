@@ -0,0 +1,124 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines the commissioner supervisor, which shards
+ *   Thread networks across worker processes.
+ *
+ */
+
+#ifndef OT_COMM_APP_SUPERVISOR_SUPERVISOR_HPP_
+#define OT_COMM_APP_SUPERVISOR_SUPERVISOR_HPP_
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+
+#include "app/json.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+/**
+ * The supervisor forks worker processes and assigns networks to them
+ * by consistent hashing of the network names, so that a network keeps
+ * its worker when workers are added or removed.
+ *
+ * A crashed worker is restarted with exponential backoff and resumes
+ * from the checkpoints of its networks. The standard output and error
+ * of workers are read through pipes and written to the standard output
+ * of the supervisor, prefixed with the worker index. Metrics of each
+ * network are written to a memory-mapped file in the state directory.
+ *
+ */
+class Supervisor
+{
+public:
+    explicit Supervisor(const SupervisorConfig &aConfig);
+
+    Error Init();
+
+    // Runs the workers until SIGTERM or SIGINT is received.
+    Error Run();
+
+private:
+    using SteadyClock = std::chrono::steady_clock;
+
+    struct WorkerProcess
+    {
+        std::vector<SupervisedNetwork> mNetworks;
+
+        pid_t       mPid    = -1;
+        int         mOutput = -1; ///< The read end of the pipe of worker output.
+        std::string mPendingOutput;
+
+        uint32_t                mRestartCount = 0;
+        std::chrono::seconds    mBackoff;
+        SteadyClock::time_point mStartTime;
+        SteadyClock::time_point mRestartTime;
+    };
+
+    static constexpr uint32_t kMinRestartBackoff = 1;  ///< In seconds.
+    static constexpr uint32_t kMaxRestartBackoff = 30; ///< In seconds.
+
+    // A worker which has been running for this long is considered healthy,
+    // the backoff of its next restart starts from kMinRestartBackoff.
+    static constexpr uint32_t kHealthyUptime = 60; ///< In seconds.
+
+    // Workers which are not stopped in this time after SIGTERM are killed.
+    static constexpr uint32_t kStopTimeout = 10; ///< In seconds.
+
+    Error StartWorker(size_t aIndex);
+    void  ReadWorkerOutput(size_t aIndex);
+    void  FlushWorkerOutput(size_t aIndex, bool aFlushPartialLine);
+    void  ReapWorkers(bool aRestart);
+    void  RestartWorkers();
+    void  StopWorkers();
+
+    // Polls the signal pipe and worker outputs for at most `aTimeout` milliseconds.
+    // Returns true if SIGTERM or SIGINT has been received.
+    bool Poll(int aTimeout);
+
+    static void HandleSignal(int aSignal);
+
+    SupervisorConfig           mConfig;
+    std::vector<WorkerProcess> mWorkers;
+
+    // The pipe written by the signal handler to wake up the poll loop.
+    static int sSignalPipe[2];
+};
+
+} // namespace commissioner
+
+} // namespace ot
+
+#endif // OT_COMM_APP_SUPERVISOR_SUPERVISOR_HPP_
@@ -0,0 +1,364 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the worker process of the commissioner supervisor.
+ *
+ */
+
+#include "app/supervisor/worker.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <fmt/format.h>
+
+#include "app/file_util.hpp"
+#include "common/error_macros.hpp"
+#include "common/utils.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+constexpr uint32_t Worker::kMinPetitionBackoff;
+constexpr uint32_t Worker::kMaxPetitionBackoff;
+
+static std::mutex sOutputMutex;
+
+// Writes a line to the standard output, which is aggregated by the supervisor.
+static void Print(const std::string &aLine)
+{
+    std::lock_guard<std::mutex> lock(sOutputMutex);
+
+    std::cout << aLine << std::endl;
+}
+
+/**
+ * The logger which writes logs of a commissioner to the standard output.
+ */
+class OutputLogger : public Logger
+{
+public:
+    explicit OutputLogger(const std::string &aNetworkName)
+        : mNetworkName(aNetworkName)
+    {
+    }
+
+    void Log(LogLevel aLevel, const std::string &aRegion, const std::string &aMsg) override
+    {
+        if (aLevel <= LogLevel::kInfo)
+        {
+            Print(fmt::format("[{}] [{}] {}", mNetworkName, aRegion, aMsg));
+        }
+    }
+
+private:
+    std::string mNetworkName;
+};
+
+Error SupervisedCommissionerApp::Create(std::shared_ptr<SupervisedCommissionerApp> &aApp,
+                                        const Config &                              aConfig,
+                                        const std::string &                         aCheckpointFile)
+{
+    Error error;
+    auto  app = std::make_shared<SupervisedCommissionerApp>();
+
+    app->mCheckpointFile = aCheckpointFile;
+    SuccessOrExit(error = app->LoadCheckpoint());
+    SuccessOrExit(error = app->Init(aConfig));
+
+    aApp = app;
+
+exit:
+    return error;
+}
+
+bool SupervisedCommissionerApp::OnJoinerFinalize(const ByteArray &  aJoinerId,
+                                                 const std::string &aVendorName,
+                                                 const std::string &aVendorModel,
+                                                 const std::string &aVendorSwVersion,
+                                                 const ByteArray &  aVendorStackVersion,
+                                                 const std::string &aProvisioningUrl,
+                                                 const ByteArray &  aVendorData)
+{
+    bool accepted = CommissionerApp::OnJoinerFinalize(aJoinerId, aVendorName, aVendorModel, aVendorSwVersion,
+                                                      aVendorStackVersion, aProvisioningUrl, aVendorData);
+
+    if (accepted)
+    {
+        std::lock_guard<std::mutex> lock(mCheckpointMutex);
+
+        if (mCheckpoint.mCommissionedJoiners.insert(aJoinerId).second)
+        {
+            Error error = SaveCheckpoint();
+
+            if (error != ErrorCode::kNone)
+            {
+                Print(fmt::format("save checkpoint {} failed: {}", mCheckpointFile, error.ToString()));
+            }
+        }
+    }
+
+    return accepted;
+}
+
+bool SupervisedCommissionerApp::IsCommissioned(uint64_t aEui64) const
+{
+    std::lock_guard<std::mutex> lock(mCheckpointMutex);
+
+    return mCheckpoint.mCommissionedJoiners.count(Commissioner::ComputeJoinerId(aEui64)) != 0;
+}
+
+Error SupervisedCommissionerApp::LoadCheckpoint()
+{
+    Error       error;
+    std::string json;
+
+    error = ReadFile(json, mCheckpointFile);
+    if (error == ErrorCode::kNotFound)
+    {
+        // There is no checkpoint before the first run.
+        ExitNow(error = ERROR_NONE);
+    }
+    SuccessOrExit(error);
+
+    SuccessOrExit(error = NetworkCheckpointFromJson(mCheckpoint, json));
+
+exit:
+    return error;
+}
+
+Error SupervisedCommissionerApp::SaveCheckpoint() const
+{
+    Error       error;
+    std::string tmpFile = mCheckpointFile + ".tmp";
+
+    // Write to a temporary file and rename it, so that a crash
+    // while writing never leaves a corrupted checkpoint behind.
+    SuccessOrExit(error = WriteFile(NetworkCheckpointToJson(mCheckpoint), tmpFile));
+    VerifyOrExit(rename(tmpFile.c_str(), mCheckpointFile.c_str()) == 0,
+                 error = ERROR_IO_ERROR("cannot rename file '{}', {}", tmpFile, strerror(errno)));
+
+exit:
+    return error;
+}
+
+Worker::Worker(size_t aIndex, const std::string &aStateDir, const std::vector<SupervisedNetwork> &aNetworks)
+    : mIndex(aIndex)
+    , mStateDir(aStateDir)
+    , mStopping(false)
+{
+    for (auto &config : aNetworks)
+    {
+        std::unique_ptr<Network> network(new Network());
+
+        network->mConfig = config;
+        mNetworks.push_back(std::move(network));
+    }
+}
+
+int Worker::Run()
+{
+    sigset_t signalSet;
+    int      signalNum = 0;
+
+    // Block signals in this thread and subsequently spawned threads,
+    // they are handled by waiting on them below.
+    sigemptyset(&signalSet);
+    sigaddset(&signalSet, SIGTERM);
+    sigaddset(&signalSet, SIGINT);
+    pthread_sigmask(SIG_BLOCK, &signalSet, nullptr);
+
+    Print(fmt::format("worker {} started with {} network(s)", mIndex, mNetworks.size()));
+
+    for (auto &network : mNetworks)
+    {
+        Error error = CreateApp(*network);
+
+        // A network with bad configuration doesn't stop other networks of this worker.
+        if (error != ErrorCode::kNone)
+        {
+            Print(fmt::format("[{}] create commissioner failed: {}", network->mConfig.mName, error.ToString()));
+            continue;
+        }
+
+        Network *net     = network.get();
+        network->mThread = std::thread([this, net]() { KeepActive(*net); });
+    }
+
+    sigwait(&signalSet, &signalNum);
+
+    Print(fmt::format("worker {} stopping", mIndex));
+
+    {
+        std::lock_guard<std::mutex> lock(mStopMutex);
+
+        mStopping = true;
+    }
+    mStopCondition.notify_all();
+
+    for (auto &network : mNetworks)
+    {
+        if (network->mApp != nullptr)
+        {
+            // Aborts the petition in progress.
+            network->mApp->CancelRequests();
+        }
+
+        if (network->mThread.joinable())
+        {
+            network->mThread.join();
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+Error Worker::CreateApp(Network &aNetwork)
+{
+    Error       error;
+    std::string configJson;
+    Config      config;
+    auto &      name = aNetwork.mConfig.mName;
+
+    SuccessOrExit(error = ReadFile(configJson, aNetwork.mConfig.mConfigFile));
+    SuccessOrExit(error = ConfigFromJson(config, configJson));
+
+    if (config.mLogger == nullptr)
+    {
+        config.mLogger = std::make_shared<OutputLogger>(name);
+    }
+
+    // The metrics files of all workers are aggregated by `commissioner-metrics <StateDir>/*.metrics`.
+    if (config.mMetricsFile.empty())
+    {
+        config.mMetricsFile = mStateDir + "/" + name + ".metrics";
+    }
+    // So are the journals, by `commissioner-journal <StateDir>/*.journal`.
+    if (config.mJournalFile.empty())
+    {
+        config.mJournalFile = mStateDir + "/" + name + ".journal";
+    }
+
+    SuccessOrExit(error = SupervisedCommissionerApp::Create(aNetwork.mApp, config,
+                                                            mStateDir + "/" + name + ".checkpoint.json"));
+
+exit:
+    return error;
+}
+
+void Worker::KeepActive(Network &aNetwork)
+{
+    uint32_t backoff = kMinPetitionBackoff;
+
+    while (!mStopping)
+    {
+        uint32_t waitTime = 1;
+
+        if (!aNetwork.mApp->IsActive())
+        {
+            Error error = Petition(aNetwork);
+
+            if (error == ErrorCode::kNone)
+            {
+                backoff = kMinPetitionBackoff;
+            }
+            else
+            {
+                aNetwork.mApp->Stop();
+
+                Print(fmt::format("[{}] petition failed, retry in {} seconds: {}", aNetwork.mConfig.mName, backoff,
+                                  error.ToString()));
+
+                waitTime = backoff;
+                backoff  = std::min(backoff * 2, kMaxPetitionBackoff);
+            }
+        }
+
+        if (!Wait(waitTime))
+        {
+            break;
+        }
+    }
+
+    aNetwork.mApp->Stop();
+}
+
+Error Worker::Petition(Network &aNetwork)
+{
+    Error       error;
+    std::string existingCommissionerId;
+    auto &      config = aNetwork.mConfig;
+    auto &      app    = aNetwork.mApp;
+
+    error = app->Start(existingCommissionerId, config.mBorderAgentAddr, config.mBorderAgentPort);
+    if (error != ErrorCode::kNone && !existingCommissionerId.empty())
+    {
+        ExitNow(error = Error(error.GetCode(), fmt::format("{}, the active commissioner is '{}'", error.GetMessage(),
+                                                           existingCommissionerId)));
+    }
+    SuccessOrExit(error);
+
+    Print(fmt::format("[{}] petitioned to border agent [{}]:{}", config.mName, config.mBorderAgentAddr,
+                      config.mBorderAgentPort));
+
+    {
+        std::vector<JoinerInfo> joiners;
+
+        for (auto &joiner : config.mJoiners)
+        {
+            if (joiner.mEui64 == 0 || !app->IsCommissioned(joiner.mEui64))
+            {
+                joiners.push_back(joiner);
+            }
+        }
+
+        // All joiners are enabled with a single MGMT_COMMISSIONER_SET.req.
+        SuccessOrExit(error = app->SyncJoiners(joiners));
+    }
+
+exit:
+    return error;
+}
+
+bool Worker::Wait(uint32_t aSeconds)
+{
+    std::unique_lock<std::mutex> lock(mStopMutex);
+
+    return !mStopCondition.wait_for(lock, std::chrono::seconds(aSeconds), [this]() { return mStopping.load(); });
+}
+
+} // namespace commissioner
+
+} // namespace ot
@@ -0,0 +1,135 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines the worker process of the commissioner supervisor.
+ *
+ */
+
+#ifndef OT_COMM_APP_SUPERVISOR_WORKER_HPP_
+#define OT_COMM_APP_SUPERVISOR_WORKER_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "app/commissioner_app.hpp"
+#include "app/json.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+/**
+ * A commissioner app which checkpoints accepted joiners,
+ * so that they are not enabled again after its worker restarts.
+ *
+ */
+class SupervisedCommissionerApp : public CommissionerApp
+{
+public:
+    static Error Create(std::shared_ptr<SupervisedCommissionerApp> &aApp,
+                        const Config &                              aConfig,
+                        const std::string &                         aCheckpointFile);
+
+    using CommissionerApp::OnJoinerFinalize;
+    bool OnJoinerFinalize(const ByteArray &  aJoinerId,
+                          const std::string &aVendorName,
+                          const std::string &aVendorModel,
+                          const std::string &aVendorSwVersion,
+                          const ByteArray &  aVendorStackVersion,
+                          const std::string &aProvisioningUrl,
+                          const ByteArray &  aVendorData) override;
+
+    bool IsCommissioned(uint64_t aEui64) const;
+
+private:
+    Error LoadCheckpoint();
+    Error SaveCheckpoint() const;
+
+    std::string        mCheckpointFile;
+    mutable std::mutex mCheckpointMutex;
+    NetworkCheckpoint  mCheckpoint;
+};
+
+/**
+ * The worker process which runs the commissioners of its networks.
+ *
+ * Each network is kept active by its own thread, which petitions
+ * again with exponential backoff once the commissioner is no longer
+ * active. Logs are written to the standard output, which is a pipe
+ * read by the supervisor.
+ *
+ */
+class Worker
+{
+public:
+    Worker(size_t aIndex, const std::string &aStateDir, const std::vector<SupervisedNetwork> &aNetworks);
+
+    // Runs the commissioners until SIGTERM or SIGINT is received.
+    // Returns the exit status of the worker process.
+    int Run();
+
+private:
+    struct Network
+    {
+        SupervisedNetwork                          mConfig;
+        std::shared_ptr<SupervisedCommissionerApp> mApp;
+        std::thread                                mThread;
+    };
+
+    static constexpr uint32_t kMinPetitionBackoff = 1;  ///< In seconds.
+    static constexpr uint32_t kMaxPetitionBackoff = 30; ///< In seconds.
+
+    Error CreateApp(Network &aNetwork);
+    void  KeepActive(Network &aNetwork);
+    Error Petition(Network &aNetwork);
+
+    // Waits for at most `aSeconds`, returns false if the worker is stopping.
+    bool Wait(uint32_t aSeconds);
+
+    size_t      mIndex;
+    std::string mStateDir;
+
+    std::vector<std::unique_ptr<Network>> mNetworks;
+
+    std::mutex              mStopMutex;
+    std::condition_variable mStopCondition;
+    std::atomic<bool>       mStopping;
+};
+
+} // namespace commissioner
+
+} // namespace ot
+
+#endif // OT_COMM_APP_SUPERVISOR_WORKER_HPP_
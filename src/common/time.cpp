@@ -35,6 +35,7 @@
 
 #include <time.h>
 
+#include <atomic>
 #include <iomanip>
 #include <sstream>
 
@@ -42,6 +43,38 @@ namespace ot {
 
 namespace commissioner {
 
+static std::atomic<const ClockSource *> sClockSource{nullptr};
+static thread_local const ClockSource * sThreadClockSource = nullptr;
+
+Clock::time_point Clock::now() noexcept
+{
+    auto source = sThreadClockSource != nullptr ? sThreadClockSource : sClockSource.load(std::memory_order_acquire);
+
+    if (source != nullptr)
+    {
+        return source->Now();
+    }
+    return time_point(std::chrono::system_clock::now().time_since_epoch());
+}
+
+std::time_t Clock::to_time_t(const time_point &aTimePoint) noexcept
+{
+    return std::chrono::system_clock::to_time_t(std::chrono::system_clock::time_point(aTimePoint.time_since_epoch()));
+}
+
+void SetClockSource(const ClockSource *aSource)
+{
+    sClockSource.store(aSource, std::memory_order_release);
+}
+
+const ClockSource *SetThreadClockSource(const ClockSource *aSource)
+{
+    auto previous = sThreadClockSource;
+
+    sThreadClockSource = aSource;
+    return previous;
+}
+
 std::string TimePointToString(const TimePoint &aTimePoint)
 {
     struct tm         localTime;
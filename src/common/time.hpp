@@ -37,15 +37,66 @@
 #include <chrono>
 #include <string>
 
+#include <time.h>
+
 namespace ot {
 
 namespace commissioner {
 
-using Clock        = std::chrono::system_clock;
+class ClockSource;
+
+/**
+ * The wall clock used by the commissioner.
+ *
+ * It reads the system clock, unless a clock source has been
+ * installed (see SetClockSource and SetThreadClockSource), e.g.
+ * the virtual time of a simulated event loop in tests and benchmarks.
+ *
+ */
+class Clock
+{
+public:
+    using duration                  = std::chrono::system_clock::duration;
+    using rep                       = duration::rep;
+    using period                    = duration::period;
+    using time_point                = std::chrono::time_point<Clock>;
+    static constexpr bool is_steady = false;
+
+    static time_point  now() noexcept;
+    static std::time_t to_time_t(const time_point &aTimePoint) noexcept;
+};
+
 using Duration     = std::chrono::milliseconds;
 using TimePoint    = std::chrono::time_point<Clock>;
 using MilliSeconds = std::chrono::milliseconds;
 
+class ClockSource
+{
+public:
+    virtual ~ClockSource() = default;
+
+    virtual TimePoint Now() const = 0;
+};
+
+/**
+ * This function installs the source of Clock::now().
+ *
+ * @param[in]  aSource  The clock source, nullptr restores the system clock.
+ *
+ */
+void SetClockSource(const ClockSource *aSource);
+
+/**
+ * This function installs the source of Clock::now() for the calling thread,
+ * which takes precedence over the one installed by SetClockSource().
+ *
+ * @param[in]  aSource  The clock source, nullptr restores the clock of the process.
+ *
+ * @returns The clock source of the calling thread before.
+ *
+ */
+const ClockSource *SetThreadClockSource(const ClockSource *aSource);
+
 template <typename D> D NowSinceEpoch()
 {
     auto now = std::chrono::time_point_cast<D>(Clock::now());
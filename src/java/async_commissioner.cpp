@@ -0,0 +1,296 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the asynchronous commissioner API for the Java binding.
+ */
+
+#include "async_commissioner.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <thread>
+
+namespace ot {
+
+namespace commissioner {
+
+// The single thread calling the handlers of all AsyncCommissioner
+// instances. Commissioner handlers are called in the event thread of
+// each commissioner; posting the results here keeps Java code off those
+// threads, and lets one JVM-attached thread serve all commissioners.
+class CompletionThread
+{
+public:
+    static CompletionThread &Get()
+    {
+        // Never destroyed, the thread runs until the process exits.
+        static CompletionThread &sCompletionThread = *new CompletionThread();
+
+        return sCompletionThread;
+    }
+
+    void Post(std::function<void()> aCompletion)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mCompletions.push_back(std::move(aCompletion));
+        }
+        mCondition.notify_one();
+    }
+
+private:
+    CompletionThread() { std::thread([this]() { Run(); }).detach(); }
+
+    void Run()
+    {
+        while (true)
+        {
+            std::function<void()> completion;
+
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mCondition.wait(lock, [this]() { return !mCompletions.empty(); });
+                completion = std::move(mCompletions.front());
+                mCompletions.pop_front();
+            }
+
+            completion();
+        }
+    }
+
+    std::mutex                        mMutex;
+    std::condition_variable           mCondition;
+    std::deque<std::function<void()>> mCompletions;
+};
+
+AsyncCommissioner::AsyncCommissioner(std::shared_ptr<Commissioner> aCommissioner, AsyncHandler &aHandler)
+    : mCommissioner(aCommissioner)
+    , mTarget(std::make_shared<Target>())
+{
+    mTarget->mHandler = &aHandler;
+}
+
+AsyncCommissioner::~AsyncCommissioner()
+{
+    std::lock_guard<std::recursive_mutex> lock(mTarget->mMutex);
+
+    mTarget->mHandler = nullptr;
+}
+
+Commissioner::ErrorHandler AsyncCommissioner::MakeErrorHandler(int64_t aRequestId)
+{
+    std::shared_ptr<Target> target = mTarget;
+
+    return [target, aRequestId](Error aError) {
+        CompletionThread::Get().Post([target, aRequestId, aError]() {
+            std::lock_guard<std::recursive_mutex> lock(target->mMutex);
+
+            if (target->mHandler != nullptr)
+            {
+                target->mHandler->OnCompleted(aRequestId, aError);
+            }
+        });
+    };
+}
+
+// The response data is copied, as it is valid only in the commissioner handler.
+template <typename T, typename Method>
+Commissioner::Handler<T> AsyncCommissioner::MakeHandler(int64_t aRequestId, Method aMethod, const T &aDefault)
+{
+    std::shared_ptr<Target> target = mTarget;
+
+    return [target, aRequestId, aMethod, aDefault](const T *aResponseData, Error aError) {
+        T responseData = aResponseData != nullptr ? *aResponseData : aDefault;
+
+        CompletionThread::Get().Post([target, aRequestId, aMethod, responseData, aError]() {
+            std::lock_guard<std::recursive_mutex> lock(target->mMutex);
+
+            if (target->mHandler != nullptr)
+            {
+                (target->mHandler->*aMethod)(aRequestId, responseData, aError);
+            }
+        });
+    };
+}
+
+void AsyncCommissioner::Connect(int64_t aRequestId, const std::string &aAddr, uint16_t aPort)
+{
+    mCommissioner->Connect(MakeErrorHandler(aRequestId), aAddr, aPort);
+}
+
+void AsyncCommissioner::Petition(int64_t aRequestId, const std::string &aAddr, uint16_t aPort)
+{
+    std::shared_ptr<Target> target = mTarget;
+
+    mCommissioner->Petition(
+        [target, aRequestId](const std::string *aExistingCommissionerId, Error aError) {
+            std::string existingCommissionerId = aExistingCommissionerId != nullptr ? *aExistingCommissionerId : "";
+
+            CompletionThread::Get().Post([target, aRequestId, existingCommissionerId, aError]() {
+                std::lock_guard<std::recursive_mutex> lock(target->mMutex);
+
+                if (target->mHandler != nullptr)
+                {
+                    target->mHandler->OnPetitioned(aRequestId, existingCommissionerId, aError);
+                }
+            });
+        },
+        aAddr, aPort);
+}
+
+void AsyncCommissioner::Resign(int64_t aRequestId)
+{
+    mCommissioner->Resign(MakeErrorHandler(aRequestId));
+}
+
+void AsyncCommissioner::GetCommissionerDataset(int64_t aRequestId, uint16_t aDatasetFlags)
+{
+    mCommissioner->GetCommissionerDataset(
+        MakeHandler<CommissionerDataset>(aRequestId, &AsyncHandler::OnCommissionerDataset), aDatasetFlags);
+}
+
+void AsyncCommissioner::SetCommissionerDataset(int64_t aRequestId, const CommissionerDataset &aDataset)
+{
+    mCommissioner->SetCommissionerDataset(MakeErrorHandler(aRequestId), aDataset);
+}
+
+void AsyncCommissioner::GetBbrDataset(int64_t aRequestId, uint16_t aDatasetFlags)
+{
+    mCommissioner->GetBbrDataset(MakeHandler<BbrDataset>(aRequestId, &AsyncHandler::OnBbrDataset), aDatasetFlags);
+}
+
+void AsyncCommissioner::SetBbrDataset(int64_t aRequestId, const BbrDataset &aDataset)
+{
+    mCommissioner->SetBbrDataset(MakeErrorHandler(aRequestId), aDataset);
+}
+
+void AsyncCommissioner::GetActiveDataset(int64_t aRequestId, uint16_t aDatasetFlags)
+{
+    mCommissioner->GetActiveDataset(MakeHandler<ActiveOperationalDataset>(aRequestId, &AsyncHandler::OnActiveDataset),
+                                    aDatasetFlags);
+}
+
+void AsyncCommissioner::GetRawActiveDataset(int64_t aRequestId, uint16_t aDatasetFlags)
+{
+    mCommissioner->GetRawActiveDataset(MakeHandler<ByteArray>(aRequestId, &AsyncHandler::OnByteArray), aDatasetFlags);
+}
+
+void AsyncCommissioner::SetActiveDataset(int64_t aRequestId, const ActiveOperationalDataset &aDataset)
+{
+    mCommissioner->SetActiveDataset(MakeErrorHandler(aRequestId), aDataset);
+}
+
+void AsyncCommissioner::GetPendingDataset(int64_t aRequestId, uint16_t aDatasetFlags)
+{
+    mCommissioner->GetPendingDataset(
+        MakeHandler<PendingOperationalDataset>(aRequestId, &AsyncHandler::OnPendingDataset), aDatasetFlags);
+}
+
+void AsyncCommissioner::SetPendingDataset(int64_t aRequestId, const PendingOperationalDataset &aDataset)
+{
+    mCommissioner->SetPendingDataset(MakeErrorHandler(aRequestId), aDataset);
+}
+
+void AsyncCommissioner::SetSecurePendingDataset(int64_t                          aRequestId,
+                                                const std::string &              aPbbrAddr,
+                                                uint32_t                         aMaxRetrievalTimer,
+                                                const PendingOperationalDataset &aDataset)
+{
+    mCommissioner->SetSecurePendingDataset(MakeErrorHandler(aRequestId), aPbbrAddr, aMaxRetrievalTimer, aDataset);
+}
+
+void AsyncCommissioner::CommandReenroll(int64_t aRequestId, const std::string &aDstAddr)
+{
+    mCommissioner->CommandReenroll(MakeErrorHandler(aRequestId), aDstAddr);
+}
+
+void AsyncCommissioner::CommandDomainReset(int64_t aRequestId, const std::string &aDstAddr)
+{
+    mCommissioner->CommandDomainReset(MakeErrorHandler(aRequestId), aDstAddr);
+}
+
+void AsyncCommissioner::CommandMigrate(int64_t            aRequestId,
+                                       const std::string &aDstAddr,
+                                       const std::string &aDesignatedNetwork)
+{
+    mCommissioner->CommandMigrate(MakeErrorHandler(aRequestId), aDstAddr, aDesignatedNetwork);
+}
+
+void AsyncCommissioner::RegisterMulticastListener(int64_t                         aRequestId,
+                                                  const std::string &             aPbbrAddr,
+                                                  const std::vector<std::string> &aMulticastAddrList,
+                                                  uint32_t                        aTimeout)
+{
+    mCommissioner->RegisterMulticastListener(MakeHandler<uint8_t>(aRequestId, &AsyncHandler::OnStatus), aPbbrAddr,
+                                             aMulticastAddrList, aTimeout);
+}
+
+void AsyncCommissioner::AnnounceBegin(int64_t            aRequestId,
+                                      uint32_t           aChannelMask,
+                                      uint8_t            aCount,
+                                      uint16_t           aPeriod,
+                                      const std::string &aDstAddr)
+{
+    mCommissioner->AnnounceBegin(MakeErrorHandler(aRequestId), aChannelMask, aCount, aPeriod, aDstAddr);
+}
+
+void AsyncCommissioner::PanIdQuery(int64_t            aRequestId,
+                                   uint32_t           aChannelMask,
+                                   uint16_t           aPanId,
+                                   const std::string &aDstAddr)
+{
+    mCommissioner->PanIdQuery(MakeErrorHandler(aRequestId), aChannelMask, aPanId, aDstAddr);
+}
+
+void AsyncCommissioner::EnergyScan(int64_t            aRequestId,
+                                   uint32_t           aChannelMask,
+                                   uint8_t            aCount,
+                                   uint16_t           aPeriod,
+                                   uint16_t           aScanDuration,
+                                   const std::string &aDstAddr)
+{
+    mCommissioner->EnergyScan(MakeErrorHandler(aRequestId), aChannelMask, aCount, aPeriod, aScanDuration, aDstAddr);
+}
+
+void AsyncCommissioner::RequestToken(int64_t aRequestId, const std::string &aAddr, uint16_t aPort)
+{
+    mCommissioner->RequestToken(MakeHandler<ByteArray>(aRequestId, &AsyncHandler::OnByteArray), aAddr, aPort);
+}
+
+void AsyncCommissioner::ProbeLink(int64_t aRequestId, const std::string &aDstAddr, uint16_t aCount, uint16_t aWindow)
+{
+    mCommissioner->ProbeLink(MakeHandler<LinkProbeResult>(aRequestId, &AsyncHandler::OnLinkProbeResult), aDstAddr,
+                             aCount, aWindow);
+}
+
+} // namespace commissioner
+
+} // namespace ot
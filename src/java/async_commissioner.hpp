@@ -0,0 +1,199 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines the asynchronous commissioner API for the Java binding.
+ *
+ *   SWIG doesn't bridge the std::function handlers of the asynchronous
+ *   Commissioner API. The AsyncCommissioner wraps those APIs with requests
+ *   identified by an ID, and delivers the results to a single director
+ *   AsyncHandler. The Java class of the same package completes a
+ *   CompletableFuture per request ID.
+ */
+
+#ifndef OT_COMM_JAVA_ASYNC_COMMISSIONER_HPP_
+#define OT_COMM_JAVA_ASYNC_COMMISSIONER_HPP_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <commissioner/commissioner.hpp>
+#include <commissioner/error.hpp>
+#include <commissioner/network_data.hpp>
+
+namespace ot {
+
+namespace commissioner {
+
+/**
+ * @brief The handler of the results of AsyncCommissioner requests.
+ *
+ * @note All handlers of all AsyncCommissioner instances are called in a
+ *       single completion thread, which stays attached to the JVM. So there
+ *       is neither a thread attachment nor a JNI global reference per request.
+ * @note Result objects are valid only during the call and should be
+ *       copied if they are used later.
+ *
+ */
+class AsyncHandler
+{
+public:
+    virtual ~AsyncHandler() = default;
+
+    /**
+     * @brief Called when a request without response data completes.
+     */
+    virtual void OnCompleted(int64_t aRequestId, const Error &aError) = 0;
+
+    /**
+     * @brief Called when a petition completes.
+     *
+     * @param[in] aExistingCommissionerId  The ID of the existing active commissioner if
+     *                                     the petition is rejected because of it, otherwise empty.
+     */
+    virtual void OnPetitioned(int64_t aRequestId, const std::string &aExistingCommissionerId, const Error &aError) = 0;
+
+    virtual void OnCommissionerDataset(int64_t                    aRequestId,
+                                       const CommissionerDataset &aDataset,
+                                       const Error &              aError) = 0;
+    virtual void OnActiveDataset(int64_t                         aRequestId,
+                                 const ActiveOperationalDataset &aDataset,
+                                 const Error &                   aError) = 0;
+    virtual void OnPendingDataset(int64_t                          aRequestId,
+                                  const PendingOperationalDataset &aDataset,
+                                  const Error &                    aError) = 0;
+    virtual void OnBbrDataset(int64_t aRequestId, const BbrDataset &aDataset, const Error &aError) = 0;
+
+    /**
+     * @brief Called when a request of raw bytes, the raw Active Operational
+     *        Dataset or a COM_TOK, completes.
+     */
+    virtual void OnByteArray(int64_t aRequestId, const ByteArray &aBytes, const Error &aError) = 0;
+
+    /**
+     * @brief Called when a multicast listener registration completes.
+     */
+    virtual void OnStatus(int64_t aRequestId, uint8_t aStatus, const Error &aError) = 0;
+
+    virtual void OnLinkProbeResult(int64_t aRequestId, const LinkProbeResult &aResult, const Error &aError) = 0;
+};
+
+/**
+ * @brief The asynchronous API of a commissioner for Java.
+ *
+ * Each method returns immediately, and the result is delivered to the
+ * handler with @p aRequestId later; it is guaranteed to be delivered
+ * exactly once unless this object is deleted before.
+ *
+ */
+class AsyncCommissioner
+{
+public:
+    /**
+     * @brief Wraps the asynchronous API of @p aCommissioner.
+     *
+     * @param[in] aCommissioner  A commissioner which is started.
+     * @param[in] aHandler       The result handler, which must outlive this object.
+     */
+    AsyncCommissioner(std::shared_ptr<Commissioner> aCommissioner, AsyncHandler &aHandler);
+
+    /**
+     * @brief Stops delivering results to the handler.
+     *
+     * It waits for the handler if it is being called in another thread.
+     */
+    ~AsyncCommissioner();
+
+    void Connect(int64_t aRequestId, const std::string &aAddr, uint16_t aPort);
+    void Petition(int64_t aRequestId, const std::string &aAddr, uint16_t aPort);
+    void Resign(int64_t aRequestId);
+
+    void GetCommissionerDataset(int64_t aRequestId, uint16_t aDatasetFlags);
+    void SetCommissionerDataset(int64_t aRequestId, const CommissionerDataset &aDataset);
+    void GetBbrDataset(int64_t aRequestId, uint16_t aDatasetFlags);
+    void SetBbrDataset(int64_t aRequestId, const BbrDataset &aDataset);
+    void GetActiveDataset(int64_t aRequestId, uint16_t aDatasetFlags);
+    void GetRawActiveDataset(int64_t aRequestId, uint16_t aDatasetFlags);
+    void SetActiveDataset(int64_t aRequestId, const ActiveOperationalDataset &aDataset);
+    void GetPendingDataset(int64_t aRequestId, uint16_t aDatasetFlags);
+    void SetPendingDataset(int64_t aRequestId, const PendingOperationalDataset &aDataset);
+    void SetSecurePendingDataset(int64_t                          aRequestId,
+                                 const std::string &              aPbbrAddr,
+                                 uint32_t                         aMaxRetrievalTimer,
+                                 const PendingOperationalDataset &aDataset);
+
+    void CommandReenroll(int64_t aRequestId, const std::string &aDstAddr);
+    void CommandDomainReset(int64_t aRequestId, const std::string &aDstAddr);
+    void CommandMigrate(int64_t aRequestId, const std::string &aDstAddr, const std::string &aDesignatedNetwork);
+
+    void RegisterMulticastListener(int64_t                         aRequestId,
+                                   const std::string &             aPbbrAddr,
+                                   const std::vector<std::string> &aMulticastAddrList,
+                                   uint32_t                        aTimeout);
+    void AnnounceBegin(int64_t            aRequestId,
+                       uint32_t           aChannelMask,
+                       uint8_t            aCount,
+                       uint16_t           aPeriod,
+                       const std::string &aDstAddr);
+    void PanIdQuery(int64_t aRequestId, uint32_t aChannelMask, uint16_t aPanId, const std::string &aDstAddr);
+    void EnergyScan(int64_t            aRequestId,
+                    uint32_t           aChannelMask,
+                    uint8_t            aCount,
+                    uint16_t           aPeriod,
+                    uint16_t           aScanDuration,
+                    const std::string &aDstAddr);
+
+    void RequestToken(int64_t aRequestId, const std::string &aAddr, uint16_t aPort);
+    void ProbeLink(int64_t aRequestId, const std::string &aDstAddr, uint16_t aCount, uint16_t aWindow);
+
+private:
+    // The handler shared with pending completions, which is
+    // cleared when this object is deleted.
+    struct Target
+    {
+        std::recursive_mutex mMutex;
+        AsyncHandler *       mHandler;
+    };
+
+    Commissioner::ErrorHandler MakeErrorHandler(int64_t aRequestId);
+
+    template <typename T, typename Method>
+    Commissioner::Handler<T> MakeHandler(int64_t aRequestId, Method aMethod, const T &aDefault = T{});
+
+    std::shared_ptr<Commissioner> mCommissioner;
+    std::shared_ptr<Target>       mTarget;
+};
+
+} // namespace commissioner
+
+} // namespace ot
+
+#endif // OT_COMM_JAVA_ASYNC_COMMISSIONER_HPP_
@@ -36,11 +36,20 @@
 
 %module(directors="1") commissionerModule
 
+// Keep the completion thread of the AsyncCommissioner attached to the
+// JVM, rather than attaching and detaching it for every result, but
+// don't let it prevent the JVM from exiting.
+%begin %{
+#define SWIG_JAVA_NO_DETACH_CURRENT_THREAD
+#define SWIG_JAVA_ATTACH_CURRENT_THREAD_AS_DAEMON
+%}
+
 %{
 #include <commissioner/defines.hpp>
 #include <commissioner/error.hpp>
 #include <commissioner/network_data.hpp>
 #include <commissioner/commissioner.hpp>
+#include "async_commissioner.hpp"
 %}
 
 %include <std_string.i>
@@ -74,6 +83,8 @@
 %apply const unsigned int & { const uint32_t & };
 %apply unsigned long long { uint64_t };
 %apply const unsigned long long & { const uint64_t & };
+%apply long long { int64_t };
+%apply const long long & { const int64_t & };
 
 // Remove the 'm' prefix of all members.
 %rename("%(regex:/^(m)(.*)/\\2/)s") "";
@@ -95,6 +106,17 @@
 
 %feature("director") ot::commissioner::CommissionerHandler;
 %feature("director") ot::commissioner::Logger;
+%feature("director") ot::commissioner::AsyncHandler;
+
+// The Java AsyncCommissioner, which returns CompletableFutures, is built on it.
+%rename(NativeAsyncCommissioner) ot::commissioner::AsyncCommissioner;
+
+// Results passed to the AsyncHandler are copied to complete the futures.
+%copyctor ot::commissioner::CommissionerDataset;
+%copyctor ot::commissioner::ActiveOperationalDataset;
+%copyctor ot::commissioner::PendingOperationalDataset;
+%copyctor ot::commissioner::BbrDataset;
+%copyctor ot::commissioner::LinkProbeResult;
 
 %template(ChannelMask) std::vector<ot::commissioner::ChannelMaskEntry>;
 %template(StringVector) std::vector<std::string>;
@@ -168,6 +190,36 @@ namespace commissioner {
                                                     const std::vector<std::string> &aMulticastAddrList,
                                                     uint32_t                        aTimeout);
     %ignore Commissioner::RequestToken(Handler<ByteArray> aHandler, const std::string &aAddr, uint16_t aPort);
+    %ignore Commissioner::ProbeLink(Handler<LinkProbeResult> aHandler,
+                                    const std::string &      aDstAddr,
+                                    uint16_t                 aCount,
+                                    uint16_t                 aWindow);
+    %ignore Commissioner::BindUdpProxyPort(uint16_t aLocalPort, UdpReceiveHandler aHandler);
+    %ignore Commissioner::SendUdpProxy(ErrorHandler       aHandler,
+                                       uint16_t           aLocalPort,
+                                       const std::string &aDstAddr,
+                                       uint16_t           aDstPort,
+                                       const ByteArray &  aData);
+
+    // The completion cannot be called back from Java, Java handlers
+    // decide on joiners with the synchronous OnJoinerFinalize().
+    %ignore CommissionerHandler::OnJoinerFinalize(const ByteArray &        aJoinerId,
+                                                  const std::string &      aVendorName,
+                                                  const std::string &      aVendorModel,
+                                                  const std::string &      aVendorSwVersion,
+                                                  const ByteArray &        aVendorStackVersion,
+                                                  const std::string &      aProvisioningUrl,
+                                                  const ByteArray &        aVendorData,
+                                                  JoinerFinalizeCompletion aCompletion);
+
+    // Zero-copy accessors of the raw dataset cannot be mapped to Java.
+    %ignore LazyActiveDataset::GetExtendedPanId(const uint8_t *&aData, size_t &aLength) const;
+    %ignore LazyActiveDataset::GetMeshLocalPrefix(const uint8_t *&aData, size_t &aLength) const;
+    %ignore LazyActiveDataset::GetNetworkMasterKey(const uint8_t *&aData, size_t &aLength) const;
+    %ignore LazyActiveDataset::GetPSKc(const uint8_t *&aData, size_t &aLength) const;
+
+    // The host event loop is not available to Java applications.
+    %ignore Commissioner::Create(CommissionerHandler &aHandler, struct event_base *aEventBase);
 
     // Remove operators and move constructor of Error.
     %ignore Error::operator=(const Error &aError);
@@ -186,4 +238,6 @@ namespace commissioner {
 %include <commissioner/error.hpp>
 %include <commissioner/network_data.hpp>
 %include <commissioner/commissioner.hpp>
+%include "async_commissioner.hpp"
 %include <commissioner/commissioner.hpp>
+%include "async_commissioner.hpp"
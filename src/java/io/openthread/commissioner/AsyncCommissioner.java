@@ -0,0 +1,264 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+package io.openthread.commissioner;
+
+import java.util.Map;
+import java.util.concurrent.CancellationException;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.atomic.AtomicLong;
+import java.util.function.LongConsumer;
+
+/**
+ * The asynchronous API of a {@link Commissioner}, which returns a {@link CompletableFuture} per
+ * request instead of blocking the calling thread.
+ *
+ * <p>A failed request completes its future exceptionally with a {@link CommissionerException}.
+ *
+ * <p>Futures of all instances are completed in a single native thread, so dependent actions which
+ * are not light should run in an executor with the {@code *Async} methods of the future.
+ */
+public class AsyncCommissioner implements AutoCloseable {
+  private final Commissioner commissioner;
+  private final ResultHandler handler = new ResultHandler();
+  private final NativeAsyncCommissioner nativeCommissioner;
+
+  private final AtomicLong nextRequestId = new AtomicLong();
+  private final Map<Long, CompletableFuture<?>> futures = new ConcurrentHashMap<>();
+
+  /** Wraps the asynchronous API of {@code commissioner}, which should be created and started. */
+  public AsyncCommissioner(Commissioner commissioner) {
+    this.commissioner = commissioner;
+    nativeCommissioner = new NativeAsyncCommissioner(commissioner, handler);
+  }
+
+  /** Returns the wrapped commissioner. */
+  public Commissioner getCommissioner() {
+    return commissioner;
+  }
+
+  /** Cancels futures of pending requests; no future will be completed after this. */
+  @Override
+  public void close() {
+    nativeCommissioner.delete();
+    for (Long requestId : futures.keySet()) {
+      CompletableFuture<?> future = futures.remove(requestId);
+      if (future != null) {
+        future.completeExceptionally(new CancellationException("the commissioner is closed"));
+      }
+    }
+  }
+
+  public CompletableFuture<Void> connect(String addr, int port) {
+    return submit(requestId -> nativeCommissioner.connect(requestId, addr, port));
+  }
+
+  /**
+   * Petitions to be the active commissioner. The future is completed with the ID of the existing
+   * active commissioner if the petition is rejected because of it, otherwise with an empty string.
+   */
+  public CompletableFuture<String> petition(String addr, int port) {
+    return submit(requestId -> nativeCommissioner.petition(requestId, addr, port));
+  }
+
+  public CompletableFuture<Void> resign() {
+    return submit(requestId -> nativeCommissioner.resign(requestId));
+  }
+
+  public CompletableFuture<CommissionerDataset> getCommissionerDataset(int datasetFlags) {
+    return submit(requestId -> nativeCommissioner.getCommissionerDataset(requestId, datasetFlags));
+  }
+
+  public CompletableFuture<Void> setCommissionerDataset(CommissionerDataset dataset) {
+    return submit(requestId -> nativeCommissioner.setCommissionerDataset(requestId, dataset));
+  }
+
+  public CompletableFuture<BbrDataset> getBbrDataset(int datasetFlags) {
+    return submit(requestId -> nativeCommissioner.getBbrDataset(requestId, datasetFlags));
+  }
+
+  public CompletableFuture<Void> setBbrDataset(BbrDataset dataset) {
+    return submit(requestId -> nativeCommissioner.setBbrDataset(requestId, dataset));
+  }
+
+  public CompletableFuture<ActiveOperationalDataset> getActiveDataset(int datasetFlags) {
+    return submit(requestId -> nativeCommissioner.getActiveDataset(requestId, datasetFlags));
+  }
+
+  public CompletableFuture<ByteArray> getRawActiveDataset(int datasetFlags) {
+    return submit(requestId -> nativeCommissioner.getRawActiveDataset(requestId, datasetFlags));
+  }
+
+  public CompletableFuture<Void> setActiveDataset(ActiveOperationalDataset dataset) {
+    return submit(requestId -> nativeCommissioner.setActiveDataset(requestId, dataset));
+  }
+
+  public CompletableFuture<PendingOperationalDataset> getPendingDataset(int datasetFlags) {
+    return submit(requestId -> nativeCommissioner.getPendingDataset(requestId, datasetFlags));
+  }
+
+  public CompletableFuture<Void> setPendingDataset(PendingOperationalDataset dataset) {
+    return submit(requestId -> nativeCommissioner.setPendingDataset(requestId, dataset));
+  }
+
+  public CompletableFuture<Void> setSecurePendingDataset(
+      String pbbrAddr, long maxRetrievalTimer, PendingOperationalDataset dataset) {
+    return submit(
+        requestId ->
+            nativeCommissioner.setSecurePendingDataset(
+                requestId, pbbrAddr, maxRetrievalTimer, dataset));
+  }
+
+  public CompletableFuture<Void> commandReenroll(String dstAddr) {
+    return submit(requestId -> nativeCommissioner.commandReenroll(requestId, dstAddr));
+  }
+
+  public CompletableFuture<Void> commandDomainReset(String dstAddr) {
+    return submit(requestId -> nativeCommissioner.commandDomainReset(requestId, dstAddr));
+  }
+
+  public CompletableFuture<Void> commandMigrate(String dstAddr, String designatedNetwork) {
+    return submit(
+        requestId -> nativeCommissioner.commandMigrate(requestId, dstAddr, designatedNetwork));
+  }
+
+  /** Registers multicast listeners; the future is completed with the MLR status. */
+  public CompletableFuture<Short> registerMulticastListener(
+      String pbbrAddr, StringVector multicastAddrList, long timeout) {
+    return submit(
+        requestId ->
+            nativeCommissioner.registerMulticastListener(
+                requestId, pbbrAddr, multicastAddrList, timeout));
+  }
+
+  public CompletableFuture<Void> announceBegin(
+      long channelMask, short count, int period, String dstAddr) {
+    return submit(
+        requestId ->
+            nativeCommissioner.announceBegin(requestId, channelMask, count, period, dstAddr));
+  }
+
+  public CompletableFuture<Void> panIdQuery(long channelMask, int panId, String dstAddr) {
+    return submit(
+        requestId -> nativeCommissioner.panIdQuery(requestId, channelMask, panId, dstAddr));
+  }
+
+  public CompletableFuture<Void> energyScan(
+      long channelMask, short count, int period, int scanDuration, String dstAddr) {
+    return submit(
+        requestId ->
+            nativeCommissioner.energyScan(
+                requestId, channelMask, count, period, scanDuration, dstAddr));
+  }
+
+  /** Requests a COM_TOK from the registrar; the future is completed with the signed token. */
+  public CompletableFuture<ByteArray> requestToken(String addr, int port) {
+    return submit(requestId -> nativeCommissioner.requestToken(requestId, addr, port));
+  }
+
+  public CompletableFuture<LinkProbeResult> probeLink(String dstAddr, int count, int window) {
+    return submit(requestId -> nativeCommissioner.probeLink(requestId, dstAddr, count, window));
+  }
+
+  private <T> CompletableFuture<T> submit(LongConsumer request) {
+    long requestId = nextRequestId.getAndIncrement();
+    CompletableFuture<T> future = new CompletableFuture<>();
+
+    futures.put(requestId, future);
+    try {
+      request.accept(requestId);
+    } catch (RuntimeException e) {
+      futures.remove(requestId);
+      future.completeExceptionally(e);
+    }
+    return future;
+  }
+
+  @SuppressWarnings("unchecked")
+  private <T> void complete(long requestId, Error error, T result) {
+    CompletableFuture<T> future = (CompletableFuture<T>) futures.remove(requestId);
+
+    if (future == null) {
+      return;
+    }
+    if (error.getCode() == ErrorCode.kNone) {
+      future.complete(result);
+    } else {
+      future.completeExceptionally(new CommissionerException(new Error(error)));
+    }
+  }
+
+  // Arguments are valid only during the calls, results are copied.
+  private class ResultHandler extends AsyncHandler {
+    @Override
+    public void onCompleted(long requestId, Error error) {
+      complete(requestId, error, null);
+    }
+
+    @Override
+    public void onPetitioned(long requestId, String existingCommissionerId, Error error) {
+      complete(requestId, error, existingCommissionerId);
+    }
+
+    @Override
+    public void onCommissionerDataset(long requestId, CommissionerDataset dataset, Error error) {
+      complete(requestId, error, new CommissionerDataset(dataset));
+    }
+
+    @Override
+    public void onActiveDataset(long requestId, ActiveOperationalDataset dataset, Error error) {
+      complete(requestId, error, new ActiveOperationalDataset(dataset));
+    }
+
+    @Override
+    public void onPendingDataset(long requestId, PendingOperationalDataset dataset, Error error) {
+      complete(requestId, error, new PendingOperationalDataset(dataset));
+    }
+
+    @Override
+    public void onBbrDataset(long requestId, BbrDataset dataset, Error error) {
+      complete(requestId, error, new BbrDataset(dataset));
+    }
+
+    @Override
+    public void onByteArray(long requestId, ByteArray bytes, Error error) {
+      complete(requestId, error, new ByteArray(bytes));
+    }
+
+    @Override
+    public void onStatus(long requestId, short status, Error error) {
+      complete(requestId, error, status);
+    }
+
+    @Override
+    public void onLinkProbeResult(long requestId, LinkProbeResult result, Error error) {
+      complete(requestId, error, new LinkProbeResult(result));
+    }
+  }
+}
@@ -374,24 +374,31 @@ exit:
     return error;
 }
 
-Coap::RequestHolder::RequestHolder(const RequestPtr aRequest, ResponseHandler aHandler)
+Coap::RequestHolder::RequestHolder(const RequestPtr aRequest, ResponseHandler aHandler, uint32_t aMaxRetransmit)
     : mRequest(aRequest)
     , mHandler(aHandler)
+    , mMaxRetransmit(aMaxRetransmit)
     , mRetransmissionCount(0)
     , mAcknowledged(false)
+    , mIsMulticast(false)
 {
     uint32_t lowBound    = 1000 * kAckTimeout;
     uint32_t upperBound  = 1000 * kAckTimeout * kAckRandomFactorNumerator / kAckRandomFactorDenominator;
     uint32_t delay       = random::non_crypto::GetUint32InRange(lowBound, upperBound);
     mRetransmissionDelay = std::chrono::milliseconds(delay);
-    mNextTimerShot       = Clock::now() + mRetransmissionDelay;
+    mSendTime            = Clock::now();
+    mNextTimerShot       = mSendTime + mRetransmissionDelay;
 }
 
-Coap::Coap(struct event_base *aEventBase, Endpoint &aEndpoint)
+Coap::Coap(struct event_base *aEventBase, Endpoint &aEndpoint, CpuAccount *aCpuAccount)
     : mMessageId(0)
-    , mRequestsCache(aEventBase, [this](Timer &aTimer) { Retransmit(aTimer); })
-    , mResponsesCache(aEventBase, std::chrono::seconds(kExchangeLifetime))
+    , mRequestsCache(aEventBase, [this](Timer &aTimer) { Retransmit(aTimer); }, aCpuAccount)
+    , mResponsesCache(aEventBase, std::chrono::seconds(kExchangeLifetime), aCpuAccount)
+    , mMessageIdWindowsTimer(
+          aEventBase, [this](Timer &aTimer) { EvictMessageIdWindows(aTimer); }, /* aIsSingle */ true, aCpuAccount)
+    , mDuplicateDropCount(0)
     , mDefaultHandler(nullptr)
+    , mTransactionObserver(nullptr)
     , mEndpoint(aEndpoint)
 {
     using namespace std::placeholders;
@@ -402,6 +409,8 @@ void Coap::ClearRequestsAndResponses(void)
 {
     CancelRequests();
     mResponsesCache.Clear();
+    mMessageIdWindows.clear();
+    mMessageIdWindowsTimer.Stop();
 }
 
 void Coap::CancelRequests()
@@ -465,6 +474,53 @@ exit:
     }
 }
 
+void Coap::SendMulticastRequest(const Request &aRequest, ResponseHandler aHandler, Duration aTimeout)
+{
+    Error         error;
+    auto          request = std::make_shared<Request>(aRequest);
+    RequestHolder requestHolder{request, aHandler, /* aMaxRetransmit */ 0};
+
+    VerifyOrExit(request->IsNonConfirmable(),
+                 error = ERROR_INVALID_ARGS("a CoAP multicast request is not Non-confirmable"));
+    VerifyOrExit(aHandler != nullptr, error = ERROR_INVALID_ARGS("a CoAP multicast request has no response handler"));
+
+    VerifyOrDie(request->GetMessageId() == 0);
+    request->SetMessageId(AllocMessageId());
+    request->SetToken(kDefaultTokenLength);
+
+    SuccessOrExit(error = Send(*request));
+
+    // Responses are collected until the deadline.
+    requestHolder.mIsMulticast   = true;
+    requestHolder.mNextTimerShot = requestHolder.mSendTime + aTimeout;
+    mRequestsCache.Put(requestHolder);
+
+exit:
+    if (error != ErrorCode::kNone && aHandler != nullptr)
+    {
+        aHandler(nullptr, error);
+    }
+}
+
+void Coap::SendPing(ResponseHandler aHandler)
+{
+    Error error;
+    auto  ping = std::make_shared<Request>(Type::kConfirmable, Code::kEmpty);
+
+    // An empty message has no token.
+    ping->SetMessageId(AllocMessageId());
+
+    SuccessOrExit(error = Send(*ping));
+
+    mRequestsCache.Put({ping, aHandler, /* aMaxRetransmit */ 0});
+
+exit:
+    if (error != ErrorCode::kNone && aHandler != nullptr)
+    {
+        aHandler(nullptr, error);
+    }
+}
+
 Error Coap::SendResponse(const Request &aRequest, Response &aResponse)
 {
     // Set message id to request's id
@@ -485,6 +541,46 @@ Error Coap::SendResponse(const Request &aRequest, Response &aResponse)
     return Send(aResponse);
 }
 
+Error Coap::DeferResponse(const Request &aRequest)
+{
+    Error    error;
+    Response ack{Type::kAcknowledgment, Code::kEmpty};
+
+    VerifyOrExit(aRequest.IsConfirmable(), error = ERROR_INVALID_ARGS("CoAP request is not Confirmable"));
+
+    ack.SetMessageId(aRequest.GetMessageId());
+    ack.SetEndpoint(aRequest.GetEndpoint());
+
+    // Duplicates of the request will match the cached empty ACK.
+    mResponsesCache.Put(ack);
+
+    SuccessOrExit(error = Send(ack));
+
+exit:
+    return error;
+}
+
+Error Coap::SendSeparateResponse(const Request &aRequest, Response &aResponse, ResponseHandler aHandler)
+{
+    Error error;
+
+    VerifyOrExit(aRequest.IsConfirmable(), error = ERROR_INVALID_ARGS("CoAP request is not Confirmable"));
+    VerifyOrExit(aResponse.IsResponse(), error = ERROR_INVALID_ARGS("the CoAP message is not a response"));
+
+    aResponse.SetType(Type::kConfirmable);
+    aResponse.SetMessageId(AllocMessageId());
+    aResponse.SetToken(aRequest.GetToken());
+    aResponse.SetEndpoint(aRequest.GetEndpoint());
+
+    SuccessOrExit(error = Send(aResponse));
+
+    // The response is removed once it is acknowledged or timeout.
+    mRequestsCache.Put(std::make_shared<Response>(aResponse), aHandler);
+
+exit:
+    return error;
+}
+
 Error Coap::SendEmptyChanged(const Request &aRequest)
 {
     if (!aRequest.IsConfirmable())
@@ -498,8 +594,100 @@ void Coap::Receive(Endpoint &aEndpoint, const ByteArray &aBuf)
 {
     Error error;
 
-    auto message = Message::Deserialize(error, aBuf);
-    ReceiveMessage(aEndpoint, message, error);
+    if (IsDuplicate(aEndpoint, aBuf))
+    {
+        ++mDuplicateDropCount;
+        LOG_DEBUG(LOG_REGION_COAP, "drop a duplicate Non-confirmable CoAP message, total dropped = {}",
+                  mDuplicateDropCount);
+    }
+    else
+    {
+        auto message = Message::Deserialize(error, aBuf);
+        ReceiveMessage(aEndpoint, message, error);
+    }
+}
+
+bool Coap::IsDuplicate(const Endpoint &aEndpoint, const ByteArray &aBuf)
+{
+    static constexpr size_t kFixedHeaderSize = 4;
+
+    bool                                            isDuplicate = false;
+    uint16_t                                        messageId;
+    std::tuple<const Endpoint *, Address, uint16_t> source;
+
+    VerifyOrExit(aBuf.size() >= kFixedHeaderSize);
+    VerifyOrExit((aBuf[0] >> 6) == kVersion1);
+    VerifyOrExit(((aBuf[0] >> 4) & 0x03) == utils::to_underlying(Type::kNonConfirmable));
+
+    messageId   = (aBuf[2] << 8) | aBuf[3];
+    source      = std::make_tuple(&aEndpoint, aEndpoint.GetPeerAddr(), aEndpoint.GetPeerPort());
+    isDuplicate = !mMessageIdWindows[source].Update(messageId);
+
+    if (!mMessageIdWindowsTimer.IsRunning())
+    {
+        mMessageIdWindowsTimer.Start(std::chrono::seconds(kExchangeLifetime));
+    }
+
+exit:
+    return isDuplicate;
+}
+
+void Coap::EvictMessageIdWindows(Timer &aTimer)
+{
+    auto now = Clock::now();
+
+    for (auto window = mMessageIdWindows.begin(); window != mMessageIdWindows.end();)
+    {
+        if (window->second.IsExpired(now))
+        {
+            window = mMessageIdWindows.erase(window);
+        }
+        else
+        {
+            ++window;
+        }
+    }
+
+    if (!mMessageIdWindows.empty())
+    {
+        aTimer.Start(std::chrono::seconds(kExchangeLifetime));
+    }
+}
+
+bool Coap::MessageIdWindow::Update(uint16_t aMessageId)
+{
+    bool    isNew = true;
+    auto    now   = Clock::now();
+    int16_t delta = static_cast<int16_t>(aMessageId - mLatest);
+
+    if (mBitmap == 0 || IsExpired(now))
+    {
+        // A message ID is not reused within EXCHANGE_LIFETIME (RFC 7252, p. 4.4).
+        mLatest = aMessageId;
+        mBitmap = 1;
+    }
+    else if (delta > 0)
+    {
+        mLatest = aMessageId;
+        mBitmap = delta < kSize ? (mBitmap << delta) | 1 : 1;
+    }
+    else if (-delta < kSize)
+    {
+        uint64_t bit = uint64_t{1} << -delta;
+
+        isNew = (mBitmap & bit) == 0;
+        mBitmap |= bit;
+    }
+
+    // Message IDs older than the window are accepted since we cannot tell.
+
+    mUpdateTime = now;
+    return isNew;
+}
+
+bool Coap::MessageIdWindow::IsExpired(TimePoint aNow) const
+{
+    return aNow - mUpdateTime > std::chrono::seconds(kExchangeLifetime);
 }
 
 void Coap::ReceiveMessage(Endpoint &aEndpoint, std::shared_ptr<Message> aMessage, Error error)
@@ -582,11 +770,22 @@ void Coap::HandleResponse(const Response &aResponse)
         ExitNow();
     }
 
+    if (requestHolder->mIsMulticast)
+    {
+        HandleMulticastResponse(*requestHolder, aResponse);
+        ExitNow();
+    }
+
     requestHolder->mRequest->GetUriPath(requestUri).IgnoreError();
     switch (aResponse.GetType())
     {
     case Type::kReset:
-        if (aResponse.IsEmpty())
+        if (aResponse.IsEmpty() && requestHolder->mRequest->IsEmpty())
+        {
+            // The peer is alive if it resets a CoAP ping.
+            FinalizeTransaction(*requestHolder, &aResponse, ERROR_NONE);
+        }
+        else if (aResponse.IsEmpty())
         {
             FinalizeTransaction(*requestHolder, nullptr, ERROR_ABORTED("request to {} was reset by peer", requestUri));
         }
@@ -608,6 +807,11 @@ void Coap::HandleResponse(const Response &aResponse)
             {
                 mRequestsCache.Eliminate(*requestHolder);
             }
+            else if (requestHolder->mRequest->IsResponse())
+            {
+                // A separate response is done once it is acknowledged.
+                FinalizeTransaction(*requestHolder, nullptr, ERROR_NONE);
+            }
         }
         else if (aResponse.IsResponse() && aResponse.IsTokenEqual(*requestHolder->mRequest))
         {
@@ -635,20 +839,57 @@ exit:
     return;
 }
 
+void Coap::HandleMulticastResponse(const RequestHolder &aRequestHolder, const Response &aResponse)
+{
+    std::pair<Address, uint16_t> source;
+    ResponseHandler               handler;
+
+    // Acknowledgments and resets are not expected for a Non-confirmable request.
+    VerifyOrExit(aResponse.IsConfirmable() || aResponse.IsNonConfirmable());
+
+    if (aResponse.IsConfirmable())
+    {
+        IgnoreError(SendAck(aResponse));
+    }
+
+    VerifyOrExit(aResponse.IsResponse());
+
+    // The endpoint is pointing at the source of the response while it is being handled.
+    source = {aResponse.GetEndpoint()->GetPeerAddr(), aResponse.GetEndpoint()->GetPeerPort()};
+    if (!aRequestHolder.mResponders.insert(source).second)
+    {
+        LOG_DEBUG(LOG_REGION_COAP, "client(={}) drop duplicate multicast response from [{}]:{}",
+                  static_cast<void *>(this), source.first.ToString(), source.second);
+        ExitNow();
+    }
+
+    // The handler is kept for subsequent responses. Call it with a copy
+    // since the user-provided handler may cancel the request.
+    handler = aRequestHolder.mHandler;
+    if (handler != nullptr)
+    {
+        handler(&aResponse, ERROR_NONE);
+    }
+
+exit:
+    return;
+}
+
 void Coap::Retransmit(Timer &)
 {
     auto now = Clock::now();
 
     LOG_DEBUG(LOG_REGION_COAP, "client(={}) retransmit timer triggered", static_cast<void *>(this));
 
-    while (!mRequestsCache.IsEmpty() && mRequestsCache.Earliest() < now)
+    while (!mRequestsCache.IsEmpty() && mRequestsCache.Earliest() <= now)
     {
         auto requestHolder = mRequestsCache.Eliminate();
 
         std::string uri = "UNKOWN_URI";
         requestHolder.mRequest->GetUriPath(uri).IgnoreError();
 
-        if ((requestHolder.mRequest->IsConfirmable()) && (requestHolder.mRetransmissionCount < kMaxRetransmit))
+        if ((requestHolder.mRequest->IsConfirmable()) &&
+            (requestHolder.mRetransmissionCount < requestHolder.mMaxRetransmit))
         {
             // Increment retransmission counter and timer.
             ++requestHolder.mRetransmissionCount;
@@ -680,6 +921,11 @@ void Coap::Retransmit(Timer &)
                           static_cast<void *>(this), uri);
             }
         }
+        else if (requestHolder.mIsMulticast && !requestHolder.mResponders.empty())
+        {
+            // The end of the multicast response collection.
+            FinalizeTransaction(requestHolder, nullptr, ERROR_NONE);
+        }
         else
         {
             // No expected response or acknowledgment.
@@ -756,6 +1002,12 @@ exit:
 
 void Coap::FinalizeTransaction(const RequestHolder &aRequestHolder, const Response *aResponse, Error aResult)
 {
+    // The latency of a multicast request is the collection timeout.
+    if (mTransactionObserver != nullptr && aRequestHolder.mRequest->IsRequest() && !aRequestHolder.mIsMulticast)
+    {
+        mTransactionObserver(std::chrono::duration_cast<Duration>(Clock::now() - aRequestHolder.mSendTime), aResult);
+    }
+
     if (aRequestHolder.mHandler != nullptr)
     {
         auto handler = aRequestHolder.mHandler;
@@ -788,6 +1040,12 @@ const Response *Coap::ResponsesCache::Match(const Request &aRequest) const
     return nullptr;
 }
 
+void Coap::ResponsesCache::Put(const Response &aResponse)
+{
+    mContainer.emplace(Clock::now() + mLifetime, aResponse);
+    UpdateTimer();
+}
+
 void Coap::ResponsesCache::Clear()
 {
     mTimer.Stop();
@@ -811,6 +1069,20 @@ void Coap::ResponsesCache::Eliminate()
         LOG_INFO(LOG_REGION_COAP, "server(={}) remove response cache: token={}, messageId={}",
                  static_cast<void *>(this), utils::Hex(response.GetToken()), response.GetMessageId());
     }
+
+    UpdateTimer();
+}
+
+void Coap::ResponsesCache::UpdateTimer()
+{
+    if (IsEmpty())
+    {
+        mTimer.Stop();
+    }
+    else if (!mTimer.IsRunning())
+    {
+        mTimer.Start(mContainer.begin()->first);
+    }
 }
 
 void Coap::RequestsCache::Put(const RequestPtr aRequest, ResponseHandler aHandler)
@@ -1014,12 +1286,21 @@ exit:
 }
 
 std::shared_ptr<Message> Message::Deserialize(Error &aError, const ByteArray &aBuf)
+{
+    size_t optionNum;
+
+    return Deserialize(aError, aBuf, optionNum);
+}
+
+std::shared_ptr<Message> Message::Deserialize(Error &aError, const ByteArray &aBuf, size_t &aOptionNum)
 {
     Error    error;
     size_t   offset = 0;
     uint16_t lastOptionNumber;
     auto     message = std::make_shared<Message>();
 
+    aOptionNum = 0;
+
     SuccessOrExit(error = Deserialize(message->mHeader, aBuf, offset));
     VerifyOrExit(message->mHeader.IsValid(), error = ERROR_BAD_FORMAT("invalid CoAP message header"));
 
@@ -1029,6 +1310,10 @@ std::shared_ptr<Message> Message::Deserialize(Error &aError, const ByteArray &aB
         OptionType  number;
         OptionValue value;
 
+        VerifyOrExit(aOptionNum < kMaxOptionNum,
+                     error = ERROR_BAD_FORMAT("too many CoAP options (max={})", kMaxOptionNum));
+
+        ++aOptionNum;
         SuccessOrExit(error = Deserialize(number, value, lastOptionNumber, aBuf, offset));
 
         if (IsValidOption(number, value))
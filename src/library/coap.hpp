@@ -41,6 +41,8 @@
 #include <memory>
 #include <queue>
 #include <set>
+#include <tuple>
+#include <utility>
 
 #include <commissioner/defines.hpp>
 #include <commissioner/error.hpp>
@@ -400,6 +402,10 @@ static constexpr uint8_t kVersion1           = 1;
 static constexpr uint8_t kMaxTokenLength     = 8;
 static constexpr uint8_t kDefaultTokenLength = kMaxTokenLength;
 
+// The max number of options accepted in a received message. Messages
+// with more options are rejected before the options are stored.
+static constexpr size_t kMaxOptionNum = 32;
+
 /**
  * This class implements CoAP message generation and parsing.
  *
@@ -431,7 +437,12 @@ public:
 
     // Read and deserialize a message from the buffer.
     static std::shared_ptr<Message> Deserialize(Error &aError, const ByteArray &aBuf);
-    Error                           Serialize(ByteArray &aBuf) const;
+
+    // As above, @p aOptionNum is set to the number of options parsed,
+    // which is never more than kMaxOptionNum.
+    static std::shared_ptr<Message> Deserialize(Error &aError, const ByteArray &aBuf, size_t &aOptionNum);
+
+    Error Serialize(ByteArray &aBuf) const;
 
     Message(Type aType, Code aCode);
     Message();
@@ -557,6 +568,9 @@ using ResponsePtr     = std::shared_ptr<Response>;
 using RequestHandler  = std::function<void(const Request &)>;
 using ResponseHandler = std::function<void(const Response *, Error)>;
 
+// Observes the latency and result of each finalized request.
+using TransactionObserver = std::function<void(Duration aLatency, const Error &aResult)>;
+
 /**
  * This class implements CoAP resource handling.
  *
@@ -595,7 +609,7 @@ private:
 class Coap
 {
 public:
-    Coap(struct event_base *aEventBase, Endpoint &aEndpoint);
+    Coap(struct event_base *aEventBase, Endpoint &aEndpoint, CpuAccount *aCpuAccount = nullptr);
     virtual ~Coap() = default;
 
     // Cancel all outstanding requests
@@ -607,15 +621,37 @@ public:
     size_t GetPendingRequestsNum() const { return mRequestsCache.Count(); }
     size_t GetCachedResponsesNum() const { return mResponsesCache.Count(); }
 
+    // The number of duplicate Non-confirmable messages dropped before parsing.
+    uint64_t GetDuplicateDropCount() const { return mDuplicateDropCount; }
+
+    // The number of sources whose recent Non-confirmable message IDs are tracked.
+    size_t GetMessageIdWindowsNum() const { return mMessageIdWindows.size(); }
+
     Error AddResource(const Resource &aResource);
 
     void RemoveResource(const Resource &aResource);
     void SetDefaultHandler(RequestHandler aHandler);
 
+    // The observer is called before the response handler of each unicast request.
+    void SetTransactionObserver(TransactionObserver aObserver) { mTransactionObserver = aObserver; }
+
     // If `aRequest` is confirmable, `aHandler` is guaranteed to be called;
     // Otherwise, `aHandler` will be called only when failed to send the request.
     void SendRequest(const Request &aRequest, ResponseHandler aHandler);
 
+    // Send a multicast request (RFC 7252, p. 8.1), which must be Non-confirmable.
+    // The token is kept open until `aTimeout` expires and `aHandler` is called
+    // with each response, at most once per source address and port. The
+    // collection ends with a final call of `aHandler` with a null response and
+    // ERROR_NONE, or ERROR_TIMEOUT if no response has been received.
+    void SendMulticastRequest(const Request &aRequest, ResponseHandler aHandler, Duration aTimeout);
+
+    // Send a CoAP ping (an empty Confirmable message, RFC 7252, p. 4.3).
+    // `aHandler` is called with no error when the peer resets the ping.
+    // The ping is not retransmitted, so a lost ping or reset times out
+    // after the first ACK timeout.
+    void SendPing(ResponseHandler aHandler);
+
     Error SendReset(const Request &aRequest) { return SendEmptyMessage(Type::kReset, aRequest); };
 
     Error SendHeaderResponse(Code aCode, const Request &aRequest);
@@ -627,6 +663,19 @@ public:
 
     Error SendAck(const Request &aRequest) { return SendEmptyMessage(Type::kAcknowledgment, aRequest); }
 
+    // Acknowledge a Confirmable request with an empty ACK and defer its
+    // response (RFC 7252, p. 5.2.2). The empty ACK is cached so that
+    // duplicates of the request are acknowledged again but not dispatched
+    // to the resource handler.
+    Error DeferResponse(const Request &aRequest);
+
+    // Send the separate response of a request deferred by `DeferResponse`.
+    // The response is sent as a Confirmable message with a new message ID
+    // and retransmitted until it is acknowledged. The optional handler is
+    // called with ERROR_NONE once the response is acknowledged, or with the
+    // error which ended the retransmission.
+    Error SendSeparateResponse(const Request &aRequest, Response &aResponse, ResponseHandler aHandler = nullptr);
+
     Error SendNotFound(const Request &aRequest) { return SendHeaderResponse(Code::kNotFound, aRequest); }
 
     void Receive(const ByteArray &aBuf) { Receive(mEndpoint, aBuf); }
@@ -638,15 +687,22 @@ private:
      */
     struct RequestHolder
     {
-        RequestHolder(const RequestPtr aRequest, ResponseHandler aHandler);
+        RequestHolder(const RequestPtr aRequest, ResponseHandler aHandler, uint32_t aMaxRetransmit = kMaxRetransmit);
 
         RequestPtr              mRequest;
         mutable ResponseHandler mHandler;
+        uint32_t                mMaxRetransmit;
         uint32_t                mRetransmissionCount;
         Duration                mRetransmissionDelay;
         TimePoint               mNextTimerShot;
+        TimePoint               mSendTime;
         mutable bool            mAcknowledged;
 
+        // A multicast request is finalized at `mNextTimerShot` rather
+        // than by the first response.
+        bool                                           mIsMulticast;
+        mutable std::set<std::pair<Address, uint16_t>> mResponders;
+
         bool operator<(const RequestHolder &aOther) const { return mNextTimerShot < aOther.mNextTimerShot; }
     };
 
@@ -656,8 +712,8 @@ private:
     class RequestsCache
     {
     public:
-        RequestsCache(struct event_base *aEventBase, Timer::Action aRetransmitter)
-            : mRetransmissionTimer(aEventBase, aRetransmitter)
+        RequestsCache(struct event_base *aEventBase, Timer::Action aRetransmitter, CpuAccount *aCpuAccount)
+            : mRetransmissionTimer(aEventBase, aRetransmitter, /* aIsSingle */ true, aCpuAccount)
         {
         }
         ~RequestsCache() = default;
@@ -706,14 +762,14 @@ private:
     class ResponsesCache
     {
     public:
-        explicit ResponsesCache(struct event_base *aEventBase, const Duration &aLifetime)
+        ResponsesCache(struct event_base *aEventBase, const Duration &aLifetime, CpuAccount *aCpuAccount)
             : mLifetime(aLifetime)
-            , mTimer(aEventBase, [this](Timer &) { Eliminate(); })
+            , mTimer(aEventBase, [this](Timer &) { Eliminate(); }, /* aIsSingle */ true, aCpuAccount)
         {
         }
         ~ResponsesCache() = default;
 
-        void Put(const Response &aResponse) { mContainer.emplace(Clock::now() + mLifetime, aResponse); }
+        void Put(const Response &aResponse);
 
         // Find the response of a request in the response cache.
         const Response *Match(const Request &aRequest) const;
@@ -727,6 +783,9 @@ private:
         // Remove all response caches that have expired.
         void Eliminate();
 
+        // Start the timer for the earliest response cache if it is not running.
+        void UpdateTimer();
+
         Duration mLifetime;
 
         // The timer to remove a response.
@@ -734,13 +793,41 @@ private:
         std::multimap<TimePoint, Response> mContainer;
     };
 
+    // A sliding window of the message IDs of Non-confirmable messages
+    // recently received from an endpoint.
+    class MessageIdWindow
+    {
+    public:
+        // Record the message ID. Returns false if it has been recorded.
+        bool Update(uint16_t aMessageId);
+
+        // A window not updated within EXCHANGE_LIFETIME tells nothing.
+        bool IsExpired(TimePoint aNow) const;
+
+    private:
+        static constexpr int kSize = 64;
+
+        uint16_t mLatest = 0;
+
+        // Bit `i` is set if message ID `mLatest - i` has been received.
+        uint64_t  mBitmap = 0;
+        TimePoint mUpdateTime;
+    };
+
     uint16_t AllocMessageId() { return ++mMessageId; }
 
+    // Check the fixed header of a received message and tell if it
+    // is a duplicate Non-confirmable message.
+    bool IsDuplicate(const Endpoint &aEndpoint, const ByteArray &aBuf);
+
     void Receive(Endpoint &aEndpoint, const ByteArray &aBuf);
     void ReceiveMessage(Endpoint &aEndpoint, std::shared_ptr<Message> aMessage, Error error);
 
     void Retransmit(Timer &aTimer);
 
+    // Remove the windows of sources not heard from within EXCHANGE_LIFETIME.
+    void EvictMessageIdWindows(Timer &aTimer);
+
     void FinalizeTransaction(const RequestHolder &aRequestHolder, const Response *aResponse, Error aResult);
 
     void HandleRequest(const Request &aRequest);
@@ -748,6 +835,8 @@ private:
     // Handle empty and response message
     void HandleResponse(const Response &aResponse);
 
+    void HandleMulticastResponse(const RequestHolder &aRequestHolder, const Response &aResponse);
+
     Error SendEmptyMessage(Type aType, const Request &aRequest);
 
     Error Send(const Message &aMessage);
@@ -760,9 +849,17 @@ private:
     RequestsCache  mRequestsCache;
     ResponsesCache mResponsesCache;
 
+    // Keyed by the source address and port as well since an endpoint
+    // (e.g. the UDP proxy) may receive from multiple peers.
+    std::map<std::tuple<const Endpoint *, Address, uint16_t>, MessageIdWindow> mMessageIdWindows;
+    Timer                                                                      mMessageIdWindowsTimer;
+    uint64_t                                                                   mDuplicateDropCount;
+
     // The default request handler when there is matching resource.
     RequestHandler mDefaultHandler;
 
+    TransactionObserver mTransactionObserver;
+
     Endpoint &mEndpoint;
 };
 
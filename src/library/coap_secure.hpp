@@ -37,6 +37,7 @@
 #include "common/error_macros.hpp"
 #include "library/coap.hpp"
 #include "library/dtls.hpp"
+#include "library/impaired_socket.hpp"
 
 namespace ot {
 
@@ -47,21 +48,70 @@ namespace coap {
 class CoapSecure
 {
 public:
-    explicit CoapSecure(struct event_base *aEventBase, bool aIsServer = false)
-        : mSocket(std::make_shared<UdpSocket>(aEventBase))
-        , mDtlsSession(aEventBase, aIsServer, mSocket)
-        , mCoap(aEventBase, mDtlsSession)
+    explicit CoapSecure(struct event_base *aEventBase, bool aIsServer = false, CpuAccount *aCpuAccount = nullptr)
+        : CoapSecure(aEventBase, aIsServer, ImpairmentConfig{}, aCpuAccount)
+    {
+    }
+
+    // Emulates a lossy, high latency link for tests and benchmarks. The UDP
+    // socket is wrapped by an ImpairedSocket only if any impairment is enabled.
+    CoapSecure(struct event_base *     aEventBase,
+               bool                    aIsServer,
+               const ImpairmentConfig &aImpairment,
+               CpuAccount *            aCpuAccount = nullptr)
+        : mEventBase(aEventBase)
+        , mSocket(std::make_shared<UdpSocket>(aEventBase, aCpuAccount))
+        , mImpairedSocket(aImpairment.IsEnabled() ? std::make_shared<ImpairedSocket>(aEventBase, mSocket, aImpairment)
+                                                  : nullptr)
+        , mDtlsSession(aEventBase, aIsServer, mImpairedSocket != nullptr ? SocketPtr{mImpairedSocket} : mSocket)
+        , mCoap(aEventBase, mDtlsSession, aCpuAccount)
+        , mIsDtlsSessionInitialized(false)
     {
     }
 
     ~CoapSecure() = default;
 
-    Error Init(const DtlsConfig &aConfig) { return mDtlsSession.Init(aConfig); }
+    // The DTLS session is initialized on the first connection, because parsing
+    // credentials and seeding the DRBG are expensive and not all clients connect.
+    Error Init(const DtlsConfig &aConfig)
+    {
+        mDtlsConfig               = aConfig;
+        mIsDtlsSessionInitialized = false;
+        return ERROR_NONE;
+    }
+
+    // Emulates a lossy, high latency link for testing. The UDP socket is
+    // wrapped by an ImpairedSocket only if any impairment is enabled, which
+    // must happen before the first connection.
+    Error SetImpairment(const ImpairmentConfig &aImpairment)
+    {
+        Error error;
+
+        if (mImpairedSocket != nullptr)
+        {
+            mImpairedSocket->SetConfig(aImpairment);
+        }
+        else if (aImpairment.IsEnabled())
+        {
+            VerifyOrExit(mDtlsSession.GetState() == DtlsSession::State::kOpen,
+                         error = ERROR_INVALID_STATE("cannot impair a link which has been connected"));
+            mImpairedSocket = std::make_shared<ImpairedSocket>(mEventBase, mSocket, aImpairment);
+            mDtlsSession.SetSocket(mImpairedSocket);
+        }
+
+    exit:
+        return error;
+    }
+
+    // Returns nullptr if the link is not impaired.
+    const ImpairedSocket *GetImpairedSocket() const { return mImpairedSocket.get(); }
 
     Error Start(DtlsSession::ConnectHandler aOnConnected, const std::string &aLocalAddr, uint16_t aLocalPort)
     {
         Error error;
 
+        SuccessOrExit(error = InitDtlsSession());
+
         if (int fail = mSocket->Bind(aLocalAddr, aLocalPort))
         {
             ExitNow(error = ERROR_IO_ERROR("bind socket to local addr={}, port={} failed: {}", aLocalAddr, aLocalPort,
@@ -75,6 +125,17 @@ public:
 
     void Connect(DtlsSession::ConnectHandler aOnConnected, const std::string &aPeerAddr, uint16_t aPeerPort)
     {
+        Error error = InitDtlsSession();
+
+        if (error != ErrorCode::kNone)
+        {
+            if (aOnConnected != nullptr)
+            {
+                aOnConnected(mDtlsSession, error);
+            }
+            ExitNow();
+        }
+
         if (int fail = mSocket->Connect(aPeerAddr, aPeerPort))
         {
             if (aOnConnected != nullptr)
@@ -115,18 +176,55 @@ public:
 
     void SendRequest(const Request &aRequest, ResponseHandler aHandler) { mCoap.SendRequest(aRequest, aHandler); }
 
+    void SendPing(ResponseHandler aHandler) { mCoap.SendPing(aHandler); }
+
     Error SendResponse(const Request &aRequest, Response &aResponse) { return mCoap.SendResponse(aRequest, aResponse); }
 
     bool IsConnected() const { return mDtlsSession.GetState() == DtlsSession::State::kConnected; }
 
     const DtlsSession &GetDtlsSession() const { return mDtlsSession; }
 
+    void SetCompactExtendedTlv(bool aEnabled) { mDtlsSession.SetCompactExtendedTlv(aEnabled); }
+
+    // The arrival time of the last received datagram, see Socket::GetLastRecvTime().
+    TimePoint GetLastRecvTime() const
+    {
+        return mImpairedSocket != nullptr ? mImpairedSocket->GetLastRecvTime() : mSocket->GetLastRecvTime();
+    }
+
     void CancelRequests() { mCoap.CancelRequests(); }
 
+    size_t GetPendingRequestsNum() const { return mCoap.GetPendingRequestsNum(); }
+
+    void SetTransactionObserver(TransactionObserver aObserver) { mCoap.SetTransactionObserver(aObserver); }
+
+    uint64_t GetDuplicateDropCount() const { return mCoap.GetDuplicateDropCount(); }
+
 private:
-    UdpSocketPtr mSocket;
-    DtlsSession  mDtlsSession;
-    Coap         mCoap;
+    // A failed initialization is not retried, the DTLS session may have been partially initialized.
+    Error InitDtlsSession()
+    {
+        if (!mIsDtlsSessionInitialized)
+        {
+            mDtlsSessionInitError     = mDtlsSession.Init(mDtlsConfig);
+            mIsDtlsSessionInitialized = true;
+
+            // Don't keep a second copy of the credentials.
+            mDtlsConfig = DtlsConfig();
+        }
+
+        return mDtlsSessionInitError;
+    }
+
+    struct event_base *mEventBase;
+    UdpSocketPtr       mSocket;
+    ImpairedSocketPtr  mImpairedSocket;
+    DtlsSession        mDtlsSession;
+    Coap               mCoap;
+
+    DtlsConfig mDtlsConfig;
+    bool       mIsDtlsSessionInitialized;
+    Error      mDtlsSessionInitError;
 };
 
 } // namespace coap
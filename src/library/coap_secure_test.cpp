@@ -178,6 +178,112 @@ TEST_CASE("coap-secure-basic", "[coaps]")
     event_base_free(eventBase);
 }
 
+TEST_CASE("coap-secure-impaired-border-agent", "[coaps]")
+{
+    static constexpr uint32_t kDelay = 20;
+
+    DtlsConfig       config;
+    ImpairmentConfig impairment;
+    TimePoint        requestTime;
+
+    config.mCaChain = ByteArray{kServerTrustAnchor.begin(), kServerTrustAnchor.end()};
+    config.mOwnCert = ByteArray{kServerCert.begin(), kServerCert.end()};
+    config.mOwnKey  = ByteArray{kServerKey.begin(), kServerKey.end()};
+
+    config.mCaChain.push_back(0);
+    config.mOwnCert.push_back(0);
+    config.mOwnKey.push_back(0);
+
+    // A simulated border agent behind a high latency link.
+    impairment.mDelay = kDelay;
+
+    auto eventBase = event_base_new();
+    REQUIRE(eventBase != nullptr);
+
+    CoapSecure borderAgent{eventBase, true, impairment};
+    Resource   resHello{"/hello", [&borderAgent](const Request &aRequest) {
+                          Response response{Type::kAcknowledgment, Code::kChanged};
+                          REQUIRE(borderAgent.SendResponse(aRequest, response) == ErrorCode::kNone);
+                      }};
+    REQUIRE(borderAgent.AddResource(resHello) == ErrorCode::kNone);
+    REQUIRE(borderAgent.GetImpairedSocket() != nullptr);
+
+    REQUIRE(borderAgent.Init(config) == ErrorCode::kNone);
+    REQUIRE(borderAgent.Start(nullptr, kServerAddr, kServerPort) == ErrorCode::kNone);
+
+    // No impairment is configured, the client link is not wrapped.
+    CoapSecure coapsClient{eventBase, false};
+    REQUIRE(coapsClient.GetImpairedSocket() == nullptr);
+
+    config.mCaChain = ByteArray{kClientTrustAnchor.begin(), kClientTrustAnchor.end()};
+    config.mOwnCert = ByteArray{kClientCert.begin(), kClientCert.end()};
+    config.mOwnKey  = ByteArray{kClientKey.begin(), kClientKey.end()};
+
+    config.mCaChain.push_back(0);
+    config.mOwnCert.push_back(0);
+    config.mOwnKey.push_back(0);
+
+    REQUIRE(coapsClient.Init(config) == ErrorCode::kNone);
+    auto onClientConnected = [&coapsClient, &requestTime, eventBase](const DtlsSession &, Error aError) {
+        REQUIRE(aError == ErrorCode::kNone);
+
+        Request request{Type::kConfirmable, Code::kPost};
+        REQUIRE(request.SetUriPath("/hello") == ErrorCode::kNone);
+        auto onResponse = [&requestTime, eventBase](const Response *aResponse, Error aError) {
+            REQUIRE(aError == ErrorCode::kNone);
+            REQUIRE(aResponse != nullptr);
+            REQUIRE(aResponse->GetCode() == Code::kChanged);
+
+            // Both the request and the response are delayed.
+            REQUIRE(Clock::now() - requestTime >= MilliSeconds(2 * kDelay));
+
+            event_base_loopbreak(eventBase);
+        };
+        requestTime = Clock::now();
+        coapsClient.SendRequest(request, onResponse);
+    };
+    coapsClient.Connect(onClientConnected, kServerAddr, kServerPort);
+
+    REQUIRE(event_base_loop(eventBase, EVLOOP_NO_EXIT_ON_EMPTY) == 0);
+
+    REQUIRE(borderAgent.GetImpairedSocket()->GetRecvCounters().mDelivered > 0);
+    REQUIRE(borderAgent.GetImpairedSocket()->GetSendCounters().mDelivered > 0);
+    REQUIRE(borderAgent.GetImpairedSocket()->GetSendCounters().mDropped == 0);
+
+    event_base_free(eventBase);
+}
+
+TEST_CASE("coap-secure-lazy-init", "[coaps]")
+{
+    DtlsConfig config;
+    bool       isConnectHandlerCalled = false;
+
+    config.mCaChain = ByteArray{'b', 'a', 'd', 0};
+    config.mOwnCert = ByteArray{kClientCert.begin(), kClientCert.end()};
+    config.mOwnKey  = ByteArray{kClientKey.begin(), kClientKey.end()};
+
+    config.mOwnCert.push_back(0);
+    config.mOwnKey.push_back(0);
+
+    auto eventBase = event_base_new();
+    REQUIRE(eventBase != nullptr);
+
+    CoapSecure coapsClient{eventBase, false};
+
+    // Credentials are not parsed until the first connection.
+    REQUIRE(coapsClient.Init(config) == ErrorCode::kNone);
+
+    auto onConnected = [&isConnectHandlerCalled](const DtlsSession &, Error aError) {
+        REQUIRE(aError == ErrorCode::kInvalidArgs);
+        isConnectHandlerCalled = true;
+    };
+    coapsClient.Connect(onConnected, kServerAddr, kServerPort);
+    REQUIRE(isConnectHandlerCalled);
+    REQUIRE(!coapsClient.IsConnected());
+
+    event_base_free(eventBase);
+}
+
 } // namespace coap
 
 } // namespace commissioner
@@ -34,8 +34,12 @@
 #include "common/error_macros.hpp"
 #include "library/coap.hpp"
 
+#include <random>
+
 #include <catch2/catch.hpp>
 
+#include "library/simulated_event_loop.hpp"
+
 namespace ot {
 
 namespace commissioner {
@@ -450,6 +454,534 @@ TEST_CASE("coap-message-confirmable", "[coap]")
     event_base_free(eventBase);
 }
 
+TEST_CASE("coap-message-confirmable-virtual-time", "[coap]")
+{
+    static constexpr size_t kRequestCount = 1000;
+
+    Address localhost;
+    REQUIRE(localhost.Set("127.0.0.1") == ErrorCode::kNone);
+
+    auto eventBase = event_base_new();
+    REQUIRE(eventBase != nullptr);
+
+    {
+        SimulatedEventLoop loop{eventBase};
+
+        MockEndpoint peer0{eventBase, localhost, 5683};
+        MockEndpoint peer1{eventBase, localhost, 5684};
+        peer0.SetPeer(&peer1);
+        peer1.SetPeer(&peer0);
+
+        Coap coap0{eventBase, peer0};
+        Coap coap1{eventBase, peer1};
+
+        SECTION("all requests time out after retransmissions")
+        {
+            const auto startTime    = Clock::now();
+            size_t     timeoutCount = 0;
+
+            // The first ACK timeout is within [kAckTimeout, kAckTimeout * 1.5] and
+            // is doubled after each of the kMaxRetransmit retransmissions.
+            const auto minTimeout = std::chrono::seconds(kAckTimeout * ((2 << kMaxRetransmit) - 1));
+            const auto maxTimeout = minTimeout * kAckRandomFactorNumerator / kAckRandomFactorDenominator;
+
+            peer0.SetDropMessage(true);
+            for (size_t i = 0; i < kRequestCount; ++i)
+            {
+                Message request{Type::kConfirmable, Code::kGet};
+                REQUIRE(request.SetUriPath("/hello") == ErrorCode::kNone);
+
+                coap0.SendRequest(request, [&](const Response *aResponse, Error aError) {
+                    REQUIRE(aResponse == nullptr);
+                    REQUIRE(aError == ErrorCode::kTimeout);
+                    REQUIRE(Clock::now() - startTime >= minTimeout);
+                    REQUIRE(Clock::now() - startTime <= maxTimeout);
+                    ++timeoutCount;
+                });
+            }
+
+            REQUIRE(loop.RunUntil([&]() { return timeoutCount == kRequestCount; }, std::chrono::hours(1)));
+            REQUIRE(loop.GetPendingTimerCount() == 0);
+        }
+    }
+
+    event_base_free(eventBase);
+}
+
+TEST_CASE("coap-ping", "[coap]")
+{
+    Address localhost;
+    REQUIRE(localhost.Set("127.0.0.1") == ErrorCode::kNone);
+
+    auto eventBase = event_base_new();
+    REQUIRE(eventBase != nullptr);
+
+    {
+        SimulatedEventLoop loop{eventBase};
+
+        MockEndpoint peer0{eventBase, localhost, 5683};
+        MockEndpoint peer1{eventBase, localhost, 5684};
+        peer0.SetPeer(&peer1);
+        peer1.SetPeer(&peer0);
+
+        Coap coap0{eventBase, peer0};
+        Coap coap1{eventBase, peer1};
+
+        const auto startTime = Clock::now();
+        bool       done      = false;
+
+        SECTION("ping is reset by peer")
+        {
+            coap0.SendPing([&](const Response *aResponse, Error aError) {
+                REQUIRE(aError == ErrorCode::kNone);
+                REQUIRE(aResponse != nullptr);
+                REQUIRE(aResponse->IsReset());
+                done = true;
+            });
+
+            REQUIRE(loop.RunUntil([&]() { return done; }, std::chrono::seconds(1)));
+            REQUIRE(Clock::now() == startTime);
+            REQUIRE(coap0.GetPendingRequestsNum() == 0);
+        }
+
+        SECTION("lost ping times out without retransmission")
+        {
+            peer0.SetDropMessage(true);
+            coap0.SendPing([&](const Response *aResponse, Error aError) {
+                REQUIRE(aError == ErrorCode::kTimeout);
+                REQUIRE(aResponse == nullptr);
+                REQUIRE(Clock::now() - startTime >= std::chrono::seconds(kAckTimeout));
+                REQUIRE(Clock::now() - startTime <= std::chrono::seconds(kAckTimeout) * kAckRandomFactorNumerator /
+                                                        kAckRandomFactorDenominator);
+                done = true;
+            });
+
+            REQUIRE(loop.RunUntil([&]() { return done; }, std::chrono::minutes(1)));
+            REQUIRE(loop.GetPendingTimerCount() == 0);
+        }
+    }
+
+    event_base_free(eventBase);
+}
+
+TEST_CASE("coap-separate-response", "[coap]")
+{
+    Address localhost;
+    REQUIRE(localhost.Set("127.0.0.1") == ErrorCode::kNone);
+
+    auto eventBase = event_base_new();
+    REQUIRE(eventBase != nullptr);
+
+    {
+        SimulatedEventLoop loop{eventBase};
+
+        MockEndpoint peer0{eventBase, localhost, 5683};
+        MockEndpoint peer1{eventBase, localhost, 5684};
+        peer0.SetPeer(&peer1);
+        peer1.SetPeer(&peer0);
+
+        Coap coap0{eventBase, peer0};
+        Coap coap1{eventBase, peer1};
+
+        static constexpr auto kHandlingDelay = std::chrono::seconds(30);
+
+        size_t  handledCount = 0;
+        size_t  ackCount     = 0;
+        Request deferredRequest;
+        Timer   responder{eventBase, [&](Timer &) {
+                            Response response{Type::kAcknowledgment, Code::kChanged};
+                            response.Append("done");
+
+                            auto onAcknowledged = [&ackCount](const Response *, Error aError) {
+                                REQUIRE(aError == ErrorCode::kNone);
+                                ++ackCount;
+                            };
+                            REQUIRE(coap1.SendSeparateResponse(deferredRequest, response, onAcknowledged) ==
+                                    ErrorCode::kNone);
+                        }};
+
+        REQUIRE(coap1.AddResource({"/slow", [&](const Request &aRequest) {
+                                       ++handledCount;
+                                       deferredRequest = aRequest;
+                                       REQUIRE(coap1.DeferResponse(aRequest) == ErrorCode::kNone);
+                                       responder.Start(kHandlingDelay);
+                                   }}) == ErrorCode::kNone);
+
+        const auto startTime = Clock::now();
+        bool       done      = false;
+
+        Message request{Type::kConfirmable, Code::kPost};
+        REQUIRE(request.SetUriPath("/slow") == ErrorCode::kNone);
+
+        auto onResponse = [&](const Response *aResponse, Error aError) {
+            REQUIRE(aError == ErrorCode::kNone);
+            REQUIRE(aResponse != nullptr);
+            REQUIRE(aResponse->GetType() == Type::kConfirmable);
+            REQUIRE(aResponse->GetCode() == Code::kChanged);
+            REQUIRE(aResponse->GetPayloadAsString() == "done");
+            REQUIRE(Clock::now() - startTime == kHandlingDelay);
+            done = true;
+        };
+
+        SECTION("the empty ACK stops retransmission of the request")
+        {
+            coap0.SendRequest(request, onResponse);
+
+            REQUIRE(loop.RunUntil([&]() { return done; }, std::chrono::minutes(1)));
+            REQUIRE(handledCount == 1);
+        }
+
+        SECTION("duplicates received while the response is pending are suppressed")
+        {
+            // Lose the empty ACK so that the request is retransmitted.
+            coap0.SendRequest(request, onResponse);
+            peer1.SetDropMessage(true);
+            REQUIRE(loop.RunUntil([&]() { return handledCount == 1; }, std::chrono::seconds(1)));
+            peer1.SetDropMessage(false);
+
+            REQUIRE(loop.RunUntil([&]() { return done; }, std::chrono::minutes(1)));
+            REQUIRE(handledCount == 1);
+            REQUIRE(coap1.GetCachedResponsesNum() == 1);
+        }
+
+        // The separate response is acknowledged and no longer retransmitted.
+        REQUIRE(loop.RunUntil([&]() { return coap1.GetPendingRequestsNum() == 0; }, std::chrono::seconds(1)));
+        REQUIRE(coap0.GetPendingRequestsNum() == 0);
+        REQUIRE(ackCount == 1);
+
+        // The cached empty ACK expires after the exchange lifetime.
+        REQUIRE(loop.RunUntil([&]() { return coap1.GetCachedResponsesNum() == 0; },
+                              std::chrono::seconds(kExchangeLifetime)));
+        REQUIRE(loop.GetPendingTimerCount() == 0);
+    }
+
+    event_base_free(eventBase);
+}
+
+TEST_CASE("coap-non-confirmable-duplicate-suppression", "[coap]")
+{
+    Address localhost;
+    REQUIRE(localhost.Set("127.0.0.1") == ErrorCode::kNone);
+
+    auto eventBase = event_base_new();
+    REQUIRE(eventBase != nullptr);
+
+    {
+        SimulatedEventLoop loop{eventBase};
+
+        MockEndpoint peer0{eventBase, localhost, 5683};
+        MockEndpoint peer1{eventBase, localhost, 5684};
+        peer0.SetPeer(&peer1);
+        peer1.SetPeer(&peer0);
+
+        Coap coap1{eventBase, peer1};
+
+        std::vector<uint16_t> handledIds;
+        REQUIRE(coap1.AddResource({"/ntf", [&](const Request &aRequest) {
+                                       handledIds.push_back(aRequest.GetMessageId());
+                                   }}) == ErrorCode::kNone);
+
+        ByteArray notification;
+        Message   ntf{Type::kNonConfirmable, Code::kPost};
+        REQUIRE(ntf.SetUriPath("/ntf") == ErrorCode::kNone);
+        REQUIRE(ntf.Serialize(notification) == ErrorCode::kNone);
+
+        auto receive = [&](uint16_t aMessageId) {
+            notification[2] = aMessageId >> 8;
+            notification[3] = aMessageId & 0xFF;
+            coap1.Receive(notification);
+        };
+
+        for (uint16_t id = 0xFFF0; id != 0x0010; ++id)
+        {
+            receive(id);
+            receive(id);
+        }
+        REQUIRE(handledIds.size() == 0x20);
+        REQUIRE(coap1.GetDuplicateDropCount() == 0x20);
+
+        // Out-of-order messages within the window.
+        receive(0x0020);
+        receive(0x0015);
+        receive(0x0015);
+        receive(0xFFF5);
+        REQUIRE(handledIds.size() == 0x22);
+        REQUIRE(coap1.GetDuplicateDropCount() == 0x22);
+
+        // Messages older than the window are accepted.
+        receive(0x0020 - 64);
+        REQUIRE(handledIds.size() == 0x23);
+
+        // Confirmable messages are not filtered.
+        ByteArray request;
+        Message   req{Type::kConfirmable, Code::kPost};
+        REQUIRE(req.SetUriPath("/ntf") == ErrorCode::kNone);
+        REQUIRE(req.Serialize(request) == ErrorCode::kNone);
+        coap1.Receive(request);
+        coap1.Receive(request);
+        REQUIRE(handledIds.size() == 0x25);
+
+        // The window expires after the exchange lifetime.
+        loop.RunFor(std::chrono::seconds(kExchangeLifetime + 1));
+        receive(0x0020);
+        REQUIRE(handledIds.size() == 0x26);
+        REQUIRE(coap1.GetDuplicateDropCount() == 0x22);
+
+        // The window is removed once the source stays quiet.
+        REQUIRE(coap1.GetMessageIdWindowsNum() == 1);
+        loop.RunFor(std::chrono::seconds(2 * kExchangeLifetime + 1));
+        REQUIRE(coap1.GetMessageIdWindowsNum() == 0);
+    }
+
+    event_base_free(eventBase);
+}
+
+// An endpoint which records sent messages and receives from a
+// configurable peer, like the UDP proxy endpoint.
+class RecordingEndpoint : public Endpoint
+{
+public:
+    Error Send(const ByteArray &aBuf, MessageSubType) override
+    {
+        mSentMessages.push_back(aBuf);
+        return ERROR_NONE;
+    }
+
+    Address  GetPeerAddr() const override { return mPeerAddr; }
+    uint16_t GetPeerPort() const override { return mPeerPort; }
+
+    void SetPeer(const Address &aPeerAddr, uint16_t aPeerPort)
+    {
+        mPeerAddr = aPeerAddr;
+        mPeerPort = aPeerPort;
+    }
+
+    void Receive(const ByteArray &aBuf) { mReceiver(*this, aBuf); }
+
+    std::vector<ByteArray> mSentMessages;
+
+private:
+    Address  mPeerAddr;
+    uint16_t mPeerPort = 0;
+};
+
+TEST_CASE("coap-multicast-request", "[coap]")
+{
+    static constexpr auto     kTimeout  = std::chrono::seconds(5);
+    static constexpr uint16_t kCoapPort = 5683;
+
+    const Address kGroupAddr = Address::FromString("ff03::1");
+    const Address kNode0     = Address::FromString("fd00::1");
+    const Address kNode1     = Address::FromString("fd00::2");
+
+    auto eventBase = event_base_new();
+    REQUIRE(eventBase != nullptr);
+
+    {
+        SimulatedEventLoop loop{eventBase};
+
+        RecordingEndpoint client;
+        RecordingEndpoint server;
+        Coap              coap0{eventBase, client};
+        Coap              coap1{eventBase, server};
+
+        REQUIRE(coap1.AddResource({"/diag", [&](const Request &aRequest) {
+                                       REQUIRE(coap1.SendHeaderResponse(Code::kContent, aRequest) == ErrorCode::kNone);
+                                   }}) == ErrorCode::kNone);
+
+        const auto             startTime = Clock::now();
+        std::vector<Address>   responders;
+        std::vector<ErrorCode> results;
+        Message                request{Type::kNonConfirmable, Code::kGet};
+        REQUIRE(request.SetUriPath("/diag") == ErrorCode::kNone);
+
+        auto onResponse = [&](const Response *aResponse, Error aError) {
+            if (aResponse != nullptr)
+            {
+                REQUIRE(aError == ErrorCode::kNone);
+                REQUIRE(aResponse->GetCode() == Code::kContent);
+                responders.push_back(aResponse->GetEndpoint()->GetPeerAddr());
+            }
+            else
+            {
+                REQUIRE(Clock::now() - startTime == kTimeout);
+                results.push_back(aError.GetCode());
+            }
+        };
+
+        // Get a response of the multicast request from a node.
+        auto respond = [&](const Address &aNode) -> ByteArray {
+            client.SetPeer(aNode, kCoapPort);
+            server.SetPeer(aNode, kCoapPort);
+            server.Receive(client.mSentMessages.back());
+            return server.mSentMessages.back();
+        };
+
+        SECTION("responses of all nodes are collected until the timeout")
+        {
+            coap0.SendMulticastRequest(request, onResponse, kTimeout);
+            REQUIRE(client.mSentMessages.size() == 1);
+
+            ByteArray response0 = respond(kNode0);
+            ByteArray response1 = respond(kNode1);
+
+            client.SetPeer(kNode0, kCoapPort);
+            client.Receive(response0);
+            client.SetPeer(kNode1, kCoapPort);
+            client.Receive(response1);
+
+            // A retransmitted response is dropped.
+            client.Receive(response1);
+
+            // So is a second response from the same node.
+            client.Receive(respond(kNode0));
+
+            REQUIRE(responders == std::vector<Address>{kNode0, kNode1});
+            REQUIRE(coap0.GetPendingRequestsNum() == 1);
+
+            REQUIRE(loop.RunUntil([&]() { return !results.empty(); }, std::chrono::minutes(1)));
+            REQUIRE(results == std::vector<ErrorCode>{ErrorCode::kNone});
+            REQUIRE(coap0.GetPendingRequestsNum() == 0);
+
+            // A late response is not handled.
+            client.Receive(respond(kNode1));
+            REQUIRE(responders.size() == 2);
+        }
+
+        SECTION("the request times out if no node responds")
+        {
+            coap0.SendMulticastRequest(request, onResponse, kTimeout);
+
+            REQUIRE(loop.RunUntil([&]() { return !results.empty(); }, std::chrono::minutes(1)));
+            REQUIRE(results == std::vector<ErrorCode>{ErrorCode::kTimeout});
+            REQUIRE(responders.empty());
+        }
+
+        SECTION("a Confirmable multicast request is rejected")
+        {
+            Message confirmable{Type::kConfirmable, Code::kGet};
+            bool    rejected = false;
+
+            coap0.SendMulticastRequest(confirmable, [&](const Response *aResponse, Error aError) {
+                REQUIRE(aResponse == nullptr);
+                REQUIRE(aError == ErrorCode::kInvalidArgs);
+                rejected = true;
+            }, kTimeout);
+            REQUIRE(rejected);
+            REQUIRE(client.mSentMessages.empty());
+        }
+
+        REQUIRE(coap0.GetPendingRequestsNum() == 0);
+    }
+
+    event_base_free(eventBase);
+}
+
+TEST_CASE("coap-message-option-limit", "[coap]")
+{
+    Error     error;
+    ByteArray buf;
+    Message   message{Type::kConfirmable, Code::kPost};
+
+    SECTION("the max number of options is accepted")
+    {
+        std::string uriPath;
+        for (size_t i = 0; i < kMaxOptionNum; ++i)
+        {
+            uriPath += "/a";
+        }
+        REQUIRE(message.SetUriPath(uriPath) == ErrorCode::kNone);
+        REQUIRE(message.Serialize(buf) == ErrorCode::kNone);
+
+        REQUIRE(Message::Deserialize(error, buf) != nullptr);
+        REQUIRE(error == ErrorCode::kNone);
+    }
+
+    SECTION("too many options are rejected")
+    {
+        std::string uriPath;
+        for (size_t i = 0; i <= kMaxOptionNum; ++i)
+        {
+            uriPath += "/a";
+        }
+        REQUIRE(message.SetUriPath(uriPath) == ErrorCode::kNone);
+        REQUIRE(message.Serialize(buf) == ErrorCode::kNone);
+
+        REQUIRE(Message::Deserialize(error, buf) == nullptr);
+        REQUIRE(error == ErrorCode::kBadFormat);
+    }
+}
+
+TEST_CASE("coap-message-deserialize-bounded-options", "[coap]")
+{
+    static constexpr size_t kMaxDatagramSize = 1280;
+    static constexpr size_t kFuzzRounds      = 20000;
+
+    std::mt19937                       random{0x5EED};
+    std::uniform_int_distribution<int> byte{0, 0xFF};
+    std::vector<ByteArray>             seeds;
+
+    {
+        ByteArray seed;
+        Message   message{Type::kNonConfirmable, Code::kPost};
+        REQUIRE(message.SetUriPath("/c/ur") == ErrorCode::kNone);
+        REQUIRE(message.SetContentFormat(ContentFormat::kOctetStream) == ErrorCode::kNone);
+        message.Append(ByteArray(64, 0xAB));
+        REQUIRE(message.Serialize(seed) == ErrorCode::kNone);
+        seeds.push_back(seed);
+    }
+
+    {
+        // A Uri-Path option followed by empty options repeating it.
+        ByteArray seed{0x50, utils::to_underlying(Code::kPost), 0x00, 0x01, 0xB1, 'a'};
+        while (seed.size() < kMaxDatagramSize)
+        {
+            seed.push_back(0x01);
+            seed.push_back('a');
+        }
+        seeds.push_back(seed);
+    }
+
+    {
+        // Options of the max extended length.
+        ByteArray seed{0x50, utils::to_underlying(Code::kPost), 0x00, 0x01};
+        while (seed.size() < kMaxDatagramSize)
+        {
+            seed.push_back(0x3E);
+            seed.push_back(0xFF);
+            seed.push_back(0xFF);
+        }
+        seeds.push_back(seed);
+    }
+
+    for (size_t round = 0; round < kFuzzRounds; ++round)
+    {
+        ByteArray buf = seeds[round % seeds.size()];
+
+        // Mutate a few random bytes and occasionally truncate or extend the datagram.
+        for (int i = byte(random) % 8; i >= 0; --i)
+        {
+            buf[byte(random) * buf.size() / 0x100] = byte(random);
+        }
+        if (byte(random) < 0x20)
+        {
+            buf.resize(byte(random) * buf.size() / 0x100);
+        }
+        while (byte(random) < 0x20 && buf.size() < kMaxDatagramSize)
+        {
+            buf.push_back(byte(random));
+        }
+
+        Error  error;
+        size_t optionNum = 0;
+        auto   msg       = Message::Deserialize(error, buf, optionNum);
+
+        // The parser never visits more options than the limit, whatever the input.
+        REQUIRE(optionNum <= kMaxOptionNum);
+        REQUIRE((msg == nullptr || msg->GetOptionNum() <= optionNum));
+    }
+}
+
 // TODO(wgtdkp): test with multiple outstanding requests / pressure tests.
 
 // TODO(wgtdkp): add test cases to cover all CoAP APIs.
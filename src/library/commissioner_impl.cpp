@@ -35,7 +35,9 @@
 
 #include "library/coap.hpp"
 #include "library/cose.hpp"
+#include "library/dataset.hpp"
 #include "library/dtls.hpp"
+#include "library/link_probe.hpp"
 #include "library/logging.hpp"
 #include "library/openthread/bloom_filter.hpp"
 #include "library/openthread/pbkdf2_cmac.hpp"
@@ -53,6 +55,9 @@ static constexpr uint16_t kDefaultMmPort = 61631;
 static constexpr uint32_t kMinKeepAliveInterval = 30;
 static constexpr uint32_t kMaxKeepAliveInterval = 45;
 
+// The interval of sampling gauges into the metrics file.
+static constexpr uint32_t kMetricsSampleInterval = 1000;
+
 Error Commissioner::GeneratePSKc(ByteArray &        aPSKc,
                                  const std::string &aPassphrase,
                                  const std::string &aNetworkName,
@@ -141,30 +146,63 @@ exit:
 }
 
 CommissionerImpl::CommissionerImpl(CommissionerHandler &aHandler, struct event_base *aEventBase)
-    : mState(State::kDisabled)
+    : mSampledCpuTimes()
+    , mState(State::kDisabled)
     , mSessionId(0)
     , mCommissionerHandler(aHandler)
     , mEventBase(aEventBase)
-    , mKeepAliveTimer(mEventBase, [this](Timer &aTimer) { SendKeepAlive(aTimer); })
-    , mBrClient(mEventBase)
-    , mJoinerSessionTimer(mEventBase, [this](Timer &aTimer) { HandleJoinerSessionTimer(aTimer); })
+    , mKeepAliveTimer(mEventBase, [this](Timer &aTimer) { SendKeepAlive(aTimer); }, /* aIsSingle */ true, &mCpuAccount)
+    , mBrClient(mEventBase, /* aIsServer */ false, &mCpuAccount)
+    , mJoinerSessionTimer(
+          mEventBase, [this](Timer &aTimer) { HandleJoinerSessionTimer(aTimer); }, /* aIsSingle */ true, &mCpuAccount)
     , mResourceUdpRx(uri::kUdpRx, [this](const coap::Request &aRequest) { mProxyClient.HandleUdpRx(aRequest); })
     , mResourceRlyRx(uri::kRelayRx, [this](const coap::Request &aRequest) { HandleRlyRx(aRequest); })
-    , mProxyClient(mEventBase, mBrClient)
+    , mProxyClient(mEventBase, mBrClient, &mCpuAccount)
 #if OT_COMM_CONFIG_CCM_ENABLE
-    , mTokenManager(mEventBase)
+    , mTokenManager(mEventBase, &mCpuAccount)
 #endif
     , mResourceDatasetChanged(uri::kMgmtDatasetChanged,
                               [this](const coap::Request &aRequest) { HandleDatasetChanged(aRequest); })
     , mResourcePanIdConflict(uri::kMgmtPanidConflict,
                              [this](const coap::Request &aRequest) { HandlePanIdConflict(aRequest); })
     , mResourceEnergyReport(uri::kMgmtEdReport, [this](const coap::Request &aRequest) { HandleEnergyReport(aRequest); })
+    , mDatasetChangedDeferred(false)
+    , mOverloadController(mEventBase, &mCpuAccount)
+    , mMetricsTimer(mEventBase, [this](Timer &aTimer) { SampleMetrics(aTimer); }, /* aIsSingle */ true, &mCpuAccount)
+    , mAliveToken(std::make_shared<AliveToken>())
 {
+    mAliveToken->mCommissioner = this;
+
+    VerifyOrDie(event_assign(&mAsyncRequestEvent, mEventBase, -1, 0, HandleAsyncRequests, this) == 0);
+
     SuccessOrDie(mBrClient.AddResource(mResourceUdpRx));
     SuccessOrDie(mBrClient.AddResource(mResourceRlyRx));
     SuccessOrDie(mProxyClient.AddResource(mResourceDatasetChanged));
     SuccessOrDie(mProxyClient.AddResource(mResourcePanIdConflict));
     SuccessOrDie(mProxyClient.AddResource(mResourceEnergyReport));
+
+    mOverloadController.AddQueue([this]() {
+        return mBrClient.GetPendingRequestsNum() + mProxyClient.GetPendingRequestsNum() + mJoinerSessions.size();
+    });
+    mOverloadController.SetStateHandler([this](bool aOverloaded) { HandleOverloadStateChanged(aOverloaded); });
+
+    auto transactionObserver = [this](Duration aLatency, const Error &aResult) {
+        HandleTransaction(aLatency, aResult);
+    };
+    mBrClient.SetTransactionObserver(transactionObserver);
+    mProxyClient.SetTransactionObserver(transactionObserver);
+}
+
+CommissionerImpl::~CommissionerImpl()
+{
+    {
+        // Waits for a completion pushing a request right now.
+        std::lock_guard<std::mutex> _(mAliveToken->mMutex);
+
+        mAliveToken->mCommissioner = nullptr;
+    }
+
+    event_del(&mAsyncRequestEvent);
 }
 
 Error CommissionerImpl::Init(const Config &aConfig)
@@ -178,6 +216,8 @@ Error CommissionerImpl::Init(const Config &aConfig)
     LoggingConfig();
 
     SuccessOrExit(error = mBrClient.Init(GetDtlsConfig(mConfig)));
+    SuccessOrExit(error = mBrClient.SetImpairment(mConfig.mImpairment));
+    mBrClient.SetCompactExtendedTlv(mConfig.mEnableCompactExtendedTlv);
 
 #if OT_COMM_CONFIG_CCM_ENABLE
     if (IsCcmMode())
@@ -188,6 +228,17 @@ Error CommissionerImpl::Init(const Config &aConfig)
     }
 #endif
 
+    if (!mConfig.mMetricsFile.empty())
+    {
+        SuccessOrExit(error = mMetrics.Open(mConfig.mMetricsFile, mConfig.mId));
+        mMetricsTimer.Start(MilliSeconds(kMetricsSampleInterval));
+    }
+
+    if (!mConfig.mJournalFile.empty())
+    {
+        SuccessOrExit(error = mJournal.Open(mConfig.mJournalFile, mConfig.mId));
+    }
+
 exit:
     return error;
 }
@@ -208,6 +259,16 @@ Error CommissionerImpl::ValidateConfig(const Config &aConfig)
         error = ERROR_INVALID_ARGS("keep-alive internal {} exceeds range [{}, {}]", aConfig.mKeepAliveInterval,
                                    kMinKeepAliveInterval, kMaxKeepAliveInterval));
 
+    {
+        const auto &impairment = aConfig.mImpairment;
+
+        for (double rate : {impairment.mLossRate, impairment.mDuplicateRate, impairment.mReorderRate})
+        {
+            VerifyOrExit(rate >= 0 && rate <= 1,
+                         error = ERROR_INVALID_ARGS("impairment rate {} exceeds range [0.0, 1.0]", rate));
+        }
+    }
+
     if (aConfig.mEnableCcm)
     {
         tlv::Tlv domainNameTlv{tlv::Type::kDomainName, aConfig.mDomainName};
@@ -246,6 +307,19 @@ void CommissionerImpl::LoggingConfig()
     LOG_INFO(LOG_REGION_CONFIG, "keep alive interval = {}", mConfig.mKeepAliveInterval);
     LOG_INFO(LOG_REGION_CONFIG, "enable DTLS debug logging = {}", mConfig.mEnableDtlsDebugLogging);
     LOG_INFO(LOG_REGION_CONFIG, "maximum connection number = {}", mConfig.mMaxConnectionNum);
+    LOG_INFO(LOG_REGION_CONFIG, "overload thresholds: loop lag = {}ms, queue depth = {}", mConfig.mOverload.mMaxLoopLag,
+             mConfig.mOverload.mMaxQueueDepth);
+
+    if (mConfig.mImpairment.IsEnabled())
+    {
+        const auto &impairment = mConfig.mImpairment;
+
+        LOG_WARN(LOG_REGION_CONFIG,
+                 "network impairment enabled: seed={}, loss={}, duplicate={}, reorder={}, delay={}ms, jitter={}ms, "
+                 "reorderDelay={}ms, rateLimit={}B/s",
+                 impairment.mSeed, impairment.mLossRate, impairment.mDuplicateRate, impairment.mReorderRate,
+                 impairment.mDelay, impairment.mDelayJitter, impairment.mReorderDelay, impairment.mRateLimit);
+    }
 
     // Do not logging credentials
 }
@@ -276,6 +350,8 @@ void CommissionerImpl::Petition(PetitionHandler aHandler, const std::string &aAd
 
     LOG_DEBUG(LOG_REGION_MESHCOP, "starting petition: border agent = ({}, {})", aAddr, aPort);
 
+    // The petition is sent in the same event loop turn the DTLS handshake completes.
+    mPetitionStartTime = Clock::now();
     if (mBrClient.IsConnected())
     {
         SendPetition(aHandler);
@@ -319,6 +395,9 @@ void CommissionerImpl::Disconnect()
 {
     mBrClient.Disconnect(ERROR_CANCELLED("the CoAPs client was disconnected"));
     mState = State::kDisabled;
+
+    mDatasetChangedDeferred = false;
+    mOverloadController.Stop();
 }
 
 uint16_t CommissionerImpl::GetSessionId() const
@@ -1028,6 +1107,92 @@ exit:
     }
 }
 
+Error CommissionerImpl::BindUdpProxyPort(uint16_t aLocalPort, UdpReceiveHandler aHandler)
+{
+    Error error;
+
+    auto onReceive = [aHandler](const Address &aPeerAddr, uint16_t aPeerPort, const uint8_t *aData, size_t aLength) {
+        aHandler(aPeerAddr.ToString(), aPeerPort, aData, aLength);
+    };
+    std::unique_ptr<ProxySocket> socket{new ProxySocket(mProxyClient, onReceive)};
+
+    VerifyOrExit(aHandler != nullptr, error = ERROR_INVALID_ARGS("the UDP receive handler is null"));
+    SuccessOrExit(error = socket->Bind(aLocalPort));
+    mProxySockets[aLocalPort] = std::move(socket);
+
+exit:
+    return error;
+}
+
+void CommissionerImpl::UnbindUdpProxyPort(uint16_t aLocalPort)
+{
+    mProxySockets.erase(aLocalPort);
+}
+
+void CommissionerImpl::SendUdpProxy(ErrorHandler       aHandler,
+                                    uint16_t           aLocalPort,
+                                    const std::string &aDstAddr,
+                                    uint16_t           aDstPort,
+                                    const ByteArray &  aData)
+{
+    Error   error;
+    Address dstAddr;
+    auto    socket = mProxySockets.find(aLocalPort);
+
+    VerifyOrExit(IsActive(), error = ERROR_INVALID_STATE("the commissioner is not active"));
+    VerifyOrExit(socket != mProxySockets.end(), error = ERROR_NOT_FOUND("UDP proxy port {} is not bound", aLocalPort));
+    SuccessOrExit(error = dstAddr.Set(aDstAddr));
+    SuccessOrExit(error = socket->second->SendTo(aData, dstAddr, aDstPort, aHandler));
+
+exit:
+    if (error != ErrorCode::kNone)
+    {
+        aHandler(error);
+    }
+}
+
+void CommissionerImpl::ProbeLink(Handler<LinkProbeResult> aHandler,
+                                 const std::string &      aDstAddr,
+                                 uint16_t                 aCount,
+                                 uint16_t                 aWindow)
+{
+    Error             error;
+    Address           dstAddr;
+    LinkProbe::Pinger pinger;
+
+    VerifyOrExit(aCount > 0 && aWindow > 0, error = ERROR_INVALID_ARGS("probe count and window must be positive"));
+    VerifyOrExit(mBrClient.IsConnected(), error = ERROR_INVALID_STATE("not connected to the border agent"));
+
+    if (aDstAddr.empty())
+    {
+        pinger = [this](coap::ResponseHandler aPongHandler) { mBrClient.SendPing(aPongHandler); };
+    }
+    else
+    {
+        SuccessOrExit(error = dstAddr.Set(aDstAddr));
+        VerifyOrExit(dstAddr.IsIpv6() && !dstAddr.IsMulticast(),
+                     error = ERROR_INVALID_ARGS("{} is not a valid IPv6 unicast address", aDstAddr));
+        VerifyOrExit(IsActive(), error = ERROR_INVALID_STATE("the commissioner is not active"));
+
+        pinger = [this, dstAddr](coap::ResponseHandler aPongHandler) {
+            mProxyClient.SendPing(aPongHandler, dstAddr, kDefaultMmPort);
+        };
+    }
+
+    // Answers from both the border agent and mesh nodes arrive on the border agent socket.
+    std::make_shared<LinkProbe>(
+        pinger, [this]() { return mBrClient.GetLastRecvTime(); }, aCount, aWindow, aHandler)
+        ->Start();
+
+    LOG_DEBUG(LOG_REGION_MGMT, "started link probe: dstAddr={}, count={}, window={}", aDstAddr, aCount, aWindow);
+
+exit:
+    if (error != ErrorCode::kNone)
+    {
+        aHandler(nullptr, error);
+    }
+}
+
 void CommissionerImpl::AnnounceBegin(ErrorHandler       aHandler,
                                      uint32_t           aChannelMask,
                                      uint8_t            aCount,
@@ -1229,6 +1394,9 @@ void CommissionerImpl::SendPetition(PetitionHandler aHandler)
         mSessionId = sessionIdTlv->GetValueAsUint16();
         mState     = State::kActive;
         mKeepAliveTimer.Start(GetKeepAliveInterval());
+        mOverloadController.Start(mConfig.mOverload);
+        mMetrics.Observe(metrics::Histogram::kTimeToActive,
+                         std::chrono::duration_cast<MilliSeconds>(Clock::now() - mPetitionStartTime).count());
 
         LOG_INFO(LOG_REGION_MESHCOP, "petition succeed, start keep-alive timer with {} seconds",
                  GetKeepAliveInterval().count() / 1000);
@@ -1257,6 +1425,7 @@ void CommissionerImpl::SendPetition(PetitionHandler aHandler)
     mState = State::kPetitioning;
 
     mBrClient.SendRequest(request, onResponse);
+    mMetrics.Increase(metrics::Counter::kPetitions);
 
     LOG_DEBUG(LOG_REGION_MESHCOP, "sent petition request");
 
@@ -1285,10 +1454,13 @@ void CommissionerImpl::SendKeepAlive(Timer &, bool aKeepAlive)
         {
             mState = State::kDisabled;
             Resign([](Error) {});
+            mMetrics.Increase(metrics::Counter::kKeepAliveFailures);
 
             LOG_WARN(LOG_REGION_MESHCOP, "keep alive message rejected: {}", error.ToString());
         }
 
+        CpuScope cpuScope(&mCpuAccount, CpuCategory::kHandler);
+
         mCommissionerHandler.OnKeepAliveResponse(error);
     };
 
@@ -1309,6 +1481,7 @@ void CommissionerImpl::SendKeepAlive(Timer &, bool aKeepAlive)
     mKeepAliveTimer.Start(GetKeepAliveInterval());
 
     mBrClient.SendRequest(request, onResponse);
+    mMetrics.Increase(metrics::Counter::kKeepAlives);
 
     LOG_DEBUG(LOG_REGION_MESHCOP, "sent keep alive message: keepAlive={}", aKeepAlive);
 
@@ -1338,7 +1511,7 @@ exit:
 }
 #endif // OT_COMM_CONFIG_CCM_ENABLE
 
-Error AppendTlv(coap::Message &aMessage, const tlv::Tlv &aTlv)
+Error AppendTlv(coap::Message &aMessage, const tlv::Tlv &aTlv, bool aCompactExtendedTlv)
 {
     Error     error;
     ByteArray buf;
@@ -1346,7 +1519,7 @@ Error AppendTlv(coap::Message &aMessage, const tlv::Tlv &aTlv)
     VerifyOrExit(aTlv.IsValid(),
                  error = ERROR_INVALID_ARGS("the tlv(type={}) is in bad format", utils::to_underlying(aTlv.GetType())));
 
-    aTlv.Serialize(buf);
+    aTlv.Serialize(buf, aCompactExtendedTlv);
     aMessage.Append(buf);
 
 exit:
@@ -1451,89 +1624,6 @@ ByteArray CommissionerImpl::GetPendingOperationalDatasetTlvs(uint16_t aDatasetFl
     return tlvTypes;
 }
 
-Error CommissionerImpl::DecodeActiveOperationalDataset(ActiveOperationalDataset &aDataset, const ByteArray &aPayload)
-{
-    Error                    error;
-    tlv::TlvSet              tlvSet;
-    ActiveOperationalDataset dataset;
-
-    // Clear all data fields
-    dataset.mPresentFlags = 0;
-
-    SuccessOrExit(error = tlv::GetTlvSet(tlvSet, aPayload));
-
-    if (auto activeTimeStamp = tlvSet[tlv::Type::kActiveTimestamp])
-    {
-        uint64_t value;
-        value                    = utils::Decode<uint64_t>(activeTimeStamp->GetValue());
-        dataset.mActiveTimestamp = Timestamp::Decode(value);
-        dataset.mPresentFlags |= ActiveOperationalDataset::kActiveTimestampBit;
-    }
-
-    if (auto channel = tlvSet[tlv::Type::kChannel])
-    {
-        const ByteArray &value   = channel->GetValue();
-        dataset.mChannel.mPage   = value[0];
-        dataset.mChannel.mNumber = utils::Decode<uint16_t>(value.data() + 1, value.size() - 1);
-        dataset.mPresentFlags |= ActiveOperationalDataset::kChannelBit;
-    }
-
-    if (auto channelMask = tlvSet[tlv::Type::kChannelMask])
-    {
-        SuccessOrExit(DecodeChannelMask(dataset.mChannelMask, channelMask->GetValue()));
-        dataset.mPresentFlags |= ActiveOperationalDataset::kChannelMaskBit;
-    }
-
-    if (auto extendedPanId = tlvSet[tlv::Type::kExtendedPanId])
-    {
-        dataset.mExtendedPanId = extendedPanId->GetValue();
-        dataset.mPresentFlags |= ActiveOperationalDataset::kExtendedPanIdBit;
-    }
-
-    if (auto meshLocalPrefix = tlvSet[tlv::Type::kNetworkMeshLocalPrefix])
-    {
-        dataset.mMeshLocalPrefix = meshLocalPrefix->GetValue();
-        dataset.mPresentFlags |= ActiveOperationalDataset::kMeshLocalPrefixBit;
-    }
-
-    if (auto networkMasterKey = tlvSet[tlv::Type::kNetworkMasterKey])
-    {
-        dataset.mNetworkMasterKey = networkMasterKey->GetValue();
-        dataset.mPresentFlags |= ActiveOperationalDataset::kNetworkMasterKeyBit;
-    }
-
-    if (auto networkName = tlvSet[tlv::Type::kNetworkName])
-    {
-        dataset.mNetworkName = networkName->GetValueAsString();
-        dataset.mPresentFlags |= ActiveOperationalDataset::kNetworkNameBit;
-    }
-
-    if (auto panId = tlvSet[tlv::Type::kPanId])
-    {
-        dataset.mPanId = utils::Decode<uint16_t>(panId->GetValue());
-        dataset.mPresentFlags |= ActiveOperationalDataset::kPanIdBit;
-    }
-
-    if (auto pskc = tlvSet[tlv::Type::kPSKc])
-    {
-        dataset.mPSKc = pskc->GetValue();
-        dataset.mPresentFlags |= ActiveOperationalDataset::kPSKcBit;
-    }
-
-    if (auto securityPolicy = tlvSet[tlv::Type::kSecurityPolicy])
-    {
-        auto &value                           = securityPolicy->GetValue();
-        dataset.mSecurityPolicy.mRotationTime = utils::Decode<uint16_t>(value);
-        dataset.mSecurityPolicy.mFlags        = {value.begin() + sizeof(uint16_t), value.end()};
-        dataset.mPresentFlags |= ActiveOperationalDataset::kSecurityPolicyBit;
-    }
-
-    aDataset = dataset;
-
-exit:
-    return error;
-}
-
 Error CommissionerImpl::DecodePendingOperationalDataset(PendingOperationalDataset &aDataset,
                                                         const coap::Response &     aResponse)
 {
@@ -1567,37 +1657,6 @@ exit:
     return error;
 }
 
-Error CommissionerImpl::DecodeChannelMask(ChannelMask &aChannelMask, const ByteArray &aBuf)
-{
-    Error       error;
-    ChannelMask channelMask;
-    size_t      offset = 0;
-    size_t      length = aBuf.size();
-
-    while (offset < length)
-    {
-        ChannelMaskEntry entry;
-        uint8_t          entryLength;
-        VerifyOrExit(offset + 2 <= length, error = ERROR_BAD_FORMAT("premature end of Channel Mask Entry"));
-
-        entry.mPage = aBuf[offset++];
-        entryLength = aBuf[offset++];
-
-        VerifyOrExit(offset + entryLength <= length, error = ERROR_BAD_FORMAT("premature end of Channel Mask Entry"));
-        entry.mMasks = {aBuf.begin() + offset, aBuf.begin() + offset + entryLength};
-        channelMask.emplace_back(entry);
-
-        offset += entryLength;
-    }
-
-    ASSERT(offset == length);
-
-    aChannelMask = channelMask;
-
-exit:
-    return error;
-}
-
 Error CommissionerImpl::EncodeActiveOperationalDataset(coap::Request &                 aRequest,
                                                        const ActiveOperationalDataset &aDataset)
 {
@@ -1982,8 +2041,19 @@ void CommissionerImpl::HandleDatasetChanged(const coap::Request &aRequest)
              aRequest.GetEndpoint()->GetPeerAddr().ToString());
 
     mProxyClient.SendEmptyChanged(aRequest);
+    mMetrics.Increase(metrics::Counter::kDatasetChanges);
 
-    mCommissionerHandler.OnDatasetChanged();
+    if (mOverloadController.ShouldShed(OverloadController::Work::kNotification))
+    {
+        // Reported once after recovering from overload.
+        mDatasetChangedDeferred = true;
+    }
+    else
+    {
+        CpuScope cpuScope(&mCpuAccount, CpuCategory::kHandler);
+
+        mCommissionerHandler.OnDatasetChanged();
+    }
 }
 
 void CommissionerImpl::HandlePanIdConflict(const coap::Request &aRequest)
@@ -1999,6 +2069,7 @@ void CommissionerImpl::HandlePanIdConflict(const coap::Request &aRequest)
     LOG_INFO(LOG_REGION_MGMT, "received MGMT_PANID_CONFLICT.ans from {}", peerAddr);
 
     mProxyClient.SendEmptyChanged(aRequest);
+    mMetrics.Increase(metrics::Counter::kPanIdConflicts);
 
     SuccessOrExit(error = GetTlvSet(tlvSet, aRequest));
     VerifyOrExit((channelMaskTlv = tlvSet[tlv::Type::kChannelMask]) != nullptr,
@@ -2009,7 +2080,11 @@ void CommissionerImpl::HandlePanIdConflict(const coap::Request &aRequest)
     SuccessOrExit(error = DecodeChannelMask(channelMask, channelMaskTlv->GetValue()));
     panId = panIdTlv->GetValueAsUint16();
 
-    mCommissionerHandler.OnPanIdConflict(peerAddr, channelMask, panId);
+    {
+        CpuScope cpuScope(&mCpuAccount, CpuCategory::kHandler);
+
+        mCommissionerHandler.OnPanIdConflict(peerAddr, channelMask, panId);
+    }
 
 exit:
     if (error != ErrorCode::kNone)
@@ -2029,6 +2104,9 @@ void CommissionerImpl::HandleEnergyReport(const coap::Request &aRequest)
     LOG_INFO(LOG_REGION_MGMT, "received MGMT_ED_REPORT.ans from {}", peerAddr);
 
     mProxyClient.SendEmptyChanged(aRequest);
+    mMetrics.Increase(metrics::Counter::kEnergyReports);
+
+    VerifyOrExit(!mOverloadController.ShouldShed(OverloadController::Work::kEnergyReport));
 
     SuccessOrExit(error = GetTlvSet(tlvSet, aRequest));
     if (auto channelMaskTlv = tlvSet[tlv::Type::kChannelMask])
@@ -2040,7 +2118,11 @@ void CommissionerImpl::HandleEnergyReport(const coap::Request &aRequest)
         energyList = eneryListTlv->GetValue();
     }
 
-    mCommissionerHandler.OnEnergyReport(peerAddr, channelMask, energyList);
+    {
+        CpuScope cpuScope(&mCpuAccount, CpuCategory::kHandler);
+
+        mCommissionerHandler.OnEnergyReport(peerAddr, channelMask, energyList);
+    }
 
 exit:
     if (error != ErrorCode::kNone)
@@ -2113,8 +2195,21 @@ void CommissionerImpl::HandleRlyRx(const coap::Request &aRlyRx)
     joinerId[0] ^= kLocalExternalAddrMask;
     LOG_DEBUG(LOG_REGION_JOINER_SESSION, "received RLY_RX.ntf: joinerID={}, joinerRouterLocator={}, length={}",
               utils::Hex(joinerId), joinerRouterLocator, dtlsRecords.size());
+    mMetrics.Increase(metrics::Counter::kJoinerRequests);
 
-    joinerPSKd = mCommissionerHandler.OnJoinerRequest(joinerId);
+    // Joiner sessions in progress are served, but new joiners are not admitted.
+    if (mJoinerSessions.count(joinerId) == 0 &&
+        mOverloadController.ShouldShed(OverloadController::Work::kJoinerAdmission))
+    {
+        mMetrics.Increase(metrics::Counter::kJoinersShed);
+        ExitNow();
+    }
+
+    {
+        CpuScope cpuScope(&mCpuAccount, CpuCategory::kHandler);
+
+        joinerPSKd = mCommissionerHandler.OnJoinerRequest(joinerId);
+    }
     if (joinerPSKd.empty())
     {
         LOG_INFO(LOG_REGION_JOINER_SESSION, "joiner(ID={}) is disabled", utils::Hex(joinerId));
@@ -2125,6 +2220,7 @@ void CommissionerImpl::HandleRlyRx(const coap::Request &aRlyRx)
         auto it = mJoinerSessions.find(joinerId);
         if (it != mJoinerSessions.end() && it->second.Disabled())
         {
+            ObserveJoinerSessionEnd(it->second);
             mJoinerSessions.erase(it);
             it = mJoinerSessions.end();
         }
@@ -2148,11 +2244,13 @@ void CommissionerImpl::HandleRlyRx(const coap::Request &aRlyRx)
             LOG_DEBUG(LOG_REGION_JOINER_SESSION, "received a new joiner(ID={}) DTLS connection from [{}]:{}",
                       utils::Hex(joinerId), peerAddr, session.GetPeerPort());
 
+            mJournal.Append(journal::Event::kSessionCreated, joinerId, joinerRouterLocator);
             session.Connect();
+            mMetrics.Increase(metrics::Counter::kJoinerSessions);
 
-            LOG_INFO(LOG_REGION_JOINER_SESSION, "joiner session timer started, expiration-time={}",
+            LOG_INFO(LOG_REGION_JOINER_SESSION, "joiner session started, expiration-time={}",
                      TimePointToString(session.GetExpirationTime()));
-            mJoinerSessionTimer.Start(session.GetExpirationTime());
+            ScheduleJoinerSessionTimer(session.GetExpirationTime());
         }
 
         ASSERT(it != mJoinerSessions.end());
@@ -2167,6 +2265,67 @@ exit:
     }
 }
 
+void CommissionerImpl::HandleOverloadStateChanged(bool aOverloaded)
+{
+    if (!aOverloaded && mDatasetChangedDeferred)
+    {
+        mDatasetChangedDeferred = false;
+        CpuScope cpuScope(&mCpuAccount, CpuCategory::kHandler);
+
+        mCommissionerHandler.OnDatasetChanged();
+    }
+}
+
+void CommissionerImpl::HandleTransaction(Duration aLatency, const Error &aResult)
+{
+    mMetrics.Increase(metrics::Counter::kRequests);
+    mMetrics.Observe(metrics::Histogram::kRequestLatency, aLatency.count());
+
+    if (aResult == ErrorCode::kTimeout)
+    {
+        mMetrics.Increase(metrics::Counter::kRequestTimeouts);
+    }
+    else if (aResult != ErrorCode::kNone)
+    {
+        mMetrics.Increase(metrics::Counter::kRequestFailures);
+    }
+}
+
+void CommissionerImpl::SampleMetrics(Timer &aTimer)
+{
+    const OverloadMetrics &overloadMetrics = mOverloadController.GetMetrics();
+
+    mMetrics.Set(metrics::Gauge::kState, static_cast<int64_t>(mState));
+    mMetrics.Set(metrics::Gauge::kPendingRequests,
+                 mBrClient.GetPendingRequestsNum() + mProxyClient.GetPendingRequestsNum());
+    mMetrics.Set(metrics::Gauge::kJoinerSessions, mJoinerSessions.size());
+    mMetrics.Set(metrics::Gauge::kLoopLag, overloadMetrics.mLoopLag);
+    mMetrics.Set(metrics::Gauge::kOverloaded, overloadMetrics.mOverloaded);
+
+    for (size_t i = 0; i < kCpuCategoryNum; ++i)
+    {
+        static const metrics::Counter kCpuTimeCounters[kCpuCategoryNum] = {
+            metrics::Counter::kSocketCpuTime,  metrics::Counter::kJoinerCpuTime,  metrics::Counter::kTimerCpuTime,
+            metrics::Counter::kRequestCpuTime, metrics::Counter::kHandlerCpuTime,
+        };
+
+        uint64_t cpuTime = mCpuAccount.GetTime(static_cast<CpuCategory>(i));
+
+        mMetrics.Increase(kCpuTimeCounters[i], cpuTime - mSampledCpuTimes[i]);
+        mSampledCpuTimes[i] = cpuTime;
+    }
+
+    aTimer.Start(MilliSeconds(kMetricsSampleInterval));
+}
+
+void CommissionerImpl::ObserveJoinerSessionEnd(const JoinerSession &aSession)
+{
+    auto duration = std::chrono::duration_cast<MilliSeconds>(Clock::now() - aSession.GetCreationTime());
+
+    mMetrics.Observe(metrics::Histogram::kJoinerSessionDuration, duration.count());
+    mJournal.Append(journal::Event::kSessionRemoved, aSession.GetJoinerId(), static_cast<int32_t>(duration.count()));
+}
+
 void CommissionerImpl::HandleJoinerSessionTimer(Timer &aTimer)
 {
     TimePoint nextShot;
@@ -2182,10 +2341,11 @@ void CommissionerImpl::HandleJoinerSessionTimer(Timer &aTimer)
 
         if (now >= session.GetExpirationTime())
         {
-            it = mJoinerSessions.erase(it);
-
             LOG_INFO(LOG_REGION_JOINER_SESSION, "joiner session (joiner ID={}) removed",
                      utils::Hex(session.GetJoinerId()));
+
+            ObserveJoinerSessionEnd(session);
+            it = mJoinerSessions.erase(it);
         }
         else
         {
@@ -2205,6 +2365,88 @@ void CommissionerImpl::HandleJoinerSessionTimer(Timer &aTimer)
     }
 }
 
+void CommissionerImpl::ScheduleJoinerSessionTimer(const TimePoint &aExpirationTime)
+{
+    // Never postpone the removal of sessions that expire earlier.
+    if (!mJoinerSessionTimer.IsRunning() || aExpirationTime < mJoinerSessionTimer.GetFireTime())
+    {
+        mJoinerSessionTimer.Start(aExpirationTime);
+    }
+}
+
+void CommissionerImpl::CompleteJoinerFinalize(const ByteArray &aJoinerId, const ByteArray &aToken, bool aAccepted)
+{
+    auto it = mJoinerSessions.find(aJoinerId);
+
+    if (it == mJoinerSessions.end())
+    {
+        LOG_INFO(LOG_REGION_JOINER_SESSION, "joiner(ID={}) is finalized after its session was removed",
+                 utils::Hex(aJoinerId));
+        ExitNow();
+    }
+
+    it->second.CompleteJoinFin(aToken, aAccepted);
+
+exit:
+    return;
+}
+
+JoinerFinalizeCompletion CommissionerImpl::MakeJoinerFinalizeCompletion(const ByteArray &aJoinerId,
+                                                                        const ByteArray &aToken)
+{
+    std::shared_ptr<AliveToken> aliveToken = mAliveToken;
+
+    // The decision is always handled in a later turn of the event
+    // loop, the user may complete it right away or from another thread.
+    return [aliveToken, aJoinerId, aToken](bool aAccepted) {
+        std::lock_guard<std::mutex> _(aliveToken->mMutex);
+        CommissionerImpl *          commImpl = aliveToken->mCommissioner;
+
+        VerifyOrExit(commImpl != nullptr);
+        commImpl->PushAsyncRequest([commImpl, aJoinerId, aToken, aAccepted]() {
+            commImpl->CompleteJoinerFinalize(aJoinerId, aToken, aAccepted);
+        });
+
+    exit:
+        return;
+    };
+}
+
+void CommissionerImpl::PushAsyncRequest(AsyncRequest &&aAsyncRequest)
+{
+    std::lock_guard<std::mutex> _(mAsyncRequestMutex);
+
+    mAsyncRequestQueue.emplace(std::move(aAsyncRequest));
+    event_active(&mAsyncRequestEvent, 0, 0);
+}
+
+void CommissionerImpl::HandleAsyncRequests(evutil_socket_t, short, void *aContext)
+{
+    auto commissioner = reinterpret_cast<CommissionerImpl *>(aContext);
+
+    VerifyOrDie(commissioner != nullptr);
+
+    // Requests pushed before the event is handled are coalesced
+    // into a single activation, drain all of them.
+    while (auto asyncRequest = commissioner->PopAsyncRequest())
+    {
+        asyncRequest();
+    }
+}
+
+CommissionerImpl::AsyncRequest CommissionerImpl::PopAsyncRequest()
+{
+    std::lock_guard<std::mutex> _(mAsyncRequestMutex);
+
+    if (!mAsyncRequestQueue.empty())
+    {
+        auto ret = std::move(mAsyncRequestQueue.front());
+        mAsyncRequestQueue.pop();
+        return ret;
+    }
+    return nullptr;
+}
+
 } // namespace commissioner
 
 } // namespace ot
@@ -30,15 +30,22 @@
 #define OT_COMM_LIBRARY_COMMISSIONER_IMPL_HPP_
 
 #include <atomic>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <queue>
 
 #include <commissioner/commissioner.hpp>
 
 #include "library/coap.hpp"
 #include "library/coap_secure.hpp"
+#include "library/cpu_account.hpp"
 #include "library/dtls.hpp"
 #include "library/event.hpp"
 #include "library/joiner_session.hpp"
+#include "library/journal.hpp"
+#include "library/metrics.hpp"
+#include "library/overload_controller.hpp"
 #include "library/timer.hpp"
 #include "library/tlv.hpp"
 #include "library/token_manager.hpp"
@@ -75,7 +82,7 @@ public:
 
     Error Init(const Config &aConfig) override;
 
-    ~CommissionerImpl() override = default;
+    ~CommissionerImpl() override;
 
     const Config &GetConfig() const override;
 
@@ -89,6 +96,14 @@ public:
 
     const std::string &GetDomainName() const override;
 
+    OverloadMetrics GetOverloadMetrics() const override { return mOverloadController.GetMetrics(); }
+
+    OverloadController &GetOverloadController() { return mOverloadController; }
+
+    CpuUsage GetCpuUsage() const override { return mCpuAccount.GetUsage(); }
+
+    CpuAccount &GetCpuAccount() { return mCpuAccount; }
+
     void CancelRequests() override;
 
     void  Connect(ErrorHandler aHandler, const std::string &aAddr, uint16_t aPort) override;
@@ -189,8 +204,35 @@ public:
 
     Error SetToken(const ByteArray &aSignedToken, const ByteArray &aSignerCert) override;
 
+    void  ProbeLink(Handler<LinkProbeResult> aHandler,
+                    const std::string &      aDstAddr,
+                    uint16_t                 aCount,
+                    uint16_t                 aWindow) override;
+    Error ProbeLink(LinkProbeResult &, const std::string &, uint16_t, uint16_t) override
+    {
+        return ERROR_UNIMPLEMENTED("");
+    }
+
+    Error BindUdpProxyPort(uint16_t aLocalPort, UdpReceiveHandler aHandler) override;
+    void  UnbindUdpProxyPort(uint16_t aLocalPort) override;
+
+    void  SendUdpProxy(ErrorHandler       aHandler,
+                       uint16_t           aLocalPort,
+                       const std::string &aDstAddr,
+                       uint16_t           aDstPort,
+                       const ByteArray &  aData) override;
+    Error SendUdpProxy(uint16_t, const std::string &, uint16_t, const ByteArray &) override
+    {
+        return ERROR_UNIMPLEMENTED("");
+    }
+
     struct event_base *GetEventBase() { return mEventBase; }
 
+    // Returns the completion of the JOIN_FIN.req @p aToken of joiner @p aJoinerId.
+    // It can be called from any thread, and does nothing once the commissioner
+    // has been destroyed.
+    JoinerFinalizeCompletion MakeJoinerFinalizeCompletion(const ByteArray &aJoinerId, const ByteArray &aToken);
+
 private:
     using AsyncRequest = std::function<void()>;
 
@@ -202,9 +244,7 @@ private:
     static ByteArray GetActiveOperationalDatasetTlvs(uint16_t aDatasetFlags);
     static ByteArray GetPendingOperationalDatasetTlvs(uint16_t aDatasetFlags);
 
-    static Error DecodeActiveOperationalDataset(ActiveOperationalDataset &aDataset, const ByteArray &aPayload);
     static Error DecodePendingOperationalDataset(PendingOperationalDataset &aDataset, const coap::Response &aResponse);
-    static Error DecodeChannelMask(ChannelMask &aChannelMask, const ByteArray &aBuf);
     static Error EncodeActiveOperationalDataset(coap::Request &aRequest, const ActiveOperationalDataset &aDataset);
     static Error EncodePendingOperationalDataset(coap::Request &aRequest, const PendingOperationalDataset &aDataset);
     static Error EncodeChannelMask(ByteArray &aBuf, const ChannelMask &aChannelMask);
@@ -241,10 +281,31 @@ private:
     void HandleRlyRx(const coap::Request &aRequest);
 
     void HandleJoinerSessionTimer(Timer &aTimer);
+    void ScheduleJoinerSessionTimer(const TimePoint &aExpirationTime);
+    void CompleteJoinerFinalize(const ByteArray &aJoinerId, const ByteArray &aToken, bool aAccepted);
+
+    // Runs the request in the event loop, can be called from any thread.
+    void         PushAsyncRequest(AsyncRequest &&aAsyncRequest);
+    AsyncRequest PopAsyncRequest();
+    static void  HandleAsyncRequests(evutil_socket_t aFd, short aFlags, void *aContext);
+
+    void HandleOverloadStateChanged(bool aOverloaded);
+
+    void HandleTransaction(Duration aLatency, const Error &aResult);
+    void SampleMetrics(Timer &aTimer);
+    void ObserveJoinerSessionEnd(const JoinerSession &aSession);
 
 private:
-    State    mState;
-    uint16_t mSessionId; ///< The Commissioner Session ID.
+    // Declared first because it is given to the timers and sockets of the
+    // other members, which charge their CPU time to it.
+    CpuAccount mCpuAccount;
+
+    // The CPU times last written to the metrics, in microseconds.
+    uint64_t mSampledCpuTimes[kCpuCategoryNum];
+
+    State     mState;
+    uint16_t  mSessionId;         ///< The Commissioner Session ID.
+    TimePoint mPetitionStartTime; ///< When the petition started, before connecting to the border agent.
 
 private:
     /*
@@ -268,6 +329,9 @@ private:
 
     ProxyClient mProxyClient;
 
+    // Destroyed before the proxy client.
+    std::map<uint16_t, std::unique_ptr<ProxySocket>> mProxySockets;
+
 #if OT_COMM_CONFIG_CCM_ENABLE
     TokenManager mTokenManager;
 #endif
@@ -275,12 +339,37 @@ private:
     coap::Resource mResourceDatasetChanged;
     coap::Resource mResourcePanIdConflict;
     coap::Resource mResourceEnergyReport;
+
+    // Notifications coalesced while overloaded.
+    bool mDatasetChangedDeferred;
+
+    OverloadController mOverloadController;
+
+    metrics::Metrics mMetrics;
+    Timer            mMetricsTimer;
+
+    journal::Journal mJournal;
+
+    // Requests pushed by PushAsyncRequest(), the event
+    // is activated to run them in the event loop.
+    struct event             mAsyncRequestEvent;
+    std::mutex               mAsyncRequestMutex;
+    std::queue<AsyncRequest> mAsyncRequestQueue;
+
+    // Shared with the completions handed out to the user, which may outlive
+    // the commissioner. The commissioner is reset on destruction.
+    struct AliveToken
+    {
+        std::mutex        mMutex;
+        CommissionerImpl *mCommissioner;
+    };
+    std::shared_ptr<AliveToken> mAliveToken;
 };
 
 /*
  * CoAP message and tlv related utilities
  */
-Error       AppendTlv(coap::Message &aMessage, const tlv::Tlv &aTlv);
+Error       AppendTlv(coap::Message &aMessage, const tlv::Tlv &aTlv, bool aCompactExtendedTlv = false);
 Error       GetTlvSet(tlv::TlvSet &aTlvSet, const coap::Message &aMessage, tlv::Scope aScope = tlv::Scope::kMeshCoP);
 tlv::TlvPtr GetTlv(tlv::Type aTlvType, const coap::Message &aMessage, tlv::Scope aScope = tlv::Scope::kMeshCoP);
 
@@ -40,6 +40,7 @@
 #include <catch2/catch.hpp>
 
 #include "common/utils.hpp"
+#include "library/uri.hpp"
 
 namespace ot {
 
@@ -123,6 +124,126 @@ TEST_CASE("pskc-test-invalid-args", "[pskc]")
     }
 }
 
+TEST_CASE("lazy-active-dataset", "[dataset]")
+{
+    const ByteArray kExtendedPanId{0xDE, 0xAD, 0x00, 0xBE, 0xEF, 0x00, 0xCA, 0xFE};
+
+    ByteArray rawDataset;
+    tlv::Tlv{tlv::Type::kActiveTimestamp, uint64_t{0x10000}}.Serialize(rawDataset);
+    tlv::Tlv{tlv::Type::kChannel, ByteArray{0x00, 0x00, 0x13}}.Serialize(rawDataset);
+    tlv::Tlv{tlv::Type::kExtendedPanId, kExtendedPanId}.Serialize(rawDataset);
+    tlv::Tlv{tlv::Type::kNetworkName, std::string{"OpenThread"}}.Serialize(rawDataset);
+    tlv::Tlv{tlv::Type::kPanId, uint16_t{0xFACE}}.Serialize(rawDataset);
+
+    LazyActiveDataset dataset{rawDataset};
+
+    SECTION("fields are decoded on demand")
+    {
+        Timestamp   activeTimestamp;
+        Channel     channel;
+        std::string networkName;
+        uint16_t    panId;
+
+        REQUIRE(dataset.GetActiveTimestamp(activeTimestamp) == ErrorCode::kNone);
+        REQUIRE(activeTimestamp.mSeconds == 1);
+        REQUIRE(dataset.GetChannel(channel) == ErrorCode::kNone);
+        REQUIRE(channel.mPage == 0);
+        REQUIRE(channel.mNumber == 19);
+        REQUIRE(dataset.GetNetworkName(networkName) == ErrorCode::kNone);
+        REQUIRE(networkName == "OpenThread");
+        REQUIRE(dataset.GetPanId(panId) == ErrorCode::kNone);
+        REQUIRE(panId == 0xFACE);
+    }
+
+    SECTION("byte fields are not copied")
+    {
+        const uint8_t *data   = nullptr;
+        size_t         length = 0;
+
+        REQUIRE(dataset.GetExtendedPanId(data, length) == ErrorCode::kNone);
+        REQUIRE(ByteArray(data, data + length) == kExtendedPanId);
+        REQUIRE(data >= dataset.GetRaw().data());
+        REQUIRE(data + length <= dataset.GetRaw().data() + dataset.GetRaw().size());
+    }
+
+    SECTION("missing fields are not found")
+    {
+        const uint8_t *data;
+        size_t         length;
+
+        REQUIRE(dataset.GetPSKc(data, length) == ErrorCode::kNotFound);
+        REQUIRE(dataset.GetMeshLocalPrefix(data, length) == ErrorCode::kNotFound);
+    }
+
+    SECTION("the full dataset equals the eagerly decoded one")
+    {
+        ActiveOperationalDataset activeDataset;
+
+        REQUIRE(dataset.ToActiveDataset(activeDataset) == ErrorCode::kNone);
+        REQUIRE(activeDataset.mPresentFlags ==
+                (ActiveOperationalDataset::kActiveTimestampBit | ActiveOperationalDataset::kChannelBit |
+                 ActiveOperationalDataset::kExtendedPanIdBit | ActiveOperationalDataset::kNetworkNameBit |
+                 ActiveOperationalDataset::kPanIdBit));
+        REQUIRE(activeDataset.mExtendedPanId == kExtendedPanId);
+        REQUIRE(activeDataset.mNetworkName == "OpenThread");
+        REQUIRE(activeDataset.mPanId == 0xFACE);
+    }
+}
+
+TEST_CASE("commissioner-handler-joiner-finalize-completion", "[comm-impl]")
+{
+    // A handler that only implements the synchronous decision.
+    class SyncHandler : public CommissionerHandler
+    {
+    public:
+        using CommissionerHandler::OnJoinerFinalize;
+        bool OnJoinerFinalize(const ByteArray &,
+                              const std::string &aVendorName,
+                              const std::string &,
+                              const std::string &,
+                              const ByteArray &,
+                              const std::string &,
+                              const ByteArray &) override
+        {
+            return aVendorName == "accepted";
+        }
+    };
+
+    SyncHandler          syncHandler;
+    CommissionerHandler &handler = syncHandler;
+    std::vector<bool>    decisions;
+    auto                 completion = [&decisions](bool aAccepted) { decisions.push_back(aAccepted); };
+
+    handler.OnJoinerFinalize({0x01}, "accepted", "model", "1.0", {0, 0, 0, 0, 0}, "", {}, completion);
+    handler.OnJoinerFinalize({0x02}, "rejected", "model", "1.0", {0, 0, 0, 0, 0}, "", {}, completion);
+
+    // The default asynchronous handler completes right away.
+    REQUIRE(decisions == std::vector<bool>{true, false});
+}
+
+TEST_CASE("commissioner-impl-joiner-finalize-completion-outlives-commissioner", "[comm-impl]")
+{
+    CommissionerHandler      dummyHandler;
+    struct event_base *      eventBase = event_base_new();
+    JoinerFinalizeCompletion completion;
+
+    {
+        CommissionerImpl commImpl(dummyHandler, eventBase);
+
+        completion = commImpl.MakeJoinerFinalizeCompletion({0x01}, {0x02});
+
+        // Completed for a joiner session which doesn't exist anymore.
+        completion(true);
+        REQUIRE(event_base_loop(eventBase, EVLOOP_NONBLOCK) >= 0);
+    }
+
+    // The user decides after the commissioner has been destroyed.
+    completion(false);
+    REQUIRE(event_base_loop(eventBase, EVLOOP_NONBLOCK) >= 0);
+
+    event_base_free(eventBase);
+}
+
 TEST_CASE("commissioner-impl-not-implemented-APIs", "[comm-impl]")
 {
     static const std::string kDstAddr = "fd00:7d03:7d03:7d03:d020:79b7:6a02:ab5e";
@@ -174,6 +295,224 @@ TEST_CASE("commissioner-impl-not-implemented-APIs", "[comm-impl]")
     ByteArray signedToken;
     REQUIRE(commImpl.RequestToken(signedToken, "fdaa:bb::de6", 5684) == ErrorCode::kUnimplemented);
 
+    REQUIRE(commImpl.SendUdpProxy(49152, kDstAddr, 5683, {0x01}) == ErrorCode::kUnimplemented);
+
+    event_base_free(eventBase);
+}
+
+TEST_CASE("commissioner-impl-udp-proxy-port", "[comm-impl]")
+{
+    static const std::string kDstAddr = "fd00:7d03:7d03:7d03:d020:79b7:6a02:ab5e";
+
+    Config config;
+    config.mEnableCcm = false;
+    config.mPSKc = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff};
+
+    CommissionerHandler dummyHandler;
+    struct event_base * eventBase = event_base_new();
+    CommissionerImpl    commImpl(dummyHandler, eventBase);
+    REQUIRE(commImpl.Init(config) == ErrorCode::kNone);
+
+    auto  onReceive = [](const std::string &, uint16_t, const uint8_t *, size_t) {};
+    Error sendError;
+
+    REQUIRE(commImpl.BindUdpProxyPort(0, onReceive) == ErrorCode::kInvalidArgs);
+    REQUIRE(commImpl.BindUdpProxyPort(49152, nullptr) == ErrorCode::kInvalidArgs);
+    REQUIRE(commImpl.BindUdpProxyPort(49152, onReceive) == ErrorCode::kNone);
+    REQUIRE(commImpl.BindUdpProxyPort(49152, onReceive) == ErrorCode::kAlreadyExists);
+
+    // Datagrams are only sent by an active commissioner.
+    commImpl.SendUdpProxy([&sendError](Error aError) { sendError = aError; }, 49152, kDstAddr, 5683, {0x01});
+    REQUIRE(sendError == ErrorCode::kInvalidState);
+
+    commImpl.UnbindUdpProxyPort(49152);
+    REQUIRE(commImpl.BindUdpProxyPort(49152, onReceive) == ErrorCode::kNone);
+    commImpl.UnbindUdpProxyPort(49152);
+
+    event_base_free(eventBase);
+}
+
+// Makes a UDP_RX.ntf of a datagram from @p aPeerAddr:@p aPeerPort to @p aLocalPort.
+static coap::Request MakeUdpRx(const Address &  aPeerAddr,
+                               uint16_t         aPeerPort,
+                               uint16_t         aLocalPort,
+                               const ByteArray &aData)
+{
+    coap::Request udpRx{coap::Type::kNonConfirmable, coap::Code::kPost};
+    ByteArray     udpEncap;
+
+    utils::Encode<uint16_t>(udpEncap, aPeerPort);
+    utils::Encode<uint16_t>(udpEncap, aLocalPort);
+    udpEncap.insert(udpEncap.end(), aData.begin(), aData.end());
+
+    SuccessOrDie(udpRx.SetUriPath(uri::kUdpRx));
+    SuccessOrDie(AppendTlv(udpRx, {tlv::Type::kIpv6Address, aPeerAddr.GetRaw()}));
+    SuccessOrDie(AppendTlv(udpRx, {tlv::Type::kUdpEncapsulation, udpEncap}));
+
+    return udpRx;
+}
+
+// The border agent is not connected in the proxy socket tests, so every
+// datagram is written with an error. That is enough to tell when the
+// datagrams leave the send queues.
+TEST_CASE("proxy-socket-send-window", "[udp-proxy]")
+{
+    static const std::string kDstAddr = "fd00:7d03:7d03:7d03:d020:79b7:6a02:ab5e";
+
+    auto eventBase = event_base_new();
+    REQUIRE(eventBase != nullptr);
+
+    {
+        coap::CoapSecure brClient{eventBase};
+        ProxyClient      proxyClient{eventBase, brClient};
+        ProxySocket      socket{proxyClient, nullptr};
+        Address          dstAddr;
+        size_t           sentNum = 0;
+        auto             onSent  = [&sentNum](Error) { ++sentNum; };
+
+        REQUIRE(dstAddr.Set(kDstAddr) == ErrorCode::kNone);
+        REQUIRE(socket.Bind(49152) == ErrorCode::kNone);
+        socket.SetSendWindow(2);
+
+        REQUIRE(socket.SendTo({0x01}, dstAddr, 5683, onSent) == ErrorCode::kNone);
+        REQUIRE(socket.SendTo({0x02}, dstAddr, 5683, onSent) == ErrorCode::kNone);
+        REQUIRE(socket.SendTo({0x03}, dstAddr, 5683, onSent) == ErrorCode::kBusy);
+        REQUIRE(socket.GetPendingSendNum() == 2);
+        REQUIRE(sentNum == 0);
+
+        // The window frees up once the queued datagrams are written.
+        REQUIRE(event_base_loop(eventBase, EVLOOP_ONCE) == 0);
+        REQUIRE(sentNum == 2);
+        REQUIRE(socket.GetPendingSendNum() == 0);
+        REQUIRE(socket.SendTo({0x03}, dstAddr, 5683, onSent) == ErrorCode::kNone);
+    }
+
+    event_base_free(eventBase);
+}
+
+TEST_CASE("proxy-socket-send-batch", "[udp-proxy]")
+{
+    static const std::string kDstAddr      = "fd00:7d03:7d03:7d03:d020:79b7:6a02:ab5e";
+    static constexpr size_t  kDatagramsNum = ProxyClient::kSendBatchSize + 4;
+
+    auto eventBase = event_base_new();
+    REQUIRE(eventBase != nullptr);
+
+    {
+        coap::CoapSecure brClient{eventBase};
+        ProxyClient      proxyClient{eventBase, brClient};
+        ProxySocket      socket0{proxyClient, nullptr};
+        ProxySocket      socket1{proxyClient, nullptr};
+        Address          dstAddr;
+        size_t           sentNum = 0;
+        auto             onSent  = [&sentNum](Error) { ++sentNum; };
+
+        REQUIRE(dstAddr.Set(kDstAddr) == ErrorCode::kNone);
+        REQUIRE(socket0.Bind(49152) == ErrorCode::kNone);
+        REQUIRE(socket1.Bind(49153) == ErrorCode::kNone);
+
+        for (size_t i = 0; i < kDatagramsNum; ++i)
+        {
+            REQUIRE(socket0.SendTo({0x00}, dstAddr, 5683, onSent) == ErrorCode::kNone);
+            REQUIRE(socket1.SendTo({0x01}, dstAddr, 5683, onSent) == ErrorCode::kNone);
+        }
+
+        // Each socket writes a batch per turn of the event loop.
+        REQUIRE(event_base_loop(eventBase, EVLOOP_ONCE) == 0);
+        REQUIRE(sentNum == 2 * ProxyClient::kSendBatchSize);
+        REQUIRE(socket0.GetPendingSendNum() == kDatagramsNum - ProxyClient::kSendBatchSize);
+        REQUIRE(socket1.GetPendingSendNum() == kDatagramsNum - ProxyClient::kSendBatchSize);
+
+        REQUIRE(event_base_loop(eventBase, EVLOOP_ONCE) == 0);
+        REQUIRE(sentNum == 2 * kDatagramsNum);
+        REQUIRE(socket0.GetPendingSendNum() == 0);
+        REQUIRE(socket1.GetPendingSendNum() == 0);
+    }
+
+    event_base_free(eventBase);
+}
+
+TEST_CASE("proxy-socket-congestion-backoff", "[udp-proxy]")
+{
+    static const std::string kDstAddr = "fd00:7d03:7d03:7d03:d020:79b7:6a02:ab5e";
+
+    auto eventBase = event_base_new();
+    REQUIRE(eventBase != nullptr);
+
+    {
+        coap::CoapSecure brClient{eventBase};
+        ProxyClient      proxyClient{eventBase, brClient};
+        ProxySocket      socket{proxyClient, nullptr};
+        Address          dstAddr;
+        size_t           backlog = ProxyClient::kMaxDtlsSendQueueSize + 1;
+        size_t           sentNum = 0;
+        TimePoint        sendTime;
+
+        proxyClient.SetBacklogGetter([&backlog]() { return backlog; });
+
+        REQUIRE(dstAddr.Set(kDstAddr) == ErrorCode::kNone);
+        REQUIRE(socket.Bind(49152) == ErrorCode::kNone);
+        REQUIRE(socket.SendTo({0x01}, dstAddr, 5683, [&sentNum](Error) { ++sentNum; }) == ErrorCode::kNone);
+        sendTime = Clock::now();
+
+        // Nothing is written while the DTLS session falls behind.
+        REQUIRE(event_base_loop(eventBase, EVLOOP_ONCE) == 0);
+        REQUIRE(sentNum == 0);
+        REQUIRE(socket.GetPendingSendNum() == 1);
+
+        // Writing is retried after the backoff once the DTLS session catches up.
+        backlog = ProxyClient::kMaxDtlsSendQueueSize;
+        REQUIRE(event_base_loop(eventBase, EVLOOP_ONCE) == 0);
+        REQUIRE(sentNum == 1);
+        REQUIRE(Clock::now() - sendTime >= Duration(ProxyClient::kCongestionBackoff));
+    }
+
+    event_base_free(eventBase);
+}
+
+TEST_CASE("proxy-socket-receive", "[udp-proxy]")
+{
+    static const std::string kPeerAddr = "fd00:7d03:7d03:7d03:d020:79b7:6a02:ab5e";
+
+    auto eventBase = event_base_new();
+    REQUIRE(eventBase != nullptr);
+
+    {
+        coap::CoapSecure brClient{eventBase};
+        ProxyClient      proxyClient{eventBase, brClient};
+        Address          peerAddr;
+        ByteArray        received;
+        uint16_t         receivedPeerPort = 0;
+        size_t           handledNum       = 0;
+        ByteArray        datagram;
+        coap::Message    request{coap::Type::kNonConfirmable, coap::Code::kPost};
+        coap::Resource   resource{"/test", [&handledNum](const coap::Request &) { ++handledNum; }};
+
+        ProxySocket socket{proxyClient, [&](const Address &, uint16_t aPeerPort, const uint8_t *aData, size_t aLength) {
+                               receivedPeerPort = aPeerPort;
+                               received.assign(aData, aData + aLength);
+                           }};
+
+        REQUIRE(peerAddr.Set(kPeerAddr) == ErrorCode::kNone);
+        REQUIRE(socket.Bind(49152) == ErrorCode::kNone);
+        REQUIRE(proxyClient.AddResource(resource) == ErrorCode::kNone);
+
+        // A CoAP request, which the CoAP client of the UDP proxy would handle.
+        REQUIRE(request.SetUriPath("/test") == ErrorCode::kNone);
+        REQUIRE(request.Serialize(datagram) == ErrorCode::kNone);
+
+        proxyClient.HandleUdpRx(MakeUdpRx(peerAddr, 5683, 49152, datagram));
+        REQUIRE(received == datagram);
+        REQUIRE(receivedPeerPort == 5683);
+        REQUIRE(handledNum == 0);
+
+        // Datagrams to other ports still go to the CoAP client.
+        received.clear();
+        proxyClient.HandleUdpRx(MakeUdpRx(peerAddr, 5683, 49153, datagram));
+        REQUIRE(received.empty());
+        REQUIRE(handledNum == 1);
+    }
+
     event_base_free(eventBase);
 }
 
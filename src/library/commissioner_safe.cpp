@@ -49,6 +49,15 @@ std::shared_ptr<Commissioner> Commissioner::Create(CommissionerHandler &aHandler
     return std::make_shared<CommissionerSafe>(aHandler);
 }
 
+std::shared_ptr<Commissioner> Commissioner::Create(CommissionerHandler &aHandler, struct event_base *aEventBase)
+{
+    if (aEventBase == nullptr)
+    {
+        return nullptr;
+    }
+    return std::make_shared<CommissionerImpl>(aHandler, aEventBase);
+}
+
 Error CommissionerSafe::Init(const Config &aConfig)
 {
     Error                             error;
@@ -70,6 +79,10 @@ Error CommissionerSafe::Init(const Config &aConfig)
 
     impl = std::make_shared<CommissionerImpl>(mHandler, mEventBase.Get());
     SuccessOrExit(error = impl->Init(aConfig));
+    impl->GetOverloadController().AddQueue([this]() {
+        std::lock_guard<std::mutex> _(mInvokeMutex);
+        return mAsyncRequestQueue.size();
+    });
     mImpl = impl;
 
     StartEventLoopThread();
@@ -169,6 +182,21 @@ const std::string &CommissionerSafe::GetDomainName() const
     return mImpl->GetDomainName();
 }
 
+OverloadMetrics CommissionerSafe::GetOverloadMetrics() const
+{
+    std::promise<OverloadMetrics> pro;
+
+    // The metrics are updated by the event loop thread, copy them there.
+    const_cast<CommissionerSafe *>(this)->PushAsyncRequest(
+        [&pro, this]() { pro.set_value(mImpl->GetOverloadMetrics()); });
+    return pro.get_future().get();
+}
+
+CpuUsage CommissionerSafe::GetCpuUsage() const
+{
+    return mImpl->GetCpuUsage();
+}
+
 void CommissionerSafe::CancelRequests()
 {
     PushAsyncRequest([=]() { mImpl->CancelRequests(); });
@@ -540,13 +568,77 @@ Error CommissionerSafe::SetToken(const ByteArray &aSignedToken, const ByteArray
     return pro.get_future().get();
 }
 
+void CommissionerSafe::ProbeLink(Handler<LinkProbeResult> aHandler,
+                                 const std::string &      aDstAddr,
+                                 uint16_t                 aCount,
+                                 uint16_t                 aWindow)
+{
+    PushAsyncRequest([=]() { mImpl->ProbeLink(aHandler, aDstAddr, aCount, aWindow); });
+}
+
+Error CommissionerSafe::ProbeLink(LinkProbeResult &  aResult,
+                                  const std::string &aDstAddr,
+                                  uint16_t           aCount,
+                                  uint16_t           aWindow)
+{
+    std::promise<Error> pro;
+    auto                wait = [&pro, &aResult](const LinkProbeResult *result, Error error) {
+        if (result != nullptr)
+        {
+            aResult = *result;
+        }
+        pro.set_value(error);
+    };
+
+    ProbeLink(wait, aDstAddr, aCount, aWindow);
+    return pro.get_future().get();
+}
+
+Error CommissionerSafe::BindUdpProxyPort(uint16_t aLocalPort, UdpReceiveHandler aHandler)
+{
+    std::promise<Error> pro;
+    PushAsyncRequest([&]() { pro.set_value(mImpl->BindUdpProxyPort(aLocalPort, aHandler)); });
+    return pro.get_future().get();
+}
+
+void CommissionerSafe::UnbindUdpProxyPort(uint16_t aLocalPort)
+{
+    PushAsyncRequest([=]() { mImpl->UnbindUdpProxyPort(aLocalPort); });
+}
+
+void CommissionerSafe::SendUdpProxy(ErrorHandler       aHandler,
+                                    uint16_t           aLocalPort,
+                                    const std::string &aDstAddr,
+                                    uint16_t           aDstPort,
+                                    const ByteArray &  aData)
+{
+    PushAsyncRequest([=]() { mImpl->SendUdpProxy(aHandler, aLocalPort, aDstAddr, aDstPort, aData); });
+}
+
+Error CommissionerSafe::SendUdpProxy(uint16_t           aLocalPort,
+                                     const std::string &aDstAddr,
+                                     uint16_t           aDstPort,
+                                     const ByteArray &  aData)
+{
+    std::promise<Error> pro;
+    auto                wait = [&pro](Error aError) { pro.set_value(aError); };
+
+    SendUdpProxy(wait, aLocalPort, aDstAddr, aDstPort, aData);
+    return pro.get_future().get();
+}
+
 void CommissionerSafe::Invoke(evutil_socket_t, short, void *aContext)
 {
     auto commissionerSafe = reinterpret_cast<CommissionerSafe *>(aContext);
 
     VerifyOrDie(commissionerSafe != nullptr);
 
-    if (auto asyncReq = commissionerSafe->PopAsyncRequest())
+    auto     impl = commissionerSafe->mImpl;
+    CpuScope cpuScope(impl != nullptr ? &impl->GetCpuAccount() : nullptr, CpuCategory::kRequest);
+
+    // Requests pushed before the event is handled are coalesced
+    // into a single activation, drain all of them.
+    while (auto asyncReq = commissionerSafe->PopAsyncRequest())
     {
         asyncReq();
     }
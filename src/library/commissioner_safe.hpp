@@ -90,6 +90,10 @@ public:
 
     const std::string &GetDomainName() const override;
 
+    OverloadMetrics GetOverloadMetrics() const override;
+
+    CpuUsage GetCpuUsage() const override;
+
     void CancelRequests() override;
 
     void  Connect(ErrorHandler aHandler, const std::string &aAddr, uint16_t aPort) override;
@@ -188,6 +192,25 @@ public:
 
     Error SetToken(const ByteArray &aSignedToken, const ByteArray &aSignerCert) override;
 
+    void  ProbeLink(Handler<LinkProbeResult> aHandler,
+                    const std::string &      aDstAddr,
+                    uint16_t                 aCount,
+                    uint16_t                 aWindow) override;
+    Error ProbeLink(LinkProbeResult &aResult, const std::string &aDstAddr, uint16_t aCount, uint16_t aWindow) override;
+
+    Error BindUdpProxyPort(uint16_t aLocalPort, UdpReceiveHandler aHandler) override;
+    void  UnbindUdpProxyPort(uint16_t aLocalPort) override;
+
+    void  SendUdpProxy(ErrorHandler       aHandler,
+                       uint16_t           aLocalPort,
+                       const std::string &aDstAddr,
+                       uint16_t           aDstPort,
+                       const ByteArray &  aData) override;
+    Error SendUdpProxy(uint16_t           aLocalPort,
+                       const std::string &aDstAddr,
+                       uint16_t           aDstPort,
+                       const ByteArray &  aData) override;
+
 private:
     using AsyncRequest = std::function<void()>;
 
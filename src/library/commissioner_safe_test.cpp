@@ -54,6 +54,51 @@ TEST_CASE("stop-immediately-after-starting", "[commissioner]")
     REQUIRE(commissioner->Init(config) == ErrorCode::kNone);
 }
 
+TEST_CASE("run-on-host-event-loop", "[commissioner]")
+{
+    CommissionerHandler dummyHandler;
+
+    Config config;
+    config.mEnableCcm = false;
+    config.mPSKc = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff};
+
+    REQUIRE(Commissioner::Create(dummyHandler, nullptr) == nullptr);
+
+    struct event_base *eventBase = event_base_new();
+    REQUIRE(eventBase != nullptr);
+
+    {
+        // This creates an CommissionerImpl instance.
+        auto commissioner = Commissioner::Create(dummyHandler, eventBase);
+        REQUIRE(commissioner != nullptr);
+        REQUIRE(commissioner->Init(config) == ErrorCode::kNone);
+
+        // Synchronous APIs would block the host event loop.
+        REQUIRE(commissioner->Connect("::1", 5684) == ErrorCode::kUnimplemented);
+
+        // Requests are executed in the calling thread without a thread hop.
+        bool            handled = false;
+        std::thread::id handlerThread;
+        commissioner->GetActiveDataset(
+            [&](const ActiveOperationalDataset *aDataset, Error aError) {
+                handled       = true;
+                handlerThread = std::this_thread::get_id();
+                REQUIRE(aDataset == nullptr);
+                REQUIRE(aError != ErrorCode::kNone);
+            },
+            0xFFFF);
+
+        for (int i = 0; i < 10 && !handled; ++i)
+        {
+            event_base_loop(eventBase, EVLOOP_NONBLOCK);
+        }
+        REQUIRE(handled);
+        REQUIRE(handlerThread == std::this_thread::get_id());
+    }
+
+    event_base_free(eventBase);
+}
+
 } // namespace commissioner
 
 } // namespace ot
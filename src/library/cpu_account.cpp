@@ -0,0 +1,135 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   The file implements the CPU time accounting.
+ */
+
+#include "library/cpu_account.hpp"
+
+#include <time.h>
+
+#include "common/utils.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+thread_local CpuScope *CpuScope::sCurrent = nullptr;
+
+// Returns the CPU time of the calling thread, in nanoseconds.
+static uint64_t GetThreadCpuTime()
+{
+    struct timespec now;
+
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now) != 0)
+    {
+        return 0;
+    }
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000 + static_cast<uint64_t>(now.tv_nsec);
+}
+
+CpuAccount::CpuAccount()
+{
+    for (auto &time : mTimes)
+    {
+        time.store(0, std::memory_order_relaxed);
+    }
+}
+
+CpuUsage CpuAccount::GetUsage() const
+{
+    CpuUsage usage;
+
+    usage.mSocketTime  = GetTime(CpuCategory::kSocket);
+    usage.mJoinerTime  = GetTime(CpuCategory::kJoiner);
+    usage.mTimerTime   = GetTime(CpuCategory::kTimer);
+    usage.mRequestTime = GetTime(CpuCategory::kRequest);
+    usage.mHandlerTime = GetTime(CpuCategory::kHandler);
+
+    return usage;
+}
+
+CpuScope::CpuScope(CpuAccount *aAccount, CpuCategory aCategory)
+    : mAccount(aAccount)
+    , mCategory(aCategory)
+    , mParent(nullptr)
+    , mStartTime(0)
+{
+    uint64_t now;
+
+    VerifyOrExit(mAccount != nullptr);
+
+    now = GetThreadCpuTime();
+
+    // The parent stops being charged until this scope ends.
+    mParent = sCurrent;
+    if (mParent != nullptr)
+    {
+        mParent->Charge(now);
+    }
+
+    sCurrent   = this;
+    mStartTime = now;
+
+exit:
+    return;
+}
+
+CpuScope::~CpuScope()
+{
+    uint64_t now;
+
+    VerifyOrExit(mAccount != nullptr);
+
+    now = GetThreadCpuTime();
+    Charge(now);
+
+    sCurrent = mParent;
+    if (mParent != nullptr)
+    {
+        mParent->mStartTime = now;
+    }
+
+exit:
+    return;
+}
+
+void CpuScope::Charge(uint64_t aNow)
+{
+    if (aNow > mStartTime)
+    {
+        mAccount->mTimes[static_cast<size_t>(mCategory)].fetch_add(aNow - mStartTime, std::memory_order_relaxed);
+    }
+    mStartTime = aNow;
+}
+
+} // namespace commissioner
+
+} // namespace ot
@@ -0,0 +1,119 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   The file includes definitions of the CPU time accounting.
+ */
+
+#ifndef OT_COMM_LIBRARY_CPU_ACCOUNT_HPP_
+#define OT_COMM_LIBRARY_CPU_ACCOUNT_HPP_
+
+#include <atomic>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <commissioner/commissioner.hpp>
+
+namespace ot {
+
+namespace commissioner {
+
+// The kinds of callbacks which use CPU time, see CpuUsage.
+enum class CpuCategory : uint8_t
+{
+    kSocket = 0, ///< Socket events of the border agent.
+    kJoiner,     ///< Socket events of joiner sessions.
+    kTimer,
+    kRequest, ///< Requests from other threads.
+    kHandler, ///< CommissionerHandler callbacks.
+
+    kNum,
+};
+
+static constexpr size_t kCpuCategoryNum = static_cast<size_t>(CpuCategory::kNum);
+
+// The CPU time used by callbacks of an owner, typically a commissioner
+// sharing an event loop thread with others. The time is read from the
+// thread CPU clock in CpuScope. The owner gives the account to its
+// timers and sockets, including those of the sessions it creates.
+//
+// Times may be read from any thread.
+class CpuAccount
+{
+public:
+    CpuAccount();
+
+    CpuAccount(const CpuAccount &) = delete;
+    CpuAccount &operator=(const CpuAccount &) = delete;
+
+    // In microseconds.
+    uint64_t GetTime(CpuCategory aCategory) const
+    {
+        return mTimes[static_cast<size_t>(aCategory)].load(std::memory_order_relaxed) / 1000;
+    }
+
+    CpuUsage GetUsage() const;
+
+private:
+    friend class CpuScope;
+
+    // In nanoseconds, so that short callbacks add up.
+    std::atomic<uint64_t> mTimes[kCpuCategoryNum];
+};
+
+// Charges the thread CPU time used during its lifetime to an account.
+// The time of nested scopes is charged to the nested scopes only, so
+// a callback of one owner running inside that of another is charged
+// correctly. It is a no-op if the account is null.
+class CpuScope
+{
+public:
+    CpuScope(CpuAccount *aAccount, CpuCategory aCategory);
+    ~CpuScope();
+
+    CpuScope(const CpuScope &) = delete;
+    CpuScope &operator=(const CpuScope &) = delete;
+
+private:
+    void Charge(uint64_t aNow);
+
+    CpuAccount *const mAccount;
+    const CpuCategory mCategory;
+    CpuScope *        mParent;
+    uint64_t          mStartTime;
+
+    static thread_local CpuScope *sCurrent;
+};
+
+} // namespace commissioner
+
+} // namespace ot
+
+#endif // OT_COMM_LIBRARY_CPU_ACCOUNT_HPP_
@@ -0,0 +1,143 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines test cases for the CPU time accounting.
+ */
+
+#include "library/cpu_account.hpp"
+
+#include <time.h>
+
+#include <catch2/catch.hpp>
+
+#include "library/timer.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+// Uses the CPU of this thread for about `aMilliseconds`.
+static void Spin(uint64_t aMilliseconds)
+{
+    struct timespec start;
+    struct timespec now;
+    int64_t         elapsed;
+
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+    do
+    {
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+
+        // In nanoseconds, the difference of tv_nsec may be negative.
+        elapsed = (now.tv_sec - start.tv_sec) * 1000000000 + (now.tv_nsec - start.tv_nsec);
+    } while (elapsed < static_cast<int64_t>(aMilliseconds) * 1000000);
+}
+
+TEST_CASE("cpu-account-scope", "[cpu]")
+{
+    CpuAccount account;
+
+    SECTION("time is charged to the category of the scope")
+    {
+        {
+            CpuScope scope(&account, CpuCategory::kSocket);
+
+            Spin(5);
+        }
+
+        REQUIRE(account.GetTime(CpuCategory::kSocket) >= 5000);
+        REQUIRE(account.GetTime(CpuCategory::kTimer) == 0);
+        REQUIRE(account.GetUsage().mSocketTime == account.GetTime(CpuCategory::kSocket));
+    }
+
+    SECTION("nested scopes are not charged to the parent")
+    {
+        CpuAccount other;
+
+        {
+            CpuScope scope(&account, CpuCategory::kTimer);
+            {
+                CpuScope nested(&other, CpuCategory::kHandler);
+
+                Spin(20);
+            }
+        }
+
+        REQUIRE(other.GetTime(CpuCategory::kHandler) >= 20000);
+        REQUIRE(account.GetTime(CpuCategory::kTimer) < 20000);
+    }
+
+    SECTION("a scope without account is a no-op")
+    {
+        {
+            CpuScope scope(&account, CpuCategory::kTimer);
+            {
+                CpuScope nested(nullptr, CpuCategory::kHandler);
+
+                Spin(5);
+            }
+        }
+
+        REQUIRE(account.GetTime(CpuCategory::kTimer) >= 5000);
+        REQUIRE(account.GetTime(CpuCategory::kHandler) == 0);
+    }
+}
+
+TEST_CASE("cpu-account-timer", "[cpu]")
+{
+    auto eventBase = event_base_new();
+    REQUIRE(eventBase != nullptr);
+
+    {
+        CpuAccount account;
+        bool       fired = false;
+
+        Timer timer(
+            eventBase,
+            [&fired](Timer &) {
+                fired = true;
+                Spin(5);
+            },
+            /* aIsSingle */ true, &account);
+
+        timer.Start(MilliSeconds(0));
+        REQUIRE(event_base_loop(eventBase, EVLOOP_ONCE) == 0);
+
+        REQUIRE(fired);
+        REQUIRE(account.GetTime(CpuCategory::kTimer) >= 5000);
+        REQUIRE(account.GetTime(CpuCategory::kSocket) == 0);
+    }
+
+    event_base_free(eventBase);
+}
+
+} // namespace commissioner
+
+} // namespace ot
@@ -0,0 +1,505 @@
+/*
+ *  Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the crypto provider selection and the mbedtls crypto provider.
+ */
+
+#include "library/crypto_provider.hpp"
+
+#include <algorithm>
+
+#include <string.h>
+
+#include <mbedtls/aes.h>
+#include <mbedtls/ccm.h>
+#include <mbedtls/cmac.h>
+#include <mbedtls/sha256.h>
+
+#include "common/error_macros.hpp"
+#include "common/utils.hpp"
+#include "library/mbedtls_error.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+class MbedtlsSha256Context : public Sha256Context
+{
+public:
+    MbedtlsSha256Context() { mbedtls_sha256_init(&mContext); }
+    ~MbedtlsSha256Context() override { mbedtls_sha256_free(&mContext); }
+
+    void Start() override { mbedtls_sha256_starts_ret(&mContext, 0); }
+    void Update(const uint8_t *aBuf, size_t aLength) override { mbedtls_sha256_update_ret(&mContext, aBuf, aLength); }
+    void Finish(uint8_t aHash[kSha256HashSize]) override { mbedtls_sha256_finish_ret(&mContext, aHash); }
+
+private:
+    mbedtls_sha256_context mContext;
+};
+
+// AES-CCM (RFC 3610) on top of the AES block cipher. The mbedtls
+// AES-CCM implementation is replaced by the crypto provider in use
+// (see below), so this one cannot be built with it.
+class MbedtlsAesCcmContext : public AesCcmContext
+{
+public:
+    MbedtlsAesCcmContext() { mbedtls_aes_init(&mAes); }
+    ~MbedtlsAesCcmContext() override { mbedtls_aes_free(&mAes); }
+
+    Error SetKey(const uint8_t aKey[kAesKeySize]) override;
+
+    Error Encrypt(uint8_t *      aOutput,
+                  const uint8_t *aNonce,
+                  size_t         aNonceLength,
+                  const uint8_t *aAad,
+                  size_t         aAadLength,
+                  const uint8_t *aInput,
+                  size_t         aLength,
+                  uint8_t *      aTag,
+                  size_t         aTagLength) override;
+
+    Error Decrypt(uint8_t *      aOutput,
+                  const uint8_t *aNonce,
+                  size_t         aNonceLength,
+                  const uint8_t *aAad,
+                  size_t         aAadLength,
+                  const uint8_t *aInput,
+                  size_t         aLength,
+                  const uint8_t *aTag,
+                  size_t         aTagLength) override;
+
+private:
+    // Encrypts or decrypts the input and computes the full-length tag.
+    Error Crypt(bool           aIsEncrypt,
+                uint8_t *      aOutput,
+                const uint8_t *aNonce,
+                size_t         aNonceLength,
+                const uint8_t *aAad,
+                size_t         aAadLength,
+                const uint8_t *aInput,
+                size_t         aLength,
+                uint8_t        aTag[kAesBlockSize],
+                size_t         aTagLength);
+
+    void EncryptBlock(uint8_t aBlock[kAesBlockSize])
+    {
+        mbedtls_aes_crypt_ecb(&mAes, MBEDTLS_AES_ENCRYPT, aBlock, aBlock);
+    }
+
+    // Adds data to the CBC-MAC, @p aOffset is the offset in the current block.
+    void UpdateMac(uint8_t aMac[kAesBlockSize], size_t &aOffset, const uint8_t *aData, size_t aLength);
+
+    mbedtls_aes_context mAes;
+    bool                mIsKeySet = false;
+};
+
+Error MbedtlsAesCcmContext::SetKey(const uint8_t aKey[kAesKeySize])
+{
+    Error error;
+
+    if (int fail = mbedtls_aes_setkey_enc(&mAes, aKey, kAesKeySize * 8))
+    {
+        ExitNow(error = ErrorFromMbedtlsError(fail));
+    }
+    mIsKeySet = true;
+
+exit:
+    return error;
+}
+
+Error MbedtlsAesCcmContext::Encrypt(uint8_t *      aOutput,
+                                    const uint8_t *aNonce,
+                                    size_t         aNonceLength,
+                                    const uint8_t *aAad,
+                                    size_t         aAadLength,
+                                    const uint8_t *aInput,
+                                    size_t         aLength,
+                                    uint8_t *      aTag,
+                                    size_t         aTagLength)
+{
+    Error   error;
+    uint8_t tag[kAesBlockSize];
+
+    SuccessOrExit(error = Crypt(/* aIsEncrypt */ true, aOutput, aNonce, aNonceLength, aAad, aAadLength, aInput, aLength,
+                                tag, aTagLength));
+    memcpy(aTag, tag, aTagLength);
+
+exit:
+    return error;
+}
+
+Error MbedtlsAesCcmContext::Decrypt(uint8_t *      aOutput,
+                                    const uint8_t *aNonce,
+                                    size_t         aNonceLength,
+                                    const uint8_t *aAad,
+                                    size_t         aAadLength,
+                                    const uint8_t *aInput,
+                                    size_t         aLength,
+                                    const uint8_t *aTag,
+                                    size_t         aTagLength)
+{
+    Error   error;
+    uint8_t tag[kAesBlockSize];
+    uint8_t diff = 0;
+
+    SuccessOrExit(error = Crypt(/* aIsEncrypt */ false, aOutput, aNonce, aNonceLength, aAad, aAadLength, aInput,
+                                aLength, tag, aTagLength));
+
+    // Compares in constant time.
+    for (size_t i = 0; i < aTagLength; ++i)
+    {
+        diff |= tag[i] ^ aTag[i];
+    }
+    if (diff != 0)
+    {
+        memset(aOutput, 0, aLength);
+        ExitNow(error = ERROR_SECURITY("AES-CCM authentication failed"));
+    }
+
+exit:
+    return error;
+}
+
+Error MbedtlsAesCcmContext::Crypt(bool           aIsEncrypt,
+                                  uint8_t *      aOutput,
+                                  const uint8_t *aNonce,
+                                  size_t         aNonceLength,
+                                  const uint8_t *aAad,
+                                  size_t         aAadLength,
+                                  const uint8_t *aInput,
+                                  size_t         aLength,
+                                  uint8_t        aTag[kAesBlockSize],
+                                  size_t         aTagLength)
+{
+    Error    error;
+    size_t   lengthSize = kAesBlockSize - 1 - aNonceLength;
+    uint64_t length     = aLength;
+    uint8_t  mac[kAesBlockSize];
+    uint8_t  counter[kAesBlockSize] = {0};
+    uint8_t  stream[kAesBlockSize];
+    size_t   offset = 0;
+
+    VerifyOrExit(mIsKeySet, error = ERROR_INVALID_STATE("the AES-CCM key is not set"));
+    VerifyOrExit(aNonceLength >= 7 && aNonceLength <= 13,
+                 error = ERROR_INVALID_ARGS("bad AES-CCM nonce length {}", aNonceLength));
+    VerifyOrExit(aTagLength == 0 || (aTagLength >= 4 && aTagLength <= kAesBlockSize && aTagLength % 2 == 0),
+                 error = ERROR_INVALID_ARGS("bad AES-CCM tag length {}", aTagLength));
+    VerifyOrExit(lengthSize == sizeof(length) || (length >> (8 * lengthSize)) == 0,
+                 error = ERROR_INVALID_ARGS("too long AES-CCM input of {} bytes", aLength));
+
+    // B_0: the flags, the nonce and the length of the message.
+    mac[0] = static_cast<uint8_t>((aAadLength > 0 ? 0x40 : 0x00) | (aTagLength > 0 ? (aTagLength - 2) / 2 << 3 : 0) |
+                                  (lengthSize - 1));
+    memcpy(&mac[1], aNonce, aNonceLength);
+    for (size_t i = 0; i < lengthSize; ++i)
+    {
+        mac[kAesBlockSize - 1 - i] = static_cast<uint8_t>(length >> (8 * i));
+    }
+    EncryptBlock(mac);
+
+    if (aAadLength > 0)
+    {
+        uint8_t aadLength[6];
+        size_t  aadLengthSize;
+
+        if (aAadLength < 0xff00)
+        {
+            aadLength[0]  = static_cast<uint8_t>(aAadLength >> 8);
+            aadLength[1]  = static_cast<uint8_t>(aAadLength);
+            aadLengthSize = 2;
+        }
+        else
+        {
+            VerifyOrExit(static_cast<uint64_t>(aAadLength) <= 0xffffffff,
+                         error = ERROR_INVALID_ARGS("too long AES-CCM AAD of {} bytes", aAadLength));
+            aadLength[0] = 0xff;
+            aadLength[1] = 0xfe;
+            for (size_t i = 0; i < 4; ++i)
+            {
+                aadLength[5 - i] = static_cast<uint8_t>(aAadLength >> (8 * i));
+            }
+            aadLengthSize = 6;
+        }
+
+        UpdateMac(mac, offset, aadLength, aadLengthSize);
+        UpdateMac(mac, offset, aAad, aAadLength);
+        if (offset != 0)
+        {
+            EncryptBlock(mac);
+        }
+    }
+
+    // A_0, whose key stream encrypts the tag, and A_i for the message.
+    counter[0] = static_cast<uint8_t>(lengthSize - 1);
+    memcpy(&counter[1], aNonce, aNonceLength);
+    memcpy(aTag, counter, kAesBlockSize);
+    EncryptBlock(aTag);
+
+    for (size_t begin = 0; begin < aLength; begin += kAesBlockSize)
+    {
+        size_t blockLength = std::min(aLength - begin, kAesBlockSize);
+
+        for (size_t i = kAesBlockSize - 1; ++counter[i] == 0 && i > kAesBlockSize - lengthSize; --i)
+        {
+        }
+        memcpy(stream, counter, kAesBlockSize);
+        EncryptBlock(stream);
+
+        // The input is read before the output is written, they may overlap.
+        for (size_t i = 0; i < blockLength; ++i)
+        {
+            uint8_t input  = aInput[begin + i];
+            uint8_t output = input ^ stream[i];
+
+            mac[i] ^= aIsEncrypt ? input : output;
+            aOutput[begin + i] = output;
+        }
+        EncryptBlock(mac);
+    }
+
+    for (size_t i = 0; i < kAesBlockSize; ++i)
+    {
+        aTag[i] ^= mac[i];
+    }
+
+exit:
+    return error;
+}
+
+void MbedtlsAesCcmContext::UpdateMac(uint8_t aMac[kAesBlockSize], size_t &aOffset, const uint8_t *aData, size_t aLength)
+{
+    for (size_t i = 0; i < aLength; ++i)
+    {
+        aMac[aOffset++] ^= aData[i];
+        if (aOffset == kAesBlockSize)
+        {
+            EncryptBlock(aMac);
+            aOffset = 0;
+        }
+    }
+}
+
+class MbedtlsCryptoProvider : public CryptoProvider
+{
+public:
+    const char *GetName() const override { return "mbedtls"; }
+
+    void Sha256(uint8_t aHash[kSha256HashSize], const uint8_t *aBuf, size_t aLength) override;
+
+    std::unique_ptr<Sha256Context> CreateSha256Context() override;
+
+    void AesCmacPrf128(uint8_t        aOutput[kAesBlockSize],
+                       const uint8_t *aKey,
+                       size_t         aKeyLength,
+                       const uint8_t *aInput,
+                       size_t         aInputLength) override;
+
+    std::unique_ptr<AesCcmContext> CreateAesCcmContext() override;
+};
+
+void MbedtlsCryptoProvider::Sha256(uint8_t aHash[kSha256HashSize], const uint8_t *aBuf, size_t aLength)
+{
+    mbedtls_sha256_ret(aBuf, aLength, aHash, 0);
+}
+
+std::unique_ptr<Sha256Context> MbedtlsCryptoProvider::CreateSha256Context()
+{
+    return std::unique_ptr<Sha256Context>(new MbedtlsSha256Context());
+}
+
+void MbedtlsCryptoProvider::AesCmacPrf128(uint8_t        aOutput[kAesBlockSize],
+                                          const uint8_t *aKey,
+                                          size_t         aKeyLength,
+                                          const uint8_t *aInput,
+                                          size_t         aInputLength)
+{
+    mbedtls_aes_cmac_prf_128(aKey, aKeyLength, aInput, aInputLength, aOutput);
+}
+
+std::unique_ptr<AesCcmContext> MbedtlsCryptoProvider::CreateAesCcmContext()
+{
+    return std::unique_ptr<AesCcmContext>(new MbedtlsAesCcmContext());
+}
+
+static CryptoProvider *sCryptoProvider = nullptr;
+
+CryptoProvider &GetMbedtlsCryptoProvider()
+{
+    static MbedtlsCryptoProvider sMbedtlsCryptoProvider;
+    return sMbedtlsCryptoProvider;
+}
+
+CryptoProvider &GetCryptoProvider()
+{
+    if (sCryptoProvider != nullptr)
+    {
+        return *sCryptoProvider;
+    }
+
+#if OT_COMM_CONFIG_OPENSSL_ENABLE
+    return GetOpensslCryptoProvider();
+#else
+    return GetMbedtlsCryptoProvider();
+#endif
+}
+
+void SetCryptoProvider(CryptoProvider *aProvider)
+{
+    sCryptoProvider = aProvider;
+}
+
+} // namespace commissioner
+
+} // namespace ot
+
+// mbedtls is built with MBEDTLS_CCM_ALT, the AES-CCM functions below
+// replace its implementation and protect DTLS records with the crypto
+// provider in use. They are defined along with GetCryptoProvider() so that
+// they are linked whenever the library is.
+
+using ot::commissioner::AesCcmContext;
+using ot::commissioner::Error;
+using ot::commissioner::ErrorCode;
+
+static int CcmErrorFromError(const Error &aError)
+{
+    switch (aError.GetCode())
+    {
+    case ErrorCode::kNone:
+        return 0;
+    case ErrorCode::kSecurity:
+        return MBEDTLS_ERR_CCM_AUTH_FAILED;
+    default:
+        return MBEDTLS_ERR_CCM_BAD_INPUT;
+    }
+}
+
+void mbedtls_ccm_init(mbedtls_ccm_context *aContext)
+{
+    aContext->provider_context = nullptr;
+}
+
+int mbedtls_ccm_setkey(mbedtls_ccm_context *aContext,
+                       mbedtls_cipher_id_t  aCipher,
+                       const unsigned char *aKey,
+                       unsigned int         aKeyBits)
+{
+    int                            ret = MBEDTLS_ERR_CCM_BAD_INPUT;
+    std::unique_ptr<AesCcmContext> ccm;
+
+    VerifyOrExit(aCipher == MBEDTLS_CIPHER_ID_AES && aKeyBits == ot::commissioner::kAesKeySize * 8);
+
+    ccm = ot::commissioner::GetCryptoProvider().CreateAesCcmContext();
+    ret = CcmErrorFromError(ccm->SetKey(aKey));
+    VerifyOrExit(ret == 0);
+
+    mbedtls_ccm_free(aContext);
+    aContext->provider_context = ccm.release();
+
+exit:
+    return ret;
+}
+
+void mbedtls_ccm_free(mbedtls_ccm_context *aContext)
+{
+    if (aContext != nullptr)
+    {
+        delete static_cast<AesCcmContext *>(aContext->provider_context);
+        aContext->provider_context = nullptr;
+    }
+}
+
+int mbedtls_ccm_star_encrypt_and_tag(mbedtls_ccm_context *aContext,
+                                     size_t               aLength,
+                                     const unsigned char *aNonce,
+                                     size_t               aNonceLength,
+                                     const unsigned char *aAad,
+                                     size_t               aAadLength,
+                                     const unsigned char *aInput,
+                                     unsigned char *      aOutput,
+                                     unsigned char *      aTag,
+                                     size_t               aTagLength)
+{
+    auto ccm = static_cast<AesCcmContext *>(aContext->provider_context);
+
+    return ccm == nullptr ? MBEDTLS_ERR_CCM_BAD_INPUT
+                          : CcmErrorFromError(ccm->Encrypt(aOutput, aNonce, aNonceLength, aAad, aAadLength, aInput,
+                                                           aLength, aTag, aTagLength));
+}
+
+int mbedtls_ccm_encrypt_and_tag(mbedtls_ccm_context *aContext,
+                                size_t               aLength,
+                                const unsigned char *aNonce,
+                                size_t               aNonceLength,
+                                const unsigned char *aAad,
+                                size_t               aAadLength,
+                                const unsigned char *aInput,
+                                unsigned char *      aOutput,
+                                unsigned char *      aTag,
+                                size_t               aTagLength)
+{
+    return aTagLength == 0 ? MBEDTLS_ERR_CCM_BAD_INPUT
+                           : mbedtls_ccm_star_encrypt_and_tag(aContext, aLength, aNonce, aNonceLength, aAad,
+                                                              aAadLength, aInput, aOutput, aTag, aTagLength);
+}
+
+int mbedtls_ccm_star_auth_decrypt(mbedtls_ccm_context *aContext,
+                                  size_t               aLength,
+                                  const unsigned char *aNonce,
+                                  size_t               aNonceLength,
+                                  const unsigned char *aAad,
+                                  size_t               aAadLength,
+                                  const unsigned char *aInput,
+                                  unsigned char *      aOutput,
+                                  const unsigned char *aTag,
+                                  size_t               aTagLength)
+{
+    auto ccm = static_cast<AesCcmContext *>(aContext->provider_context);
+
+    return ccm == nullptr ? MBEDTLS_ERR_CCM_BAD_INPUT
+                          : CcmErrorFromError(ccm->Decrypt(aOutput, aNonce, aNonceLength, aAad, aAadLength, aInput,
+                                                           aLength, aTag, aTagLength));
+}
+
+int mbedtls_ccm_auth_decrypt(mbedtls_ccm_context *aContext,
+                             size_t               aLength,
+                             const unsigned char *aNonce,
+                             size_t               aNonceLength,
+                             const unsigned char *aAad,
+                             size_t               aAadLength,
+                             const unsigned char *aInput,
+                             unsigned char *      aOutput,
+                             const unsigned char *aTag,
+                             size_t               aTagLength)
+{
+    return aTagLength == 0 ? MBEDTLS_ERR_CCM_BAD_INPUT
+                           : mbedtls_ccm_star_auth_decrypt(aContext, aLength, aNonce, aNonceLength, aAad, aAadLength,
+                                                           aInput, aOutput, aTag, aTagLength);
+}
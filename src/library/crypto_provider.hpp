@@ -0,0 +1,163 @@
+/*
+ *  Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines the crypto provider interface.
+ *
+ *   A crypto provider implements the symmetric primitives used by the
+ *   commissioner: AES-CCM record protection, AES-CMAC-PRF-128 and SHA-256.
+ *   The mbedtls provider is always available; an OpenSSL provider is built
+ *   when OT_COMM_OPENSSL is enabled and becomes the default provider in
+ *   that case.
+ *
+ *   mbedtls is built with MBEDTLS_CCM_ALT, the mbedtls_ccm_* functions
+ *   are implemented with the provider in use, so that DTLS records are
+ *   protected by it.
+ */
+
+#ifndef OT_COMM_LIBRARY_CRYPTO_PROVIDER_HPP_
+#define OT_COMM_LIBRARY_CRYPTO_PROVIDER_HPP_
+
+#include <memory>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <commissioner/defines.hpp>
+#include <commissioner/error.hpp>
+
+namespace ot {
+
+namespace commissioner {
+
+static constexpr size_t kSha256HashSize = 32;
+static constexpr size_t kAesKeySize     = 16;
+static constexpr size_t kAesBlockSize   = 16;
+
+// An incremental SHA-256 computation.
+class Sha256Context
+{
+public:
+    virtual ~Sha256Context() = default;
+
+    virtual void Start()                                     = 0;
+    virtual void Update(const uint8_t *aBuf, size_t aLength) = 0;
+    virtual void Finish(uint8_t aHash[kSha256HashSize])      = 0;
+};
+
+// AES-128-CCM under a key set once, for protecting the records of a session.
+// The nonce is 7 to 13 bytes long. The tag is 4 to 16 bytes long, or empty
+// for CCM* without authentication, which not all providers support.
+class AesCcmContext
+{
+public:
+    virtual ~AesCcmContext() = default;
+
+    virtual Error SetKey(const uint8_t aKey[kAesKeySize]) = 0;
+
+    // Encrypts @p aLength bytes of @p aInput into @p aOutput, which may be
+    // the same buffer, and writes the authentication tag into @p aTag.
+    virtual Error Encrypt(uint8_t *      aOutput,
+                          const uint8_t *aNonce,
+                          size_t         aNonceLength,
+                          const uint8_t *aAad,
+                          size_t         aAadLength,
+                          const uint8_t *aInput,
+                          size_t         aLength,
+                          uint8_t *      aTag,
+                          size_t         aTagLength) = 0;
+
+    // Decrypts @p aLength bytes of @p aInput into @p aOutput, which may be
+    // the same buffer. @p aOutput is zeroed if the tag doesn't match.
+    virtual Error Decrypt(uint8_t *      aOutput,
+                          const uint8_t *aNonce,
+                          size_t         aNonceLength,
+                          const uint8_t *aAad,
+                          size_t         aAadLength,
+                          const uint8_t *aInput,
+                          size_t         aLength,
+                          const uint8_t *aTag,
+                          size_t         aTagLength) = 0;
+};
+
+class CryptoProvider
+{
+public:
+    virtual ~CryptoProvider() = default;
+
+    // Returns the name of this provider, for logging and benchmarks.
+    virtual const char *GetName() const = 0;
+
+    virtual void Sha256(uint8_t aHash[kSha256HashSize], const uint8_t *aBuf, size_t aLength) = 0;
+
+    // Returns a new SHA-256 context, which must be started before use.
+    virtual std::unique_ptr<Sha256Context> CreateSha256Context() = 0;
+
+    // AES-CMAC-PRF-128 (RFC 4615). The key may be of any length.
+    virtual void AesCmacPrf128(uint8_t        aOutput[kAesBlockSize],
+                               const uint8_t *aKey,
+                               size_t         aKeyLength,
+                               const uint8_t *aInput,
+                               size_t         aInputLength) = 0;
+
+    // Returns a new AES-128-CCM context, whose key must be set before use.
+    virtual std::unique_ptr<AesCcmContext> CreateAesCcmContext() = 0;
+};
+
+/**
+ * This function returns the crypto provider in use.
+ *
+ * The OpenSSL provider is the default when built with OT_COMM_OPENSSL,
+ * otherwise the mbedtls provider.
+ *
+ */
+CryptoProvider &GetCryptoProvider();
+
+/**
+ * This function replaces the crypto provider in use.
+ *
+ * It is not thread-safe and should be called before any commissioner
+ * instance is created.
+ *
+ * @param[in]  aProvider  The new provider, nullptr restores the default one.
+ *
+ */
+void SetCryptoProvider(CryptoProvider *aProvider);
+
+CryptoProvider &GetMbedtlsCryptoProvider();
+
+#if OT_COMM_CONFIG_OPENSSL_ENABLE
+CryptoProvider &GetOpensslCryptoProvider();
+#endif
+
+} // namespace commissioner
+
+} // namespace ot
+
+#endif // OT_COMM_LIBRARY_CRYPTO_PROVIDER_HPP_
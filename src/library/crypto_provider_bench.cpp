@@ -0,0 +1,137 @@
+/*
+ *  Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements a benchmark of the crypto providers.
+ *
+ *   It measures the cost of protecting and unprotecting a DTLS record
+ *   (AES-128-CCM-8 with a full 1024 bytes record, under a key set once
+ *   as by the mbedtls SSL layer) and of generating a PSKc (PBKDF2 with
+ *   AES-CMAC-PRF-128, 16384 iterations).
+ */
+
+#include <chrono>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <commissioner/commissioner.hpp>
+
+#include "common/utils.hpp"
+#include "library/crypto_provider.hpp"
+
+using namespace ot::commissioner;
+
+static constexpr size_t kRecordLength = 1024;
+static constexpr size_t kTagLength    = 8;
+static constexpr size_t kRecordCount  = 20000;
+static constexpr size_t kPSKcCount    = 20;
+
+using BenchClock = std::chrono::steady_clock;
+
+static double ElapsedMicroseconds(BenchClock::time_point aBegin, size_t aCount)
+{
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(BenchClock::now() - aBegin);
+    return elapsed.count() / 1000.0 / aCount;
+}
+
+static void BenchRecordProtection(CryptoProvider &aProvider)
+{
+    const uint8_t key[kAesKeySize] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+                                      0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff};
+    auto          ccm              = aProvider.CreateAesCcmContext();
+    ByteArray     nonce(12, 0x5a);
+    ByteArray     aad(13, 0xa5);
+    ByteArray     record(kRecordLength, 0x3c);
+    ByteArray     tags(kRecordCount * kTagLength);
+
+    SuccessOrDie(ccm->SetKey(key));
+
+    auto begin = BenchClock::now();
+    for (size_t i = 0; i < kRecordCount; ++i)
+    {
+        nonce.back() = static_cast<uint8_t>(i);
+        SuccessOrDie(ccm->Encrypt(record.data(), nonce.data(), nonce.size(), aad.data(), aad.size(), record.data(),
+                                  record.size(), &tags[i * kTagLength], kTagLength));
+    }
+    auto encrypt = ElapsedMicroseconds(begin, kRecordCount);
+
+    // Unprotects the records in reverse order, each under its own nonce and tag.
+    begin = BenchClock::now();
+    for (size_t i = kRecordCount; i-- > 0;)
+    {
+        nonce.back() = static_cast<uint8_t>(i);
+        SuccessOrDie(ccm->Decrypt(record.data(), nonce.data(), nonce.size(), aad.data(), aad.size(), record.data(),
+                                  record.size(), &tags[i * kTagLength], kTagLength));
+    }
+    auto decrypt = ElapsedMicroseconds(begin, kRecordCount);
+
+    VerifyOrDie(record == ByteArray(kRecordLength, 0x3c));
+
+    fmt::print("{:<10} record protect   {:>10.3f} us/record ({:.1f} MB/s)\n", aProvider.GetName(), encrypt,
+               kRecordLength / encrypt);
+    fmt::print("{:<10} record unprotect {:>10.3f} us/record ({:.1f} MB/s)\n", aProvider.GetName(), decrypt,
+               kRecordLength / decrypt);
+}
+
+static void BenchPSKc(CryptoProvider &aProvider)
+{
+    const ByteArray extendedPanId = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07};
+    ByteArray       pskc;
+
+    SetCryptoProvider(&aProvider);
+
+    auto begin = BenchClock::now();
+    for (size_t i = 0; i < kPSKcCount; ++i)
+    {
+        SuccessOrDie(Commissioner::GeneratePSKc(pskc, "12SECRETPASSWORD34", "Test Network", extendedPanId));
+    }
+    auto elapsed = ElapsedMicroseconds(begin, kPSKcCount);
+
+    SetCryptoProvider(nullptr);
+
+    fmt::print("{:<10} PSKc generation  {:>10.3f} us/PSKc\n", aProvider.GetName(), elapsed);
+}
+
+int main()
+{
+    std::vector<CryptoProvider *> providers{&GetMbedtlsCryptoProvider()};
+
+#if OT_COMM_CONFIG_OPENSSL_ENABLE
+    providers.push_back(&GetOpensslCryptoProvider());
+#endif
+
+    for (auto provider : providers)
+    {
+        BenchRecordProtection(*provider);
+        BenchPSKc(*provider);
+    }
+
+    return 0;
+}
@@ -0,0 +1,377 @@
+/*
+ *  Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the OpenSSL crypto provider.
+ *
+ *   OpenSSL picks AES-NI, SHA-NI and other hardware accelerated
+ *   paths at runtime when the CPU supports them.
+ */
+
+#include "library/crypto_provider.hpp"
+
+#include <memory>
+
+#include <string.h>
+
+#include <openssl/evp.h>
+#include <openssl/opensslv.h>
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+#include <openssl/core_names.h>
+#else
+#include <openssl/cmac.h>
+#endif
+
+#include "common/error_macros.hpp"
+#include "common/utils.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+struct EvpMdCtxDeleter
+{
+    void operator()(EVP_MD_CTX *aCtx) const { EVP_MD_CTX_free(aCtx); }
+};
+
+struct EvpCipherCtxDeleter
+{
+    void operator()(EVP_CIPHER_CTX *aCtx) const { EVP_CIPHER_CTX_free(aCtx); }
+};
+
+struct CmacContext
+{
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    CmacContext()
+        : mContext(nullptr)
+        , mIsKeySet(false)
+    {
+        EVP_MAC *cmac = EVP_MAC_fetch(nullptr, OSSL_MAC_NAME_CMAC, nullptr);
+
+        if (cmac != nullptr)
+        {
+            mContext = EVP_MAC_CTX_new(cmac);
+            EVP_MAC_free(cmac);
+        }
+    }
+    ~CmacContext() { EVP_MAC_CTX_free(mContext); }
+
+    EVP_MAC_CTX *mContext;
+#else
+    CmacContext()
+        : mContext(CMAC_CTX_new())
+        , mIsKeySet(false)
+    {
+    }
+    ~CmacContext() { CMAC_CTX_free(mContext); }
+
+    CMAC_CTX *mContext;
+#endif
+    bool    mIsKeySet;
+    uint8_t mKey[kAesKeySize];
+};
+
+using EvpMdCtxPtr     = std::unique_ptr<EVP_MD_CTX, EvpMdCtxDeleter>;
+using EvpCipherCtxPtr = std::unique_ptr<EVP_CIPHER_CTX, EvpCipherCtxDeleter>;
+
+class OpensslSha256Context : public Sha256Context
+{
+public:
+    OpensslSha256Context()
+        : mContext(EVP_MD_CTX_new())
+    {
+        VerifyOrDie(mContext != nullptr);
+    }
+
+    void Start() override { VerifyOrDie(EVP_DigestInit_ex(mContext.get(), EVP_sha256(), nullptr) == 1); }
+    void Update(const uint8_t *aBuf, size_t aLength) override
+    {
+        VerifyOrDie(EVP_DigestUpdate(mContext.get(), aBuf, aLength) == 1);
+    }
+    void Finish(uint8_t aHash[kSha256HashSize]) override
+    {
+        VerifyOrDie(EVP_DigestFinal_ex(mContext.get(), aHash, nullptr) == 1);
+    }
+
+private:
+    EvpMdCtxPtr mContext;
+};
+
+// OpenSSL takes the tag length before and the tag itself after the key,
+// so the key is kept and the cipher context is initialized for each record.
+class OpensslAesCcmContext : public AesCcmContext
+{
+public:
+    OpensslAesCcmContext()
+        : mContext(EVP_CIPHER_CTX_new())
+        , mIsKeySet(false)
+    {
+        VerifyOrDie(mContext != nullptr);
+    }
+
+    Error SetKey(const uint8_t aKey[kAesKeySize]) override
+    {
+        memcpy(mKey, aKey, kAesKeySize);
+        mIsKeySet = true;
+        return ERROR_NONE;
+    }
+
+    Error Encrypt(uint8_t *      aOutput,
+                  const uint8_t *aNonce,
+                  size_t         aNonceLength,
+                  const uint8_t *aAad,
+                  size_t         aAadLength,
+                  const uint8_t *aInput,
+                  size_t         aLength,
+                  uint8_t *      aTag,
+                  size_t         aTagLength) override;
+
+    Error Decrypt(uint8_t *      aOutput,
+                  const uint8_t *aNonce,
+                  size_t         aNonceLength,
+                  const uint8_t *aAad,
+                  size_t         aAadLength,
+                  const uint8_t *aInput,
+                  size_t         aLength,
+                  const uint8_t *aTag,
+                  size_t         aTagLength) override;
+
+private:
+    Error Start(bool           aIsEncrypt,
+                const uint8_t *aNonce,
+                size_t         aNonceLength,
+                const uint8_t *aAad,
+                size_t         aAadLength,
+                size_t         aLength,
+                const uint8_t *aTag,
+                size_t         aTagLength);
+
+    EvpCipherCtxPtr mContext;
+    bool            mIsKeySet;
+    uint8_t         mKey[kAesKeySize];
+};
+
+Error OpensslAesCcmContext::Start(bool           aIsEncrypt,
+                                  const uint8_t *aNonce,
+                                  size_t         aNonceLength,
+                                  const uint8_t *aAad,
+                                  size_t         aAadLength,
+                                  size_t         aLength,
+                                  const uint8_t *aTag,
+                                  size_t         aTagLength)
+{
+    Error error;
+    int   length;
+    auto  ctx = mContext.get();
+
+    VerifyOrExit(mIsKeySet, error = ERROR_INVALID_STATE("the AES-CCM key is not set"));
+    VerifyOrExit(aNonceLength >= 7 && aNonceLength <= 13,
+                 error = ERROR_INVALID_ARGS("bad AES-CCM nonce length {}", aNonceLength));
+    VerifyOrExit(aTagLength >= 4 && aTagLength <= kAesBlockSize && aTagLength % 2 == 0,
+                 error = ERROR_INVALID_ARGS("bad AES-CCM tag length {}", aTagLength));
+
+    VerifyOrExit(EVP_CipherInit_ex(ctx, EVP_aes_128_ccm(), nullptr, nullptr, nullptr, aIsEncrypt) == 1 &&
+                     EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_IVLEN, static_cast<int>(aNonceLength), nullptr) == 1 &&
+                     EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_TAG, static_cast<int>(aTagLength),
+                                         aIsEncrypt ? nullptr : const_cast<uint8_t *>(aTag)) == 1 &&
+                     EVP_CipherInit_ex(ctx, nullptr, nullptr, mKey, aNonce, aIsEncrypt) == 1,
+                 error = ERROR_SECURITY("initialize AES-CCM failed"));
+
+    // CCM takes the length of the message before the AAD.
+    VerifyOrExit(EVP_CipherUpdate(ctx, nullptr, &length, nullptr, static_cast<int>(aLength)) == 1,
+                 error = ERROR_INVALID_ARGS("too long AES-CCM input of {} bytes", aLength));
+    if (aAadLength > 0)
+    {
+        VerifyOrExit(EVP_CipherUpdate(ctx, nullptr, &length, aAad, static_cast<int>(aAadLength)) == 1,
+                     error = ERROR_SECURITY("AES-CCM AAD failed"));
+    }
+
+exit:
+    return error;
+}
+
+Error OpensslAesCcmContext::Encrypt(uint8_t *      aOutput,
+                                    const uint8_t *aNonce,
+                                    size_t         aNonceLength,
+                                    const uint8_t *aAad,
+                                    size_t         aAadLength,
+                                    const uint8_t *aInput,
+                                    size_t         aLength,
+                                    uint8_t *      aTag,
+                                    size_t         aTagLength)
+{
+    Error error;
+    int   length;
+
+    SuccessOrExit(error = Start(/* aIsEncrypt */ true, aNonce, aNonceLength, aAad, aAadLength, aLength, nullptr,
+                                aTagLength));
+    VerifyOrExit(EVP_EncryptUpdate(mContext.get(), aOutput, &length, aInput, static_cast<int>(aLength)) == 1 &&
+                     EVP_EncryptFinal_ex(mContext.get(), aOutput + length, &length) == 1,
+                 error = ERROR_SECURITY("AES-CCM encryption failed"));
+    VerifyOrExit(EVP_CIPHER_CTX_ctrl(mContext.get(), EVP_CTRL_AEAD_GET_TAG, static_cast<int>(aTagLength), aTag) == 1,
+                 error = ERROR_SECURITY("get AES-CCM tag failed"));
+
+exit:
+    return error;
+}
+
+Error OpensslAesCcmContext::Decrypt(uint8_t *      aOutput,
+                                    const uint8_t *aNonce,
+                                    size_t         aNonceLength,
+                                    const uint8_t *aAad,
+                                    size_t         aAadLength,
+                                    const uint8_t *aInput,
+                                    size_t         aLength,
+                                    const uint8_t *aTag,
+                                    size_t         aTagLength)
+{
+    Error error;
+    int   length;
+
+    SuccessOrExit(error = Start(/* aIsEncrypt */ false, aNonce, aNonceLength, aAad, aAadLength, aLength, aTag,
+                                aTagLength));
+
+    // The tag is verified by the update of the whole message.
+    if (EVP_DecryptUpdate(mContext.get(), aOutput, &length, aInput, static_cast<int>(aLength)) != 1)
+    {
+        memset(aOutput, 0, aLength);
+        ExitNow(error = ERROR_SECURITY("AES-CCM authentication failed"));
+    }
+
+exit:
+    return error;
+}
+
+class OpensslCryptoProvider : public CryptoProvider
+{
+public:
+    const char *GetName() const override { return "openssl"; }
+
+    void Sha256(uint8_t aHash[kSha256HashSize], const uint8_t *aBuf, size_t aLength) override;
+
+    std::unique_ptr<Sha256Context> CreateSha256Context() override;
+
+    void AesCmacPrf128(uint8_t        aOutput[kAesBlockSize],
+                       const uint8_t *aKey,
+                       size_t         aKeyLength,
+                       const uint8_t *aInput,
+                       size_t         aInputLength) override;
+
+    std::unique_ptr<AesCcmContext> CreateAesCcmContext() override;
+
+private:
+    static void AesCmac(uint8_t        aOutput[kAesBlockSize],
+                        const uint8_t  aKey[kAesKeySize],
+                        const uint8_t *aInput,
+                        size_t         aInputLength);
+};
+
+void OpensslCryptoProvider::Sha256(uint8_t aHash[kSha256HashSize], const uint8_t *aBuf, size_t aLength)
+{
+    VerifyOrDie(EVP_Digest(aBuf, aLength, aHash, nullptr, EVP_sha256(), nullptr) == 1);
+}
+
+std::unique_ptr<Sha256Context> OpensslCryptoProvider::CreateSha256Context()
+{
+    return std::unique_ptr<Sha256Context>(new OpensslSha256Context());
+}
+
+void OpensslCryptoProvider::AesCmac(uint8_t        aOutput[kAesBlockSize],
+                                    const uint8_t  aKey[kAesKeySize],
+                                    const uint8_t *aInput,
+                                    size_t         aInputLength)
+{
+    // PBKDF2 calls AES-CMAC thousands of times with the same key, keeping
+    // the context and the expanded key around avoids re-scheduling the key
+    // and re-allocating the context for each call.
+    static thread_local CmacContext sCmac;
+    size_t                          outputLength = 0;
+    bool                            isSameKey    = sCmac.mIsKeySet && memcmp(sCmac.mKey, aKey, kAesKeySize) == 0;
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    char       cipherName[] = "AES-128-CBC";
+    OSSL_PARAM params[]     = {OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_CIPHER, cipherName, 0),
+                           OSSL_PARAM_construct_end()};
+
+    VerifyOrDie(sCmac.mContext != nullptr);
+    VerifyOrDie(isSameKey ? EVP_MAC_init(sCmac.mContext, nullptr, 0, nullptr) == 1
+                          : EVP_MAC_init(sCmac.mContext, aKey, kAesKeySize, params) == 1);
+    VerifyOrDie(EVP_MAC_update(sCmac.mContext, aInput, aInputLength) == 1);
+    VerifyOrDie(EVP_MAC_final(sCmac.mContext, aOutput, &outputLength, kAesBlockSize) == 1);
+#else
+    VerifyOrDie(sCmac.mContext != nullptr);
+    VerifyOrDie(isSameKey ? CMAC_Init(sCmac.mContext, nullptr, 0, nullptr, nullptr) == 1
+                          : CMAC_Init(sCmac.mContext, aKey, kAesKeySize, EVP_aes_128_cbc(), nullptr) == 1);
+    VerifyOrDie(CMAC_Update(sCmac.mContext, aInput, aInputLength) == 1);
+    VerifyOrDie(CMAC_Final(sCmac.mContext, aOutput, &outputLength) == 1);
+#endif
+
+    VerifyOrDie(outputLength == kAesBlockSize);
+
+    memcpy(sCmac.mKey, aKey, kAesKeySize);
+    sCmac.mIsKeySet = true;
+}
+
+void OpensslCryptoProvider::AesCmacPrf128(uint8_t        aOutput[kAesBlockSize],
+                                          const uint8_t *aKey,
+                                          size_t         aKeyLength,
+                                          const uint8_t *aInput,
+                                          size_t         aInputLength)
+{
+    // See RFC 4615: a key of other than 16 bytes is first
+    // compressed with AES-CMAC under the all-zero key.
+    static const uint8_t kZeroKey[kAesKeySize] = {0};
+    uint8_t              key[kAesKeySize];
+
+    if (aKeyLength == kAesKeySize)
+    {
+        AesCmac(aOutput, aKey, aInput, aInputLength);
+    }
+    else
+    {
+        AesCmac(key, kZeroKey, aKey, aKeyLength);
+        AesCmac(aOutput, key, aInput, aInputLength);
+    }
+}
+
+std::unique_ptr<AesCcmContext> OpensslCryptoProvider::CreateAesCcmContext()
+{
+    return std::unique_ptr<AesCcmContext>(new OpensslAesCcmContext());
+}
+
+CryptoProvider &GetOpensslCryptoProvider()
+{
+    static OpensslCryptoProvider sOpensslCryptoProvider;
+    return sOpensslCryptoProvider;
+}
+
+} // namespace commissioner
+
+} // namespace ot
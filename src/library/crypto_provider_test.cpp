@@ -0,0 +1,227 @@
+/*
+ *  Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines test cases for crypto providers.
+ */
+
+#include "library/crypto_provider.hpp"
+
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <mbedtls/ccm.h>
+
+#include "common/utils.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+static std::vector<CryptoProvider *> GetAllCryptoProviders()
+{
+    std::vector<CryptoProvider *> providers{&GetMbedtlsCryptoProvider()};
+
+#if OT_COMM_CONFIG_OPENSSL_ENABLE
+    providers.push_back(&GetOpensslCryptoProvider());
+#endif
+
+    return providers;
+}
+
+TEST_CASE("crypto-provider-sha256", "[crypto]")
+{
+    for (auto provider : GetAllCryptoProviders())
+    {
+        const std::string input = "abc";
+        uint8_t           hash[kSha256HashSize];
+
+        provider->Sha256(hash, reinterpret_cast<const uint8_t *>(input.data()), input.size());
+        REQUIRE(utils::Hex({hash, hash + sizeof(hash)}) ==
+                "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    }
+}
+
+TEST_CASE("crypto-provider-sha256-incremental", "[crypto]")
+{
+    const std::string input = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+
+    for (auto provider : GetAllCryptoProviders())
+    {
+        auto    context = provider->CreateSha256Context();
+        uint8_t hash[kSha256HashSize];
+
+        // The context can be restarted after finishing.
+        for (int i = 0; i < 2; ++i)
+        {
+            context->Start();
+            for (auto c : input)
+            {
+                context->Update(reinterpret_cast<const uint8_t *>(&c), 1);
+            }
+            context->Finish(hash);
+            REQUIRE(utils::Hex({hash, hash + sizeof(hash)}) ==
+                    "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+        }
+    }
+}
+
+// Test vectors from section 4 of RFC 4615.
+TEST_CASE("crypto-provider-aes-cmac-prf-128", "[crypto]")
+{
+    const ByteArray message = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09,
+                               0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x12, 0x13};
+    const ByteArray key     = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+                           0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0xed, 0xcb};
+
+    for (auto provider : GetAllCryptoProviders())
+    {
+        uint8_t output[kAesBlockSize];
+
+        provider->AesCmacPrf128(output, key.data(), 18, message.data(), message.size());
+        REQUIRE(utils::Hex({output, output + sizeof(output)}) == "84a348a4a45d235babfffc0d2b4da09a");
+
+        provider->AesCmacPrf128(output, key.data(), 16, message.data(), message.size());
+        REQUIRE(utils::Hex({output, output + sizeof(output)}) == "980ae87b5f4c9c5214f5b6a8455e4c2d");
+
+        provider->AesCmacPrf128(output, key.data(), 10, message.data(), message.size());
+        REQUIRE(utils::Hex({output, output + sizeof(output)}) == "290d9e112edb09ee141fcf64c0b72f3d");
+    }
+}
+
+// Packet vector #1 from RFC 3610.
+TEST_CASE("crypto-provider-aes-ccm", "[crypto]")
+{
+    const uint8_t key[kAesKeySize] = {0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7,
+                                      0xc8, 0xc9, 0xca, 0xcb, 0xcc, 0xcd, 0xce, 0xcf};
+    const ByteArray nonce          = {0x00, 0x00, 0x00, 0x03, 0x02, 0x01, 0x00, 0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5};
+    const ByteArray aad            = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07};
+    const ByteArray plain          = {0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x12,
+                             0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e};
+
+    for (auto provider : GetAllCryptoProviders())
+    {
+        auto      ccm = provider->CreateAesCcmContext();
+        ByteArray record(plain);
+        uint8_t   tag[8];
+
+        REQUIRE(ccm->SetKey(key) == ErrorCode::kNone);
+
+        // Records are protected in place, as by mbedtls.
+        REQUIRE(ccm->Encrypt(record.data(), nonce.data(), nonce.size(), aad.data(), aad.size(), record.data(),
+                             record.size(), tag, sizeof(tag)) == ErrorCode::kNone);
+        REQUIRE(utils::Hex(record) == "588c979a61c663d2f066d0c2c0f989806d5f6b61dac384");
+        REQUIRE(utils::Hex({tag, tag + sizeof(tag)}) == "17e8d12cfdf926e0");
+
+        REQUIRE(ccm->Decrypt(record.data(), nonce.data(), nonce.size(), aad.data(), aad.size(), record.data(),
+                             record.size(), tag, sizeof(tag)) == ErrorCode::kNone);
+        REQUIRE(record == plain);
+
+        REQUIRE(ccm->Encrypt(record.data(), nonce.data(), nonce.size(), aad.data(), aad.size(), record.data(),
+                             record.size(), tag, sizeof(tag)) == ErrorCode::kNone);
+        tag[0] ^= 0x01;
+        REQUIRE(ccm->Decrypt(record.data(), nonce.data(), nonce.size(), aad.data(), aad.size(), record.data(),
+                             record.size(), tag, sizeof(tag)) == ErrorCode::kSecurity);
+        REQUIRE(record == ByteArray(plain.size(), 0));
+
+        REQUIRE(ccm->Encrypt(record.data(), nonce.data(), 6, aad.data(), aad.size(), record.data(), record.size(), tag,
+                             sizeof(tag)) == ErrorCode::kInvalidArgs);
+    }
+}
+
+// Delegates to the mbedtls provider and counts the AES-CCM contexts created.
+class CountingCryptoProvider : public CryptoProvider
+{
+public:
+    const char *GetName() const override { return "counting"; }
+
+    void Sha256(uint8_t aHash[kSha256HashSize], const uint8_t *aBuf, size_t aLength) override
+    {
+        GetMbedtlsCryptoProvider().Sha256(aHash, aBuf, aLength);
+    }
+
+    std::unique_ptr<Sha256Context> CreateSha256Context() override
+    {
+        return GetMbedtlsCryptoProvider().CreateSha256Context();
+    }
+
+    void AesCmacPrf128(uint8_t        aOutput[kAesBlockSize],
+                       const uint8_t *aKey,
+                       size_t         aKeyLength,
+                       const uint8_t *aInput,
+                       size_t         aInputLength) override
+    {
+        GetMbedtlsCryptoProvider().AesCmacPrf128(aOutput, aKey, aKeyLength, aInput, aInputLength);
+    }
+
+    std::unique_ptr<AesCcmContext> CreateAesCcmContext() override
+    {
+        ++mAesCcmContextCount;
+        return GetMbedtlsCryptoProvider().CreateAesCcmContext();
+    }
+
+    size_t mAesCcmContextCount = 0;
+};
+
+TEST_CASE("crypto-provider-protects-mbedtls-records", "[crypto]")
+{
+    const uint8_t key[kAesKeySize] = {0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7,
+                                      0xc8, 0xc9, 0xca, 0xcb, 0xcc, 0xcd, 0xce, 0xcf};
+    const ByteArray nonce          = {0x00, 0x00, 0x00, 0x03, 0x02, 0x01, 0x00, 0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5};
+    const ByteArray aad            = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07};
+    ByteArray       record         = {0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x12,
+                              0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e};
+
+    CountingCryptoProvider provider;
+    mbedtls_ccm_context    ccm;
+    uint8_t                tag[8];
+
+    SetCryptoProvider(&provider);
+    mbedtls_ccm_init(&ccm);
+
+    // The AES-CCM of the mbedtls SSL layer is done by the provider in use.
+    REQUIRE(mbedtls_ccm_setkey(&ccm, MBEDTLS_CIPHER_ID_AES, key, kAesKeySize * 8) == 0);
+    REQUIRE(provider.mAesCcmContextCount == 1);
+    REQUIRE(mbedtls_ccm_encrypt_and_tag(&ccm, record.size(), nonce.data(), nonce.size(), aad.data(), aad.size(),
+                                        record.data(), record.data(), tag, sizeof(tag)) == 0);
+    REQUIRE(utils::Hex(record) == "588c979a61c663d2f066d0c2c0f989806d5f6b61dac384");
+    REQUIRE(utils::Hex({tag, tag + sizeof(tag)}) == "17e8d12cfdf926e0");
+
+    tag[0] ^= 0x01;
+    REQUIRE(mbedtls_ccm_auth_decrypt(&ccm, record.size(), nonce.data(), nonce.size(), aad.data(), aad.size(),
+                                     record.data(), record.data(), tag, sizeof(tag)) == MBEDTLS_ERR_CCM_AUTH_FAILED);
+
+    mbedtls_ccm_free(&ccm);
+    SetCryptoProvider(nullptr);
+}
+
+} // namespace commissioner
+
+} // namespace ot
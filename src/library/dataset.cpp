@@ -0,0 +1,160 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the decoders of Thread datasets.
+ */
+
+#include "library/dataset.hpp"
+
+#include "common/error_macros.hpp"
+#include "common/utils.hpp"
+#include "library/tlv.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+Error DecodeActiveOperationalDataset(ActiveOperationalDataset &aDataset, const ByteArray &aPayload)
+{
+    Error                    error;
+    tlv::TlvSet              tlvSet;
+    ActiveOperationalDataset dataset;
+
+    // Clear all data fields
+    dataset.mPresentFlags = 0;
+
+    SuccessOrExit(error = tlv::GetTlvSet(tlvSet, aPayload));
+
+    if (auto activeTimeStamp = tlvSet[tlv::Type::kActiveTimestamp])
+    {
+        uint64_t value;
+        value                    = utils::Decode<uint64_t>(activeTimeStamp->GetValue());
+        dataset.mActiveTimestamp = Timestamp::Decode(value);
+        dataset.mPresentFlags |= ActiveOperationalDataset::kActiveTimestampBit;
+    }
+
+    if (auto channel = tlvSet[tlv::Type::kChannel])
+    {
+        const ByteArray &value   = channel->GetValue();
+        dataset.mChannel.mPage   = value[0];
+        dataset.mChannel.mNumber = utils::Decode<uint16_t>(value.data() + 1, value.size() - 1);
+        dataset.mPresentFlags |= ActiveOperationalDataset::kChannelBit;
+    }
+
+    if (auto channelMask = tlvSet[tlv::Type::kChannelMask])
+    {
+        SuccessOrExit(DecodeChannelMask(dataset.mChannelMask, channelMask->GetValue()));
+        dataset.mPresentFlags |= ActiveOperationalDataset::kChannelMaskBit;
+    }
+
+    if (auto extendedPanId = tlvSet[tlv::Type::kExtendedPanId])
+    {
+        dataset.mExtendedPanId = extendedPanId->GetValue();
+        dataset.mPresentFlags |= ActiveOperationalDataset::kExtendedPanIdBit;
+    }
+
+    if (auto meshLocalPrefix = tlvSet[tlv::Type::kNetworkMeshLocalPrefix])
+    {
+        dataset.mMeshLocalPrefix = meshLocalPrefix->GetValue();
+        dataset.mPresentFlags |= ActiveOperationalDataset::kMeshLocalPrefixBit;
+    }
+
+    if (auto networkMasterKey = tlvSet[tlv::Type::kNetworkMasterKey])
+    {
+        dataset.mNetworkMasterKey = networkMasterKey->GetValue();
+        dataset.mPresentFlags |= ActiveOperationalDataset::kNetworkMasterKeyBit;
+    }
+
+    if (auto networkName = tlvSet[tlv::Type::kNetworkName])
+    {
+        dataset.mNetworkName = networkName->GetValueAsString();
+        dataset.mPresentFlags |= ActiveOperationalDataset::kNetworkNameBit;
+    }
+
+    if (auto panId = tlvSet[tlv::Type::kPanId])
+    {
+        dataset.mPanId = utils::Decode<uint16_t>(panId->GetValue());
+        dataset.mPresentFlags |= ActiveOperationalDataset::kPanIdBit;
+    }
+
+    if (auto pskc = tlvSet[tlv::Type::kPSKc])
+    {
+        dataset.mPSKc = pskc->GetValue();
+        dataset.mPresentFlags |= ActiveOperationalDataset::kPSKcBit;
+    }
+
+    if (auto securityPolicy = tlvSet[tlv::Type::kSecurityPolicy])
+    {
+        auto &value                           = securityPolicy->GetValue();
+        dataset.mSecurityPolicy.mRotationTime = utils::Decode<uint16_t>(value);
+        dataset.mSecurityPolicy.mFlags        = {value.begin() + sizeof(uint16_t), value.end()};
+        dataset.mPresentFlags |= ActiveOperationalDataset::kSecurityPolicyBit;
+    }
+
+    aDataset = dataset;
+
+exit:
+    return error;
+}
+
+Error DecodeChannelMask(ChannelMask &aChannelMask, const ByteArray &aBuf)
+{
+    Error       error;
+    ChannelMask channelMask;
+    size_t      offset = 0;
+    size_t      length = aBuf.size();
+
+    while (offset < length)
+    {
+        ChannelMaskEntry entry;
+        uint8_t          entryLength;
+        VerifyOrExit(offset + 2 <= length, error = ERROR_BAD_FORMAT("premature end of Channel Mask Entry"));
+
+        entry.mPage = aBuf[offset++];
+        entryLength = aBuf[offset++];
+
+        VerifyOrExit(offset + entryLength <= length, error = ERROR_BAD_FORMAT("premature end of Channel Mask Entry"));
+        entry.mMasks = {aBuf.begin() + offset, aBuf.begin() + offset + entryLength};
+        channelMask.emplace_back(entry);
+
+        offset += entryLength;
+    }
+
+    ASSERT(offset == length);
+
+    aChannelMask = channelMask;
+
+exit:
+    return error;
+}
+
+} // namespace commissioner
+
+} // namespace ot
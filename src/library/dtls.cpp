@@ -47,12 +47,39 @@ namespace ot {
 
 namespace commissioner {
 
-static const int    kAuthMode              = MBEDTLS_SSL_VERIFY_REQUIRED;
-static const size_t kMaxContentLength      = MBEDTLS_SSL_MAX_CONTENT_LEN;
-static const size_t KMaxFragmentLengthCode = MBEDTLS_SSL_MAX_FRAG_LEN_1024;
-static const size_t kMaxTransmissionUnit   = 1280;
+static const int    kAuthMode            = MBEDTLS_SSL_VERIFY_REQUIRED;
+static const size_t kMaxContentLength    = MBEDTLS_SSL_MAX_CONTENT_LEN;
+static const size_t kMaxTransmissionUnit = 1280;
 
-static_assert(256 * (1 << KMaxFragmentLengthCode) <= kMaxContentLength, "invalid DTLS Max Fragment Length");
+static Error GetMaxFragmentLengthCode(unsigned char &aCode, uint16_t aMaxFragmentLength)
+{
+    Error error;
+
+    VerifyOrExit(aMaxFragmentLength <= kMaxContentLength,
+                 error = ERROR_INVALID_ARGS("DTLS Max Fragment Length {} is greater than the max content length {}",
+                                            aMaxFragmentLength, kMaxContentLength));
+
+    switch (aMaxFragmentLength)
+    {
+    case 512:
+        aCode = MBEDTLS_SSL_MAX_FRAG_LEN_512;
+        break;
+    case 1024:
+        aCode = MBEDTLS_SSL_MAX_FRAG_LEN_1024;
+        break;
+    case 2048:
+        aCode = MBEDTLS_SSL_MAX_FRAG_LEN_2048;
+        break;
+    case 4096:
+        aCode = MBEDTLS_SSL_MAX_FRAG_LEN_4096;
+        break;
+    default:
+        ExitNow(error = ERROR_INVALID_ARGS("invalid DTLS Max Fragment Length {}", aMaxFragmentLength));
+    }
+
+exit:
+    return error;
+}
 
 static void HandleMbedtlsDebug(void *, int level, const char *file, int line, const char *str)
 {
@@ -93,7 +120,7 @@ DtlsConfig GetDtlsConfig(const Config &aConfig)
 
 DtlsSession::DtlsSession(struct event_base *aEventBase, bool aIsServer, SocketPtr aSocket)
     : mSocket(aSocket)
-    , mHandshakeTimer(aEventBase, [this](Timer &aTimer) { HandshakeTimerCallback(aTimer); })
+    , mHandshakeTimer(aEventBase, [this](Timer &aTimer) { HandshakeTimerCallback(aTimer); }, aSocket->GetCpuAccount())
     , mState(State::kOpen)
     , mIsServer(aIsServer)
 {
@@ -106,6 +133,14 @@ DtlsSession::~DtlsSession()
     FreeMbedtls();
 }
 
+void DtlsSession::SetSocket(SocketPtr aSocket)
+{
+    VerifyOrDie(mState == State::kOpen);
+
+    mSocket = aSocket;
+    mSocket->SetEventHandler([this](short aFlags) { HandleEvent(aFlags); });
+}
+
 void DtlsSession::InitMbedtls()
 {
     mbedtls_ssl_config_init(&mConfig);
@@ -134,7 +169,10 @@ void DtlsSession::FreeMbedtls()
 
 Error DtlsSession::Init(const DtlsConfig &aConfig)
 {
-    Error error;
+    Error         error;
+    unsigned char maxFragmentLengthCode = MBEDTLS_SSL_MAX_FRAG_LEN_NONE;
+
+    SuccessOrExit(error = GetMaxFragmentLengthCode(maxFragmentLengthCode, aConfig.mMaxFragmentLength));
 
     if (int fail = mbedtls_ssl_config_defaults(&mConfig, mIsServer, MBEDTLS_SSL_TRANSPORT_DATAGRAM,
                                                MBEDTLS_SSL_PRESET_DEFAULT))
@@ -218,7 +256,9 @@ Error DtlsSession::Init(const DtlsConfig &aConfig)
     // Timer
     mbedtls_ssl_set_timer_cb(&mSsl, &mHandshakeTimer, DtlsTimer::SetDelay, DtlsTimer::GetDelay);
 
-    if (int fail = mbedtls_ssl_conf_max_frag_len(&mConfig, KMaxFragmentLengthCode))
+    // Only a client sends the Max Fragment Length extension, a server
+    // echoes the one of its client and ignores this setting otherwise.
+    if (int fail = mbedtls_ssl_conf_max_frag_len(&mConfig, maxFragmentLengthCode))
     {
         ExitNow(error = ErrorFromMbedtlsError(fail));
     }
@@ -70,6 +70,14 @@ struct DtlsConfig
     ByteArray mOwnKey;
     ByteArray mOwnCert;
     ByteArray mCaChain;
+
+    // The DTLS Max Fragment Length (RFC 6066), one of 512, 1024, 2048 and
+    // 4096 but no greater than MBEDTLS_SSL_MAX_CONTENT_LEN. The record
+    // buffers of a connected session are shrunk to it. A client requests
+    // it in the handshake, but a server only applies the length requested
+    // by its client: a server session whose client doesn't negotiate the
+    // extension keeps buffers of MBEDTLS_SSL_MAX_CONTENT_LEN.
+    uint16_t mMaxFragmentLength = 1024;
 };
 
 DtlsConfig GetDtlsConfig(const Config &aConfig);
@@ -97,6 +105,9 @@ public:
 
     Error Init(const DtlsConfig &aConfig);
 
+    // Replaces the underlying socket. This must happen before initialization.
+    void SetSocket(SocketPtr aSocket);
+
     // Reset session state without changing user configurations.
     void Reset();
 
@@ -112,6 +123,9 @@ public:
 
     uint16_t GetLocalPort() const { return mSocket->GetLocalPort(); }
 
+    // The number of messages waiting for the socket to be writable.
+    size_t GetSendQueueSize() const { return mSendQueue.size(); }
+
     const mbedtls_x509_crt *GetPeerCertificate() const { return mSsl.session ? mSsl.session->peer_cert : nullptr; }
 
     const ByteArray &GetKek() const { return mKek; }
@@ -122,8 +136,8 @@ private:
     class DtlsTimer : public Timer
     {
     public:
-        DtlsTimer(struct event_base *aEventBase, Action aAction)
-            : Timer(aEventBase, aAction)
+        DtlsTimer(struct event_base *aEventBase, Action aAction, CpuAccount *aCpuAccount)
+            : Timer(aEventBase, aAction, /* aIsSingle */ true, aCpuAccount)
             , mCancelled(false)
         {
         }
@@ -170,6 +170,45 @@ TEST_CASE("dtls-mbedtls-client-server", "[dtls]")
     event_base_free(eventBase);
 }
 
+TEST_CASE("dtls-max-fragment-length", "[dtls]")
+{
+    auto eventBase = event_base_new();
+    REQUIRE(eventBase != nullptr);
+
+    {
+        DtlsConfig config;
+        config.mPSK = {'1', '2', '3', '4', '5', '6'};
+
+        auto socket = std::make_shared<UdpSocket>(eventBase);
+
+        SECTION("smaller fragments than the max content length are accepted")
+        {
+            DtlsSession dtlsSession{eventBase, true, socket};
+
+            config.mMaxFragmentLength = 512;
+            REQUIRE(dtlsSession.Init(config) == ErrorCode::kNone);
+        }
+
+        SECTION("fragments larger than the max content length are rejected")
+        {
+            DtlsSession dtlsSession{eventBase, true, socket};
+
+            config.mMaxFragmentLength = 2 * MBEDTLS_SSL_MAX_CONTENT_LEN;
+            REQUIRE(dtlsSession.Init(config) == ErrorCode::kInvalidArgs);
+        }
+
+        SECTION("fragment lengths not defined by RFC 6066 are rejected")
+        {
+            DtlsSession dtlsSession{eventBase, true, socket};
+
+            config.mMaxFragmentLength = 500;
+            REQUIRE(dtlsSession.Init(config) == ErrorCode::kInvalidArgs);
+        }
+    }
+
+    event_base_free(eventBase);
+}
+
 } // namespace commissioner
 
 } // namespace ot
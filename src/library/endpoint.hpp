@@ -57,8 +57,14 @@ public:
 
     void SetReceiver(Receiver aReceiver) { mReceiver = aReceiver; }
 
+    // Whether the peer accepts extended TLVs (e.g. UDP Encapsulation TLV)
+    // in the base TLV format, which saves 2 bytes per TLV.
+    void SetCompactExtendedTlv(bool aEnabled) { mCompactExtendedTlv = aEnabled; }
+    bool IsCompactExtendedTlv() const { return mCompactExtendedTlv; }
+
 protected:
-    Receiver mReceiver = nullptr;
+    Receiver mReceiver           = nullptr;
+    bool     mCompactExtendedTlv = false;
 };
 
 } // namespace commissioner
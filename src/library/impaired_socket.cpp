@@ -0,0 +1,272 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   The file implements the impaired socket.
+ */
+
+#include "library/impaired_socket.hpp"
+
+#include <string.h>
+
+#include "common/utils.hpp"
+#include "library/logging.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+// The max size of a datagram read from the underlying socket.
+static constexpr size_t kMaxDatagramSize = 2048;
+
+// A rate-limited link drops datagrams which would wait longer than this for transmission.
+static constexpr std::chrono::seconds kMaxQueueDelay{1};
+
+ImpairedSocket::ImpairedSocket(struct event_base *aEventBase, SocketPtr aSocket, const ImpairmentConfig &aConfig)
+    : Socket(aEventBase, aSocket->GetCpuAccount())
+    , mSocket(aSocket)
+    , mConfig(aConfig)
+    , mRandom(aConfig.mSeed)
+    , mSendLink(aEventBase,
+                mCpuAccount,
+                [this](const ByteArray &aDatagram) { mSocket->Send(aDatagram.data(), aDatagram.size()); })
+    , mRecvLink(aEventBase, mCpuAccount, [this](const ByteArray &aDatagram) { HandleDatagramReceived(aDatagram); })
+    , mRecvBuf(kMaxDatagramSize)
+{
+    int fail;
+
+    fail = event_assign(&mEvent, mEventBase, -1, EV_PERSIST, HandleEvent, this);
+    VerifyOrDie(fail == 0);
+    VerifyOrDie((fail = event_add(&mEvent, nullptr)) == 0);
+
+    mSocket->SetEventHandler([this](short aFlags) { HandleSocketEvent(aFlags); });
+}
+
+ImpairedSocket::~ImpairedSocket()
+{
+    // The underlying socket may outlive this socket.
+    mSocket->SetEventHandler([](short) {});
+}
+
+void ImpairedSocket::SetConfig(const ImpairmentConfig &aConfig)
+{
+    if (aConfig.mSeed != mConfig.mSeed)
+    {
+        mRandom.seed(aConfig.mSeed);
+    }
+    mConfig = aConfig;
+}
+
+int ImpairedSocket::Send(const uint8_t *aBuf, size_t aLen)
+{
+    int rval = static_cast<int>(aLen);
+
+    mIsConnected = mSocket->IsConnected();
+
+    if (mConfig.IsEnabled())
+    {
+        mSendLink.Transmit(*this, aBuf, aLen);
+    }
+    else
+    {
+        rval = mSocket->Send(aBuf, aLen);
+    }
+
+    return rval;
+}
+
+int ImpairedSocket::Receive(uint8_t *aBuf, size_t aMaxLen)
+{
+    int rval;
+
+    if (mRecvQueue.empty())
+    {
+        // Datagrams of the underlying socket are drained into the receive queue when impaired.
+        if (mConfig.IsEnabled())
+        {
+            return MBEDTLS_ERR_SSL_WANT_READ;
+        }
+
+        rval          = mSocket->Receive(aBuf, aMaxLen);
+        mLastRecvTime = mSocket->GetLastRecvTime();
+        return rval;
+    }
+
+    {
+        auto &datagram = mRecvQueue.front();
+
+        // Like a UDP socket, the part of the datagram that doesn't fit into the buffer is discarded.
+        rval = static_cast<int>(std::min(aMaxLen, datagram.size()));
+        memcpy(aBuf, datagram.data(), rval);
+        mRecvQueue.pop();
+
+        // The datagram arrives when it leaves the emulated link.
+        mLastRecvTime = Clock::now();
+    }
+
+    if (!mRecvQueue.empty())
+    {
+        event_active(&mEvent, EV_READ, 0);
+    }
+
+    return rval;
+}
+
+void ImpairedSocket::SetEventHandler(EventHandler aEventHandler)
+{
+    mEventHandler = aEventHandler;
+}
+
+bool ImpairedSocket::Happens(double aProbability)
+{
+    return aProbability > 0 && std::bernoulli_distribution(std::min(aProbability, 1.0))(mRandom);
+}
+
+void ImpairedSocket::HandleSocketEvent(short aFlags)
+{
+    mIsConnected = mSocket->IsConnected();
+
+    if (mConfig.IsEnabled() && (aFlags & EV_READ))
+    {
+        int rval;
+
+        while ((rval = mSocket->Receive(mRecvBuf.data(), mRecvBuf.size())) > 0)
+        {
+            mRecvLink.Transmit(*this, mRecvBuf.data(), static_cast<size_t>(rval));
+        }
+
+        if (rval != MBEDTLS_ERR_SSL_WANT_READ)
+        {
+            LOG_WARN(LOG_REGION_SOCKET, "impaired socket(={}) receive failed: {}", static_cast<void *>(this), rval);
+        }
+
+        // Received datagrams are reported when they leave the emulated link.
+        aFlags &= ~EV_READ;
+    }
+
+    if (aFlags != 0 && mEventHandler != nullptr)
+    {
+        mEventHandler(aFlags);
+    }
+}
+
+void ImpairedSocket::HandleDatagramReceived(const ByteArray &aDatagram)
+{
+    mRecvQueue.push(aDatagram);
+    event_active(&mEvent, EV_READ, 0);
+}
+
+ImpairedSocket::Link::Link(struct event_base *aEventBase, CpuAccount *aCpuAccount, Deliver aDeliver)
+    : mDeliver(aDeliver)
+    , mTimer(aEventBase, [this](Timer &aTimer) { HandleTimer(aTimer); }, /* aIsSingle */ true, aCpuAccount)
+{
+}
+
+void ImpairedSocket::Link::Transmit(ImpairedSocket &aSocket, const uint8_t *aBuf, size_t aLen)
+{
+    const auto &config    = aSocket.mConfig;
+    auto        now       = Clock::now();
+    auto        departure = now;
+    auto        delay     = Duration(MilliSeconds(config.mDelay));
+    ByteArray   datagram{aBuf, aBuf + aLen};
+
+    if (aSocket.Happens(config.mLossRate))
+    {
+        ++mCounters.mDropped;
+        ExitNow();
+    }
+
+    if (config.mRateLimit > 0)
+    {
+        // The datagram departs after the link has finished transmitting all previous datagrams.
+        departure = std::max(now, mIdleTime);
+        if (departure - now > kMaxQueueDelay)
+        {
+            ++mCounters.mDropped;
+            ExitNow();
+        }
+        mIdleTime = departure + std::chrono::microseconds(uint64_t{aLen} * 1000000 / config.mRateLimit);
+    }
+
+    if (config.mDelayJitter > 0)
+    {
+        delay += MilliSeconds(std::uniform_int_distribution<uint32_t>(0, config.mDelayJitter)(aSocket.mRandom));
+    }
+
+    if (aSocket.Happens(config.mReorderRate))
+    {
+        // Datagrams sent later will overtake this one.
+        delay += MilliSeconds(config.mReorderDelay);
+        ++mCounters.mReordered;
+    }
+
+    Schedule(departure + delay, datagram);
+
+    if (aSocket.Happens(config.mDuplicateRate))
+    {
+        Schedule(departure + delay, datagram);
+        ++mCounters.mDuplicated;
+    }
+
+exit:
+    return;
+}
+
+void ImpairedSocket::Link::Schedule(TimePoint aTime, const ByteArray &aDatagram)
+{
+    mInFlight.emplace(aTime, aDatagram);
+
+    if (!mTimer.IsRunning() || aTime < mTimer.GetFireTime())
+    {
+        mTimer.Start(aTime);
+    }
+}
+
+void ImpairedSocket::Link::HandleTimer(Timer &aTimer)
+{
+    auto now = Clock::now();
+
+    while (!mInFlight.empty() && mInFlight.begin()->first <= now)
+    {
+        ByteArray datagram = std::move(mInFlight.begin()->second);
+
+        mInFlight.erase(mInFlight.begin());
+        ++mCounters.mDelivered;
+        mDeliver(datagram);
+    }
+
+    if (!mInFlight.empty())
+    {
+        aTimer.Start(mInFlight.begin()->first);
+    }
+}
+
+} // namespace commissioner
+
+} // namespace ot
@@ -0,0 +1,135 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   The file includes definitions of the impaired socket.
+ *
+ *   An impaired socket wraps another socket and emulates a lossy,
+ *   high latency link in both directions according to an
+ *   ImpairmentConfig. All random decisions are drawn from a generator
+ *   seeded by the config, so a run can be reproduced exactly when
+ *   driven by the SimulatedEventLoop.
+ *
+ *   This is for reproducing lossy, high latency networks in tests and
+ *   benchmarks. It is inserted into a link only if an impairment is
+ *   enabled, see Config::mImpairment.
+ */
+
+#ifndef OT_COMM_LIBRARY_IMPAIRED_SOCKET_HPP_
+#define OT_COMM_LIBRARY_IMPAIRED_SOCKET_HPP_
+
+#include <map>
+#include <queue>
+#include <random>
+
+#include <commissioner/commissioner.hpp>
+
+#include "common/time.hpp"
+#include "library/socket.hpp"
+#include "library/timer.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+struct ImpairmentCounters
+{
+    uint64_t mDelivered  = 0; ///< Datagrams delivered, including duplicates.
+    uint64_t mDropped    = 0; ///< Datagrams dropped by emulated loss or rate limiting.
+    uint64_t mDuplicated = 0; ///< Datagrams delivered twice.
+    uint64_t mReordered  = 0; ///< Datagrams held back by the reorder delay.
+};
+
+class ImpairedSocket : public Socket
+{
+public:
+    ImpairedSocket(struct event_base *aEventBase, SocketPtr aSocket, const ImpairmentConfig &aConfig = {});
+    ImpairedSocket(ImpairedSocket &&aOther) = delete;
+    ~ImpairedSocket() override;
+
+    // Changes the impairments. Datagrams already in flight are not affected.
+    void SetConfig(const ImpairmentConfig &aConfig);
+
+    const ImpairmentConfig &GetConfig() const { return mConfig; }
+
+    const ImpairmentCounters &GetSendCounters() const { return mSendLink.mCounters; }
+    const ImpairmentCounters &GetRecvCounters() const { return mRecvLink.mCounters; }
+
+    uint16_t GetLocalPort() const override { return mSocket->GetLocalPort(); }
+    Address  GetLocalAddr() const override { return mSocket->GetLocalAddr(); }
+    uint16_t GetPeerPort() const override { return mSocket->GetPeerPort(); }
+    Address  GetPeerAddr() const override { return mSocket->GetPeerAddr(); }
+
+    // A datagram dropped by the emulated link is reported as sent.
+    int Send(const uint8_t *aBuf, size_t aLen) override;
+
+    int Receive(uint8_t *aBuf, size_t aMaxLen) override;
+
+    void SetEventHandler(EventHandler aEventHandler) override;
+
+private:
+    // A single direction of the emulated link.
+    struct Link
+    {
+        using Deliver = std::function<void(const ByteArray &aDatagram)>;
+
+        Link(struct event_base *aEventBase, CpuAccount *aCpuAccount, Deliver aDeliver);
+
+        void Transmit(ImpairedSocket &aSocket, const uint8_t *aBuf, size_t aLen);
+        void Schedule(TimePoint aTime, const ByteArray &aDatagram);
+        void HandleTimer(Timer &aTimer);
+
+        Deliver                             mDeliver;
+        std::multimap<TimePoint, ByteArray> mInFlight;
+        TimePoint                           mIdleTime;
+        Timer                               mTimer;
+        ImpairmentCounters                  mCounters;
+    };
+
+    bool Happens(double aProbability);
+
+    void HandleSocketEvent(short aFlags);
+    void HandleDatagramReceived(const ByteArray &aDatagram);
+
+    SocketPtr             mSocket;
+    ImpairmentConfig      mConfig;
+    std::mt19937          mRandom;
+    Link                  mSendLink;
+    Link                  mRecvLink;
+    std::queue<ByteArray> mRecvQueue;
+    ByteArray             mRecvBuf;
+};
+
+using ImpairedSocketPtr = std::shared_ptr<ImpairedSocket>;
+
+} // namespace commissioner
+
+} // namespace ot
+
+#endif // OT_COMM_LIBRARY_IMPAIRED_SOCKET_HPP_
@@ -0,0 +1,303 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines test cases for the impaired socket.
+ */
+
+#include "library/impaired_socket.hpp"
+
+#include <memory.h>
+
+#include <catch2/catch.hpp>
+
+#include "library/simulated_event_loop.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+// A socket delivering datagrams to its peer in the same event base.
+class LoopbackSocket : public Socket
+{
+public:
+    explicit LoopbackSocket(struct event_base *aEventBase)
+        : Socket(aEventBase)
+    {
+        mIsConnected = true;
+        VerifyOrDie(event_assign(&mEvent, mEventBase, -1, EV_PERSIST, HandleEvent, this) == 0);
+        VerifyOrDie(event_add(&mEvent, nullptr) == 0);
+    }
+
+    uint16_t GetLocalPort() const override { return 0; }
+    Address  GetLocalAddr() const override { return Address{}; }
+    uint16_t GetPeerPort() const override { return 0; }
+    Address  GetPeerAddr() const override { return Address{}; }
+
+    int Send(const uint8_t *aBuf, size_t aLen) override
+    {
+        mPeer->mDatagrams.emplace(aBuf, aBuf + aLen);
+        event_active(&mPeer->mEvent, EV_READ, 0);
+        return static_cast<int>(aLen);
+    }
+
+    int Receive(uint8_t *aBuf, size_t aMaxLen) override
+    {
+        int rval = MBEDTLS_ERR_SSL_WANT_READ;
+
+        if (!mDatagrams.empty())
+        {
+            rval = static_cast<int>(std::min(aMaxLen, mDatagrams.front().size()));
+            memcpy(aBuf, mDatagrams.front().data(), rval);
+            mDatagrams.pop();
+        }
+        return rval;
+    }
+
+    static void Connect(LoopbackSocket &aSocket0, LoopbackSocket &aSocket1)
+    {
+        aSocket0.mPeer = &aSocket1;
+        aSocket1.mPeer = &aSocket0;
+    }
+
+private:
+    LoopbackSocket *      mPeer = nullptr;
+    std::queue<ByteArray> mDatagrams;
+};
+
+// Collects all datagrams arriving at the socket.
+static void CollectDatagrams(Socket &aSocket, std::vector<ByteArray> &aDatagrams)
+{
+    aSocket.SetEventHandler([&aSocket, &aDatagrams](short aFlags) {
+        uint8_t buf[256];
+        int     rval;
+
+        REQUIRE((aFlags & EV_READ));
+        while ((rval = aSocket.Receive(buf, sizeof(buf))) > 0)
+        {
+            aDatagrams.emplace_back(buf, buf + rval);
+        }
+    });
+}
+
+static void SendDatagrams(Socket &aSocket, size_t aCount, size_t aLength = 2)
+{
+    for (size_t i = 0; i < aCount; ++i)
+    {
+        ByteArray datagram(aLength, 0);
+
+        datagram[0] = static_cast<uint8_t>(i >> 8);
+        datagram[1] = static_cast<uint8_t>(i & 0xFF);
+        REQUIRE(aSocket.Send(datagram.data(), datagram.size()) == static_cast<int>(datagram.size()));
+    }
+}
+
+static size_t GetIndex(const ByteArray &aDatagram)
+{
+    return (static_cast<size_t>(aDatagram[0]) << 8) | aDatagram[1];
+}
+
+TEST_CASE("impaired-socket-pass-through", "[impaired-socket]")
+{
+    auto eventBase = event_base_new();
+    REQUIRE(eventBase != nullptr);
+
+    {
+        SimulatedEventLoop     loop{eventBase};
+        auto                   socket = std::make_shared<LoopbackSocket>(eventBase);
+        LoopbackSocket         peer{eventBase};
+        ImpairedSocket         impairedSocket{eventBase, socket};
+        std::vector<ByteArray> sent;
+        std::vector<ByteArray> received;
+        auto                   startTime = Clock::now();
+
+        LoopbackSocket::Connect(*socket, peer);
+        CollectDatagrams(peer, sent);
+        CollectDatagrams(impairedSocket, received);
+
+        REQUIRE_FALSE(impairedSocket.GetConfig().IsEnabled());
+
+        SendDatagrams(impairedSocket, 10);
+        SendDatagrams(peer, 10);
+        REQUIRE(loop.RunUntil([&]() { return sent.size() == 10 && received.size() == 10; }, std::chrono::seconds(1)));
+        REQUIRE(Clock::now() == startTime);
+    }
+
+    event_base_free(eventBase);
+}
+
+TEST_CASE("impaired-socket-loss", "[impaired-socket]")
+{
+    static constexpr size_t kDatagramNum = 1000;
+
+    auto eventBase = event_base_new();
+    REQUIRE(eventBase != nullptr);
+
+    auto run = [eventBase](uint32_t aSeed, double aLossRate) {
+        SimulatedEventLoop     loop{eventBase};
+        auto                   socket = std::make_shared<LoopbackSocket>(eventBase);
+        LoopbackSocket         peer{eventBase};
+        ImpairmentConfig       config;
+        std::vector<ByteArray> received;
+
+        config.mSeed     = aSeed;
+        config.mLossRate = aLossRate;
+
+        ImpairedSocket impairedSocket{eventBase, socket, config};
+
+        LoopbackSocket::Connect(*socket, peer);
+        CollectDatagrams(peer, received);
+
+        SendDatagrams(impairedSocket, kDatagramNum);
+        loop.RunFor(std::chrono::seconds(1));
+
+        REQUIRE(impairedSocket.GetSendCounters().mDropped + received.size() == kDatagramNum);
+
+        return received;
+    };
+
+    auto received = run(1, 0.2);
+
+    REQUIRE(received.size() > kDatagramNum * 7 / 10);
+    REQUIRE(received.size() < kDatagramNum * 9 / 10);
+
+    // The same seed reproduces the same losses.
+    REQUIRE(run(1, 0.2) == received);
+    REQUIRE(run(2, 0.2) != received);
+
+    REQUIRE(run(1, 0).size() == kDatagramNum);
+    REQUIRE(run(1, 1).empty());
+
+    event_base_free(eventBase);
+}
+
+TEST_CASE("impaired-socket-delay-reorder-duplicate", "[impaired-socket]")
+{
+    auto eventBase = event_base_new();
+    REQUIRE(eventBase != nullptr);
+
+    {
+        SimulatedEventLoop     loop{eventBase};
+        auto                   socket = std::make_shared<LoopbackSocket>(eventBase);
+        LoopbackSocket         peer{eventBase};
+        ImpairedSocket         impairedSocket{eventBase, socket};
+        ImpairmentConfig       config;
+        std::vector<ByteArray> sent;
+        std::vector<ByteArray> received;
+        auto                   startTime = Clock::now();
+
+        LoopbackSocket::Connect(*socket, peer);
+        CollectDatagrams(peer, sent);
+        CollectDatagrams(impairedSocket, received);
+
+        SECTION("delay applies to both directions")
+        {
+            config.mDelay = 200;
+            impairedSocket.SetConfig(config);
+
+            SendDatagrams(impairedSocket, 10);
+            SendDatagrams(peer, 10);
+            loop.RunFor(std::chrono::milliseconds(199));
+            REQUIRE(sent.empty());
+            REQUIRE(received.empty());
+
+            loop.RunFor(std::chrono::milliseconds(1));
+            REQUIRE(sent.size() == 10);
+            REQUIRE(received.size() == 10);
+            REQUIRE(impairedSocket.GetRecvCounters().mDelivered == 10);
+        }
+
+        SECTION("jitter is bounded")
+        {
+            config.mDelay       = 100;
+            config.mDelayJitter = 50;
+            impairedSocket.SetConfig(config);
+
+            SendDatagrams(impairedSocket, 100);
+            loop.RunFor(std::chrono::milliseconds(99));
+            REQUIRE(sent.empty());
+
+            REQUIRE(loop.RunUntil([&]() { return sent.size() == 100; }, std::chrono::seconds(1)));
+            REQUIRE(Clock::now() <= startTime + std::chrono::milliseconds(150));
+        }
+
+        SECTION("reordered datagrams are overtaken")
+        {
+            config.mDelay       = 10;
+            config.mReorderRate = 1;
+            impairedSocket.SetConfig(config);
+            SendDatagrams(impairedSocket, 1);
+
+            config.mReorderRate = 0;
+            impairedSocket.SetConfig(config);
+            SendDatagrams(impairedSocket, 2);
+
+            REQUIRE(loop.RunUntil([&]() { return sent.size() == 2; }, std::chrono::seconds(1)));
+            REQUIRE(loop.RunUntil([&]() { return sent.size() == 3; }, std::chrono::seconds(1)));
+            REQUIRE(GetIndex(sent[0]) == 0);
+            REQUIRE(GetIndex(sent[1]) == 1);
+            REQUIRE(GetIndex(sent[2]) == 0);
+            REQUIRE(Clock::now() == startTime + std::chrono::milliseconds(110));
+            REQUIRE(impairedSocket.GetSendCounters().mReordered == 1);
+        }
+
+        SECTION("duplicated datagrams are delivered twice")
+        {
+            config.mDuplicateRate = 1;
+            impairedSocket.SetConfig(config);
+
+            SendDatagrams(impairedSocket, 5);
+            loop.RunFor(std::chrono::milliseconds(1));
+            REQUIRE(sent.size() == 10);
+            REQUIRE(impairedSocket.GetSendCounters().mDuplicated == 5);
+        }
+
+        SECTION("rate limit")
+        {
+            config.mRateLimit = 1000;
+            impairedSocket.SetConfig(config);
+
+            // Datagrams queued for more than one second are dropped.
+            SendDatagrams(impairedSocket, 20, 100);
+            REQUIRE(impairedSocket.GetSendCounters().mDropped == 9);
+
+            loop.RunFor(std::chrono::milliseconds(500));
+            REQUIRE(sent.size() == 6);
+
+            REQUIRE(loop.RunUntil([&]() { return sent.size() == 11; }, std::chrono::seconds(2)));
+            REQUIRE(Clock::now() == startTime + std::chrono::seconds(1));
+        }
+    }
+
+    event_base_free(eventBase);
+}
+
+} // namespace commissioner
+
+} // namespace ot
@@ -58,8 +58,10 @@ JoinerSession::JoinerSession(CommissionerImpl & aCommImpl,
     , mJoinerRouterLocator(aJoinerRouterLocator)
     , mRelaySocket(std::make_shared<RelaySocket>(*this, aJoinerAddr, aJoinerPort, aLocalAddr, aLocalPort))
     , mDtlsSession(std::make_shared<DtlsSession>(aCommImpl.GetEventBase(), /* aIsServer */ true, mRelaySocket))
-    , mCoap(aCommImpl.GetEventBase(), *mDtlsSession)
+    , mCoap(aCommImpl.GetEventBase(), *mDtlsSession, &aCommImpl.mCpuAccount)
     , mResourceJoinFin(uri::kJoinFin, [this](const coap::Request &aRequest) { HandleJoinFin(aRequest); })
+    , mIsJoinFinDeferred(false)
+    , mCreationTime(Clock::now())
 {
     SuccessOrDie(mCoap.AddResource(mResourceJoinFin));
 }
@@ -69,11 +71,13 @@ void JoinerSession::Connect()
     Error error;
 
     auto dtlsConfig = GetDtlsConfig(mCommImpl.GetConfig());
-    dtlsConfig.mPSK = {mJoinerPSKd.begin(), mJoinerPSKd.end()};
+    dtlsConfig.mPSK               = {mJoinerPSKd.begin(), mJoinerPSKd.end()};
+    dtlsConfig.mMaxFragmentLength = kJoinerMaxFragmentLength;
 
     mExpirationTime = Clock::now() + MilliSeconds(kDtlsHandshakeTimeoutMax * 1000 + kJoinerTimeout * 1000);
 
     SuccessOrExit(error = mDtlsSession->Init(dtlsConfig));
+    mCommImpl.mJournal.Append(journal::Event::kHandshakeStarted, mJoinerId);
 
     {
         auto onConnected = [this](const DtlsSession &, Error aError) { HandleConnect(aError); };
@@ -96,7 +100,22 @@ ByteArray JoinerSession::GetJoinerIid() const
 
 void JoinerSession::HandleConnect(Error aError)
 {
-    mCommImpl.mCommissionerHandler.OnJoinerConnected(mJoinerId, aError);
+    mCommImpl.mJournal.Append(journal::Event::kHandshakeFinished, mJoinerId, static_cast<int32_t>(aError.GetCode()));
+
+    if (aError != ErrorCode::kNone)
+    {
+        Release();
+    }
+    else
+    {
+        mCommImpl.mMetrics.Increase(metrics::Counter::kJoinersConnected);
+    }
+
+    {
+        CpuScope cpuScope(&mCommImpl.mCpuAccount, CpuCategory::kHandler);
+
+        mCommImpl.mCommissionerHandler.OnJoinerConnected(mJoinerId, aError);
+    }
 }
 
 void JoinerSession::RecvJoinerDtlsRecords(const ByteArray &aRecords)
@@ -114,7 +133,8 @@ Error JoinerSession::SendRlyTx(const ByteArray &aDtlsMessage, bool aIncludeKek)
     SuccessOrExit(error = AppendTlv(rlyTx, {tlv::Type::kJoinerUdpPort, GetJoinerUdpPort()}));
     SuccessOrExit(error = AppendTlv(rlyTx, {tlv::Type::kJoinerRouterLocator, GetJoinerRouterLocator()}));
     SuccessOrExit(error = AppendTlv(rlyTx, {tlv::Type::kJoinerIID, GetJoinerIid()}));
-    SuccessOrExit(error = AppendTlv(rlyTx, {tlv::Type::kJoinerDtlsEncapsulation, aDtlsMessage}));
+    SuccessOrExit(error = AppendTlv(rlyTx, {tlv::Type::kJoinerDtlsEncapsulation, aDtlsMessage},
+                                    mCommImpl.mBrClient.GetDtlsSession().IsCompactExtendedTlv()));
 
     if (aIncludeKek)
     {
@@ -123,6 +143,10 @@ Error JoinerSession::SendRlyTx(const ByteArray &aDtlsMessage, bool aIncludeKek)
     }
 
     mCommImpl.mBrClient.SendRequest(rlyTx, nullptr);
+    if (aIncludeKek)
+    {
+        mCommImpl.mJournal.Append(journal::Event::kKekSent, mJoinerId);
+    }
 
     LOG_DEBUG(LOG_REGION_JOINER_SESSION,
               "session(={}) sent RLY_TX.ntf: SessionState={}, joinerID={}, length={}, includeKek={}",
@@ -135,7 +159,7 @@ exit:
 
 void JoinerSession::HandleJoinFin(const coap::Request &aJoinFin)
 {
-    bool        accepted = false;
+    bool        deferred = false;
     Error       error;
     tlv::TlvSet tlvSet;
     tlv::TlvPtr stateTlv              = nullptr;
@@ -179,44 +203,135 @@ void JoinerSession::HandleJoinFin(const coap::Request &aJoinFin)
              static_cast<void *>(this), vendorNameTlv->GetValueAsString(), vendorModelTlv->GetValueAsString(),
              vendorSwVersionTlv->GetValueAsString(), utils::Hex(vendorStackVersionTlv->GetValue()), provisioningUrl,
              utils::Hex(vendorData));
+    mCommImpl.mJournal.Append(journal::Event::kJoinFinReceived, mJoinerId, 0,
+                              vendorNameTlv->GetValueAsString() + "/" + vendorModelTlv->GetValueAsString());
+
+    // A new JOIN_FIN.req is ignored until the user decided on the first one,
+    // retransmissions of the first one are answered by the CoAP layer.
+    if (mJoinFin != nullptr)
+    {
+        LOG_INFO(LOG_REGION_JOINER_SESSION, "session(={}) ignored JOIN_FIN.req: waiting for the user",
+                 static_cast<void *>(this));
+        ExitNow();
+    }
+
+    // The user may take a while to approve the joiner, acknowledge the
+    // request first to stop the joiner from retransmitting JOIN_FIN.req.
+    if (mCoap.DeferResponse(aJoinFin) == ErrorCode::kNone)
+    {
+        deferred = true;
+    }
+
+    mJoinFin.reset(new coap::Request(aJoinFin));
+    mIsJoinFinDeferred = deferred;
+
+    // The user has at least another kJoinerTimeout seconds to decide.
+    mExpirationTime = std::max(mExpirationTime, Clock::now() + std::chrono::seconds(kJoinerTimeout));
+    mCommImpl.ScheduleJoinerSessionTimer(mExpirationTime);
 
     // Validation done, request commissioning by user.
-    accepted = mCommImpl.mCommissionerHandler.OnJoinerFinalize(
-        mJoinerId, vendorNameTlv->GetValueAsString(), vendorModelTlv->GetValueAsString(),
-        vendorSwVersionTlv->GetValueAsString(), vendorStackVersionTlv->GetValue(), provisioningUrl, vendorData);
-    VerifyOrExit(accepted, error = ERROR_REJECTED("joiner(ID={}) is rejected", utils::Hex(mJoinerId)));
+    {
+        CpuScope cpuScope(&mCommImpl.mCpuAccount, CpuCategory::kHandler);
+        auto     completion = mCommImpl.MakeJoinerFinalizeCompletion(mJoinerId, aJoinFin.GetToken());
+
+        mCommImpl.mCommissionerHandler.OnJoinerFinalize(
+            mJoinerId, vendorNameTlv->GetValueAsString(), vendorModelTlv->GetValueAsString(),
+            vendorSwVersionTlv->GetValueAsString(), vendorStackVersionTlv->GetValue(), provisioningUrl, vendorData,
+            completion);
+    }
 
 exit:
     if (error != ErrorCode::kNone)
     {
         LOG_WARN(LOG_REGION_JOINER_SESSION, "session(={}) handle JOIN_FIN.req failed: {}", static_cast<void *>(this),
                  error.ToString());
+
+        // Malformed requests are rejected right away.
+        mCommImpl.mJournal.Append(journal::Event::kJoinerRejected, mJoinerId, static_cast<int32_t>(error.GetCode()));
+        IgnoreError(SendJoinFinResponse(aJoinFin, /* aAccept */ false, /* aSeparate */ false));
+        LOG_INFO(LOG_REGION_JOINER_SESSION, "session(={}) sent JOIN_FIN.rsp: accepted=false, separate=false",
+                 static_cast<void *>(this));
     }
+}
+
+void JoinerSession::CompleteJoinFin(const ByteArray &aToken, bool aAccepted)
+{
+    Error                          error;
+    std::unique_ptr<coap::Request> joinFin;
+
+    VerifyOrExit(mJoinFin != nullptr && mJoinFin->GetToken() == aToken,
+                 error = ERROR_INVALID_STATE("JOIN_FIN.req has already been answered"));
+    joinFin = std::move(mJoinFin);
+
+    mCommImpl.mMetrics.Increase(aAccepted ? metrics::Counter::kJoinersAccepted : metrics::Counter::kJoinersRejected);
+    mCommImpl.mJournal.Append(aAccepted ? journal::Event::kJoinerAccepted : journal::Event::kJoinerRejected, mJoinerId,
+                              static_cast<int32_t>(aAccepted ? ErrorCode::kNone : ErrorCode::kRejected));
+    if (!aAccepted)
+    {
+        LOG_WARN(LOG_REGION_JOINER_SESSION, "session(={}) joiner(ID={}) is rejected", static_cast<void *>(this),
+                 utils::Hex(mJoinerId));
+    }
+
+    IgnoreError(SendJoinFinResponse(*joinFin, aAccepted, mIsJoinFinDeferred));
+    LOG_INFO(LOG_REGION_JOINER_SESSION, "session(={}) sent JOIN_FIN.rsp: accepted={}, separate={}",
+             static_cast<void *>(this), aAccepted, mIsJoinFinDeferred);
 
-    IgnoreError(SendJoinFinResponse(aJoinFin, accepted));
-    LOG_INFO(LOG_REGION_JOINER_SESSION, "session(={}) sent JOIN_FIN.rsp: accepted={}", static_cast<void *>(this),
-             accepted);
+exit:
+    if (error != ErrorCode::kNone)
+    {
+        LOG_WARN(LOG_REGION_JOINER_SESSION, "session(={}) complete JOIN_FIN.req failed: {}", static_cast<void *>(this),
+                 error.ToString());
+    }
 }
 
-Error JoinerSession::SendJoinFinResponse(const coap::Request &aJoinFinReq, bool aAccept)
+Error JoinerSession::SendJoinFinResponse(const coap::Request &aJoinFinReq, bool aAccept, bool aSeparate)
 {
     Error          error;
     coap::Response joinFin{coap::Type::kAcknowledgment, coap::Code::kChanged};
     SuccessOrExit(error = AppendTlv(joinFin, {tlv::Type::kState, aAccept ? tlv::kStateAccept : tlv::kStateReject}));
 
     joinFin.SetSubType(MessageSubType::kJoinFinResponse);
-    SuccessOrExit(error = mCoap.SendResponse(aJoinFinReq, joinFin));
+    if (aSeparate)
+    {
+        auto onAcknowledged = [this](const coap::Response *, Error aError) {
+            LOG_INFO(LOG_REGION_JOINER_SESSION, "session(={}) JOIN_FIN.rsp exchange done: {}",
+                     static_cast<void *>(this), aError.ToString());
+            Release();
+        };
+
+        SuccessOrExit(error = mCoap.SendSeparateResponse(aJoinFinReq, joinFin, onAcknowledged));
+    }
+    else
+    {
+        // The KEK has been relayed along with the piggybacked response. The
+        // session is kept until the exchange lifetime ends, so that the cached
+        // response can still be resent to a retransmitted JOIN_FIN.req.
+        SuccessOrExit(error = mCoap.SendResponse(aJoinFinReq, joinFin));
+        mExpirationTime = Clock::now() + std::chrono::seconds(coap::kExchangeLifetime);
+        mCommImpl.ScheduleJoinerSessionTimer(mExpirationTime);
+    }
 
 exit:
+    if (error != ErrorCode::kNone)
+    {
+        Release();
+    }
     return error;
 }
 
+void JoinerSession::Release()
+{
+    // The session may not be removed on its own call stack.
+    mExpirationTime = Clock::now();
+    mCommImpl.ScheduleJoinerSessionTimer(mExpirationTime);
+}
+
 JoinerSession::RelaySocket::RelaySocket(JoinerSession &aJoinerSession,
                                         const Address &aPeerAddr,
                                         uint16_t       aPeerPort,
                                         const Address &aLocalAddr,
                                         uint16_t       aLocalPort)
-    : Socket(aJoinerSession.mCommImpl.GetEventBase())
+    : Socket(aJoinerSession.mCommImpl.GetEventBase(), &aJoinerSession.mCommImpl.mCpuAccount)
     , mJoinerSession(aJoinerSession)
     , mPeerAddr(aPeerAddr)
     , mPeerPort(aPeerPort)
@@ -226,6 +341,7 @@ JoinerSession::RelaySocket::RelaySocket(JoinerSession &aJoinerSession,
     int fail;
 
     mIsConnected = true;
+    mCpuCategory = CpuCategory::kJoiner;
 
     fail = event_assign(&mEvent, mEventBase, -1, EV_PERSIST, HandleEvent, this);
     VerifyOrDie(fail == 0);
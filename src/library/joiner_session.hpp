@@ -55,6 +55,13 @@ static constexpr uint16_t kListeningJoinerPort = 9527;
 // the joiner session will be closed and removed.
 static constexpr uint32_t kJoinerTimeout = 20;
 
+// The DTLS Max Fragment Length of joiner sessions. Messages exchanged
+// with a joiner are small, the smaller fragments make the record
+// buffers of each session smaller. The commissioner is the DTLS server
+// of a joiner, so this only takes effect if the joiner negotiates the
+// Max Fragment Length extension (see DtlsConfig::mMaxFragmentLength).
+static constexpr uint16_t kJoinerMaxFragmentLength = 512;
+
 static constexpr uint8_t kLocalExternalAddrMask = 1 << 1;
 
 class CommissionerImpl;
@@ -96,6 +103,11 @@ public:
     void RecvJoinerDtlsRecords(const ByteArray &aRecords);
 
     const TimePoint &GetExpirationTime() const { return mExpirationTime; }
+    const TimePoint &GetCreationTime() const { return mCreationTime; }
+
+    // Sends JOIN_FIN.rsp once the user decided on the joiner. @p aToken
+    // identifies the JOIN_FIN.req, a stale decision is ignored.
+    void CompleteJoinFin(const ByteArray &aToken, bool aAccepted);
 
 private:
     friend class RelaySocket;
@@ -138,7 +150,11 @@ private:
 
     Error SendRlyTx(const ByteArray &aDtlsMessage, bool aIncludeKek);
     void  HandleJoinFin(const coap::Request &aJoinFin);
-    Error SendJoinFinResponse(const coap::Request &aJoinFinReq, bool aAccept);
+    Error SendJoinFinResponse(const coap::Request &aJoinFinReq, bool aAccept, bool aSeparate);
+
+    // Expire the session right away, it is removed by the joiner
+    // session timer of the commissioner.
+    void Release();
 
     CommissionerImpl &mCommImpl;
 
@@ -153,7 +169,12 @@ private:
 
     coap::Resource mResourceJoinFin;
 
+    // The JOIN_FIN.req waiting for the decision of the user.
+    std::unique_ptr<coap::Request> mJoinFin;
+    bool                           mIsJoinFinDeferred;
+
     TimePoint mExpirationTime;
+    TimePoint mCreationTime;
 };
 
 } // namespace commissioner
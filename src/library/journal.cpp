@@ -0,0 +1,302 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   The file implements the joiner commissioning journal.
+ */
+
+#include "library/journal.hpp"
+
+#include <algorithm>
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "common/error_macros.hpp"
+#include "common/time.hpp"
+#include "common/utils.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+namespace journal {
+
+const char *GetName(Event aEvent)
+{
+    switch (aEvent)
+    {
+    case Event::kSessionCreated:
+        return "session_created";
+    case Event::kHandshakeStarted:
+        return "handshake_started";
+    case Event::kHandshakeFinished:
+        return "handshake_finished";
+    case Event::kJoinFinReceived:
+        return "join_fin_received";
+    case Event::kJoinerAccepted:
+        return "joiner_accepted";
+    case Event::kJoinerRejected:
+        return "joiner_rejected";
+    case Event::kKekSent:
+        return "kek_sent";
+    case Event::kSessionRemoved:
+        return "session_removed";
+    }
+    return "unknown";
+}
+
+// Tells if @p aHeader is of a journal file of @p aFileSize bytes written by this version.
+static bool IsValid(const Header &aHeader, size_t aFileSize)
+{
+    return aHeader.mMagic == kMagic && aHeader.mVersion == kVersion && aHeader.mRecordSize == sizeof(Record) &&
+           aHeader.mCapacity > 0 && (aFileSize - sizeof(Header)) / sizeof(Record) >= aHeader.mCapacity;
+}
+
+static Error MapWritable(void *&aSegment, int aFd, size_t aSize, const std::string &aFileName)
+{
+    Error error;
+
+    aSegment = mmap(nullptr, aSize, PROT_READ | PROT_WRITE, MAP_SHARED, aFd, 0);
+    VerifyOrExit(aSegment != MAP_FAILED,
+                 error = ERROR_IO_ERROR("failed to map journal file {}: {}", aFileName, strerror(errno)));
+
+exit:
+    return error;
+}
+
+Error Read(std::vector<Entry> &aEntries, std::string &aCommissionerId, const std::string &aFileName)
+{
+    Error         error;
+    void *        mapped = MAP_FAILED;
+    size_t        size   = 0;
+    struct stat   fileStat;
+    const Header *header;
+    const Record *records;
+    uint64_t      next;
+    uint64_t      sequence;
+    int           fd = open(aFileName.c_str(), O_RDONLY | O_CLOEXEC);
+
+    VerifyOrExit(fd >= 0 && fstat(fd, &fileStat) == 0,
+                 error = ERROR_IO_ERROR("failed to open journal file {}: {}", aFileName, strerror(errno)));
+    size = static_cast<size_t>(fileStat.st_size);
+    VerifyOrExit(size >= sizeof(Header), error = ERROR_BAD_FORMAT("{} is not a journal file", aFileName));
+
+    mapped = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    VerifyOrExit(mapped != MAP_FAILED,
+                 error = ERROR_IO_ERROR("failed to map journal file {}: {}", aFileName, strerror(errno)));
+
+    // The magic is written last, after the header.
+    header  = static_cast<const Header *>(mapped);
+    records = reinterpret_cast<const Record *>(header + 1);
+    VerifyOrExit(IsValid(*header, size),
+                 error = ERROR_BAD_FORMAT("{} is not a journal file of this version", aFileName));
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    aCommissionerId.assign(header->mId, strnlen(header->mId, sizeof(header->mId)));
+
+    next     = header->mNextSequence.load(std::memory_order_acquire);
+    sequence = next > header->mCapacity ? next - header->mCapacity : 1;
+    for (; sequence < next; ++sequence)
+    {
+        const Record &record = records[(sequence - 1) % header->mCapacity];
+        Entry         entry;
+
+        if (record.mSequence.load(std::memory_order_acquire) != sequence)
+        {
+            continue;
+        }
+
+        entry.mSequence = sequence;
+        entry.mTime     = record.mTime;
+        entry.mJoinerId.assign(record.mJoinerId, record.mJoinerId + sizeof(record.mJoinerId));
+        entry.mEvent  = static_cast<Event>(record.mEvent);
+        entry.mValue  = record.mValue;
+        entry.mDetail = std::string(record.mDetail, strnlen(record.mDetail, sizeof(record.mDetail)));
+
+        // Drops the copy if the record has been overwritten meanwhile.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (record.mSequence.load(std::memory_order_relaxed) == sequence)
+        {
+            aEntries.push_back(std::move(entry));
+        }
+    }
+
+exit:
+    if (mapped != MAP_FAILED)
+    {
+        munmap(mapped, size);
+    }
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+    return error;
+}
+
+Error Journal::Open(const std::string &aFileName, const std::string &aCommissionerId, uint32_t aCapacity)
+{
+    Error       error;
+    int         fd      = -1;
+    void *      segment = MAP_FAILED;
+    size_t      size    = sizeof(Header) + sizeof(Record) * aCapacity;
+    bool        resumed = false;
+    struct stat fileStat;
+    Header      header;
+
+    Close();
+
+    VerifyOrExit(aCapacity > 0, error = ERROR_INVALID_ARGS("the journal capacity should not be zero"));
+
+    // Readers in other processes see the records only if they are plain memory.
+    VerifyOrExit(header.mNextSequence.is_lock_free(),
+                 error = ERROR_UNIMPLEMENTED("64-bit atomics are not lock-free on this platform"));
+
+    fd = open(aFileName.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    VerifyOrExit(fd >= 0 && fstat(fd, &fileStat) == 0,
+                 error = ERROR_IO_ERROR("failed to open journal file {}: {}", aFileName, strerror(errno)));
+
+    if (static_cast<size_t>(fileStat.st_size) == size)
+    {
+        const Header *existing;
+
+        SuccessOrExit(error = MapWritable(segment, fd, size, aFileName));
+        existing = static_cast<const Header *>(segment);
+        resumed  = IsValid(*existing, size) && existing->mCapacity == aCapacity &&
+                   existing->mNextSequence.load(std::memory_order_relaxed) > 0;
+    }
+
+    if (!resumed)
+    {
+        if (segment != MAP_FAILED)
+        {
+            munmap(segment, size);
+            segment = MAP_FAILED;
+        }
+
+        // Keeps the records of a previous run rather than overwriting them.
+        if (fileStat.st_size > 0)
+        {
+            std::string oldFileName = aFileName + ".old";
+
+            close(fd);
+            fd = -1;
+            VerifyOrExit(rename(aFileName.c_str(), oldFileName.c_str()) == 0,
+                         error = ERROR_IO_ERROR("failed to rename journal file {} to {}: {}", aFileName, oldFileName,
+                                                strerror(errno)));
+            fd = open(aFileName.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+            VerifyOrExit(fd >= 0,
+                         error = ERROR_IO_ERROR("failed to open journal file {}: {}", aFileName, strerror(errno)));
+        }
+
+        VerifyOrExit(ftruncate(fd, size) == 0,
+                     error = ERROR_IO_ERROR("failed to resize journal file {}: {}", aFileName, strerror(errno)));
+        SuccessOrExit(error = MapWritable(segment, fd, size, aFileName));
+    }
+
+    mSize               = size;
+    mHeader             = static_cast<Header *>(segment);
+    mRecords            = reinterpret_cast<Record *>(mHeader + 1);
+    mHeader->mProcessId = getpid();
+    mHeader->mStartTime = time(nullptr);
+    memset(mHeader->mId, 0, sizeof(mHeader->mId));
+    strncpy(mHeader->mId, aCommissionerId.c_str(), sizeof(mHeader->mId) - 1);
+
+    // A resumed journal continues from its next sequence. A record being
+    // written when the previous writer died has a zero sequence and is skipped.
+    if (!resumed)
+    {
+        // The file is zero-filled by ftruncate, so all records are empty.
+        mHeader->mVersion    = kVersion;
+        mHeader->mRecordSize = sizeof(Record);
+        mHeader->mCapacity   = aCapacity;
+        mHeader->mNextSequence.store(1, std::memory_order_relaxed);
+
+        // Readers check the magic before anything else.
+        std::atomic_thread_fence(std::memory_order_release);
+        mHeader->mMagic = kMagic;
+    }
+
+exit:
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+    return error;
+}
+
+void Journal::Close()
+{
+    if (mHeader != nullptr)
+    {
+        munmap(mHeader, mSize);
+        mHeader  = nullptr;
+        mRecords = nullptr;
+        mSize    = 0;
+    }
+}
+
+void Journal::Append(Event aEvent, const ByteArray &aJoinerId, int32_t aValue, const std::string &aDetail)
+{
+    uint64_t sequence;
+    Record * record;
+
+    VerifyOrExit(mHeader != nullptr);
+
+    sequence = mHeader->mNextSequence.load(std::memory_order_relaxed);
+    record   = &mRecords[(sequence - 1) % mHeader->mCapacity];
+
+    // Invalidates the record before overwriting it.
+    record->mSequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    record->mTime = NowSinceEpoch<std::chrono::microseconds>().count();
+    memset(record->mJoinerId, 0, sizeof(record->mJoinerId));
+    memcpy(record->mJoinerId, aJoinerId.data(), std::min(aJoinerId.size(), sizeof(record->mJoinerId)));
+    record->mEvent = static_cast<uint8_t>(aEvent);
+    record->mValue = aValue;
+    memset(record->mDetail, 0, sizeof(record->mDetail));
+    memcpy(record->mDetail, aDetail.data(), std::min(aDetail.size(), sizeof(record->mDetail)));
+
+    record->mSequence.store(sequence, std::memory_order_release);
+    mHeader->mNextSequence.store(sequence + 1, std::memory_order_release);
+
+exit:
+    return;
+}
+
+} // namespace journal
+
+} // namespace commissioner
+
+} // namespace ot
@@ -0,0 +1,158 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   The file includes definitions of the joiner commissioning journal.
+ */
+
+#ifndef OT_COMM_LIBRARY_JOURNAL_HPP_
+#define OT_COMM_LIBRARY_JOURNAL_HPP_
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <commissioner/defines.hpp>
+#include <commissioner/error.hpp>
+
+namespace ot {
+
+namespace commissioner {
+
+namespace journal {
+
+// Events in the commissioning of a joiner, in the order they happen.
+enum class Event : uint8_t
+{
+    kSessionCreated = 1, ///< The first RLY_RX.ntf of a joiner. Value: the Joiner Router Locator.
+    kHandshakeStarted,   ///< The DTLS handshake started.
+    kHandshakeFinished,  ///< The DTLS handshake finished. Value: the ErrorCode.
+    kJoinFinReceived,    ///< Detail: the vendor name and model.
+    kJoinerAccepted,
+    kJoinerRejected, ///< Value: the ErrorCode.
+    kKekSent,        ///< The KEK was relayed with JOIN_FIN.rsp.
+    kSessionRemoved, ///< The session expired or was released.
+};
+
+static constexpr uint32_t kMagic           = 0x4a43544f; // "OTCJ"
+static constexpr uint32_t kVersion         = 1;
+static constexpr uint32_t kDefaultCapacity = 65536;
+static constexpr size_t   kDetailLength    = 32;
+
+// A record is valid only if its sequence is not zero. The writer clears
+// the sequence before overwriting a record and sets it afterwards, so
+// that a reader can tell whether it copied a record being written.
+struct Record
+{
+    std::atomic<uint64_t> mSequence;
+    int64_t               mTime; ///< Unix time, in microseconds.
+    uint8_t               mJoinerId[kJoinerIdLength];
+    uint8_t               mEvent;
+    uint8_t               mReserved[3];
+    int32_t               mValue;
+    char                  mDetail[kDetailLength]; ///< Not null-terminated if full.
+};
+
+static_assert(sizeof(Record) == 64, "the journal record should be 64 bytes");
+
+// The layout of the journal file is the header followed by mCapacity
+// records, used as a ring. All values are in host byte order.
+struct Header
+{
+    uint32_t              mMagic;
+    uint32_t              mVersion;
+    uint32_t              mRecordSize;
+    uint32_t              mCapacity;
+    int64_t               mProcessId;
+    int64_t               mStartTime; ///< Unix time, in seconds.
+    char                  mId[72];    ///< The commissioner ID, null-terminated.
+    std::atomic<uint64_t> mNextSequence;
+    uint8_t               mReserved[16];
+};
+
+static_assert(sizeof(Header) == 128, "the journal header should be 128 bytes");
+
+// A copy of a valid record.
+struct Entry
+{
+    uint64_t    mSequence;
+    int64_t     mTime;
+    ByteArray   mJoinerId;
+    Event       mEvent;
+    int32_t     mValue;
+    std::string mDetail;
+};
+
+const char *GetName(Event aEvent);
+
+// Reads the journal file @p aFileName into @p aEntries, from the oldest
+// to the newest, while it may be appended. Records being written are
+// skipped.
+Error Read(std::vector<Entry> &aEntries, std::string &aCommissionerId, const std::string &aFileName);
+
+// The journal of a commissioner, mapped to a file so that it survives a
+// crash and can be read without involving the commissioner. The newest
+// records overwrite the oldest once the file is full. Appending is a
+// few plain stores, and a no-op if no file is opened. There should be
+// only one writer of a journal.
+class Journal
+{
+public:
+    Journal() = default;
+    ~Journal() { Close(); }
+
+    Journal(const Journal &) = delete;
+    Journal &operator=(const Journal &) = delete;
+
+    // Opens @p aFileName and continues its records if it is a journal of
+    // @p aCapacity records, e.g. after a restart. Otherwise, an existing
+    // file is renamed to `<aFileName>.old` and a new journal is created.
+    Error Open(const std::string &aFileName, const std::string &aCommissionerId, uint32_t aCapacity = kDefaultCapacity);
+    void  Close();
+
+    bool IsOpen() const { return mHeader != nullptr; }
+
+    void Append(Event aEvent, const ByteArray &aJoinerId, int32_t aValue = 0, const std::string &aDetail = "");
+
+private:
+    Header *mHeader  = nullptr;
+    Record *mRecords = nullptr;
+    size_t  mSize    = 0;
+};
+
+} // namespace journal
+
+} // namespace commissioner
+
+} // namespace ot
+
+#endif // OT_COMM_LIBRARY_JOURNAL_HPP_
@@ -0,0 +1,194 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines test cases for the joiner commissioning journal.
+ */
+
+#include "library/journal.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <stdio.h>
+#include <unistd.h>
+
+namespace ot {
+
+namespace commissioner {
+
+namespace journal {
+
+TEST_CASE("journal-disabled", "[journal]")
+{
+    Journal journal;
+
+    REQUIRE_FALSE(journal.IsOpen());
+
+    // Appending without a file does nothing.
+    journal.Append(Event::kSessionCreated, {1, 2, 3, 4, 5, 6, 7, 8});
+}
+
+TEST_CASE("journal-records", "[journal]")
+{
+    std::string        fileName = "journal-test-" + std::to_string(getpid()) + ".journal";
+    ByteArray          joinerId = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88};
+    Journal            journal;
+    std::vector<Entry> entries;
+    std::string        id;
+
+    REQUIRE(journal.Open(fileName, "test-commissioner", 4) == ErrorCode::kNone);
+    REQUIRE(journal.IsOpen());
+
+    SECTION("an empty journal has no entries")
+    {
+        REQUIRE(Read(entries, id, fileName) == ErrorCode::kNone);
+        REQUIRE(entries.empty());
+        REQUIRE(id == "test-commissioner");
+    }
+
+    SECTION("entries are read in the order they are appended")
+    {
+        journal.Append(Event::kSessionCreated, joinerId, 0x0400);
+        journal.Append(Event::kJoinFinReceived, joinerId, 0, "OpenThread/Reference Device");
+        journal.Append(Event::kJoinerRejected, joinerId, static_cast<int32_t>(ErrorCode::kRejected));
+
+        REQUIRE(Read(entries, id, fileName) == ErrorCode::kNone);
+        REQUIRE(entries.size() == 3);
+
+        REQUIRE(entries[0].mSequence == 1);
+        REQUIRE(entries[0].mEvent == Event::kSessionCreated);
+        REQUIRE(entries[0].mJoinerId == joinerId);
+        REQUIRE(entries[0].mValue == 0x0400);
+        REQUIRE(entries[0].mTime > 0);
+
+        REQUIRE(entries[1].mEvent == Event::kJoinFinReceived);
+        REQUIRE(entries[1].mDetail == "OpenThread/Reference Device");
+
+        REQUIRE(entries[2].mSequence == 3);
+        REQUIRE(entries[2].mEvent == Event::kJoinerRejected);
+        REQUIRE(entries[2].mValue == static_cast<int32_t>(ErrorCode::kRejected));
+        REQUIRE(entries[2].mTime >= entries[0].mTime);
+    }
+
+    SECTION("long details are truncated")
+    {
+        std::string detail(kDetailLength + 8, 'x');
+
+        journal.Append(Event::kJoinFinReceived, joinerId, 0, detail);
+
+        REQUIRE(Read(entries, id, fileName) == ErrorCode::kNone);
+        REQUIRE(entries.size() == 1);
+        REQUIRE(entries[0].mDetail == detail.substr(0, kDetailLength));
+    }
+
+    SECTION("the newest entries overwrite the oldest")
+    {
+        for (int i = 0; i < 6; ++i)
+        {
+            journal.Append(Event::kHandshakeStarted, joinerId, i);
+        }
+
+        REQUIRE(Read(entries, id, fileName) == ErrorCode::kNone);
+        REQUIRE(entries.size() == 4);
+        for (size_t i = 0; i < entries.size(); ++i)
+        {
+            REQUIRE(entries[i].mSequence == i + 3);
+            REQUIRE(entries[i].mValue == static_cast<int32_t>(i + 2));
+        }
+    }
+
+    SECTION("reopening the file continues the records")
+    {
+        journal.Append(Event::kSessionCreated, joinerId);
+        journal.Append(Event::kHandshakeStarted, joinerId);
+        REQUIRE(journal.Open(fileName, "restarted-commissioner", 4) == ErrorCode::kNone);
+        journal.Append(Event::kHandshakeFinished, joinerId);
+
+        REQUIRE(Read(entries, id, fileName) == ErrorCode::kNone);
+        REQUIRE(entries.size() == 3);
+        REQUIRE(entries[2].mSequence == 3);
+        REQUIRE(entries[2].mEvent == Event::kHandshakeFinished);
+        REQUIRE(id == "restarted-commissioner");
+    }
+
+    SECTION("a journal of another capacity is renamed aside")
+    {
+        journal.Append(Event::kSessionCreated, joinerId);
+        REQUIRE(journal.Open(fileName, "test-commissioner", 8) == ErrorCode::kNone);
+
+        REQUIRE(Read(entries, id, fileName) == ErrorCode::kNone);
+        REQUIRE(entries.empty());
+
+        REQUIRE(Read(entries, id, fileName + ".old") == ErrorCode::kNone);
+        REQUIRE(entries.size() == 1);
+        REQUIRE(entries[0].mEvent == Event::kSessionCreated);
+    }
+
+    journal.Close();
+    REQUIRE_FALSE(journal.IsOpen());
+    remove(fileName.c_str());
+    remove((fileName + ".old").c_str());
+}
+
+TEST_CASE("journal-read-invalid-file", "[journal]")
+{
+    std::string        fileName = "journal-test-" + std::to_string(getpid()) + ".invalid";
+    std::vector<Entry> entries;
+    std::string        id;
+    FILE *             file;
+
+    REQUIRE(Read(entries, id, fileName) == ErrorCode::kIOError);
+
+    file = fopen(fileName.c_str(), "w");
+    REQUIRE(file != nullptr);
+    fprintf(file, "%0256d", 0);
+    fclose(file);
+
+    REQUIRE(Read(entries, id, fileName) == ErrorCode::kBadFormat);
+
+    SECTION("a file which is not a journal is renamed aside")
+    {
+        Journal journal;
+
+        REQUIRE(journal.Open(fileName, "test-commissioner", 4) == ErrorCode::kNone);
+        journal.Close();
+
+        REQUIRE(Read(entries, id, fileName) == ErrorCode::kNone);
+        REQUIRE(Read(entries, id, fileName + ".old") == ErrorCode::kBadFormat);
+    }
+
+    remove(fileName.c_str());
+    remove((fileName + ".old").c_str());
+}
+
+} // namespace journal
+
+} // namespace commissioner
+
+} // namespace ot
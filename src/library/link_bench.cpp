@@ -0,0 +1,194 @@
+/*
+ *  Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements a benchmark of the border agent link.
+ *
+ *   A commissioner-side CoAPs client sends confirmable requests one at a
+ *   time to a simulated border agent on the loopback interface. The link
+ *   of the border agent is impaired with several loss and latency profiles
+ *   and the benchmark reports the DTLS handshake time and the latency of
+ *   the requests, including CoAP retransmissions.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include <stdlib.h>
+
+#include <fmt/format.h>
+
+#include "common/utils.hpp"
+#include "library/coap_secure.hpp"
+
+#ifndef OT_COMM_BENCH_CREDENTIALS_DIR
+#error "OT_COMM_BENCH_CREDENTIALS_DIR not defined"
+#endif
+
+using namespace ot::commissioner;
+
+static constexpr size_t   kDefaultRequestCount = 50;
+static constexpr uint16_t kBorderAgentPort     = 49191;
+static constexpr uint32_t kSeed                = 1;
+
+using BenchClock = std::chrono::steady_clock;
+
+static double ElapsedMilliseconds(BenchClock::time_point aBegin)
+{
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(BenchClock::now() - aBegin);
+    return elapsed.count() / 1000.0;
+}
+
+// Reads a PEM file, the PEM parser requires the terminating null character.
+static ByteArray ReadPemFile(const std::string &aFilename)
+{
+    std::ifstream     file(aFilename);
+    std::stringstream content;
+
+    VerifyOrDie(file.is_open());
+    content << file.rdbuf();
+
+    std::string pem = content.str();
+    ByteArray   ret{pem.begin(), pem.end()};
+
+    ret.push_back(0);
+    return ret;
+}
+
+static void BenchLink(const std::string &aName, const ImpairmentConfig &aImpairment, size_t aCount)
+{
+    DtlsConfig             config;
+    std::vector<double>    latencies;
+    size_t                 failures  = 0;
+    double                 handshake = 0;
+    BenchClock::time_point begin;
+    auto                   eventBase = event_base_new();
+
+    VerifyOrDie(eventBase != nullptr);
+
+    config.mOwnKey  = ReadPemFile(OT_COMM_BENCH_CREDENTIALS_DIR "/private-key.pem");
+    config.mOwnCert = ReadPemFile(OT_COMM_BENCH_CREDENTIALS_DIR "/certificate.pem");
+    config.mCaChain = ReadPemFile(OT_COMM_BENCH_CREDENTIALS_DIR "/trust-anchor.pem");
+
+    {
+        coap::CoapSecure borderAgent{eventBase, true, aImpairment};
+        coap::CoapSecure client{eventBase, false};
+        coap::Resource   resource{"/bench", [&borderAgent](const coap::Request &aRequest) {
+                                     coap::Response response{coap::Type::kAcknowledgment, coap::Code::kChanged};
+                                     IgnoreError(borderAgent.SendResponse(aRequest, response));
+                                 }};
+        std::function<void()> sendRequest;
+
+        sendRequest = [&]() {
+            coap::Request request{coap::Type::kConfirmable, coap::Code::kPost};
+
+            SuccessOrDie(request.SetUriPath("/bench"));
+            begin = BenchClock::now();
+            client.SendRequest(request, [&](const coap::Response *, Error aError) {
+                if (aError == ErrorCode::kNone)
+                {
+                    latencies.push_back(ElapsedMilliseconds(begin));
+                }
+                else
+                {
+                    ++failures;
+                }
+
+                if (latencies.size() + failures < aCount)
+                {
+                    sendRequest();
+                }
+                else
+                {
+                    event_base_loopbreak(eventBase);
+                }
+            });
+        };
+
+        SuccessOrDie(borderAgent.AddResource(resource));
+        SuccessOrDie(borderAgent.Init(config));
+        SuccessOrDie(borderAgent.Start(nullptr, "::", kBorderAgentPort));
+        SuccessOrDie(client.Init(config));
+
+        begin = BenchClock::now();
+        client.Connect(
+            [&](const DtlsSession &, Error aError) {
+                SuccessOrDie(aError);
+                handshake = ElapsedMilliseconds(begin);
+                sendRequest();
+            },
+            "::1", kBorderAgentPort);
+
+        VerifyOrDie(event_base_loop(eventBase, EVLOOP_NO_EXIT_ON_EMPTY) == 0);
+
+        client.Disconnect(ERROR_CANCELLED("the benchmark is done"));
+        borderAgent.Stop();
+    }
+
+    event_base_free(eventBase);
+
+    std::sort(latencies.begin(), latencies.end());
+    VerifyOrDie(!latencies.empty());
+
+    fmt::print("{:<10} handshake {:>9.3f} ms, {} requests: median {:.3f} ms, max {:.3f} ms, {} failed\n", aName,
+               handshake, aCount, latencies[latencies.size() / 2], latencies.back(), failures);
+}
+
+int main(int argc, const char *argv[])
+{
+    size_t           count = kDefaultRequestCount;
+    ImpairmentConfig impairment;
+
+    if (argc > 1)
+    {
+        count = strtoul(argv[1], nullptr, 0);
+    }
+
+    impairment.mSeed = kSeed;
+    BenchLink("clean", impairment, count);
+
+    impairment.mDelay       = 100;
+    impairment.mDelayJitter = 20;
+    BenchLink("latency", impairment, count);
+
+    impairment           = ImpairmentConfig{};
+    impairment.mSeed     = kSeed;
+    impairment.mLossRate = 0.05;
+    BenchLink("loss", impairment, count);
+
+    impairment.mDuplicateRate = 0.05;
+    impairment.mReorderRate   = 0.05;
+    impairment.mDelay         = 50;
+    BenchLink("lossy", impairment, count);
+
+    return 0;
+}
@@ -0,0 +1,165 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   The file implements the link probe.
+ */
+
+#include "library/link_probe.hpp"
+
+#include <algorithm>
+
+#include "common/utils.hpp"
+#include "library/logging.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+static uint32_t ToMicroseconds(Clock::duration aDuration)
+{
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(aDuration).count();
+
+    return static_cast<uint32_t>(std::max<decltype(us)>(us, 0));
+}
+
+LinkProbe::LinkProbe(Pinger         aPinger,
+                     RecvTimeGetter aGetRecvTime,
+                     uint16_t       aCount,
+                     uint16_t       aWindow,
+                     ResultHandler  aHandler)
+    : mPinger(aPinger)
+    , mGetRecvTime(aGetRecvTime)
+    , mCount(aCount)
+    , mWindow(aWindow)
+    , mHandler(aHandler)
+    , mOutstanding(0)
+{
+    VerifyOrDie(mCount > 0 && mWindow > 0);
+}
+
+void LinkProbe::Start()
+{
+    mStartTime = Clock::now();
+
+    while (mOutstanding < mWindow && mResult.mSent < mCount && mError == ErrorCode::kNone)
+    {
+        SendPing();
+    }
+}
+
+uint32_t LinkProbe::GetPercentile(const std::vector<uint32_t> &aSortedSamples, uint32_t aPercentile)
+{
+    size_t rank = (aSortedSamples.size() * aPercentile + 99) / 100;
+
+    return aSortedSamples.empty() ? 0 : aSortedSamples[std::max<size_t>(rank, 1) - 1];
+}
+
+void LinkProbe::SendPing()
+{
+    auto self     = shared_from_this();
+    auto sendTime = Clock::now();
+
+    ++mResult.mSent;
+    ++mOutstanding;
+
+    mPinger([self, sendTime](const coap::Response *, Error aError) { self->HandlePong(sendTime, aError); });
+}
+
+void LinkProbe::HandlePong(TimePoint aSendTime, Error aError)
+{
+    --mOutstanding;
+
+    if (aError == ErrorCode::kNone)
+    {
+        auto now      = Clock::now();
+        auto recvTime = mGetRecvTime();
+
+        // The receive time isn't available or belongs to a previous datagram.
+        if (recvTime < aSendTime || recvTime > now)
+        {
+            recvTime = now;
+        }
+
+        ++mResult.mReceived;
+        mRtts.push_back(ToMicroseconds(recvTime - aSendTime));
+        mHostDelays.push_back(ToMicroseconds(now - recvTime));
+    }
+    else if (aError != ErrorCode::kTimeout && mError == ErrorCode::kNone)
+    {
+        // Stop probing if the link fails for reasons other than loss.
+        mError = aError;
+    }
+
+    if (mResult.mSent < mCount && mError == ErrorCode::kNone)
+    {
+        SendPing();
+    }
+    else if (mOutstanding == 0)
+    {
+        Finish(mError);
+    }
+}
+
+void LinkProbe::Finish(Error aError)
+{
+    mResult.mDuration =
+        static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - mStartTime).count());
+
+    std::sort(mRtts.begin(), mRtts.end());
+    std::sort(mHostDelays.begin(), mHostDelays.end());
+
+    if (!mRtts.empty())
+    {
+        mResult.mMinRtt = mRtts.front();
+        mResult.mP50Rtt = GetPercentile(mRtts, 50);
+        mResult.mP90Rtt = GetPercentile(mRtts, 90);
+        mResult.mP99Rtt = GetPercentile(mRtts, 99);
+        mResult.mMaxRtt = mRtts.back();
+
+        mResult.mP50HostDelay = GetPercentile(mHostDelays, 50);
+        mResult.mMaxHostDelay = mHostDelays.back();
+    }
+
+    LOG_INFO(LOG_REGION_MGMT, "link probe finished: sent={}, received={}, duration={}ms, p50Rtt={}us, error={}",
+             mResult.mSent, mResult.mReceived, mResult.mDuration, mResult.mP50Rtt, aError.ToString());
+
+    if (aError == ErrorCode::kNone)
+    {
+        mHandler(&mResult, aError);
+    }
+    else
+    {
+        mHandler(nullptr, aError);
+    }
+}
+
+} // namespace commissioner
+
+} // namespace ot
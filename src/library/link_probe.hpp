@@ -0,0 +1,92 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   The file includes definitions of the link probe.
+ */
+
+#ifndef OT_COMM_LIBRARY_LINK_PROBE_HPP_
+#define OT_COMM_LIBRARY_LINK_PROBE_HPP_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <commissioner/commissioner.hpp>
+
+#include "common/time.hpp"
+#include "library/coap.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+// A link probe sends CoAP pings with a sliding window of outstanding
+// pings and summarizes round-trip times, loss and throughput.
+//
+// The probe keeps itself alive until all pings are answered or timeout.
+class LinkProbe : public std::enable_shared_from_this<LinkProbe>
+{
+public:
+    using Pinger         = std::function<void(coap::ResponseHandler aHandler)>;
+    using RecvTimeGetter = std::function<TimePoint()>;
+    using ResultHandler  = Commissioner::Handler<LinkProbeResult>;
+
+    // @p aGetRecvTime returns the arrival time of the datagram being handled.
+    LinkProbe(Pinger aPinger, RecvTimeGetter aGetRecvTime, uint16_t aCount, uint16_t aWindow, ResultHandler aHandler);
+
+    void Start();
+
+    // Returns the @p aPercentile percentile of @p aSamples by the nearest-rank method.
+    static uint32_t GetPercentile(const std::vector<uint32_t> &aSortedSamples, uint32_t aPercentile);
+
+private:
+    void SendPing();
+    void HandlePong(TimePoint aSendTime, Error aError);
+    void Finish(Error aError);
+
+    Pinger         mPinger;
+    RecvTimeGetter mGetRecvTime;
+    uint16_t       mCount;
+    uint16_t       mWindow;
+    ResultHandler  mHandler;
+
+    uint16_t              mOutstanding;
+    TimePoint             mStartTime;
+    LinkProbeResult       mResult;
+    std::vector<uint32_t> mRtts;
+    std::vector<uint32_t> mHostDelays;
+    Error                 mError;
+};
+
+} // namespace commissioner
+
+} // namespace ot
+
+#endif // OT_COMM_LIBRARY_LINK_PROBE_HPP_
@@ -0,0 +1,177 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines test cases for the link probe.
+ */
+
+#include "library/link_probe.hpp"
+
+#include <list>
+
+#include <catch2/catch.hpp>
+
+#include "common/error_macros.hpp"
+#include "library/simulated_event_loop.hpp"
+#include "library/timer.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+TEST_CASE("link-probe-percentile", "[link-probe]")
+{
+    std::vector<uint32_t> samples;
+
+    REQUIRE(LinkProbe::GetPercentile(samples, 50) == 0);
+
+    for (uint32_t i = 1; i <= 100; ++i)
+    {
+        samples.push_back(i);
+    }
+    REQUIRE(LinkProbe::GetPercentile(samples, 0) == 1);
+    REQUIRE(LinkProbe::GetPercentile(samples, 50) == 50);
+    REQUIRE(LinkProbe::GetPercentile(samples, 99) == 99);
+    REQUIRE(LinkProbe::GetPercentile(samples, 100) == 100);
+
+    samples = {7};
+    REQUIRE(LinkProbe::GetPercentile(samples, 1) == 7);
+    REQUIRE(LinkProbe::GetPercentile(samples, 99) == 7);
+}
+
+TEST_CASE("link-probe-virtual-time", "[link-probe]")
+{
+    static constexpr std::chrono::milliseconds kRtt{100};
+    static constexpr std::chrono::milliseconds kHostDelay{2};
+    static constexpr std::chrono::seconds      kTimeout{2};
+
+    auto eventBase = event_base_new();
+    REQUIRE(eventBase != nullptr);
+
+    {
+        SimulatedEventLoop loop{eventBase};
+        std::list<Timer>   timers;
+        size_t             pingCount      = 0;
+        size_t             maxOutstanding = 0;
+        size_t             outstanding    = 0;
+        TimePoint          recvTime;
+        bool               done           = false;
+        LinkProbeResult    result;
+        Error              error;
+
+        // Answers every ping after kRtt except every tenth, which times out.
+        // The answers are handled kHostDelay after arrival.
+        auto pinger = [&](coap::ResponseHandler aHandler) {
+            bool lost = (pingCount++ % 10) == 9;
+
+            maxOutstanding = std::max(maxOutstanding, ++outstanding);
+            timers.emplace_back(eventBase, [&, aHandler, lost](Timer &) {
+                --outstanding;
+                if (lost)
+                {
+                    aHandler(nullptr, ERROR_TIMEOUT("ping timeout"));
+                }
+                else
+                {
+                    recvTime = Clock::now() - kHostDelay;
+                    aHandler(nullptr, ERROR_NONE);
+                }
+            });
+            timers.back().Start(lost ? Duration(kTimeout) : kRtt + kHostDelay);
+        };
+        auto onResult = [&](const LinkProbeResult *aResult, Error aError) {
+            done  = true;
+            error = aError;
+            if (aResult != nullptr)
+            {
+                result = *aResult;
+            }
+        };
+
+        SECTION("one outstanding ping")
+        {
+            std::make_shared<LinkProbe>(
+                pinger, [&]() { return recvTime; }, 20, 1, onResult)
+                ->Start();
+
+            REQUIRE(loop.RunUntil([&]() { return done; }, std::chrono::minutes(1)));
+            REQUIRE(error == ErrorCode::kNone);
+            REQUIRE(maxOutstanding == 1);
+            REQUIRE(result.mSent == 20);
+            REQUIRE(result.mReceived == 18);
+            REQUIRE(result.GetLossRate() == Approx(0.1));
+            REQUIRE(result.mDuration == 18 * (kRtt + kHostDelay).count() + 2 * kTimeout.count() * 1000);
+            REQUIRE(result.mMinRtt == 100000);
+            REQUIRE(result.mP50Rtt == 100000);
+            REQUIRE(result.mP99Rtt == 100000);
+            REQUIRE(result.mMaxRtt == 100000);
+            REQUIRE(result.mP50HostDelay == 2000);
+            REQUIRE(result.mMaxHostDelay == 2000);
+        }
+
+        SECTION("a window of outstanding pings")
+        {
+            std::make_shared<LinkProbe>(
+                pinger, [&]() { return recvTime; }, 100, 10, onResult)
+                ->Start();
+
+            REQUIRE(loop.RunUntil([&]() { return done; }, std::chrono::minutes(1)));
+            REQUIRE(error == ErrorCode::kNone);
+            REQUIRE(maxOutstanding == 10);
+            REQUIRE(result.mSent == 100);
+            REQUIRE(result.mReceived == 90);
+
+            // Much higher than the throughput of pinging one at a time.
+            auto sequentialDuration = 90 * (kRtt + kHostDelay) + 10 * std::chrono::milliseconds(kTimeout);
+            REQUIRE(result.GetThroughput() > 5 * 90 * 1000.0 / sequentialDuration.count());
+        }
+
+        SECTION("probing stops on link failure")
+        {
+            auto failingPinger = [&](coap::ResponseHandler aHandler) {
+                ++pingCount;
+                aHandler(nullptr, ERROR_INVALID_STATE("not connected"));
+            };
+
+            std::make_shared<LinkProbe>(
+                failingPinger, [&]() { return recvTime; }, 20, 5, onResult)
+                ->Start();
+
+            REQUIRE(done);
+            REQUIRE(error == ErrorCode::kInvalidState);
+            REQUIRE(pingCount == 1);
+        }
+    }
+
+    event_base_free(eventBase);
+}
+
+} // namespace commissioner
+
+} // namespace ot
@@ -33,11 +33,16 @@
 
 #include "library/logging.hpp"
 
+#include <atomic>
+
+#include "common/utils.hpp"
+
 namespace ot {
 
 namespace commissioner {
 
 static std::shared_ptr<Logger> sLogger = nullptr;
+static std::atomic<uint32_t>   sDebugLogSuppressions{0};
 
 void InitLogger(std::shared_ptr<Logger> aLogger)
 {
@@ -57,6 +62,29 @@ void Log(LogLevel aLevel, const std::string &aRegion, const std::string &aMessag
     }
 }
 
+void DebugLogSuppression::Set(bool aSuppress)
+{
+    VerifyOrExit(aSuppress != mIsSet);
+
+    mIsSet = aSuppress;
+    if (aSuppress)
+    {
+        ++sDebugLogSuppressions;
+    }
+    else
+    {
+        --sDebugLogSuppressions;
+    }
+
+exit:
+    return;
+}
+
+bool IsLogSuppressed(LogLevel aLevel)
+{
+    return aLevel == LogLevel::kDebug && sDebugLogSuppressions > 0;
+}
+
 } // namespace commissioner
 
 } // namespace ot
@@ -48,10 +48,13 @@
 #define LOG_REGION_SOCKET "socket"
 #define LOG_REGION_TOKEN_MANAGER "token-manager"
 
-#define LOG(aLevel, aRegion, aFmt, ...)                                     \
-    do                                                                      \
-    {                                                                       \
-        Log(aLevel, aRegion, fmt::format(FMT_STRING(aFmt), ##__VA_ARGS__)); \
+#define LOG(aLevel, aRegion, aFmt, ...)                                         \
+    do                                                                          \
+    {                                                                           \
+        if (!IsLogSuppressed(aLevel))                                           \
+        {                                                                       \
+            Log(aLevel, aRegion, fmt::format(FMT_STRING(aFmt), ##__VA_ARGS__)); \
+        }                                                                       \
     } while (false)
 
 #define LOG_DEBUG(aRegion, aFmt, ...) LOG(LogLevel::kDebug, aRegion, aFmt, ##__VA_ARGS__)
@@ -71,6 +74,27 @@ std::shared_ptr<Logger> GetLogger(void);
 
 void Log(LogLevel aLevel, const std::string &aRegion, const std::string &aMessage);
 
+bool IsLogSuppressed(LogLevel aLevel);
+
+// Suppresses debug logs before they are formatted, e.g. when overloaded.
+// Each owner holds its own suppression, which is withdrawn when the owner
+// is destroyed. Debug logs are suppressed while any owner suppresses them.
+class DebugLogSuppression
+{
+public:
+    DebugLogSuppression() = default;
+    ~DebugLogSuppression() { Set(false); }
+
+    DebugLogSuppression(const DebugLogSuppression &) = delete;
+    DebugLogSuppression &operator=(const DebugLogSuppression &) = delete;
+
+    void Set(bool aSuppress);
+    bool IsSet() const { return mIsSet; }
+
+private:
+    bool mIsSet = false;
+};
+
 } // namespace commissioner
 
 } // namespace ot
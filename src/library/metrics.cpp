@@ -0,0 +1,183 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   The file implements the metrics segment.
+ */
+
+#include "library/metrics.hpp"
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "common/error_macros.hpp"
+#include "common/utils.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+namespace metrics {
+
+const char *GetName(Counter aCounter)
+{
+    static const char *const sNames[kCounterNum] = {
+        "requests_total",
+        "request_failures_total",
+        "request_timeouts_total",
+        "petitions_total",
+        "keep_alives_total",
+        "keep_alive_failures_total",
+        "joiner_requests_total",
+        "joiner_sessions_total",
+        "joiners_connected_total",
+        "joiners_accepted_total",
+        "joiners_rejected_total",
+        "joiners_shed_total",
+        "dataset_changes_total",
+        "panid_conflicts_total",
+        "energy_reports_total",
+        "socket_cpu_microseconds_total",
+        "joiner_cpu_microseconds_total",
+        "timer_cpu_microseconds_total",
+        "request_cpu_microseconds_total",
+        "handler_cpu_microseconds_total",
+    };
+
+    return sNames[static_cast<size_t>(aCounter)];
+}
+
+const char *GetName(Gauge aGauge)
+{
+    static const char *const sNames[kGaugeNum] = {
+        "state",
+        "pending_requests",
+        "joiner_sessions",
+        "loop_lag_milliseconds",
+        "overloaded",
+    };
+
+    return sNames[static_cast<size_t>(aGauge)];
+}
+
+const char *GetName(Histogram aHistogram)
+{
+    static const char *const sNames[kHistogramNum] = {
+        "request_latency_milliseconds",
+        "joiner_session_duration_milliseconds",
+        "time_to_active_milliseconds",
+    };
+
+    return sNames[static_cast<size_t>(aHistogram)];
+}
+
+Error Metrics::Open(const std::string &aFileName, const std::string &aCommissionerId)
+{
+    Error   error;
+    int     fd      = -1;
+    void *  segment = MAP_FAILED;
+    Segment header;
+
+    Close();
+
+    // Readers in other processes see the values only if they are plain memory.
+    VerifyOrExit(header.mCounters[0].is_lock_free() && header.mGauges[0].is_lock_free(),
+                 error = ERROR_UNIMPLEMENTED("64-bit atomics are not lock-free on this platform"));
+
+    fd = open(aFileName.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    VerifyOrExit(fd >= 0, error = ERROR_IO_ERROR("failed to open metrics file {}: {}", aFileName, strerror(errno)));
+    VerifyOrExit(ftruncate(fd, sizeof(Segment)) == 0,
+                 error = ERROR_IO_ERROR("failed to resize metrics file {}: {}", aFileName, strerror(errno)));
+
+    segment = mmap(nullptr, sizeof(Segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    VerifyOrExit(segment != MAP_FAILED,
+                 error = ERROR_IO_ERROR("failed to map metrics file {}: {}", aFileName, strerror(errno)));
+
+    // The file is zero-filled by ftruncate, so are all metrics.
+    mSegment                = static_cast<Segment *>(segment);
+    mSegment->mVersion      = kVersion;
+    mSegment->mCounterNum   = kCounterNum;
+    mSegment->mGaugeNum     = kGaugeNum;
+    mSegment->mHistogramNum = kHistogramNum;
+    mSegment->mBucketNum    = kBucketNum;
+    mSegment->mProcessId    = getpid();
+    mSegment->mStartTime    = time(nullptr);
+    strncpy(mSegment->mId, aCommissionerId.c_str(), sizeof(mSegment->mId) - 1);
+
+    // Readers check the magic before anything else.
+    std::atomic_thread_fence(std::memory_order_release);
+    mSegment->mMagic = kMagic;
+
+exit:
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+    return error;
+}
+
+void Metrics::Close()
+{
+    if (mSegment != nullptr)
+    {
+        munmap(mSegment, sizeof(Segment));
+        mSegment = nullptr;
+    }
+}
+
+void Metrics::Observe(Histogram aHistogram, uint64_t aValue)
+{
+    size_t bucket = 0;
+
+    VerifyOrExit(mSegment != nullptr);
+
+    while (bucket < kBucketNum - 1 && aValue > kBucketBounds[bucket])
+    {
+        ++bucket;
+    }
+
+    {
+        auto &histogram = mSegment->mHistograms[static_cast<size_t>(aHistogram)];
+
+        histogram.mBuckets[bucket].fetch_add(1, std::memory_order_relaxed);
+        histogram.mSum.fetch_add(aValue, std::memory_order_relaxed);
+    }
+
+exit:
+    return;
+}
+
+} // namespace metrics
+
+} // namespace commissioner
+
+} // namespace ot
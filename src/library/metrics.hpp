@@ -0,0 +1,191 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   The file includes definitions of the metrics segment.
+ */
+
+#ifndef OT_COMM_LIBRARY_METRICS_HPP_
+#define OT_COMM_LIBRARY_METRICS_HPP_
+
+#include <atomic>
+#include <string>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <commissioner/error.hpp>
+
+namespace ot {
+
+namespace commissioner {
+
+namespace metrics {
+
+// Counters only increase while the commissioner runs.
+enum class Counter : uint8_t
+{
+    kRequests = 0,     ///< CoAP requests to the border agent or the mesh completed.
+    kRequestFailures,  ///< Requests ended with an error other than timeout.
+    kRequestTimeouts,  ///< Requests not answered before timeout.
+    kPetitions,        ///< Petitions to be the active commissioner.
+    kKeepAlives,       ///< Keep-alive messages sent.
+    kKeepAliveFailures,
+    kJoinerRequests,   ///< Joiner DTLS records relayed to the commissioner.
+    kJoinerSessions,   ///< Joiner sessions started.
+    kJoinersConnected, ///< Joiners which completed the DTLS handshake.
+    kJoinersAccepted,  ///< Joiners accepted by JOIN_FIN.
+    kJoinersRejected,  ///< Joiners rejected by JOIN_FIN.
+    kJoinersShed,      ///< New joiners not admitted while overloaded.
+    kDatasetChanges,
+    kPanIdConflicts,
+    kEnergyReports,
+    kSocketCpuTime,    ///< CPU time of the categories of CpuUsage. In microseconds.
+    kJoinerCpuTime,
+    kTimerCpuTime,
+    kRequestCpuTime,
+    kHandlerCpuTime,
+
+    kNum,
+};
+
+// Gauges are sampled periodically.
+enum class Gauge : uint8_t
+{
+    kState = 0,      ///< The commissioner state, see State.
+    kPendingRequests,
+    kJoinerSessions, ///< Joiner sessions in progress.
+    kLoopLag,        ///< In milliseconds.
+    kOverloaded,     ///< 1 if overloaded, otherwise 0.
+
+    kNum,
+};
+
+enum class Histogram : uint8_t
+{
+    kRequestLatency = 0,    ///< From sending a request to its response or failure. In milliseconds.
+    kJoinerSessionDuration, ///< From the first joiner DTLS record to the session removed. In milliseconds.
+    kTimeToActive,          ///< From starting the petition, including the DTLS handshake, to active. In milliseconds.
+
+    kNum,
+};
+
+static constexpr size_t kCounterNum   = static_cast<size_t>(Counter::kNum);
+static constexpr size_t kGaugeNum     = static_cast<size_t>(Gauge::kNum);
+static constexpr size_t kHistogramNum = static_cast<size_t>(Histogram::kNum);
+
+// The upper bounds of histogram buckets, the last bucket is unbounded.
+static constexpr size_t   kBucketNum                    = 15;
+static constexpr uint64_t kBucketBounds[kBucketNum - 1] = {1,   2,   5,    10,   20,   50,    100,
+                                                           200, 500, 1000, 2000, 5000, 10000, 30000};
+
+static constexpr uint32_t kMagic   = 0x4d43544f; // "OTCM"
+static constexpr uint32_t kVersion = 2;
+
+// The count of observations is the sum of the buckets.
+struct HistogramData
+{
+    std::atomic<uint64_t> mBuckets[kBucketNum];
+    std::atomic<uint64_t> mSum;
+};
+
+// The layout of the metrics file. Counts of each kind are written in the
+// header: new metrics are only appended to their kind, and a reader
+// locates each kind by the counts and skips metrics it doesn't know.
+// All values are in host byte order.
+struct Segment
+{
+    uint32_t mMagic;
+    uint32_t mVersion;
+    uint32_t mCounterNum;
+    uint32_t mGaugeNum;
+    uint32_t mHistogramNum;
+    uint32_t mBucketNum;
+    int64_t  mProcessId;
+    int64_t  mStartTime; ///< Unix time, in seconds.
+    char     mId[72];    ///< The commissioner ID, null-terminated.
+
+    std::atomic<uint64_t> mCounters[kCounterNum];
+    std::atomic<int64_t>  mGauges[kGaugeNum];
+    HistogramData         mHistograms[kHistogramNum];
+};
+
+// The names of metrics, without the common prefix.
+const char *GetName(Counter aCounter);
+const char *GetName(Gauge aGauge);
+const char *GetName(Histogram aHistogram);
+
+// The metrics of a commissioner, mapped to a file so that external
+// agents can sample them at any rate without involving the
+// commissioner. Updating metrics is a relaxed atomic operation, and
+// a no-op if no file is opened.
+class Metrics
+{
+public:
+    Metrics() = default;
+    ~Metrics() { Close(); }
+
+    Metrics(const Metrics &) = delete;
+    Metrics &operator=(const Metrics &) = delete;
+
+    // Creates or truncates @p aFileName. Metrics start from zero.
+    Error Open(const std::string &aFileName, const std::string &aCommissionerId);
+    void  Close();
+
+    bool IsOpen() const { return mSegment != nullptr; }
+
+    void Increase(Counter aCounter, uint64_t aValue = 1)
+    {
+        if (mSegment != nullptr)
+        {
+            mSegment->mCounters[static_cast<size_t>(aCounter)].fetch_add(aValue, std::memory_order_relaxed);
+        }
+    }
+
+    void Set(Gauge aGauge, int64_t aValue)
+    {
+        if (mSegment != nullptr)
+        {
+            mSegment->mGauges[static_cast<size_t>(aGauge)].store(aValue, std::memory_order_relaxed);
+        }
+    }
+
+    void Observe(Histogram aHistogram, uint64_t aValue);
+
+private:
+    Segment *mSegment = nullptr;
+};
+
+} // namespace metrics
+
+} // namespace commissioner
+
+} // namespace ot
+
+#endif // OT_COMM_LIBRARY_METRICS_HPP_
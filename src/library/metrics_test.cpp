@@ -0,0 +1,172 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines test cases for the metrics segment.
+ */
+
+#include "library/metrics.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace ot {
+
+namespace commissioner {
+
+namespace metrics {
+
+// Maps the metrics file read-only, as an external reader does.
+class SegmentReader
+{
+public:
+    explicit SegmentReader(const std::string &aFileName)
+    {
+        int fd = open(aFileName.c_str(), O_RDONLY);
+
+        REQUIRE(fd >= 0);
+        mSegment = mmap(nullptr, sizeof(Segment), PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        REQUIRE(mSegment != MAP_FAILED);
+    }
+
+    ~SegmentReader() { munmap(mSegment, sizeof(Segment)); }
+
+    const Segment &Get() const { return *static_cast<const Segment *>(mSegment); }
+
+private:
+    void *mSegment;
+};
+
+TEST_CASE("metrics-disabled", "[metrics]")
+{
+    Metrics metrics;
+
+    REQUIRE_FALSE(metrics.IsOpen());
+
+    // Updating metrics without a file does nothing.
+    metrics.Increase(Counter::kRequests);
+    metrics.Set(Gauge::kState, 1);
+    metrics.Observe(Histogram::kRequestLatency, 1);
+}
+
+TEST_CASE("metrics-segment", "[metrics]")
+{
+    std::string fileName = "metrics-test-" + std::to_string(getpid()) + ".metrics";
+    Metrics     metrics;
+
+    REQUIRE(metrics.Open(fileName, "test-commissioner") == ErrorCode::kNone);
+    REQUIRE(metrics.IsOpen());
+
+    {
+        SegmentReader  reader{fileName};
+        const Segment &segment = reader.Get();
+
+        SECTION("the header describes the layout")
+        {
+            REQUIRE(segment.mMagic == kMagic);
+            REQUIRE(segment.mVersion == kVersion);
+            REQUIRE(segment.mCounterNum == kCounterNum);
+            REQUIRE(segment.mGaugeNum == kGaugeNum);
+            REQUIRE(segment.mHistogramNum == kHistogramNum);
+            REQUIRE(segment.mBucketNum == kBucketNum);
+            REQUIRE(segment.mProcessId == getpid());
+            REQUIRE(std::string(segment.mId) == "test-commissioner");
+        }
+
+        SECTION("counters and gauges are visible to the reader")
+        {
+            metrics.Increase(Counter::kRequests);
+            metrics.Increase(Counter::kRequests, 2);
+            metrics.Set(Gauge::kJoinerSessions, 5);
+            metrics.Set(Gauge::kJoinerSessions, 3);
+
+            REQUIRE(segment.mCounters[static_cast<size_t>(Counter::kRequests)].load() == 3);
+            REQUIRE(segment.mCounters[static_cast<size_t>(Counter::kPetitions)].load() == 0);
+            REQUIRE(segment.mGauges[static_cast<size_t>(Gauge::kJoinerSessions)].load() == 3);
+        }
+
+        SECTION("histogram values fall into the bucket of the first upper bound not less than them")
+        {
+            const HistogramData &histogram = segment.mHistograms[static_cast<size_t>(Histogram::kRequestLatency)];
+
+            metrics.Observe(Histogram::kRequestLatency, 0);
+            metrics.Observe(Histogram::kRequestLatency, 1);
+            metrics.Observe(Histogram::kRequestLatency, 2);
+            metrics.Observe(Histogram::kRequestLatency, 150);
+            metrics.Observe(Histogram::kRequestLatency, 60000);
+
+            REQUIRE(histogram.mBuckets[0].load() == 2);
+            REQUIRE(histogram.mBuckets[1].load() == 1);
+            REQUIRE(histogram.mBuckets[7].load() == 1);
+            REQUIRE(histogram.mBuckets[kBucketNum - 1].load() == 1);
+            REQUIRE(histogram.mSum.load() == 60153);
+        }
+    }
+
+    SECTION("reopening the file starts from zero")
+    {
+        metrics.Increase(Counter::kRequests);
+        REQUIRE(metrics.Open(fileName, "test-commissioner") == ErrorCode::kNone);
+
+        SegmentReader reader{fileName};
+        REQUIRE(reader.Get().mCounters[static_cast<size_t>(Counter::kRequests)].load() == 0);
+    }
+
+    metrics.Close();
+    REQUIRE_FALSE(metrics.IsOpen());
+    remove(fileName.c_str());
+}
+
+TEST_CASE("metrics-names", "[metrics]")
+{
+    for (size_t i = 0; i < kCounterNum; ++i)
+    {
+        REQUIRE(strlen(GetName(static_cast<Counter>(i))) > 0);
+    }
+    for (size_t i = 0; i < kGaugeNum; ++i)
+    {
+        REQUIRE(strlen(GetName(static_cast<Gauge>(i))) > 0);
+    }
+    for (size_t i = 0; i < kHistogramNum; ++i)
+    {
+        REQUIRE(strlen(GetName(static_cast<Histogram>(i))) > 0);
+    }
+}
+
+} // namespace metrics
+
+} // namespace commissioner
+
+} // namespace ot
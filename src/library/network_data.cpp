@@ -37,6 +37,8 @@
 #include "common/error_macros.hpp"
 #include "common/time.hpp"
 #include "common/utils.hpp"
+#include "library/dataset.hpp"
+#include "library/tlv.hpp"
 
 namespace ot {
 
@@ -111,6 +113,101 @@ std::string Ipv6PrefixToString(ByteArray aPrefix)
     return addr.ToString() + "/" + std::to_string(prefixLength);
 }
 
+static Error FindRawDatasetField(const uint8_t *& aData,
+                                 size_t &         aLength,
+                                 tlv::Type        aTlvType,
+                                 const ByteArray &aRawDataset)
+{
+    Error          error;
+    const uint8_t *value;
+    uint16_t       length;
+
+    SuccessOrExit(error = tlv::FindTlv(value, length, aTlvType, aRawDataset));
+    aData   = value;
+    aLength = length;
+
+exit:
+    return error;
+}
+
+Error LazyActiveDataset::GetActiveTimestamp(Timestamp &aTimestamp) const
+{
+    Error          error;
+    const uint8_t *value;
+    size_t         length;
+
+    SuccessOrExit(error = FindRawDatasetField(value, length, tlv::Type::kActiveTimestamp, mRawDataset));
+    aTimestamp = Timestamp::Decode(utils::Decode<uint64_t>(value, length));
+
+exit:
+    return error;
+}
+
+Error LazyActiveDataset::GetChannel(Channel &aChannel) const
+{
+    Error          error;
+    const uint8_t *value;
+    size_t         length;
+
+    SuccessOrExit(error = FindRawDatasetField(value, length, tlv::Type::kChannel, mRawDataset));
+    aChannel.mPage   = value[0];
+    aChannel.mNumber = utils::Decode<uint16_t>(value + 1, length - 1);
+
+exit:
+    return error;
+}
+
+Error LazyActiveDataset::GetNetworkName(std::string &aNetworkName) const
+{
+    Error          error;
+    const uint8_t *value;
+    size_t         length;
+
+    SuccessOrExit(error = FindRawDatasetField(value, length, tlv::Type::kNetworkName, mRawDataset));
+    aNetworkName.assign(value, value + length);
+
+exit:
+    return error;
+}
+
+Error LazyActiveDataset::GetPanId(uint16_t &aPanId) const
+{
+    Error          error;
+    const uint8_t *value;
+    size_t         length;
+
+    SuccessOrExit(error = FindRawDatasetField(value, length, tlv::Type::kPanId, mRawDataset));
+    aPanId = utils::Decode<uint16_t>(value, length);
+
+exit:
+    return error;
+}
+
+Error LazyActiveDataset::GetExtendedPanId(const uint8_t *&aData, size_t &aLength) const
+{
+    return FindRawDatasetField(aData, aLength, tlv::Type::kExtendedPanId, mRawDataset);
+}
+
+Error LazyActiveDataset::GetMeshLocalPrefix(const uint8_t *&aData, size_t &aLength) const
+{
+    return FindRawDatasetField(aData, aLength, tlv::Type::kNetworkMeshLocalPrefix, mRawDataset);
+}
+
+Error LazyActiveDataset::GetNetworkMasterKey(const uint8_t *&aData, size_t &aLength) const
+{
+    return FindRawDatasetField(aData, aLength, tlv::Type::kNetworkMasterKey, mRawDataset);
+}
+
+Error LazyActiveDataset::GetPSKc(const uint8_t *&aData, size_t &aLength) const
+{
+    return FindRawDatasetField(aData, aLength, tlv::Type::kPSKc, mRawDataset);
+}
+
+Error LazyActiveDataset::ToActiveDataset(ActiveOperationalDataset &aDataset) const
+{
+    return DecodeActiveOperationalDataset(aDataset, mRawDataset);
+}
+
 } // namespace commissioner
 
 } // namespace ot
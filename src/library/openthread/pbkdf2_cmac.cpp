@@ -37,7 +37,7 @@
 #include <assert.h>
 #include <memory.h>
 
-#include <mbedtls/cmac.h>
+#include "library/crypto_provider.hpp"
 
 namespace ot {
 
@@ -51,7 +51,7 @@ void otPbkdf2Cmac(const uint8_t *aPassword,
                   uint16_t       aKeyLen,
                   uint8_t *      aKey)
 {
-    const size_t kBlockSize = MBEDTLS_CIPHER_BLKSIZE_MAX;
+    const size_t kBlockSize = kAesBlockSize;
     uint8_t      prfInput[OT_PBKDF2_SALT_MAX_LEN + 4]; // Salt || INT(), for U1 calculation
     long         prfOne[kBlockSize / sizeof(long)];
     long         prfTwo[kBlockSize / sizeof(long)];
@@ -60,6 +60,7 @@ void otPbkdf2Cmac(const uint8_t *aPassword,
     uint8_t *    key          = aKey;
     uint16_t     keyLen       = aKeyLen;
     uint16_t     useLen       = 0;
+    auto &       crypto       = GetCryptoProvider();
 
     memcpy(prfInput, aSalt, aSaltLen);
     assert(aIterationCounter % 2 == 0);
@@ -74,12 +75,11 @@ void otPbkdf2Cmac(const uint8_t *aPassword,
         prfInput[aSaltLen + 3] = static_cast<uint8_t>(blockCounter);
 
         // Calculate U_1
-        mbedtls_aes_cmac_prf_128(aPassword, aPasswordLen, prfInput, aSaltLen + 4,
-                                 reinterpret_cast<uint8_t *>(keyBlock));
+        crypto.AesCmacPrf128(reinterpret_cast<uint8_t *>(keyBlock), aPassword, aPasswordLen, prfInput, aSaltLen + 4);
 
         // Calculate U_2
-        mbedtls_aes_cmac_prf_128(aPassword, aPasswordLen, reinterpret_cast<const uint8_t *>(keyBlock), kBlockSize,
-                                 reinterpret_cast<uint8_t *>(prfOne));
+        crypto.AesCmacPrf128(reinterpret_cast<uint8_t *>(prfOne), aPassword, aPasswordLen,
+                             reinterpret_cast<const uint8_t *>(keyBlock), kBlockSize);
 
         for (uint32_t j = 0; j < kBlockSize / sizeof(long); ++j)
         {
@@ -89,11 +89,11 @@ void otPbkdf2Cmac(const uint8_t *aPassword,
         for (uint32_t i = 1; i < aIterationCounter; ++i)
         {
             // Calculate U_{2 * i - 1}
-            mbedtls_aes_cmac_prf_128(aPassword, aPasswordLen, reinterpret_cast<const uint8_t *>(prfOne), kBlockSize,
-                                     reinterpret_cast<uint8_t *>(prfTwo));
+            crypto.AesCmacPrf128(reinterpret_cast<uint8_t *>(prfTwo), aPassword, aPasswordLen,
+                                 reinterpret_cast<const uint8_t *>(prfOne), kBlockSize);
             // Calculate U_{2 * i}
-            mbedtls_aes_cmac_prf_128(aPassword, aPasswordLen, reinterpret_cast<const uint8_t *>(prfTwo), kBlockSize,
-                                     reinterpret_cast<uint8_t *>(prfOne));
+            crypto.AesCmacPrf128(reinterpret_cast<uint8_t *>(prfOne), aPassword, aPasswordLen,
+                                 reinterpret_cast<const uint8_t *>(prfTwo), kBlockSize);
 
             for (uint32_t j = 0; j < kBlockSize / sizeof(long); ++j)
             {
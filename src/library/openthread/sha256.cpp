@@ -37,29 +37,26 @@ namespace ot {
 
 namespace commissioner {
 
-Sha256::Sha256()
-{
-    mbedtls_sha256_init(&mContext);
-}
+static_assert(Sha256::kHashSize == kSha256HashSize, "wrong SHA-256 hash size");
 
-Sha256::~Sha256()
+Sha256::Sha256(void)
+    : mContext(GetCryptoProvider().CreateSha256Context())
 {
-    mbedtls_sha256_free(&mContext);
 }
 
 void Sha256::Start(void)
 {
-    mbedtls_sha256_starts_ret(&mContext, 0);
+    mContext->Start();
 }
 
 void Sha256::Update(const uint8_t *aBuf, uint16_t aBufLength)
 {
-    mbedtls_sha256_update_ret(&mContext, aBuf, aBufLength);
+    mContext->Update(aBuf, aBufLength);
 }
 
 void Sha256::Finish(uint8_t aHash[kHashSize])
 {
-    mbedtls_sha256_finish_ret(&mContext, aHash);
+    mContext->Finish(aHash);
 }
 
 } // namespace commissioner
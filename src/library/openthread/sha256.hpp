@@ -35,7 +35,11 @@
 #ifndef OT_COMM_LIBRARY_OPENTHREAD_SHA256_HPP_
 #define OT_COMM_LIBRARY_OPENTHREAD_SHA256_HPP_
 
-#include <mbedtls/sha256.h>
+#include <memory>
+
+#include <stdint.h>
+
+#include "library/crypto_provider.hpp"
 
 namespace ot {
 
@@ -44,6 +48,9 @@ namespace commissioner {
 /**
  * This class implements SHA-256 computation.
  *
+ * The hash is computed incrementally by the crypto provider
+ * in use when the object is constructed.
+ *
  */
 class Sha256
 {
@@ -54,16 +61,10 @@ public:
     };
 
     /**
-     * Constructor for initializing mbedtls_sha256_context.
-     *
-     */
-    Sha256();
-
-    /**
-     * Destructor for freeing mbedtls_sha256_context.
+     * Constructor for Sha256.
      *
      */
-    ~Sha256();
+    Sha256(void);
 
     /**
      * This method starts the SHA-256 computation.
@@ -89,7 +90,7 @@ public:
     void Finish(uint8_t aHash[kHashSize]);
 
 private:
-    mbedtls_sha256_context mContext;
+    std::unique_ptr<Sha256Context> mContext;
 };
 
 } // namespace commissioner
@@ -0,0 +1,170 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file
+ *   The file implements the overload controller.
+ */
+
+#include "library/overload_controller.hpp"
+
+#include <algorithm>
+
+#include "common/utils.hpp"
+#include "library/logging.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+static constexpr uint32_t kSampleInterval = 100; ///< In milliseconds.
+
+OverloadController::OverloadController(struct event_base *aEventBase, CpuAccount *aCpuAccount)
+    : mSampleTimer(aEventBase, [this](Timer &aTimer) { HandleSampleTimer(aTimer); }, /* aIsSingle */ true, aCpuAccount)
+{
+}
+
+OverloadController::~OverloadController()
+{
+    // The owner is being destroyed and should not be called back.
+    mStateHandler = nullptr;
+    Stop();
+}
+
+void OverloadController::Start(const OverloadConfig &aConfig)
+{
+    Stop();
+
+    mConfig = aConfig;
+    if (mConfig.mMaxLoopLag != 0 || mConfig.mMaxQueueDepth != 0)
+    {
+        mSampleTimer.Start(Duration(kSampleInterval));
+    }
+}
+
+void OverloadController::Stop()
+{
+    mSampleTimer.Stop();
+    SetOverloaded(false);
+}
+
+bool OverloadController::ShouldShed(Work aWork)
+{
+    if (IsOverloaded())
+    {
+        switch (aWork)
+        {
+        case Work::kJoinerAdmission:
+            ++mMetrics.mShedJoiners;
+            break;
+        case Work::kEnergyReport:
+            ++mMetrics.mShedEnergyReports;
+            break;
+        case Work::kNotification:
+            ++mMetrics.mShedNotifications;
+            break;
+        }
+    }
+
+    return IsOverloaded();
+}
+
+void OverloadController::Update(Duration aLoopLag, size_t aQueueDepth)
+{
+    uint32_t loopLag    = static_cast<uint32_t>(std::max(aLoopLag.count(), Duration::rep{0}));
+    uint32_t queueDepth = static_cast<uint32_t>(aQueueDepth);
+
+    mMetrics.mLoopLag       = loopLag;
+    mMetrics.mMaxLoopLag    = std::max(mMetrics.mMaxLoopLag, loopLag);
+    mMetrics.mQueueDepth    = queueDepth;
+    mMetrics.mMaxQueueDepth = std::max(mMetrics.mMaxQueueDepth, queueDepth);
+
+    if (!IsOverloaded())
+    {
+        bool lagging  = mConfig.mMaxLoopLag != 0 && loopLag > mConfig.mMaxLoopLag;
+        bool queueing = mConfig.mMaxQueueDepth != 0 && queueDepth > mConfig.mMaxQueueDepth;
+
+        if (lagging || queueing)
+        {
+            LOG_WARN(LOG_REGION_MESHCOP, "overloaded: loop lag = {}ms, queue depth = {}", loopLag, queueDepth);
+            SetOverloaded(true);
+        }
+    }
+    else
+    {
+        // Recover only when well below the thresholds to avoid flapping.
+        bool lagging  = mConfig.mMaxLoopLag != 0 && loopLag > mConfig.mMaxLoopLag / 2;
+        bool queueing = mConfig.mMaxQueueDepth != 0 && queueDepth > mConfig.mMaxQueueDepth / 2;
+
+        if (!lagging && !queueing)
+        {
+            SetOverloaded(false);
+            LOG_INFO(LOG_REGION_MESHCOP, "recovered from overload: loop lag = {}ms, queue depth = {}", loopLag,
+                     queueDepth);
+        }
+    }
+}
+
+void OverloadController::HandleSampleTimer(Timer &aTimer)
+{
+    auto   loopLag    = std::chrono::duration_cast<Duration>(Clock::now() - aTimer.GetFireTime());
+    size_t queueDepth = 0;
+
+    for (const auto &getQueueDepth : mQueues)
+    {
+        queueDepth += getQueueDepth();
+    }
+
+    Update(loopLag, queueDepth);
+
+    aTimer.Start(Duration(kSampleInterval));
+}
+
+void OverloadController::SetOverloaded(bool aOverloaded)
+{
+    VerifyOrExit(aOverloaded != IsOverloaded());
+
+    mMetrics.mOverloaded = aOverloaded;
+    if (aOverloaded)
+    {
+        ++mMetrics.mOverloadCount;
+    }
+
+    mDebugLogSuppression.Set(aOverloaded);
+
+    if (mStateHandler != nullptr)
+    {
+        mStateHandler(aOverloaded);
+    }
+
+exit:
+    return;
+}
+
+} // namespace commissioner
+
+} // namespace ot
@@ -0,0 +1,105 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file
+ *   The file includes definitions of the overload controller.
+ */
+
+#ifndef OT_COMM_LIBRARY_OVERLOAD_CONTROLLER_HPP_
+#define OT_COMM_LIBRARY_OVERLOAD_CONTROLLER_HPP_
+
+#include <functional>
+#include <vector>
+
+#include <commissioner/commissioner.hpp>
+
+#include "common/time.hpp"
+#include "library/logging.hpp"
+#include "library/timer.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+// The overload controller periodically samples the lag of the event
+// loop and the depth of registered queues, and tells if low-priority
+// work should be shed. See OverloadConfig for the thresholds.
+class OverloadController
+{
+public:
+    using DepthGetter  = std::function<size_t()>;
+    using StateHandler = std::function<void(bool aOverloaded)>;
+
+    // Low-priority work which may be shed.
+    enum class Work : uint8_t
+    {
+        kJoinerAdmission = 0,
+        kEnergyReport,
+        kNotification,
+    };
+
+    explicit OverloadController(struct event_base *aEventBase, CpuAccount *aCpuAccount = nullptr);
+    ~OverloadController();
+
+    // Starts sampling. Nothing is sampled if all thresholds are disabled.
+    void Start(const OverloadConfig &aConfig);
+    void Stop();
+
+    // The depths of all queues are summed up.
+    void AddQueue(DepthGetter aGetter) { mQueues.push_back(aGetter); }
+
+    // @p aHandler is called when entering and leaving the overloaded state.
+    void SetStateHandler(StateHandler aHandler) { mStateHandler = aHandler; }
+
+    bool IsOverloaded() const { return mMetrics.mOverloaded; }
+
+    // Tells if @p aWork should be shed now. Shed work is counted.
+    bool ShouldShed(Work aWork);
+
+    const OverloadMetrics &GetMetrics() const { return mMetrics; }
+
+    // Updates the state with a sample of the loop lag and queue depth.
+    void Update(Duration aLoopLag, size_t aQueueDepth);
+
+private:
+    void HandleSampleTimer(Timer &aTimer);
+    void SetOverloaded(bool aOverloaded);
+
+    OverloadConfig           mConfig;
+    Timer                    mSampleTimer;
+    std::vector<DepthGetter> mQueues;
+    StateHandler             mStateHandler;
+    OverloadMetrics          mMetrics;
+    DebugLogSuppression      mDebugLogSuppression;
+};
+
+} // namespace commissioner
+
+} // namespace ot
+
+#endif // OT_COMM_LIBRARY_OVERLOAD_CONTROLLER_HPP_
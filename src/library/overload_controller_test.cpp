@@ -0,0 +1,210 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines test cases for the overload controller.
+ */
+
+#include "library/overload_controller.hpp"
+
+#include <catch2/catch.hpp>
+
+#include "library/logging.hpp"
+#include "library/simulated_event_loop.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+static OverloadConfig MakeOverloadConfig(uint32_t aMaxLoopLag, uint32_t aMaxQueueDepth)
+{
+    OverloadConfig config;
+
+    config.mMaxLoopLag    = aMaxLoopLag;
+    config.mMaxQueueDepth = aMaxQueueDepth;
+
+    return config;
+}
+
+TEST_CASE("overload-controller-thresholds", "[overload]")
+{
+    auto eventBase = event_base_new();
+    REQUIRE(eventBase != nullptr);
+
+    {
+        OverloadController controller{eventBase};
+        std::vector<bool>  states;
+
+        controller.SetStateHandler([&states](bool aOverloaded) { states.push_back(aOverloaded); });
+        controller.Start(MakeOverloadConfig(200, 100));
+
+        SECTION("the loop lag exceeds the threshold")
+        {
+            controller.Update(std::chrono::milliseconds(200), 0);
+            REQUIRE_FALSE(controller.IsOverloaded());
+
+            controller.Update(std::chrono::milliseconds(201), 0);
+            REQUIRE(controller.IsOverloaded());
+
+            // Recovers only below half of the threshold.
+            controller.Update(std::chrono::milliseconds(150), 0);
+            REQUIRE(controller.IsOverloaded());
+            controller.Update(std::chrono::milliseconds(100), 0);
+            REQUIRE_FALSE(controller.IsOverloaded());
+
+            REQUIRE(states == std::vector<bool>{true, false});
+        }
+
+        SECTION("the queue depth exceeds the threshold")
+        {
+            controller.Update(std::chrono::milliseconds(0), 101);
+            REQUIRE(controller.IsOverloaded());
+
+            controller.Update(std::chrono::milliseconds(0), 51);
+            REQUIRE(controller.IsOverloaded());
+            controller.Update(std::chrono::milliseconds(0), 50);
+            REQUIRE_FALSE(controller.IsOverloaded());
+
+            REQUIRE(states == std::vector<bool>{true, false});
+        }
+
+        SECTION("a disabled threshold is ignored")
+        {
+            controller.Start(MakeOverloadConfig(0, 100));
+            controller.Update(std::chrono::seconds(10), 0);
+            REQUIRE_FALSE(controller.IsOverloaded());
+        }
+
+        SECTION("metrics")
+        {
+            REQUIRE_FALSE(controller.ShouldShed(OverloadController::Work::kJoinerAdmission));
+
+            controller.Update(std::chrono::milliseconds(300), 10);
+            controller.Update(std::chrono::milliseconds(250), 200);
+            REQUIRE(controller.ShouldShed(OverloadController::Work::kJoinerAdmission));
+            REQUIRE(controller.ShouldShed(OverloadController::Work::kJoinerAdmission));
+            REQUIRE(controller.ShouldShed(OverloadController::Work::kEnergyReport));
+            REQUIRE(controller.ShouldShed(OverloadController::Work::kNotification));
+
+            controller.Update(std::chrono::milliseconds(10), 10);
+            controller.Update(std::chrono::milliseconds(300), 10);
+
+            const auto &metrics = controller.GetMetrics();
+            REQUIRE(metrics.mOverloaded);
+            REQUIRE(metrics.mOverloadCount == 2);
+            REQUIRE(metrics.mLoopLag == 300);
+            REQUIRE(metrics.mMaxLoopLag == 300);
+            REQUIRE(metrics.mQueueDepth == 10);
+            REQUIRE(metrics.mMaxQueueDepth == 200);
+            REQUIRE(metrics.mShedJoiners == 2);
+            REQUIRE(metrics.mShedEnergyReports == 1);
+            REQUIRE(metrics.mShedNotifications == 1);
+        }
+
+        SECTION("debug logs are suppressed when overloaded")
+        {
+            REQUIRE_FALSE(IsLogSuppressed(LogLevel::kDebug));
+
+            controller.Update(std::chrono::milliseconds(300), 0);
+            REQUIRE(IsLogSuppressed(LogLevel::kDebug));
+            REQUIRE_FALSE(IsLogSuppressed(LogLevel::kInfo));
+
+            // Stopping the controller withdraws the suppression.
+            controller.Stop();
+            REQUIRE_FALSE(controller.IsOverloaded());
+            REQUIRE_FALSE(IsLogSuppressed(LogLevel::kDebug));
+            REQUIRE(states == std::vector<bool>{true, false});
+        }
+
+        SECTION("debug logs are suppressed while any controller is overloaded")
+        {
+            controller.Update(std::chrono::milliseconds(300), 0);
+
+            {
+                OverloadController other{eventBase};
+
+                other.Start(MakeOverloadConfig(200, 100));
+                other.Update(std::chrono::milliseconds(300), 0);
+                other.Update(std::chrono::milliseconds(300), 0);
+                REQUIRE(IsLogSuppressed(LogLevel::kDebug));
+
+                // The other controller recovers, but this one is still overloaded.
+                other.Update(std::chrono::milliseconds(10), 0);
+                other.Update(std::chrono::milliseconds(10), 0);
+                REQUIRE(IsLogSuppressed(LogLevel::kDebug));
+
+                other.Update(std::chrono::milliseconds(300), 0);
+            }
+
+            // Destroying an overloaded controller withdraws only its own suppression.
+            REQUIRE(IsLogSuppressed(LogLevel::kDebug));
+
+            controller.Update(std::chrono::milliseconds(10), 0);
+            REQUIRE_FALSE(IsLogSuppressed(LogLevel::kDebug));
+        }
+    }
+
+    REQUIRE_FALSE(IsLogSuppressed(LogLevel::kDebug));
+    event_base_free(eventBase);
+}
+
+TEST_CASE("overload-controller-sampling", "[overload]")
+{
+    auto eventBase = event_base_new();
+    REQUIRE(eventBase != nullptr);
+
+    {
+        SimulatedEventLoop loop{eventBase};
+        OverloadController controller{eventBase};
+        size_t             queue0 = 0;
+        size_t             queue1 = 0;
+
+        controller.AddQueue([&queue0]() { return queue0; });
+        controller.AddQueue([&queue1]() { return queue1; });
+        controller.Start(MakeOverloadConfig(200, 100));
+
+        queue0 = 60;
+        queue1 = 41;
+        REQUIRE(loop.RunUntil([&controller]() { return controller.IsOverloaded(); }, std::chrono::seconds(1)));
+        REQUIRE(controller.GetMetrics().mQueueDepth == 101);
+        REQUIRE(controller.GetMetrics().mLoopLag == 0);
+
+        queue0 = 0;
+        REQUIRE(loop.RunUntil([&controller]() { return !controller.IsOverloaded(); }, std::chrono::seconds(1)));
+
+        controller.Stop();
+        REQUIRE(loop.GetPendingTimerCount() == 0);
+    }
+
+    event_base_free(eventBase);
+}
+
+} // namespace commissioner
+
+} // namespace ot
@@ -0,0 +1,212 @@
+/*
+ *  Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements a benchmark of parsing received messages.
+ *
+ *   It mutates worst-case datagrams (many options or TLVs, maximum
+ *   lengths) and measures the thread CPU time of parsing each of them
+ *   as a CoAP message and as a TLV payload. It fails if the slowest
+ *   datagram exceeds the budget.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include <time.h>
+
+#include <fmt/format.h>
+
+#include "common/utils.hpp"
+#include "library/coap.hpp"
+#include "library/tlv.hpp"
+
+using namespace ot::commissioner;
+
+static constexpr size_t kMaxDatagramSize = 1280;
+static constexpr size_t kFuzzRounds      = 20000;
+static constexpr auto   kBudget          = std::chrono::milliseconds(1);
+
+// The CPU time consumed by the calling thread.
+static std::chrono::nanoseconds GetThreadCpuTime()
+{
+    struct timespec ts;
+    VerifyOrDie(clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0);
+    return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+}
+
+static std::vector<ByteArray> MakeCoapSeeds()
+{
+    std::vector<ByteArray> seeds;
+
+    {
+        ByteArray     seed;
+        coap::Message message{coap::Type::kNonConfirmable, coap::Code::kPost};
+        SuccessOrDie(message.SetUriPath("/c/ur"));
+        SuccessOrDie(message.SetContentFormat(coap::ContentFormat::kOctetStream));
+        message.Append(ByteArray(64, 0xAB));
+        SuccessOrDie(message.Serialize(seed));
+        seeds.push_back(seed);
+    }
+
+    {
+        // A Uri-Path option followed by empty options repeating it.
+        ByteArray seed{0x50, utils::to_underlying(coap::Code::kPost), 0x00, 0x01, 0xB1, 'a'};
+        while (seed.size() < kMaxDatagramSize)
+        {
+            seed.push_back(0x01);
+            seed.push_back('a');
+        }
+        seeds.push_back(seed);
+    }
+
+    {
+        // Options of the max extended length.
+        ByteArray seed{0x50, utils::to_underlying(coap::Code::kPost), 0x00, 0x01};
+        while (seed.size() < kMaxDatagramSize)
+        {
+            seed.push_back(0x3E);
+            seed.push_back(0xFF);
+            seed.push_back(0xFF);
+        }
+        seeds.push_back(seed);
+    }
+
+    return seeds;
+}
+
+static std::vector<ByteArray> MakeTlvSeeds(std::mt19937 &aRandom)
+{
+    std::uniform_int_distribution<int> byte{0, 0xFF};
+    std::vector<ByteArray>             seeds;
+
+    {
+        // Empty TLVs of random types.
+        ByteArray seed;
+        while (seed.size() < kMaxDatagramSize)
+        {
+            seed.push_back(byte(aRandom));
+            seed.push_back(0);
+        }
+        seeds.push_back(seed);
+    }
+
+    {
+        // Duplicate TLVs of the same type.
+        ByteArray seed;
+        while (seed.size() < kMaxDatagramSize)
+        {
+            seed.push_back(utils::to_underlying(tlv::Type::kJoinerDtlsEncapsulation));
+            seed.push_back(4);
+            seed.insert(seed.end(), 4, 0xAB);
+        }
+        seeds.push_back(seed);
+    }
+
+    {
+        // An Extended TLV followed by random bytes.
+        ByteArray seed{utils::to_underlying(tlv::Type::kJoinerDtlsEncapsulation), tlv::kEscapeLength, 0x04, 0xF0};
+        while (seed.size() < kMaxDatagramSize)
+        {
+            seed.push_back(byte(aRandom));
+        }
+        seeds.push_back(seed);
+    }
+
+    return seeds;
+}
+
+// Mutates a few random bytes and occasionally truncates or extends the datagram.
+static void Mutate(ByteArray &aBuf, std::mt19937 &aRandom)
+{
+    std::uniform_int_distribution<int> byte{0, 0xFF};
+
+    for (int i = byte(aRandom) % 8; i >= 0; --i)
+    {
+        aBuf[byte(aRandom) * aBuf.size() / 0x100] = byte(aRandom);
+    }
+    if (byte(aRandom) < 0x20)
+    {
+        aBuf.resize(byte(aRandom) * aBuf.size() / 0x100);
+    }
+    while (byte(aRandom) < 0x20 && aBuf.size() < kMaxDatagramSize)
+    {
+        aBuf.push_back(byte(aRandom));
+    }
+}
+
+template <typename Parse>
+static bool BenchParse(const std::string &           aName,
+                       const std::vector<ByteArray> &aSeeds,
+                       std::mt19937 &                aRandom,
+                       Parse                         aParse)
+{
+    std::chrono::nanoseconds maxCost{0};
+    std::chrono::nanoseconds totalCost{0};
+
+    for (size_t round = 0; round < kFuzzRounds; ++round)
+    {
+        ByteArray buf = aSeeds[round % aSeeds.size()];
+
+        Mutate(buf, aRandom);
+
+        auto begin = GetThreadCpuTime();
+        aParse(buf);
+        auto cost = GetThreadCpuTime() - begin;
+
+        maxCost = std::max(maxCost, cost);
+        totalCost += cost;
+    }
+
+    fmt::print("{:<6} parse mean {:>8.3f} us, max {:>8.3f} us (budget {} us)\n", aName,
+               totalCost.count() / 1000.0 / kFuzzRounds, maxCost.count() / 1000.0,
+               std::chrono::duration_cast<std::chrono::microseconds>(kBudget).count());
+
+    return maxCost < kBudget;
+}
+
+int main()
+{
+    std::mt19937 random{0x5EED};
+    bool         withinBudget = true;
+
+    withinBudget &= BenchParse("CoAP", MakeCoapSeeds(), random, [](const ByteArray &aBuf) {
+        Error error;
+        coap::Message::Deserialize(error, aBuf);
+    });
+
+    withinBudget &= BenchParse("TLV", MakeTlvSeeds(random), random, [](const ByteArray &aBuf) {
+        tlv::TlvSet tlvSet;
+        IgnoreError(tlv::GetTlvSet(tlvSet, aBuf));
+    });
+
+    return withinBudget ? 0 : 1;
+}
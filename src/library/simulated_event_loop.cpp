@@ -0,0 +1,201 @@
+/*
+ *  Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the simulated event loop.
+ */
+
+#include "library/simulated_event_loop.hpp"
+
+#include "common/utils.hpp"
+#include "library/timer.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+// The simulated event loops attached to event bases. Timers look up the
+// map only when a loop is alive, so real event loops don't pay for it.
+static std::mutex                                                sLoopsMutex;
+static std::map<const struct event_base *, SimulatedEventLoop *> sLoops;
+static std::atomic<size_t>                                       sLoopCount{0};
+
+SimulatedEventLoop::SimulatedEventLoop(struct event_base *aEventBase, TimePoint aStartTime)
+    : mEventBase(aEventBase)
+    , mNow(aStartTime.time_since_epoch().count())
+{
+    VerifyOrDie(mEventBase != nullptr);
+
+    {
+        std::lock_guard<std::mutex> _(sLoopsMutex);
+
+        VerifyOrDie(sLoops.emplace(mEventBase, this).second);
+        ++sLoopCount;
+    }
+
+    SetThreadClockSource(this);
+}
+
+SimulatedEventLoop::SimulatedEventLoop(struct event_base *aEventBase)
+    : SimulatedEventLoop(aEventBase, Clock::now())
+{
+}
+
+SimulatedEventLoop::~SimulatedEventLoop()
+{
+    auto previous = SetThreadClockSource(nullptr);
+
+    // Keeps the clock source of another loop of this thread.
+    if (previous != this)
+    {
+        SetThreadClockSource(previous);
+    }
+
+    std::lock_guard<std::mutex> _(sLoopsMutex);
+
+    sLoops.erase(mEventBase);
+    --sLoopCount;
+}
+
+TimePoint SimulatedEventLoop::Now() const
+{
+    return TimePoint(Clock::duration(mNow.load()));
+}
+
+void SimulatedEventLoop::SetNow(TimePoint aNow)
+{
+    // The virtual time never goes backward.
+    if (aNow > Now())
+    {
+        mNow.store(aNow.time_since_epoch().count());
+    }
+}
+
+void SimulatedEventLoop::RunFor(Duration aDuration)
+{
+    RunUntil([]() { return false; }, aDuration);
+}
+
+bool SimulatedEventLoop::RunUntil(const std::function<bool()> &aCondition, Duration aTimeout)
+{
+    // The callbacks of this loop run with its virtual time, whichever thread runs it.
+    auto previousClockSource = SetThreadClockSource(this);
+    auto deadline            = Now() + aTimeout;
+    bool isDone              = false;
+
+    while (!isDone)
+    {
+        VerifyOrDie(event_base_loop(mEventBase, EVLOOP_NONBLOCK) >= 0);
+
+        isDone = aCondition();
+        if (!isDone && !FireNextTimer(deadline))
+        {
+            SetNow(deadline);
+            VerifyOrDie(event_base_loop(mEventBase, EVLOOP_NONBLOCK) >= 0);
+            break;
+        }
+    }
+
+    SetThreadClockSource(previousClockSource);
+
+    return isDone || aCondition();
+}
+
+bool SimulatedEventLoop::FireNextTimer(TimePoint aDeadline)
+{
+    Timer *timer = nullptr;
+
+    {
+        std::lock_guard<std::mutex> _(mTimersMutex);
+
+        if (mTimers.empty() || mTimers.begin()->first > aDeadline)
+        {
+            return false;
+        }
+
+        SetNow(mTimers.begin()->first);
+        timer = mTimers.begin()->second;
+        mTimers.erase(mTimers.begin());
+    }
+
+    // The timer callback runs in the event loop of the timer.
+    event_active(&timer->mTimerEvent, EV_TIMEOUT, 1);
+    return true;
+}
+
+size_t SimulatedEventLoop::GetPendingTimerCount() const
+{
+    std::lock_guard<std::mutex> _(mTimersMutex);
+
+    return mTimers.size();
+}
+
+void SimulatedEventLoop::Schedule(Timer &aTimer, TimePoint aFireTime)
+{
+    std::lock_guard<std::mutex> _(mTimersMutex);
+
+    mTimers.emplace(aFireTime, &aTimer);
+}
+
+void SimulatedEventLoop::Cancel(Timer &aTimer, TimePoint aFireTime)
+{
+    std::lock_guard<std::mutex> _(mTimersMutex);
+
+    auto range = mTimers.equal_range(aFireTime);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (it->second == &aTimer)
+        {
+            mTimers.erase(it);
+            break;
+        }
+    }
+}
+
+SimulatedEventLoop *SimulatedEventLoop::Get(const struct event_base *aEventBase)
+{
+    SimulatedEventLoop *loop = nullptr;
+
+    if (sLoopCount.load() > 0)
+    {
+        std::lock_guard<std::mutex> _(sLoopsMutex);
+        auto                        it = sLoops.find(aEventBase);
+
+        if (it != sLoops.end())
+        {
+            loop = it->second;
+        }
+    }
+
+    return loop;
+}
+
+} // namespace commissioner
+
+} // namespace ot
@@ -0,0 +1,114 @@
+/*
+ *  Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines the simulated event loop.
+ *
+ *   A simulated event loop drives a libevent event base with virtual
+ *   time: while it is alive, Clock::now() returns the virtual time on
+ *   the thread which creates or runs it, and the Timers of its event
+ *   base are scheduled by the simulated loop instead of libevent.
+ *   Loops of different event bases are independent of each other.
+ *   Whenever there is no ready event, the virtual time jumps to the
+ *   next timer, so hours of retransmission, keep-alive and expiry
+ *   behavior run in milliseconds and are reproducible.
+ */
+
+#ifndef OT_COMM_LIBRARY_SIMULATED_EVENT_LOOP_HPP_
+#define OT_COMM_LIBRARY_SIMULATED_EVENT_LOOP_HPP_
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <mutex>
+
+#include "common/time.hpp"
+#include "library/event.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+class Timer;
+
+class SimulatedEventLoop : public ClockSource
+{
+public:
+    /**
+     * Constructs a simulated event loop and installs it as the timer
+     * scheduler of @p aEventBase and the clock source of this thread.
+     *
+     * At most one simulated event loop can be attached to an event base.
+     *
+     * @param[in]  aEventBase  The event base to be driven.
+     * @param[in]  aStartTime  The initial virtual time.
+     *
+     */
+    SimulatedEventLoop(struct event_base *aEventBase, TimePoint aStartTime);
+    explicit SimulatedEventLoop(struct event_base *aEventBase);
+    ~SimulatedEventLoop() override;
+
+    SimulatedEventLoop(const SimulatedEventLoop &) = delete;
+    SimulatedEventLoop &operator=(const SimulatedEventLoop &) = delete;
+
+    TimePoint Now() const override;
+
+    // Runs ready events and timers until the virtual time has advanced by @p aDuration.
+    void RunFor(Duration aDuration);
+
+    // Runs ready events and timers until @p aCondition becomes true or the
+    // virtual time has advanced by @p aTimeout. Returns the value of @p aCondition.
+    bool RunUntil(const std::function<bool()> &aCondition, Duration aTimeout);
+
+    size_t GetPendingTimerCount() const;
+
+    // Returns the simulated event loop attached to @p aEventBase, or nullptr if there is none.
+    static SimulatedEventLoop *Get(const struct event_base *aEventBase);
+
+private:
+    friend class Timer;
+
+    void Schedule(Timer &aTimer, TimePoint aFireTime);
+    void Cancel(Timer &aTimer, TimePoint aFireTime);
+
+    // Fires the earliest timer due not later than @p aDeadline. Returns false if there is none.
+    bool FireNextTimer(TimePoint aDeadline);
+    void SetNow(TimePoint aNow);
+
+    struct event_base *               mEventBase;
+    std::atomic<Clock::rep>           mNow;
+    mutable std::mutex                mTimersMutex;
+    std::multimap<TimePoint, Timer *> mTimers;
+};
+
+} // namespace commissioner
+
+} // namespace ot
+
+#endif // OT_COMM_LIBRARY_SIMULATED_EVENT_LOOP_HPP_
@@ -0,0 +1,185 @@
+/*
+ *  Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines test cases for the simulated event loop.
+ */
+
+#include "library/simulated_event_loop.hpp"
+
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "library/timer.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+TEST_CASE("simulated-event-loop-virtual-time", "[simulated-event-loop]")
+{
+    auto eventBase = event_base_new();
+    REQUIRE(eventBase != nullptr);
+
+    {
+        const TimePoint    startTime{std::chrono::hours(24)};
+        SimulatedEventLoop loop{eventBase, startTime};
+
+        REQUIRE(SimulatedEventLoop::Get(eventBase) == &loop);
+        REQUIRE(Clock::now() == startTime);
+
+        loop.RunFor(std::chrono::hours(10));
+        REQUIRE(Clock::now() == startTime + std::chrono::hours(10));
+    }
+
+    REQUIRE(SimulatedEventLoop::Get(eventBase) == nullptr);
+
+    event_base_free(eventBase);
+}
+
+TEST_CASE("simulated-event-loop-timers", "[simulated-event-loop]")
+{
+    auto eventBase = event_base_new();
+    REQUIRE(eventBase != nullptr);
+
+    {
+        const TimePoint    startTime{std::chrono::hours(24)};
+        SimulatedEventLoop loop{eventBase, startTime};
+        std::vector<int>   fired;
+        TimePoint          fireTime;
+
+        Timer timer0{eventBase, [&](Timer &) {
+                         fired.push_back(0);
+                         fireTime = Clock::now();
+                     }};
+        Timer timer1{eventBase, [&](Timer &) { fired.push_back(1); }};
+        Timer timer2{eventBase, [&](Timer &) { fired.push_back(2); }};
+
+        SECTION("timers fire in order of fire time, instantly")
+        {
+            timer0.Start(std::chrono::seconds(3600));
+            timer1.Start(std::chrono::seconds(60));
+            timer2.Start(std::chrono::seconds(7200));
+
+            loop.RunFor(std::chrono::seconds(3600));
+            REQUIRE(fired == std::vector<int>{1, 0});
+            REQUIRE(fireTime == startTime + std::chrono::seconds(3600));
+            REQUIRE(loop.GetPendingTimerCount() == 1);
+
+            REQUIRE(loop.RunUntil([&]() { return fired.size() == 3; }, std::chrono::hours(24)));
+            REQUIRE(Clock::now() == startTime + std::chrono::seconds(7200));
+        }
+
+        SECTION("stopped and restarted timers")
+        {
+            timer0.Start(std::chrono::seconds(10));
+            timer1.Start(std::chrono::seconds(20));
+            timer0.Stop();
+            timer1.Start(std::chrono::seconds(30));
+
+            loop.RunFor(std::chrono::seconds(25));
+            REQUIRE(fired.empty());
+            loop.RunFor(std::chrono::seconds(5));
+            REQUIRE(fired == std::vector<int>{1});
+            REQUIRE(loop.GetPendingTimerCount() == 0);
+        }
+
+        SECTION("persistent timer")
+        {
+            size_t count = 0;
+            Timer  timer{eventBase, [&](Timer &) { ++count; }, /* aIsSingle */ false};
+
+            timer.Start(std::chrono::seconds(15));
+            loop.RunFor(std::chrono::hours(1));
+            REQUIRE(count == 240);
+
+            timer.Stop();
+            loop.RunFor(std::chrono::hours(1));
+            REQUIRE(count == 240);
+        }
+
+        SECTION("persistent timer of no interval")
+        {
+            size_t count = 0;
+            Timer  timer{eventBase, [&](Timer &) { ++count; }, /* aIsSingle */ false};
+
+            timer.Start(std::chrono::seconds(0));
+            loop.RunFor(std::chrono::milliseconds(1));
+            REQUIRE(count == 1000);
+        }
+    }
+
+    event_base_free(eventBase);
+}
+
+TEST_CASE("simulated-event-loop-per-event-base", "[simulated-event-loop]")
+{
+    auto eventBase0 = event_base_new();
+    auto eventBase1 = event_base_new();
+    REQUIRE(eventBase0 != nullptr);
+    REQUIRE(eventBase1 != nullptr);
+
+    {
+        SimulatedEventLoop loop0{eventBase0, TimePoint{std::chrono::hours(1)}};
+        SimulatedEventLoop loop1{eventBase1, TimePoint{std::chrono::hours(2)}};
+        TimePoint          fireTime0;
+        TimePoint          fireTime1;
+
+        Timer timer0{eventBase0, [&](Timer &) { fireTime0 = Clock::now(); }};
+        Timer timer1{eventBase1, [&](Timer &) { fireTime1 = Clock::now(); }};
+
+        REQUIRE(SimulatedEventLoop::Get(eventBase0) == &loop0);
+        REQUIRE(SimulatedEventLoop::Get(eventBase1) == &loop1);
+
+        timer0.Start(loop0.Now() + std::chrono::seconds(10));
+        timer1.Start(loop1.Now() + std::chrono::seconds(20));
+        REQUIRE(loop0.GetPendingTimerCount() == 1);
+        REQUIRE(loop1.GetPendingTimerCount() == 1);
+
+        loop0.RunFor(std::chrono::minutes(1));
+        REQUIRE(fireTime0 == TimePoint{std::chrono::hours(1) + std::chrono::seconds(10)});
+        REQUIRE(loop1.GetPendingTimerCount() == 1);
+        REQUIRE(loop1.Now() == TimePoint{std::chrono::hours(2)});
+
+        loop1.RunFor(std::chrono::minutes(1));
+        REQUIRE(fireTime1 == TimePoint{std::chrono::hours(2) + std::chrono::seconds(20)});
+        REQUIRE(loop0.Now() == TimePoint{std::chrono::hours(1) + std::chrono::minutes(1)});
+    }
+
+    REQUIRE(SimulatedEventLoop::Get(eventBase0) == nullptr);
+    REQUIRE(SimulatedEventLoop::Get(eventBase1) == nullptr);
+
+    event_base_free(eventBase1);
+    event_base_free(eventBase0);
+}
+
+} // namespace commissioner
+
+} // namespace ot
@@ -28,8 +28,10 @@
 
 #include "library/socket.hpp"
 
+#include <errno.h>
 #include <memory.h>
 #include <netinet/in.h>
+#include <sys/socket.h>
 
 #include "common/utils.hpp"
 #include "library/logging.hpp"
@@ -56,11 +58,63 @@ static uint16_t GetSockPort(const sockaddr_storage &aSockAddr)
     }
 }
 
-Socket::Socket(struct event_base *aEventBase)
+// Enables kernel receive timestamps of the socket if supported.
+static void EnableRecvTimestamp(int aFd)
+{
+#ifdef SO_TIMESTAMPNS
+    int enable = 1;
+
+    if (setsockopt(aFd, SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable)) != 0)
+    {
+        LOG_DEBUG(LOG_REGION_SOCKET, "enable SO_TIMESTAMPNS on fd={} failed: {}", aFd, strerror(errno));
+    }
+#else
+    (void)aFd;
+#endif
+}
+
+// Returns the kernel receive timestamp of a datagram as a time of Clock.
+// Returns the current time if the datagram doesn't carry a timestamp.
+static TimePoint GetRecvTime(const struct msghdr &aMsg)
+{
+    TimePoint now = Clock::now();
+
+#ifdef SO_TIMESTAMPNS
+    for (auto cmsg = CMSG_FIRSTHDR(&aMsg); cmsg != nullptr; cmsg = CMSG_NXTHDR(const_cast<msghdr *>(&aMsg), cmsg))
+    {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS)
+        {
+            using SystemClock = std::chrono::system_clock;
+
+            struct timespec         timestamp;
+            SystemClock::time_point recvTime;
+
+            memcpy(&timestamp, CMSG_DATA(cmsg), sizeof(timestamp));
+            recvTime += std::chrono::duration_cast<SystemClock::duration>(std::chrono::seconds(timestamp.tv_sec) +
+                                                                          std::chrono::nanoseconds(timestamp.tv_nsec));
+
+            // The timestamp is of the system clock, translate it by how long ago it was.
+            if (SystemClock::now() > recvTime)
+            {
+                now -= std::chrono::duration_cast<Clock::duration>(SystemClock::now() - recvTime);
+            }
+            break;
+        }
+    }
+#else
+    (void)aMsg;
+#endif
+
+    return now;
+}
+
+Socket::Socket(struct event_base *aEventBase, CpuAccount *aCpuAccount)
     : mEventBase(aEventBase)
     , mEventHandler(nullptr)
     , mIsConnected(false)
     , mSubType(MessageSubType::kNone)
+    , mCpuAccount(aCpuAccount)
+    , mCpuCategory(CpuCategory::kSocket)
 {
     memset(&mEvent, 0, sizeof(mEvent));
 }
@@ -85,14 +139,15 @@ int Socket::Receive(void *aSocket, uint8_t *aBuf, size_t aMaxLen)
 
 void Socket::HandleEvent(evutil_socket_t, short aFlags, void *aSocket)
 {
-    auto socket = reinterpret_cast<Socket *>(aSocket);
+    auto     socket = reinterpret_cast<Socket *>(aSocket);
+    CpuScope cpuScope(socket->mCpuAccount, socket->mCpuCategory);
 
     VerifyOrDie(socket->mEventHandler != nullptr);
     socket->mEventHandler(aFlags);
 }
 
-UdpSocket::UdpSocket(struct event_base *aEventBase)
-    : Socket(aEventBase)
+UdpSocket::UdpSocket(struct event_base *aEventBase, CpuAccount *aCpuAccount)
+    : Socket(aEventBase, aCpuAccount)
     , mIsBound(false)
 {
     mbedtls_net_init(&mNetCtx);
@@ -104,10 +159,11 @@ UdpSocket::~UdpSocket()
 }
 
 UdpSocket::UdpSocket(UdpSocket &&aOther)
-    : Socket(aOther.mEventBase)
+    : Socket(aOther.mEventBase, aOther.mCpuAccount)
     , mNetCtx(aOther.mNetCtx)
     , mIsBound(aOther.mIsBound)
 {
+    mCpuCategory = aOther.mCpuCategory;
     mbedtls_net_init(&aOther.mNetCtx);
 }
 
@@ -126,6 +182,7 @@ int UdpSocket::Connect(const std::string &aHost, uint16_t aPort)
     int rval = mbedtls_net_connect(&mNetCtx, aHost.c_str(), portStr.c_str(), MBEDTLS_NET_PROTO_UDP);
     VerifyOrExit(rval == 0);
     VerifyOrExit((rval = mbedtls_net_set_nonblock(&mNetCtx)) == 0);
+    EnableRecvTimestamp(mNetCtx.fd);
 
     // Setup event
     rval = event_assign(&mEvent, mEventBase, mNetCtx.fd, EV_PERSIST | EV_READ | EV_WRITE | EV_ET, HandleEvent, this);
@@ -159,6 +216,7 @@ int UdpSocket::Bind(const std::string &aBindIp, uint16_t aPort)
     int rval = mbedtls_net_bind(&mNetCtx, aBindIp.c_str(), portStr.c_str(), MBEDTLS_NET_PROTO_UDP);
     VerifyOrExit(rval == 0);
     VerifyOrExit((rval = mbedtls_net_set_nonblock(&mNetCtx)) == 0);
+    EnableRecvTimestamp(mNetCtx.fd);
 
     // Setup Event
     rval = event_assign(&mEvent, mEventBase, mNetCtx.fd, EV_PERSIST | EV_READ | EV_WRITE | EV_ET, HandleEvent, this);
@@ -230,10 +288,40 @@ int UdpSocket::Send(const uint8_t *aBuf, size_t aLen)
 
 int UdpSocket::Receive(uint8_t *aBuf, size_t aMaxLen)
 {
+    struct iovec  iov = {aBuf, aMaxLen};
+    struct msghdr msg;
+    uint8_t       control[128];
+    ssize_t       rval;
+
     VerifyOrDie(mNetCtx.fd >= 0);
     VerifyOrDie(mIsConnected);
 
-    return mbedtls_net_recv(&mNetCtx, aBuf, aMaxLen);
+    // Same as mbedtls_net_recv() except that the receive timestamp is read along with the datagram.
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov        = &iov;
+    msg.msg_iovlen     = 1;
+    msg.msg_control    = control;
+    msg.msg_controllen = sizeof(control);
+
+    rval = recvmsg(mNetCtx.fd, &msg, 0);
+    if (rval >= 0)
+    {
+        mLastRecvTime = GetRecvTime(msg);
+    }
+    else if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+    {
+        rval = MBEDTLS_ERR_SSL_WANT_READ;
+    }
+    else if (errno == EPIPE || errno == ECONNRESET)
+    {
+        rval = MBEDTLS_ERR_NET_CONN_RESET;
+    }
+    else
+    {
+        rval = MBEDTLS_ERR_NET_RECV_FAILED;
+    }
+
+    return static_cast<int>(rval);
 }
 
 void UdpSocket::SetEventHandler(EventHandler aEventHandler)
@@ -42,6 +42,8 @@
 #include <commissioner/defines.hpp>
 
 #include "common/address.hpp"
+#include "common/time.hpp"
+#include "library/cpu_account.hpp"
 #include "library/event.hpp"
 #include "library/message.hpp"
 
@@ -52,7 +54,8 @@ namespace commissioner {
 class Socket
 {
 public:
-    explicit Socket(struct event_base *aEventBase);
+    // Events are charged to @p aCpuAccount, or to no account if it is null.
+    explicit Socket(struct event_base *aEventBase, CpuAccount *aCpuAccount = nullptr);
     Socket(Socket &&aOther) = default;
     Socket &operator=(Socket &&aOther) = delete;
     Socket(const Socket &aOther)       = delete;
@@ -80,9 +83,16 @@ public:
 
     virtual void SetEventHandler(EventHandler aEventHandler) { mEventHandler = aEventHandler; }
 
+    // Get the time the last received datagram arrived at this host. It is
+    // the kernel receive timestamp if the socket supports it, so it doesn't
+    // include the time the datagram waited for the event loop.
+    TimePoint GetLastRecvTime() const { return mLastRecvTime; }
+
     // Set the sub-type of the next message. Required by JoinerSession::RelaySocket.
     MessageSubType GetSubType() const { return mSubType; }
 
+    CpuAccount *GetCpuAccount() const { return mCpuAccount; }
+
     // Get the sub-type of the next message. Required by JoinerSession::RelaySocket.
     void SetSubType(MessageSubType aSubType) { mSubType = aSubType; }
 
@@ -97,8 +107,12 @@ protected:
     struct event       mEvent;
     EventHandler       mEventHandler;
     bool               mIsConnected;
+    TimePoint          mLastRecvTime;
 
     MessageSubType mSubType;
+
+    CpuAccount *mCpuAccount;
+    CpuCategory mCpuCategory;
 };
 
 using SocketPtr = std::shared_ptr<Socket>;
@@ -106,7 +120,7 @@ using SocketPtr = std::shared_ptr<Socket>;
 class UdpSocket : public Socket
 {
 public:
-    explicit UdpSocket(struct event_base *aEventBase);
+    explicit UdpSocket(struct event_base *aEventBase, CpuAccount *aCpuAccount = nullptr);
     UdpSocket(UdpSocket &&aOther);
     ~UdpSocket() override;
 
@@ -0,0 +1,141 @@
+/*
+ *  Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements a benchmark of the commissioner startup.
+ *
+ *   It measures the time-to-ready of a commissioner, which is the time of
+ *   creating and initializing it with a configuration, for both non-CCM
+ *   (PSKc) and CCM (certificate) configurations. Nothing is sent to the
+ *   network, the cost of connecting is not included.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include <stdlib.h>
+
+#include <fmt/format.h>
+
+#include <commissioner/commissioner.hpp>
+
+#include "common/utils.hpp"
+
+#ifndef OT_COMM_BENCH_CREDENTIALS_DIR
+#error "OT_COMM_BENCH_CREDENTIALS_DIR not defined"
+#endif
+
+using namespace ot::commissioner;
+
+static constexpr size_t kDefaultCommissionerCount = 50;
+
+using BenchClock = std::chrono::steady_clock;
+
+static double ElapsedMilliseconds(BenchClock::time_point aBegin)
+{
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(BenchClock::now() - aBegin);
+    return elapsed.count() / 1000.0;
+}
+
+#if OT_COMM_CONFIG_CCM_ENABLE
+// Reads a PEM file, the PEM parser requires the terminating null character.
+static ByteArray ReadPemFile(const std::string &aFilename)
+{
+    std::ifstream     file(aFilename);
+    std::stringstream content;
+
+    VerifyOrDie(file.is_open());
+    content << file.rdbuf();
+
+    std::string pem = content.str();
+    ByteArray   ret{pem.begin(), pem.end()};
+
+    ret.push_back(0);
+    return ret;
+}
+#endif // OT_COMM_CONFIG_CCM_ENABLE
+
+static void BenchStartup(const std::string &aName, const Config &aConfig, size_t aCount)
+{
+    CommissionerHandler                        handler;
+    std::vector<std::shared_ptr<Commissioner>> commissioners;
+    double                                     maxReady = 0;
+
+    auto begin = BenchClock::now();
+    for (size_t i = 0; i < aCount; ++i)
+    {
+        auto readyBegin   = BenchClock::now();
+        auto commissioner = Commissioner::Create(handler);
+
+        VerifyOrDie(commissioner != nullptr);
+        SuccessOrDie(commissioner->Init(aConfig));
+        maxReady = std::max(maxReady, ElapsedMilliseconds(readyBegin));
+
+        commissioners.push_back(commissioner);
+    }
+    auto total = ElapsedMilliseconds(begin);
+
+    begin = BenchClock::now();
+    commissioners.clear();
+    auto teardown = ElapsedMilliseconds(begin);
+
+    fmt::print("{:<8} {} commissioners ready in {:>9.3f} ms ({:.3f} ms/commissioner, max {:.3f} ms), "
+               "teardown {:.3f} ms\n",
+               aName, aCount, total, total / aCount, maxReady, teardown);
+}
+
+int main(int argc, const char *argv[])
+{
+    size_t count = kDefaultCommissionerCount;
+    Config config;
+
+    if (argc > 1)
+    {
+        count = strtoul(argv[1], nullptr, 0);
+    }
+
+    config.mEnableCcm = false;
+    config.mPSKc      = {0x3a, 0xa5, 0x5f, 0x91, 0xca, 0x47, 0xd1, 0xe4,
+                    0xe7, 0x1a, 0x08, 0xcb, 0x35, 0xe9, 0x15, 0x91};
+    BenchStartup("non-CCM", config, count);
+
+#if OT_COMM_CONFIG_CCM_ENABLE
+    config.mEnableCcm   = true;
+    config.mPSKc        = {};
+    config.mPrivateKey  = ReadPemFile(OT_COMM_BENCH_CREDENTIALS_DIR "/private-key.pem");
+    config.mCertificate = ReadPemFile(OT_COMM_BENCH_CREDENTIALS_DIR "/certificate.pem");
+    config.mTrustAnchor = ReadPemFile(OT_COMM_BENCH_CREDENTIALS_DIR "/trust-anchor.pem");
+    BenchStartup("CCM", config, count);
+#endif
+
+    return 0;
+}
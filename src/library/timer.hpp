@@ -35,20 +35,28 @@
 
 #include "common/time.hpp"
 #include "common/utils.hpp"
+#include "library/cpu_account.hpp"
 #include "library/event.hpp"
+#include "library/simulated_event_loop.hpp"
 
 namespace ot {
 
 namespace commissioner {
 
 // The implementation of timer based on libevent.
+// Timers are scheduled by the simulated event loop instead
+// of libevent when there is one (see SimulatedEventLoop).
+// A timer charges its CPU time to the account it is created
+// with, or to no account if that is null (see CpuAccount).
 class Timer
 {
 public:
     using Action = std::function<void(Timer &aTimer)>;
 
-    Timer(struct event_base *aEventBase, Action aAction, bool aIsSingle = true)
-        : mAction(aAction)
+    Timer(struct event_base *aEventBase, Action aAction, bool aIsSingle = true, CpuAccount *aCpuAccount = nullptr)
+        : mInterval(0)
+        , mCpuAccount(aCpuAccount)
+        , mAction(aAction)
         , mIsSingle(aIsSingle)
         , mEnabled(false)
     {
@@ -67,15 +75,31 @@ public:
             Stop();
         }
 
-        auto delay = std::chrono::duration_cast<std::chrono::microseconds>(aFireTime - Clock::now());
+        auto now   = Clock::now();
+        auto delay = std::chrono::duration_cast<std::chrono::microseconds>(aFireTime - now);
 
-        struct timeval tv;
-        evutil_timerclear(&tv);
-        tv.tv_sec  = delay.count() / 1000000;
-        tv.tv_usec = delay.count() % 1000000;
+        // A persistent timer of no interval would fire again at the same time forever.
+        if (!mIsSingle && delay.count() < 1)
+        {
+            delay     = std::chrono::microseconds(1);
+            aFireTime = now + delay;
+        }
+
+        if (auto simulatedLoop = SimulatedEventLoop::Get(event_get_base(&mTimerEvent)))
+        {
+            simulatedLoop->Schedule(*this, aFireTime);
+        }
+        else
+        {
+            struct timeval tv;
+            evutil_timerclear(&tv);
+            tv.tv_sec  = delay.count() / 1000000;
+            tv.tv_usec = delay.count() % 1000000;
 
-        VerifyOrDie(event_add(&mTimerEvent, &tv) == 0);
+            VerifyOrDie(event_add(&mTimerEvent, &tv) == 0);
+        }
         mFireTime = aFireTime;
+        mInterval = delay;
         mEnabled  = true;
     }
 
@@ -85,6 +109,10 @@ public:
     {
         if (mEnabled)
         {
+            if (auto simulatedLoop = SimulatedEventLoop::Get(event_get_base(&mTimerEvent)))
+            {
+                simulatedLoop->Cancel(*this, mFireTime);
+            }
             event_del(&mTimerEvent);
         }
         mEnabled = false;
@@ -95,23 +123,35 @@ public:
     TimePoint GetFireTime() { return mFireTime; }
 
 private:
+    friend class SimulatedEventLoop;
+
     static void HandleEvent(evutil_socket_t, short, void *aContext)
     {
-        auto timer = reinterpret_cast<Timer *>(aContext);
+        auto     timer = reinterpret_cast<Timer *>(aContext);
+        CpuScope cpuScope(timer->mCpuAccount, CpuCategory::kTimer);
+
         if (timer->mIsSingle)
         {
             timer->mEnabled = false;
             // The event will be automatically deleted by libevent.
         }
+        else if (auto simulatedLoop = SimulatedEventLoop::Get(event_get_base(&timer->mTimerEvent)))
+        {
+            // libevent re-adds a persistent timer by itself, but not a simulated one.
+            timer->mFireTime += timer->mInterval;
+            simulatedLoop->Schedule(*timer, timer->mFireTime);
+        }
 
         timer->mAction(*timer);
     }
 
-    struct event mTimerEvent;
-    TimePoint    mFireTime;
-    const Action mAction;
-    const bool   mIsSingle;
-    bool         mEnabled;
+    struct event              mTimerEvent;
+    TimePoint                 mFireTime;
+    std::chrono::microseconds mInterval;
+    CpuAccount *const         mCpuAccount;
+    const Action              mAction;
+    const bool                mIsSingle;
+    bool                      mEnabled;
 };
 
 } // namespace commissioner
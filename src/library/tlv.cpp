@@ -113,19 +113,23 @@ bool IsExtendedTlv(Type aType)
     }
 }
 
-void Tlv::Serialize(ByteArray &aBuf) const
+bool Tlv::HasExtendedHeader(bool aCompactExtendedTlv) const
+{
+    // Thread 1.2 allows extended TLVs use the base TLV format if
+    // its length does not exceed 254 bytes. But OpenThread before
+    // 1.2 does not support this kind of encoding, so it is used
+    // only for peers known to accept it.
+    return GetLength() >= kEscapeLength || (IsExtendedTlv(mType) && !aCompactExtendedTlv);
+}
+
+void Tlv::Serialize(ByteArray &aBuf, bool aCompactExtendedTlv) const
 {
     ASSERT(IsValid());
 
     utils::Encode(aBuf, utils::to_underlying(GetType()));
 
-    // TODO(wgtdkp): Thread 1.2 allows extended TLVs use
-    // the base TLV format if its length does not exceed
-    // 254 bytes. But OpenThread currently does not support
-    // this kind of encoding.
-    if (IsExtendedTlv(mType))
+    if (HasExtendedHeader(aCompactExtendedTlv))
     {
-        // if (GetLength() >= kEscapeLength) {
         utils::Encode(aBuf, kEscapeLength);
         utils::Encode(aBuf, GetLength());
     }
@@ -181,151 +185,154 @@ exit:
 
 bool Tlv::IsValid() const
 {
-    auto length = GetLength();
-
     // The length is cutted off.
-    if (length != mValue.size())
+    if (GetLength() != mValue.size())
     {
         return false;
     }
 
-    if (mScope == Scope::kThread)
+    return IsValidLength(mType, GetLength(), mScope);
+}
+
+bool Tlv::IsValidLength(Type aType, uint16_t aLength, Scope aScope)
+{
+    if (aScope == Scope::kThread)
     {
-        switch (mType)
+        switch (aType)
         {
         // Thread Network Layer TLVs
         case Type::kThreadStatus:
-            return length == 1;
+            return aLength == 1;
         case Type::kThreadTimeout:
-            return length == 4;
+            return aLength == 4;
         case Type::kThreadIpv6Addresses:
-            return (length % 16 == 0) && (length / 16 >= 1 && length / 16 <= 15);
+            return (aLength % 16 == 0) && (aLength / 16 >= 1 && aLength / 16 <= 15);
         case Type::kThreadCommissionerSessionId:
-            return length == 2;
+            return aLength == 2;
         case Type::kThreadCommissionerToken:
             return true;
         case Type::kThreadCommissionerSignature:
-            return length < kEscapeLength;
+            return aLength < kEscapeLength;
         default:
             return false;
         }
     }
-    else if (mScope == Scope::kMeshLink)
+    else if (aScope == Scope::kMeshLink)
     {
         return false;
     }
 
-    switch (mType)
+    switch (aType)
     {
     // Network Management TLVs
     case Type::kChannel:
-        return length == 3;
+        return aLength == 3;
     case Type::kPanId:
-        return length == 2;
+        return aLength == 2;
     case Type::kExtendedPanId:
-        return length == 8;
+        return aLength == 8;
     case Type::kNetworkName:
-        return length <= 16;
+        return aLength <= 16;
     case Type::kPSKc:
-        return length <= 16;
+        return aLength <= 16;
     case Type::kNetworkMasterKey:
-        return length == 16;
+        return aLength == 16;
     case Type::kNetworkKeySequenceCounter:
-        return length == 4;
+        return aLength == 4;
     case Type::kNetworkMeshLocalPrefix:
-        return length == 8;
+        return aLength == 8;
     case Type::kSteeringData:
-        return length <= 16;
+        return aLength <= 16;
     case Type::kBorderAgentLocator:
-        return length == 2;
+        return aLength == 2;
     case Type::kCommissionerId:
-        return length <= 64;
+        return aLength <= 64;
     case Type::kCommissionerSessionId:
-        return length == 2;
+        return aLength == 2;
     case Type::kActiveTimestamp:
-        return length == 8;
+        return aLength == 8;
     case Type::kCommissionerUdpPort:
-        return length == 2;
+        return aLength == 2;
     case Type::kSecurityPolicy:
-        return length == 3 || length == 4;
+        return aLength == 3 || aLength == 4;
     case Type::kPendingTimestamp:
-        return length == 8;
+        return aLength == 8;
     case Type::kDelayTimer:
-        return length == 4;
+        return aLength == 4;
     case Type::kChannelMask:
-        return length < kEscapeLength;
+        return aLength < kEscapeLength;
 
     // MeshCoP Protocol Command TLVs
     case Type::kGet:
-        return length < kEscapeLength;
+        return aLength < kEscapeLength;
     case Type::kState:
-        return length == 1;
+        return aLength == 1;
     case Type::kJoinerDtlsEncapsulation:
         return true;
     case Type::kJoinerUdpPort:
-        return length == 2;
+        return aLength == 2;
     case Type::kJoinerIID:
-        return length == 8;
+        return aLength == 8;
     case Type::kJoinerRouterLocator:
-        return length == 2;
+        return aLength == 2;
     case Type::kJoinerRouterKEK:
-        return length == kJoinerRouterKekLength;
+        return aLength == kJoinerRouterKekLength;
     case Type::kCount:
-        return length == 1;
+        return aLength == 1;
     case Type::kPeriod:
-        return length == 2;
+        return aLength == 2;
     case Type::kScanDuration:
-        return length == 2;
+        return aLength == 2;
     case Type::kEnergyList:
-        return length < kEscapeLength;
+        return aLength < kEscapeLength;
     case Type::kSecureDissemination:
-        return length < kEscapeLength;
+        return aLength < kEscapeLength;
 
     // TMF Provisioning and Discovery TLVs
     case Type::kProvisioningURL:
-        return length <= 64;
+        return aLength <= 64;
     case Type::kVendorName:
-        return length <= 32;
+        return aLength <= 32;
     case Type::kVendorModel:
-        return length <= 32;
+        return aLength <= 32;
     case Type::kVendorSWVersion:
-        return length <= 16;
+        return aLength <= 16;
     case Type::kVendorData:
-        return length <= 64;
+        return aLength <= 64;
     case Type::kVendorStackVersion:
-        return length < kEscapeLength;
+        return aLength < kEscapeLength;
     case Type::kUdpEncapsulation:
-        return length >= 4;
+        return aLength >= 4;
     case Type::kIpv6Address:
-        return length == 16;
+        return aLength == 16;
     case Type::kDomainName:
-        return length <= 16;
+        return aLength <= 16;
     case Type::kDomainPrefix:
         return true; // Reserved.
     case Type::kAeSteeringData:
-        return length <= 16;
+        return aLength <= 16;
     case Type::kNmkpSteeringData:
-        return length <= 16;
+        return aLength <= 16;
     case Type::kCommissionerToken:
         return true;
     case Type::kCommissionerSignature:
-        return length < kEscapeLength;
+        return aLength < kEscapeLength;
     case Type::kAeUdpPort:
-        return length == 2;
+        return aLength == 2;
     case Type::kNmkpUdpPort:
-        return length == 2;
+        return aLength == 2;
     case Type::kTriHostname:
-        return length < kEscapeLength;
+        return aLength < kEscapeLength;
     case Type::kRegistrarIpv6Address:
-        return length == 16;
+        return aLength == 16;
     case Type::kRegistrarHostname:
-        return length < kEscapeLength;
+        return aLength < kEscapeLength;
     case Type::kCommissionerPenSignature:
-        return length < kEscapeLength;
+        return aLength < kEscapeLength;
     case Type::kDiscoveryRequest:
-        return length == 2;
+        return aLength == 2;
     case Type::kDiscoveryResponse:
-        return length == 2;
+        return aLength == 2;
 
     default:
         return false;
@@ -352,10 +359,9 @@ uint16_t Tlv::GetLength() const
     return static_cast<uint16_t>(mValue.size());
 }
 
-uint16_t Tlv::GetTotalLength() const
+uint16_t Tlv::GetTotalLength(bool aCompactExtendedTlv) const
 {
-    uint16_t valueLength = GetLength();
-    return sizeof(Type) + (valueLength >= kEscapeLength ? 3 : 1) + valueLength;
+    return sizeof(Type) + (HasExtendedHeader(aCompactExtendedTlv) ? 3 : 1) + GetLength();
 }
 
 int8_t Tlv::GetValueAsInt8() const
@@ -391,12 +397,24 @@ ByteArray &Tlv::GetValue()
 }
 
 Error GetTlvSet(TlvSet &aTlvSet, const ByteArray &aBuf, Scope aScope)
+{
+    size_t tlvNum;
+
+    return GetTlvSet(aTlvSet, aBuf, aScope, tlvNum);
+}
+
+Error GetTlvSet(TlvSet &aTlvSet, const ByteArray &aBuf, Scope aScope, size_t &aTlvNum)
 {
     Error  error;
-    size_t offset = 0;
+    size_t offset     = 0;
+    size_t invalidNum = 0;
 
+    aTlvNum = 0;
     while (offset < aBuf.size())
     {
+        VerifyOrExit(aTlvNum < kMaxTlvNum, error = ERROR_BAD_FORMAT("too many TLVs (max={})", kMaxTlvNum));
+
+        ++aTlvNum;
         auto tlv = tlv::Tlv::Deserialize(error, offset, aBuf, aScope);
         SuccessOrExit(error);
         VerifyOrDie(tlv != nullptr);
@@ -408,12 +426,16 @@ Error GetTlvSet(TlvSet &aTlvSet, const ByteArray &aBuf, Scope aScope)
         else
         {
             // Drop invalid TLVs
-            LOG_WARN(LOG_REGION_COAP, "dropping invalid/unknown TLV(type={}, value={})",
-                     utils::to_underlying(tlv->GetType()), utils::Hex(tlv->GetValue()));
+            ++invalidNum;
         }
     }
 
 exit:
+    if (invalidNum > 0)
+    {
+        // Logged once so that the cost does not grow with the number of bad TLVs.
+        LOG_WARN(LOG_REGION_COAP, "dropped {} invalid/unknown TLVs", invalidNum);
+    }
     return error;
 }
 
@@ -430,6 +452,52 @@ exit:
     return ret;
 }
 
+Error FindTlv(const uint8_t *&aValue, uint16_t &aLength, tlv::Type aTlvType, const ByteArray &aBuf, Scope aScope)
+{
+    Error          error;
+    size_t         offset = 0;
+    size_t         tlvNum = 0;
+    const uint8_t *value  = nullptr;
+    uint16_t       length = 0;
+
+    while (offset < aBuf.size())
+    {
+        uint8_t  type;
+        uint16_t tlvLength;
+
+        VerifyOrExit(++tlvNum <= kMaxTlvNum, error = ERROR_BAD_FORMAT("too many TLVs (max={})", kMaxTlvNum));
+        VerifyOrExit(offset + 2 <= aBuf.size(), error = ERROR_BAD_FORMAT("premature end of TLV"));
+
+        type      = aBuf[offset++];
+        tlvLength = aBuf[offset++];
+        if (tlvLength == kEscapeLength)
+        {
+            VerifyOrExit(offset + 2 <= aBuf.size(),
+                         error = ERROR_BAD_FORMAT("premature end of Extended TLV(type={})", type));
+            tlvLength = utils::Decode<uint16_t>(&aBuf[offset], sizeof(uint16_t));
+            offset += sizeof(uint16_t);
+        }
+
+        VerifyOrExit(offset + tlvLength <= aBuf.size(),
+                     error = ERROR_BAD_FORMAT("premature end of TLV(type={}, length={})", type, tlvLength));
+
+        if (type == utils::to_underlying(aTlvType) && Tlv::IsValidLength(aTlvType, tlvLength, aScope))
+        {
+            value  = aBuf.data() + offset;
+            length = tlvLength;
+        }
+        offset += tlvLength;
+    }
+
+    VerifyOrExit(value != nullptr, error = ERROR_NOT_FOUND("cannot find TLV(type={})", utils::to_underlying(aTlvType)));
+
+    aValue  = value;
+    aLength = length;
+
+exit:
+    return error;
+}
+
 bool IsDatasetParameter(bool aIsActiveDataset, tlv::Type aTlvType)
 {
     static const std::set<tlv::Type> kActiveSet = {tlv::Type::kActiveTimestamp,
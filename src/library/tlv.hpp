@@ -54,6 +54,8 @@ class Tlv;
 
 static constexpr uint8_t kEscapeLength =
     0xFF; ///< This length value indicates the actual length is of two-bytes length.
+static constexpr size_t kMaxTlvNum = 64; ///< The max number of TLVs accepted in a received payload.
+
 static const int8_t kStateReject  = -1;
 static const int8_t kStateAccept  = 1;
 static const int8_t kStatePending = 0;
@@ -158,7 +160,11 @@ public:
     Tlv(Type aType, uint32_t aValue, Scope aScope = Scope::kMeshCoP);
     Tlv(Type aType, uint64_t aValue, Scope aScope = Scope::kMeshCoP);
 
-    void          Serialize(ByteArray &aBuf) const;
+    // TLVs of the extended TLV format (e.g. UDP Encapsulation TLV) always
+    // have the 4-byte extended header unless `aCompactExtendedTlv` is true,
+    // in which case those shorter than 255 bytes use the 2-byte base header
+    // as allowed since Thread 1.2.
+    void          Serialize(ByteArray &aBuf, bool aCompactExtendedTlv = false) const;
     static TlvPtr Deserialize(Error &aError, size_t &aOffset, const ByteArray &aBuf, Scope aScope = Scope::kMeshCoP);
 
     bool     IsValid() const;
@@ -166,7 +172,7 @@ public:
     void     SetValue(const uint8_t *aBuf, size_t aLength);
     void     SetValue(const ByteArray &aValue);
     uint16_t GetLength() const;
-    uint16_t GetTotalLength() const;
+    uint16_t GetTotalLength(bool aCompactExtendedTlv = false) const;
 
     // It is the caller that make sure the tlv is valid.
     int8_t           GetValueAsInt8() const;
@@ -176,7 +182,12 @@ public:
     const ByteArray &GetValue() const;
     ByteArray &      GetValue();
 
+    // Tell if `aLength` is a valid value length of the TLV.
+    static bool IsValidLength(Type aType, uint16_t aLength, Scope aScope = Scope::kMeshCoP);
+
 private:
+    bool HasExtendedHeader(bool aCompactExtendedTlv) const;
+
     Scope     mScope = Scope::kMeshCoP;
     Type      mType;
     ByteArray mValue;
@@ -184,6 +195,20 @@ private:
 
 Error  GetTlvSet(TlvSet &aTlvSet, const ByteArray &aBuf, Scope aScope = Scope::kMeshCoP);
 TlvPtr GetTlv(tlv::Type aTlvType, const ByteArray &aBuf, Scope aScope = Scope::kMeshCoP);
+
+// As GetTlvSet, `aTlvNum` is set to the number of TLVs parsed,
+// which is never more than kMaxTlvNum.
+Error GetTlvSet(TlvSet &aTlvSet, const ByteArray &aBuf, Scope aScope, size_t &aTlvNum);
+
+// Find the value of a TLV in `aBuf` without decoding the TLVs into a TlvSet.
+// As with GetTlvSet, invalid TLVs are ignored and the last one wins if the
+// TLV appears more than once. `aValue` points into `aBuf` and is valid as
+// long as `aBuf` is not modified.
+Error FindTlv(const uint8_t *& aValue,
+              uint16_t &       aLength,
+              tlv::Type        aTlvType,
+              const ByteArray &aBuf,
+              Scope            aScope = Scope::kMeshCoP);
 bool   IsDatasetParameter(bool aIsActiveDataset, tlv::Type aTlvType);
 
 } // namespace tlv
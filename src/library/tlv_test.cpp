@@ -0,0 +1,289 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines test cases for TLV implementation.
+ */
+
+#include "library/tlv.hpp"
+
+#include <random>
+
+#include <catch2/catch.hpp>
+
+#include "common/utils.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+namespace tlv {
+
+TEST_CASE("tlv-set-basic", "[tlv]")
+{
+    TlvSet    tlvSet;
+    ByteArray buf{utils::to_underlying(Type::kState), 1, 0x01, utils::to_underlying(Type::kCommissionerSessionId),
+                  2, 0x12, 0x34};
+
+    REQUIRE(GetTlvSet(tlvSet, buf) == ErrorCode::kNone);
+    REQUIRE(tlvSet.size() == 2);
+    REQUIRE(tlvSet[Type::kState]->GetValueAsInt8() == kStateAccept);
+    REQUIRE(tlvSet[Type::kCommissionerSessionId]->GetValueAsUint16() == 0x1234);
+
+    SECTION("premature end of TLV")
+    {
+        buf.pop_back();
+        REQUIRE(GetTlvSet(tlvSet, buf) == ErrorCode::kBadFormat);
+    }
+}
+
+TEST_CASE("tlv-set-limit", "[tlv]")
+{
+    TlvSet    tlvSet;
+    ByteArray buf;
+
+    for (size_t i = 0; i < kMaxTlvNum; ++i)
+    {
+        buf.push_back(utils::to_underlying(Type::kState));
+        buf.push_back(1);
+        buf.push_back(0x01);
+    }
+
+    SECTION("the max number of TLVs is accepted")
+    {
+        REQUIRE(GetTlvSet(tlvSet, buf) == ErrorCode::kNone);
+        REQUIRE(tlvSet.size() == 1);
+    }
+
+    SECTION("too many TLVs are rejected")
+    {
+        buf.push_back(utils::to_underlying(Type::kState));
+        buf.push_back(0);
+        REQUIRE(GetTlvSet(tlvSet, buf) == ErrorCode::kBadFormat);
+    }
+}
+
+TEST_CASE("tlv-find", "[tlv]")
+{
+    const uint8_t *value  = nullptr;
+    uint16_t       length = 0;
+    ByteArray      buf{utils::to_underlying(Type::kState), 1, 0x01, utils::to_underlying(Type::kCommissionerSessionId),
+                       2, 0x12, 0x34};
+
+    SECTION("the value is not copied")
+    {
+        REQUIRE(FindTlv(value, length, Type::kCommissionerSessionId, buf) == ErrorCode::kNone);
+        REQUIRE(value == &buf[5]);
+        REQUIRE(length == 2);
+    }
+
+    SECTION("the last one wins as GetTlvSet")
+    {
+        buf.insert(buf.end(), {utils::to_underlying(Type::kState), 1, 0xFF});
+        REQUIRE(FindTlv(value, length, Type::kState, buf) == ErrorCode::kNone);
+        REQUIRE(value == &buf.back());
+        REQUIRE(GetTlv(Type::kState, buf)->GetValue() == ByteArray{value, value + length});
+    }
+
+    SECTION("extended TLVs are found")
+    {
+        Tlv udpEncap{Type::kUdpEncapsulation, ByteArray(300, 0xAB)};
+
+        udpEncap.Serialize(buf);
+        REQUIRE(FindTlv(value, length, Type::kUdpEncapsulation, buf) == ErrorCode::kNone);
+        REQUIRE(ByteArray{value, value + length} == udpEncap.GetValue());
+    }
+
+    SECTION("invalid TLVs are ignored as GetTlvSet")
+    {
+        buf.insert(buf.end(), {utils::to_underlying(Type::kState), 2, 0x01, 0x02});
+        REQUIRE(FindTlv(value, length, Type::kState, buf) == ErrorCode::kNone);
+        REQUIRE(value == &buf[2]);
+        REQUIRE(length == 1);
+    }
+
+    SECTION("missing TLV")
+    {
+        REQUIRE(FindTlv(value, length, Type::kPanId, buf) == ErrorCode::kNotFound);
+        REQUIRE(FindTlv(value, length, Type::kPanId, {}) == ErrorCode::kNotFound);
+    }
+
+    SECTION("premature end of TLV")
+    {
+        buf.pop_back();
+        REQUIRE(FindTlv(value, length, Type::kState, buf) == ErrorCode::kBadFormat);
+    }
+}
+
+TEST_CASE("tlv-extended-tlv-encoding", "[tlv]")
+{
+    const ByteArray kShortValue(kEscapeLength - 1, 0xAB);
+    const ByteArray kLongValue(kEscapeLength, 0xCD);
+
+    ByteArray buf;
+    size_t    offset = 0;
+    Error     error;
+
+    SECTION("extended TLVs have the extended header by default")
+    {
+        Tlv udpEncap{Type::kUdpEncapsulation, kShortValue};
+
+        udpEncap.Serialize(buf);
+        REQUIRE(buf.size() == 4 + kShortValue.size());
+        REQUIRE(buf.size() == udpEncap.GetTotalLength());
+        REQUIRE(buf[1] == kEscapeLength);
+        REQUIRE(utils::Decode<uint16_t>(buf.data() + 2, 2) == kShortValue.size());
+    }
+
+    SECTION("short extended TLVs in the compact encoding have the base header")
+    {
+        Tlv udpEncap{Type::kUdpEncapsulation, kShortValue};
+
+        udpEncap.Serialize(buf, /* aCompactExtendedTlv */ true);
+        REQUIRE(buf.size() == 2 + kShortValue.size());
+        REQUIRE(buf.size() == udpEncap.GetTotalLength(true));
+        REQUIRE(buf[1] == kShortValue.size());
+    }
+
+    SECTION("long extended TLVs in the compact encoding have the extended header")
+    {
+        Tlv dtlsEncap{Type::kJoinerDtlsEncapsulation, kLongValue};
+
+        dtlsEncap.Serialize(buf, /* aCompactExtendedTlv */ true);
+        REQUIRE(buf.size() == 4 + kLongValue.size());
+        REQUIRE(buf.size() == dtlsEncap.GetTotalLength(true));
+        REQUIRE(buf[1] == kEscapeLength);
+    }
+
+    SECTION("base TLVs are not affected by the compact encoding")
+    {
+        Tlv state{Type::kState, kStateAccept};
+
+        state.Serialize(buf, /* aCompactExtendedTlv */ true);
+        REQUIRE(buf == ByteArray{utils::to_underlying(Type::kState), 1, 0x01});
+    }
+
+    SECTION("both encodings are decoded to the same TLV")
+    {
+        for (auto type : {Type::kUdpEncapsulation, Type::kCommissionerToken, Type::kJoinerDtlsEncapsulation})
+        {
+            for (const auto &value : {kShortValue, kLongValue})
+            {
+                Tlv tlv{type, value};
+
+                for (bool compact : {false, true})
+                {
+                    buf.clear();
+                    offset = 0;
+                    tlv.Serialize(buf, compact);
+
+                    auto decoded = Tlv::Deserialize(error, offset, buf);
+                    REQUIRE(error == ErrorCode::kNone);
+                    REQUIRE(decoded != nullptr);
+                    REQUIRE(offset == buf.size());
+                    REQUIRE(decoded->GetType() == type);
+                    REQUIRE(decoded->GetValue() == value);
+                    REQUIRE(decoded->IsValid());
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("tlv-set-bounded-tlvs", "[tlv]")
+{
+    static constexpr size_t kMaxDatagramSize = 1280;
+    static constexpr size_t kFuzzRounds      = 20000;
+
+    std::mt19937                       random{0x5EED};
+    std::uniform_int_distribution<int> byte{0, 0xFF};
+    std::vector<ByteArray>             seeds;
+
+    {
+        // Empty TLVs of random types.
+        ByteArray seed;
+        while (seed.size() < kMaxDatagramSize)
+        {
+            seed.push_back(byte(random));
+            seed.push_back(0);
+        }
+        seeds.push_back(seed);
+    }
+
+    {
+        // Duplicate TLVs of the same type.
+        ByteArray seed;
+        while (seed.size() < kMaxDatagramSize)
+        {
+            seed.push_back(utils::to_underlying(Type::kJoinerDtlsEncapsulation));
+            seed.push_back(4);
+            seed.insert(seed.end(), 4, 0xAB);
+        }
+        seeds.push_back(seed);
+    }
+
+    {
+        // An Extended TLV followed by random bytes.
+        ByteArray seed{utils::to_underlying(Type::kJoinerDtlsEncapsulation), kEscapeLength, 0x04, 0xF0};
+        while (seed.size() < kMaxDatagramSize)
+        {
+            seed.push_back(byte(random));
+        }
+        seeds.push_back(seed);
+    }
+
+    for (size_t round = 0; round < kFuzzRounds; ++round)
+    {
+        ByteArray buf = seeds[round % seeds.size()];
+
+        // Mutate a few random bytes and occasionally truncate the payload.
+        for (int i = byte(random) % 8; i >= 0; --i)
+        {
+            buf[byte(random) * buf.size() / 0x100] = byte(random);
+        }
+        if (byte(random) < 0x20)
+        {
+            buf.resize(byte(random) * buf.size() / 0x100);
+        }
+
+        TlvSet tlvSet;
+        size_t tlvNum = 0;
+
+        // The parser never visits more TLVs than the limit, whatever the input.
+        IgnoreError(GetTlvSet(tlvSet, buf, Scope::kMeshCoP, tlvNum));
+        REQUIRE(tlvNum <= kMaxTlvNum);
+        REQUIRE(tlvSet.size() <= tlvNum);
+    }
+}
+
+} // namespace tlv
+
+} // namespace commissioner
+
+} // namespace ot
@@ -48,8 +48,8 @@ namespace ot {
 
 namespace commissioner {
 
-TokenManager::TokenManager(struct event_base *aEventBase)
-    : mRegistrarClient(aEventBase)
+TokenManager::TokenManager(struct event_base *aEventBase, CpuAccount *aCpuAccount)
+    : mRegistrarClient(aEventBase, /* aIsServer */ false, aCpuAccount)
 {
     mbedtls_pk_init(&mPublicKey);
     mbedtls_pk_init(&mPrivateKey);
@@ -64,6 +64,25 @@ TokenManager::~TokenManager()
 }
 
 Error TokenManager::Init(const Config &aConfig)
+{
+    Error error;
+
+    SuccessOrExit(error = mRegistrarClient.Init(GetDtlsConfig(aConfig)));
+
+    mCommissionerId = aConfig.mId;
+    mDomainName     = aConfig.mDomainName;
+
+    // The keys are parsed by LoadKeys() when they are first used.
+    mCertificate   = aConfig.mCertificate;
+    mPrivateKeyRaw = aConfig.mPrivateKey;
+    mTrustAnchor   = aConfig.mTrustAnchor;
+    mIsKeysLoaded  = false;
+
+exit:
+    return error;
+}
+
+Error TokenManager::LoadKeys()
 {
     Error              error;
     mbedtls_pk_context publicKey;
@@ -74,20 +93,22 @@ Error TokenManager::Init(const Config &aConfig)
     mbedtls_pk_init(&privateKey);
     mbedtls_pk_init(&trustAnchorPublicKey);
 
-    SuccessOrExit(error = ParsePublicKey(publicKey, aConfig.mCertificate));
-    SuccessOrExit(error = ParsePrivateKey(privateKey, aConfig.mPrivateKey));
-    SuccessOrExit(error = ParsePublicKey(trustAnchorPublicKey, aConfig.mTrustAnchor));
+    VerifyOrExit(!mIsKeysLoaded);
 
-    SuccessOrExit(error = mRegistrarClient.Init(GetDtlsConfig(aConfig)));
-
-    mCommissionerId = aConfig.mId;
-    mDomainName     = aConfig.mDomainName;
+    SuccessOrExit(error = ParsePublicKey(publicKey, mCertificate));
+    SuccessOrExit(error = ParsePrivateKey(privateKey, mPrivateKeyRaw));
+    SuccessOrExit(error = ParsePublicKey(trustAnchorPublicKey, mTrustAnchor));
 
     // Move mbedtls keys
     MoveMbedtlsKey(mPublicKey, publicKey);
     MoveMbedtlsKey(mPrivateKey, privateKey);
     MoveMbedtlsKey(mDomainCAPublicKey, trustAnchorPublicKey);
 
+    mCertificate.clear();
+    mPrivateKeyRaw.clear();
+    mTrustAnchor.clear();
+    mIsKeysLoaded = true;
+
 exit:
     mbedtls_pk_free(&trustAnchorPublicKey);
     mbedtls_pk_free(&privateKey);
@@ -144,6 +165,8 @@ exit:
 
 void TokenManager::RequestToken(Commissioner::Handler<ByteArray> aHandler, const std::string &aAddr, uint16_t aPort)
 {
+    Error error;
+
     auto onConnected = [this, aHandler](const DtlsSession &, Error aError) {
         if (aError != ErrorCode::kNone)
         {
@@ -155,7 +178,14 @@ void TokenManager::RequestToken(Commissioner::Handler<ByteArray> aHandler, const
         }
     };
 
+    SuccessOrExit(error = LoadKeys());
     mRegistrarClient.Connect(onConnected, aAddr, aPort);
+
+exit:
+    if (error != ErrorCode::kNone)
+    {
+        aHandler(nullptr, error);
+    }
 }
 
 void TokenManager::SendTokenRequest(Commissioner::Handler<ByteArray> aHandler)
@@ -339,6 +369,7 @@ Error TokenManager::SignMessage(ByteArray &aSignature, const coap::Message &aMes
     cose::Sign1Message sign1Msg;
 
     VerifyOrExit(IsValid(), error = ERROR_INVALID_STATE("has no valid Commissioner Token"));
+    SuccessOrExit(error = LoadKeys());
 
     SuccessOrExit(error = PrepareSigningContent(externalData, aMessage));
 
@@ -423,6 +454,7 @@ Error TokenManager::VerifySignature(const ByteArray &aSignature, const coap::Mes
     CborMap            publicKey;
 
     VerifyOrExit(!aSignature.empty(), error = ERROR_INVALID_ARGS("the signature is empty"));
+    SuccessOrExit(error = LoadKeys());
     SuccessOrExit(error = cose::Sign1Message::Deserialize(sign1Msg, aSignature));
 
     SuccessOrExit(error = PrepareSigningContent(externalData, aSignedMessage));
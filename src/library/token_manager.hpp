@@ -47,10 +47,11 @@ namespace commissioner {
 class TokenManager
 {
 public:
-    explicit TokenManager(struct event_base *aEventBase);
+    explicit TokenManager(struct event_base *aEventBase, CpuAccount *aCpuAccount = nullptr);
     ~TokenManager();
 
     // Initialized with Commissioner configuration.
+    // The credentials are not parsed until they are first used.
     Error Init(const Config &aConfig);
 
     bool IsValid() const { return mToken.IsValid(); }
@@ -93,6 +94,9 @@ private:
     // Move the resource from src to des, leaving the src invalid.
     static void MoveMbedtlsKey(mbedtls_pk_context &aDes, mbedtls_pk_context &aSrc);
 
+    // Parse the credentials into mbedtls keys if not yet parsed.
+    Error LoadKeys();
+
     // Verifying the signature in the signed Commissioner Token
     // with the public key of the signer.
     Error VerifyToken(CborMap &aToken, const ByteArray &aSignedToken, const mbedtls_pk_context &aPublicKey);
@@ -130,6 +134,10 @@ private:
 
     std::string        mCommissionerId;
     std::string        mDomainName;
+    ByteArray          mCertificate;
+    ByteArray          mPrivateKeyRaw;
+    ByteArray          mTrustAnchor;
+    bool               mIsKeysLoaded = false;
     mbedtls_pk_context mPublicKey;
     mbedtls_pk_context mPrivateKey;
     mbedtls_pk_context mDomainCAPublicKey;
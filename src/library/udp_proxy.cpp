@@ -41,31 +41,68 @@ namespace ot {
 
 namespace commissioner {
 
+constexpr size_t   ProxySocket::kDefaultSendWindow;
+constexpr size_t   ProxyClient::kSendBatchSize;
+constexpr size_t   ProxyClient::kMaxDtlsSendQueueSize;
+constexpr uint32_t ProxyClient::kCongestionBackoff;
+
 /**
- * Encapsulate the request and send it as a UDP_TX.ntf message.
+ * Encapsulate the UDP payload and send it as a UDP_TX.ntf message.
  */
-Error ProxyEndpoint::Send(const ByteArray &aRequest, MessageSubType aSubType)
+static Error SendUdpTx(coap::CoapSecure &aBrClient,
+                       uint16_t          aSrcPort,
+                       const Address &   aDstAddr,
+                       uint16_t          aDstPort,
+                       const ByteArray & aPayload)
 {
     Error         error;
     coap::Request udpTx{coap::Type::kNonConfirmable, coap::Code::kPost};
     ByteArray     udpPayload;
 
-    (void)aSubType;
+    VerifyOrExit(aDstAddr.IsValid() && aDstAddr.IsIpv6(), error = ERROR_INVALID_STATE("no valid IPv6 peer address"));
 
-    VerifyOrExit(GetPeerAddr().IsValid() && GetPeerAddr().IsIpv6(),
-                 error = ERROR_INVALID_STATE("no valid IPv6 peer address"));
+    VerifyOrExit(aBrClient.IsConnected(), error = ERROR_INVALID_STATE("not connected to the border agent"));
 
-    VerifyOrExit(mBrClient.IsConnected(), error = ERROR_INVALID_STATE("not connected to the border agent"));
-
-    utils::Encode<uint16_t>(udpPayload, mBrClient.GetDtlsSession().GetLocalPort());
-    utils::Encode<uint16_t>(udpPayload, GetPeerPort());
-    udpPayload.insert(udpPayload.end(), aRequest.begin(), aRequest.end());
+    udpPayload.reserve(aPayload.size() + 4);
+    utils::Encode<uint16_t>(udpPayload, aSrcPort);
+    utils::Encode<uint16_t>(udpPayload, aDstPort);
+    udpPayload.insert(udpPayload.end(), aPayload.begin(), aPayload.end());
 
     SuccessOrExit(error = udpTx.SetUriPath(uri::kUdpTx));
-    SuccessOrExit(error = AppendTlv(udpTx, {tlv::Type::kIpv6Address, mPeerAddr.GetRaw()}));
-    SuccessOrExit(error = AppendTlv(udpTx, {tlv::Type::kUdpEncapsulation, udpPayload}));
+    SuccessOrExit(error = AppendTlv(udpTx, {tlv::Type::kIpv6Address, aDstAddr.GetRaw()}));
+    SuccessOrExit(error = AppendTlv(udpTx, {tlv::Type::kUdpEncapsulation, udpPayload},
+                                    aBrClient.GetDtlsSession().IsCompactExtendedTlv()));
 
-    mBrClient.SendRequest(udpTx, nullptr);
+    aBrClient.SendRequest(udpTx, nullptr);
+
+exit:
+    return error;
+}
+
+// Handlers are called after sockets are done with their queues, since
+// a handler may send again or close a socket.
+static void Complete(std::vector<ProxySocket::Completion> &aCompletions)
+{
+    for (auto &completion : aCompletions)
+    {
+        if (completion.first != nullptr)
+        {
+            completion.first(completion.second);
+        }
+    }
+}
+
+/**
+ * Encapsulate the request and send it as a UDP_TX.ntf message.
+ */
+Error ProxyEndpoint::Send(const ByteArray &aRequest, MessageSubType aSubType)
+{
+    Error error;
+
+    (void)aSubType;
+
+    SuccessOrExit(error = SendUdpTx(mBrClient, mBrClient.GetDtlsSession().GetLocalPort(), GetPeerAddr(),
+                                    GetPeerPort(), aRequest));
 
 exit:
     if (error != ErrorCode::kNone)
@@ -87,6 +124,28 @@ void ProxyClient::SendRequest(const coap::Request & aRequest,
     mCoap.SendRequest(aRequest, aHandler);
 }
 
+void ProxyClient::SendMulticastRequest(const coap::Request & aRequest,
+                                       coap::ResponseHandler aHandler,
+                                       const Address &       aGroupAddr,
+                                       uint16_t              aPeerPort,
+                                       Duration              aTimeout)
+{
+    VerifyOrDie(aGroupAddr.IsIpv6() && aGroupAddr.IsMulticast());
+    mEndpoint.SetPeerAddr(aGroupAddr);
+    mEndpoint.SetPeerPort(aPeerPort);
+
+    mCoap.SendMulticastRequest(aRequest, aHandler, aTimeout);
+}
+
+void ProxyClient::SendPing(coap::ResponseHandler aHandler, const Address &aPeerAddr, uint16_t aPeerPort)
+{
+    VerifyOrDie(aPeerAddr.IsValid() && aPeerAddr.IsIpv6());
+    mEndpoint.SetPeerAddr(aPeerAddr);
+    mEndpoint.SetPeerPort(aPeerPort);
+
+    mCoap.SendPing(aHandler);
+}
+
 void ProxyClient::SendEmptyChanged(const coap::Request &aRequest)
 {
     mEndpoint.SetPeerAddr(aRequest.GetEndpoint()->GetPeerAddr());
@@ -95,30 +154,64 @@ void ProxyClient::SendEmptyChanged(const coap::Request &aRequest)
     IgnoreError(mCoap.SendEmptyChanged(aRequest));
 }
 
+void ProxyClient::CancelRequests()
+{
+    std::vector<ProxySocket::Completion> completions;
+
+    mCoap.CancelRequests();
+
+    for (auto &socket : mSockets)
+    {
+        socket.second->Cancel(ERROR_CANCELLED("the UDP proxy datagram was cancelled"), completions);
+    }
+    Complete(completions);
+}
+
 /**
  * Called when the commissioner received a UDP_RX.ntf request.
+ *
+ * The TLVs are located in place, so that the payload is passed to a
+ * proxy socket without being copied.
  */
 void ProxyClient::HandleUdpRx(const coap::Request &aUdpRx)
 {
-    Error       error;
-    Address     peerAddr;
-    uint16_t    peerPort;
-    tlv::TlvPtr srcAddr  = nullptr;
-    tlv::TlvPtr udpEncap = nullptr;
+    Error          error;
+    Address        peerAddr;
+    uint16_t       peerPort;
+    uint16_t       localPort;
+    const uint8_t *srcAddr;
+    uint16_t       srcAddrLength;
+    const uint8_t *udpEncap;
+    uint16_t       udpEncapLength;
 
-    VerifyOrExit((srcAddr = GetTlv(tlv::Type::kIpv6Address, aUdpRx)) != nullptr,
+    VerifyOrExit(tlv::FindTlv(srcAddr, srcAddrLength, tlv::Type::kIpv6Address, aUdpRx.GetPayload()) ==
+                     ErrorCode::kNone,
                  error = ERROR_BAD_FORMAT("no valid IPv6 Address TLV found"));
-    VerifyOrExit((udpEncap = GetTlv(tlv::Type::kUdpEncapsulation, aUdpRx)) != nullptr,
+    VerifyOrExit(tlv::FindTlv(udpEncap, udpEncapLength, tlv::Type::kUdpEncapsulation, aUdpRx.GetPayload()) ==
+                     ErrorCode::kNone,
                  error = ERROR_BAD_FORMAT("no valid UDP Encapsulation TLV found"));
 
-    SuccessOrExit(error = peerAddr.Set(srcAddr->GetValue()));
+    SuccessOrExit(error = peerAddr.Set(ByteArray{srcAddr, srcAddr + srcAddrLength}));
 
-    peerPort = utils::Decode<uint16_t>(udpEncap->GetValue());
+    peerPort  = utils::Decode<uint16_t>(udpEncap, 2);
+    localPort = utils::Decode<uint16_t>(udpEncap + 2, 2);
+
+    // CoAP messages to the port of the DTLS session are always ours.
+    if (!mBrClient.IsConnected() || localPort != mBrClient.GetDtlsSession().GetLocalPort())
+    {
+        auto socket = mSockets.find(localPort);
+
+        if (socket != mSockets.end())
+        {
+            socket->second->mReceiveHandler(peerAddr, peerPort, udpEncap + 4, udpEncapLength - 4);
+            ExitNow();
+        }
+    }
 
     mEndpoint.SetPeerAddr(peerAddr);
     mEndpoint.SetPeerPort(peerPort);
 
-    mCoap.Receive({udpEncap->GetValue().begin() + 4, udpEncap->GetValue().end()});
+    mCoap.Receive({udpEncap + 4, udpEncap + udpEncapLength});
 
 exit:
     if (error != ErrorCode::kNone)
@@ -129,6 +222,128 @@ exit:
     return;
 }
 
+Error ProxyClient::Bind(ProxySocket &aSocket, uint16_t aLocalPort)
+{
+    Error error;
+
+    VerifyOrExit(aLocalPort != 0, error = ERROR_INVALID_ARGS("the UDP proxy port should not be zero"));
+    VerifyOrExit(!mBrClient.IsConnected() || aLocalPort != mBrClient.GetDtlsSession().GetLocalPort(),
+                 error = ERROR_INVALID_ARGS("UDP proxy port {} is used by the commissioner", aLocalPort));
+    VerifyOrExit(mSockets.emplace(aLocalPort, &aSocket).second,
+                 error = ERROR_ALREADY_EXISTS("UDP proxy port {} is already bound", aLocalPort));
+
+exit:
+    return error;
+}
+
+void ProxyClient::Unbind(ProxySocket &aSocket)
+{
+    mSockets.erase(aSocket.GetLocalPort());
+}
+
+void ProxyClient::ScheduleFlush(Duration aDelay)
+{
+    if (!mFlushTimer.IsRunning())
+    {
+        mFlushTimer.Start(aDelay);
+    }
+}
+
+void ProxyClient::FlushSockets()
+{
+    std::vector<ProxySocket::Completion> completions;
+    bool                                 congested = false;
+    bool                                 pending   = false;
+
+    // Every socket gets a batch per turn, so that a busy socket does not
+    // hold back the others.
+    for (auto &socket : mSockets)
+    {
+        congested = congested || GetBacklog() > kMaxDtlsSendQueueSize;
+        if (!congested)
+        {
+            socket.second->Flush(kSendBatchSize, completions);
+        }
+        pending = pending || socket.second->GetPendingSendNum() > 0;
+    }
+
+    if (pending)
+    {
+        ScheduleFlush(congested ? Duration(kCongestionBackoff) : Duration(0));
+    }
+
+    Complete(completions);
+}
+
+size_t ProxyClient::GetBacklog() const
+{
+    return mBacklogGetter != nullptr ? mBacklogGetter() : mBrClient.GetDtlsSession().GetSendQueueSize();
+}
+
+Error ProxySocket::Bind(uint16_t aLocalPort)
+{
+    Error error;
+
+    VerifyOrExit(!IsBound(), error = ERROR_INVALID_STATE("the UDP proxy socket is already bound"));
+    SuccessOrExit(error = mClient.Bind(*this, aLocalPort));
+    mLocalPort = aLocalPort;
+
+exit:
+    return error;
+}
+
+void ProxySocket::Close()
+{
+    std::vector<Completion> completions;
+
+    if (IsBound())
+    {
+        mClient.Unbind(*this);
+        mLocalPort = 0;
+    }
+
+    Cancel(ERROR_CANCELLED("the UDP proxy socket was closed"), completions);
+    Complete(completions);
+}
+
+Error ProxySocket::SendTo(const ByteArray &aData, const Address &aPeerAddr, uint16_t aPeerPort, SendHandler aHandler)
+{
+    Error error;
+
+    VerifyOrExit(IsBound(), error = ERROR_INVALID_STATE("the UDP proxy socket is not bound"));
+    VerifyOrExit(aPeerAddr.IsValid() && aPeerAddr.IsIpv6(), error = ERROR_INVALID_ARGS("no valid IPv6 peer address"));
+    VerifyOrExit(mSendQueue.size() < mSendWindow,
+                 error = ERROR_BUSY("the send window of UDP proxy port {} is full", mLocalPort));
+
+    mSendQueue.push_back({aData, aPeerAddr, aPeerPort, aHandler});
+    mClient.ScheduleFlush(Duration(0));
+
+exit:
+    return error;
+}
+
+void ProxySocket::Flush(size_t aBatchSize, std::vector<Completion> &aCompletions)
+{
+    while (aBatchSize-- > 0 && !mSendQueue.empty())
+    {
+        Datagram &datagram = mSendQueue.front();
+        Error     error;
+
+        error = SendUdpTx(mClient.mBrClient, mLocalPort, datagram.mPeerAddr, datagram.mPeerPort, datagram.mData);
+        aCompletions.emplace_back(std::move(datagram.mHandler), error);
+        mSendQueue.pop_front();
+    }
+}
+
+void ProxySocket::Cancel(const Error &aError, std::vector<Completion> &aCompletions)
+{
+    for (auto &datagram : mSendQueue)
+    {
+        aCompletions.emplace_back(std::move(datagram.mHandler), aError);
+    }
+    mSendQueue.clear();
+}
+
 } // namespace commissioner
 
 } // namespace ot
@@ -34,11 +34,18 @@
 #ifndef OT_COMM_LIBRARY_UDP_PROXY_HPP_
 #define OT_COMM_LIBRARY_UDP_PROXY_HPP_
 
+#include <deque>
+#include <functional>
+#include <map>
+#include <utility>
+#include <vector>
+
 #include <commissioner/error.hpp>
 
 #include "common/address.hpp"
 #include "library/coap_secure.hpp"
 #include "library/endpoint.hpp"
+#include "library/timer.hpp"
 
 namespace ot {
 
@@ -69,15 +76,103 @@ private:
     uint16_t          mPeerPort;
 };
 
+class ProxyClient;
+
+// A datagram socket to mesh nodes, bound to a virtual UDP port of the
+// commissioner. Datagrams are sent in UDP_TX.ntf messages and received
+// in UDP_RX.ntf messages through the border agent.
+//
+// Datagrams to send are queued in a send window and written in batches
+// from the event loop, as long as the DTLS session to the border agent
+// keeps up. A datagram is rejected with ErrorCode::kBusy while the
+// window is full; the handler of a datagram is called once it has been
+// written, which is when the application may send more.
+class ProxySocket
+{
+public:
+    using ReceiveHandler =
+        std::function<void(const Address &aPeerAddr, uint16_t aPeerPort, const uint8_t *aData, size_t aLength)>;
+    using SendHandler = std::function<void(Error aError)>;
+
+    static constexpr size_t kDefaultSendWindow = 64;
+
+    ProxySocket(ProxyClient &aClient, ReceiveHandler aReceiveHandler)
+        : mClient(aClient)
+        , mReceiveHandler(aReceiveHandler)
+        , mLocalPort(0)
+        , mSendWindow(kDefaultSendWindow)
+    {
+    }
+    ~ProxySocket() { Close(); }
+
+    ProxySocket(const ProxySocket &) = delete;
+    ProxySocket &operator=(const ProxySocket &) = delete;
+
+    // Datagrams to @p aLocalPort are passed to the receive handler, the
+    // data is only valid during the call.
+    Error Bind(uint16_t aLocalPort);
+
+    // Unbinds the socket, queued datagrams are cancelled.
+    void Close();
+
+    bool     IsBound() const { return mLocalPort != 0; }
+    uint16_t GetLocalPort() const { return mLocalPort; }
+
+    Error SendTo(const ByteArray &aData, const Address &aPeerAddr, uint16_t aPeerPort, SendHandler aHandler);
+
+    void   SetSendWindow(size_t aSendWindow) { mSendWindow = aSendWindow; }
+    size_t GetPendingSendNum() const { return mSendQueue.size(); }
+
+    using Completion = std::pair<SendHandler, Error>;
+
+private:
+    friend class ProxyClient;
+
+    struct Datagram
+    {
+        ByteArray   mData;
+        Address     mPeerAddr;
+        uint16_t    mPeerPort;
+        SendHandler mHandler;
+    };
+
+    // Writes up to @p aBatchSize queued datagrams. Their handlers are
+    // added to @p aCompletions rather than called, since a handler may
+    // close the socket.
+    void Flush(size_t aBatchSize, std::vector<Completion> &aCompletions);
+    void Cancel(const Error &aError, std::vector<Completion> &aCompletions);
+
+    ProxyClient &        mClient;
+    ReceiveHandler       mReceiveHandler;
+    uint16_t             mLocalPort;
+    size_t               mSendWindow;
+    std::deque<Datagram> mSendQueue;
+};
+
 // The UDP proxy CoAP client that sends CoAP requests encapsulated
 // in UDP_TX.ntf message and handles/decodes UDP_RX.ntf message
-// into original CoAP message.
+// into original CoAP message. UDP_RX.ntf messages to a port bound by
+// a ProxySocket are passed to the socket instead.
 class ProxyClient
 {
 public:
-    ProxyClient(struct event_base *aEventBase, coap::CoapSecure &aBrClient)
-        : mEndpoint(aBrClient)
-        , mCoap(aEventBase, mEndpoint)
+    using BacklogGetter = std::function<size_t()>;
+
+    // The max number of datagrams a proxy socket writes in an event loop turn.
+    static constexpr size_t kSendBatchSize = 16;
+
+    // Proxy sockets stop writing while the DTLS session to the border
+    // agent has more messages than this waiting for the network.
+    static constexpr size_t kMaxDtlsSendQueueSize = 32;
+
+    // The delay of writing again after the DTLS session fell behind.
+    static constexpr uint32_t kCongestionBackoff = 10; // Milliseconds.
+
+    ProxyClient(struct event_base *aEventBase, coap::CoapSecure &aBrClient, CpuAccount *aCpuAccount = nullptr)
+        : mBrClient(aBrClient)
+        , mEndpoint(aBrClient)
+        , mCoap(aEventBase, mEndpoint, aCpuAccount)
+        , mFlushTimer(aEventBase, [this](Timer &) { FlushSockets(); }, /* aIsSingle */ true, aCpuAccount)
     {
     }
 
@@ -86,6 +181,17 @@ public:
                      const Address &       aPeerAddr,
                      uint16_t              aPeerPort);
 
+    // Send a Non-confirmable request to a multicast group (e.g. the
+    // realm-local all-nodes address) and collect the responses of all
+    // nodes until `aTimeout`. See `coap::Coap::SendMulticastRequest`.
+    void SendMulticastRequest(const coap::Request & aRequest,
+                              coap::ResponseHandler aHandler,
+                              const Address &       aGroupAddr,
+                              uint16_t              aPeerPort,
+                              Duration              aTimeout);
+
+    void SendPing(coap::ResponseHandler aHandler, const Address &aPeerAddr, uint16_t aPeerPort);
+
     void SendEmptyChanged(const coap::Request &aRequest);
 
     Error AddResource(const coap::Resource &aResource) { return mCoap.AddResource(aResource); }
@@ -94,11 +200,33 @@ public:
 
     void HandleUdpRx(const coap::Request &aUdpRx);
 
-    void CancelRequests() { mCoap.CancelRequests(); }
+    // Cancels pending CoAP requests and the datagrams queued by proxy sockets.
+    void CancelRequests();
+
+    size_t GetPendingRequestsNum() const { return mCoap.GetPendingRequestsNum(); }
+
+    // Replaces the DTLS send queue as the backlog of the link to the
+    // border agent, e.g. to emulate a congested link in tests.
+    void SetBacklogGetter(BacklogGetter aGetter) { mBacklogGetter = aGetter; }
+
+    void SetTransactionObserver(coap::TransactionObserver aObserver) { mCoap.SetTransactionObserver(aObserver); }
 
 private:
-    ProxyEndpoint mEndpoint;
-    coap::Coap    mCoap;
+    friend class ProxySocket;
+
+    Error Bind(ProxySocket &aSocket, uint16_t aLocalPort);
+    void  Unbind(ProxySocket &aSocket);
+
+    void   ScheduleFlush(Duration aDelay);
+    void   FlushSockets();
+    size_t GetBacklog() const;
+
+    coap::CoapSecure &                mBrClient;
+    ProxyEndpoint                     mEndpoint;
+    coap::Coap                        mCoap;
+    std::map<uint16_t, ProxySocket *> mSockets;
+    Timer                             mFlushTimer;
+    BacklogGetter                     mBacklogGetter;
 };
 
 } // namespace commissioner
@@ -0,0 +1,1000 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the Python extension module of the commissioner app.
+ */
+
+// Python.h must be included before any standard headers.
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+#include "app/commissioner_app.hpp"
+#include "app/file_util.hpp"
+#include "app/json.hpp"
+#include "common/error_macros.hpp"
+#include "common/utils.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+// An event handled by the commissioner app, delivered to Python.
+struct PythonEvent
+{
+    std::string mName;
+
+    // Makes the arguments tuple, called with the GIL held.
+    std::function<PyObject *()> mMakeArgs;
+};
+
+// The commissioner app which queues the events it handled for Python.
+// Events are handled in the commissioner thread, which never takes the
+// GIL, Python takes them with `get_event`.
+class PythonCommissionerApp : public CommissionerApp
+{
+public:
+    static Error Create(std::shared_ptr<PythonCommissionerApp> &aApp, const Config &aConfig)
+    {
+        Error error;
+        auto  app = std::make_shared<PythonCommissionerApp>();
+
+        SuccessOrExit(error = app->Init(aConfig));
+        aApp = app;
+
+    exit:
+        return error;
+    }
+
+    // Waits at most @p aTimeout for an event, forever if it is negative.
+    bool PopEvent(PythonEvent &aEvent, std::chrono::milliseconds aTimeout)
+    {
+        std::unique_lock<std::mutex> lock(mEventsMutex);
+        auto                         hasEvent = [this]() { return !mEvents.empty(); };
+
+        if (aTimeout.count() < 0)
+        {
+            mEventsCondition.wait(lock, hasEvent);
+        }
+        else if (!mEventsCondition.wait_for(lock, aTimeout, hasEvent))
+        {
+            return false;
+        }
+
+        aEvent = std::move(mEvents.front());
+        mEvents.pop_front();
+        return true;
+    }
+
+    // Serializes the calls made from Python threads, which run without the GIL.
+    std::mutex &GetCallMutex() { return mCallMutex; }
+
+    std::string OnJoinerRequest(const ByteArray &aJoinerId) override
+    {
+        PushEvent("joiner_request", [aJoinerId]() { return Py_BuildValue("(N)", ToPython(aJoinerId)); });
+        return CommissionerApp::OnJoinerRequest(aJoinerId);
+    }
+
+    void OnJoinerConnected(const ByteArray &aJoinerId, Error aError) override
+    {
+        PushEvent("joiner_connected", [aJoinerId, aError]() {
+            return Py_BuildValue("(NN)", ToPython(aJoinerId), ToPython(aError));
+        });
+        CommissionerApp::OnJoinerConnected(aJoinerId, aError);
+    }
+
+    using CommissionerApp::OnJoinerFinalize;
+    bool OnJoinerFinalize(const ByteArray &  aJoinerId,
+                          const std::string &aVendorName,
+                          const std::string &aVendorModel,
+                          const std::string &aVendorSwVersion,
+                          const ByteArray &  aVendorStackVersion,
+                          const std::string &aProvisioningUrl,
+                          const ByteArray &  aVendorData) override
+    {
+        bool accepted = CommissionerApp::OnJoinerFinalize(aJoinerId, aVendorName, aVendorModel, aVendorSwVersion,
+                                                          aVendorStackVersion, aProvisioningUrl, aVendorData);
+
+        PushEvent("joiner_finalize", [=]() {
+            return Py_BuildValue("(NsssNsNO)", ToPython(aJoinerId), aVendorName.c_str(), aVendorModel.c_str(),
+                                 aVendorSwVersion.c_str(), ToPython(aVendorStackVersion), aProvisioningUrl.c_str(),
+                                 ToPython(aVendorData), accepted ? Py_True : Py_False);
+        });
+        return accepted;
+    }
+
+    void OnKeepAliveResponse(Error aError) override
+    {
+        PushEvent("keep_alive_response", [aError]() { return Py_BuildValue("(N)", ToPython(aError)); });
+        CommissionerApp::OnKeepAliveResponse(aError);
+    }
+
+    void OnPanIdConflict(const std::string &aPeerAddr, const ChannelMask &aChannelMask, uint16_t aPanId) override
+    {
+        CommissionerApp::OnPanIdConflict(aPeerAddr, aChannelMask, aPanId);
+        PushEvent("panid_conflict", [aPeerAddr, aChannelMask, aPanId]() {
+            return Py_BuildValue("(sNH)", aPeerAddr.c_str(), ToPython(aChannelMask), aPanId);
+        });
+    }
+
+    void OnEnergyReport(const std::string &aPeerAddr,
+                        const ChannelMask &aChannelMask,
+                        const ByteArray &  aEnergyList) override
+    {
+        CommissionerApp::OnEnergyReport(aPeerAddr, aChannelMask, aEnergyList);
+        PushEvent("energy_report", [aPeerAddr, aChannelMask, aEnergyList]() {
+            return Py_BuildValue("(sNN)", aPeerAddr.c_str(), ToPython(aChannelMask), ToPython(aEnergyList));
+        });
+    }
+
+    void OnDatasetChanged() override
+    {
+        CommissionerApp::OnDatasetChanged();
+        PushEvent("dataset_changed", []() { return PyTuple_New(0); });
+    }
+
+    static PyObject *ToPython(const ByteArray &aBytes)
+    {
+        return PyBytes_FromStringAndSize(reinterpret_cast<const char *>(aBytes.data()),
+                                         static_cast<Py_ssize_t>(aBytes.size()));
+    }
+
+    static PyObject *ToPython(const Error &aError)
+    {
+        return Py_BuildValue("(is)", static_cast<int>(aError.GetCode()), aError.GetMessage().c_str());
+    }
+
+    static PyObject *ToPython(const ChannelMask &aChannelMask)
+    {
+        PyObject *list = PyList_New(static_cast<Py_ssize_t>(aChannelMask.size()));
+
+        for (size_t i = 0; list != nullptr && i < aChannelMask.size(); ++i)
+        {
+            PyList_SET_ITEM(list, static_cast<Py_ssize_t>(i),
+                            Py_BuildValue("(BN)", aChannelMask[i].mPage, ToPython(aChannelMask[i].mMasks)));
+        }
+        return list;
+    }
+
+private:
+    static constexpr size_t kMaxEvents = 1024;
+
+    void PushEvent(const std::string &aName, std::function<PyObject *()> aMakeArgs)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mEventsMutex);
+
+            // Drops the oldest event if Python doesn't take them.
+            if (mEvents.size() >= kMaxEvents)
+            {
+                mEvents.pop_front();
+            }
+            mEvents.push_back({aName, aMakeArgs});
+        }
+        mEventsCondition.notify_one();
+    }
+
+    std::mutex              mCallMutex;
+    std::mutex              mEventsMutex;
+    std::condition_variable mEventsCondition;
+    std::deque<PythonEvent> mEvents;
+};
+
+struct CommissionerObject
+{
+    PyObject_HEAD std::shared_ptr<PythonCommissionerApp> *mApp;
+};
+
+static PyObject *sErrorType = nullptr;
+
+static PyObject *RaiseError(const Error &aError)
+{
+    PyObject *args = PythonCommissionerApp::ToPython(aError);
+
+    if (args != nullptr)
+    {
+        PyErr_SetObject(sErrorType, args);
+        Py_DECREF(args);
+    }
+    return nullptr;
+}
+
+static PyObject *NoneOrRaise(const Error &aError)
+{
+    if (aError != ErrorCode::kNone)
+    {
+        return RaiseError(aError);
+    }
+    Py_RETURN_NONE;
+}
+
+// Calls @p aFunction on @p aApp with the GIL released, so other Python
+// threads keep running while it waits for the network. Calls on the same
+// app are serialized, the app is not thread-safe.
+template <typename Function> static Error CallWithoutGil(PythonCommissionerApp &aApp, Function aFunction)
+{
+    Error error;
+
+    Py_BEGIN_ALLOW_THREADS;
+    {
+        std::lock_guard<std::mutex> lock(aApp.GetCallMutex());
+
+        error = aFunction();
+    }
+    Py_END_ALLOW_THREADS;
+
+    return error;
+}
+
+// Stops @p aApp once the calls in progress are done.
+static void StopApp(PythonCommissionerApp &aApp)
+{
+    IgnoreError(CallWithoutGil(aApp, [&aApp]() {
+        aApp.Stop();
+        return ERROR_NONE;
+    }));
+}
+
+static bool CheckApp(CommissionerObject *aSelf)
+{
+    if (aSelf->mApp == nullptr)
+    {
+        RaiseError(ERROR_INVALID_STATE("the commissioner is not initialized"));
+        return false;
+    }
+    return true;
+}
+
+static PyObject *CommissionerNew(PyTypeObject *aType, PyObject *, PyObject *)
+{
+    auto self = reinterpret_cast<CommissionerObject *>(aType->tp_alloc(aType, 0));
+
+    if (self != nullptr)
+    {
+        self->mApp = nullptr;
+    }
+    return reinterpret_cast<PyObject *>(self);
+}
+
+static int CommissionerInit(CommissionerObject *aSelf, PyObject *aArgs, PyObject *)
+{
+    Error                                  error;
+    const char *                           configFile;
+    std::string                            configJson;
+    Config                                 config;
+    std::shared_ptr<PythonCommissionerApp> app;
+
+    if (!PyArg_ParseTuple(aArgs, "s", &configFile))
+    {
+        return -1;
+    }
+
+    SuccessOrExit(error = ReadFile(configJson, configFile));
+    SuccessOrExit(error = ConfigFromJson(config, configJson));
+    SuccessOrExit(error = PythonCommissionerApp::Create(app, config));
+
+    // `__init__` may be called again, calls still running on the previous
+    // app hold their own reference to it.
+    if (aSelf->mApp != nullptr)
+    {
+        auto previousApp = *aSelf->mApp;
+
+        StopApp(*previousApp);
+        delete aSelf->mApp;
+    }
+    aSelf->mApp = new std::shared_ptr<PythonCommissionerApp>(app);
+
+exit:
+    if (error != ErrorCode::kNone)
+    {
+        RaiseError(error);
+        return -1;
+    }
+    return 0;
+}
+
+static void CommissionerDealloc(CommissionerObject *aSelf)
+{
+    if (aSelf->mApp != nullptr)
+    {
+        auto app = *aSelf->mApp;
+
+        delete aSelf->mApp;
+        aSelf->mApp = nullptr;
+
+        // Stopping waits for the commissioner thread.
+        StopApp(*app);
+
+        Py_BEGIN_ALLOW_THREADS;
+        app.reset();
+        Py_END_ALLOW_THREADS;
+    }
+    Py_TYPE(aSelf)->tp_free(reinterpret_cast<PyObject *>(aSelf));
+}
+
+// The app is referenced until the call returns, even if `__init__`
+// replaces it meanwhile.
+#define GET_APP(aSelf)                \
+    do                                \
+    {                                 \
+        if (!CheckApp(aSelf))         \
+        {                             \
+            return nullptr;           \
+        }                             \
+    } while (false);                  \
+    auto  appHolder = *(aSelf)->mApp; \
+    auto &app       = *appHolder
+
+#define PARSE_ARGS(aArgs, ...)                           \
+    do                                                   \
+    {                                                    \
+        if (!PyArg_ParseTuple(aArgs, __VA_ARGS__))       \
+        {                                                \
+            return nullptr;                              \
+        }                                                \
+    } while (false)
+
+static Error GetJoinerType(JoinerType &aType, int aValue)
+{
+    Error error;
+
+    VerifyOrExit(aValue >= static_cast<int>(JoinerType::kMeshCoP) && aValue <= static_cast<int>(JoinerType::kNMKP),
+                 error = ERROR_INVALID_ARGS("{} is not a valid joiner type", aValue));
+    aType = static_cast<JoinerType>(aValue);
+
+exit:
+    return error;
+}
+
+static PyObject *Start(CommissionerObject *aSelf, PyObject *aArgs)
+{
+    const char *addr;
+    uint16_t    port;
+    std::string existingCommissionerId;
+    Error       error;
+
+    GET_APP(aSelf);
+    PARSE_ARGS(aArgs, "sH", &addr, &port);
+
+    error = CallWithoutGil(app, [&]() { return app.Start(existingCommissionerId, addr, port); });
+    if (!existingCommissionerId.empty())
+    {
+        error = Error{error.GetCode(), "there is an existing active commissioner: " + existingCommissionerId};
+    }
+    return NoneOrRaise(error);
+}
+
+static PyObject *Stop(CommissionerObject *aSelf, PyObject *)
+{
+    GET_APP(aSelf);
+
+    StopApp(app);
+    Py_RETURN_NONE;
+}
+
+static PyObject *CancelRequests(CommissionerObject *aSelf, PyObject *)
+{
+    GET_APP(aSelf);
+
+    // Not serialized with other calls, it cancels the requests they are waiting for.
+    app.CancelRequests();
+    Py_RETURN_NONE;
+}
+
+static PyObject *IsActive(CommissionerObject *aSelf, PyObject *)
+{
+    bool result;
+
+    GET_APP(aSelf);
+
+    IgnoreError(CallWithoutGil(app, [&]() {
+        result = app.IsActive();
+        return ERROR_NONE;
+    }));
+    return PyBool_FromLong(result);
+}
+
+static PyObject *IsCcmMode(CommissionerObject *aSelf, PyObject *)
+{
+    bool result;
+
+    GET_APP(aSelf);
+
+    IgnoreError(CallWithoutGil(app, [&]() {
+        result = app.IsCcmMode();
+        return ERROR_NONE;
+    }));
+    return PyBool_FromLong(result);
+}
+
+static PyObject *GetSessionId(CommissionerObject *aSelf, PyObject *)
+{
+    uint16_t sessionId;
+    Error    error;
+
+    GET_APP(aSelf);
+
+    SuccessOrExit(error = CallWithoutGil(app, [&]() { return app.GetSessionId(sessionId); }));
+
+exit:
+    return error == ErrorCode::kNone ? PyLong_FromUnsignedLong(sessionId) : RaiseError(error);
+}
+
+static PyObject *GetBorderAgentLocator(CommissionerObject *aSelf, PyObject *)
+{
+    uint16_t locator;
+    Error    error;
+
+    GET_APP(aSelf);
+
+    SuccessOrExit(error = CallWithoutGil(app, [&]() { return app.GetBorderAgentLocator(locator); }));
+
+exit:
+    return error == ErrorCode::kNone ? PyLong_FromUnsignedLong(locator) : RaiseError(error);
+}
+
+static PyObject *EnableJoiner(CommissionerObject *aSelf, PyObject *aArgs)
+{
+    int                type;
+    unsigned long long eui64;
+    const char *       pskd            = "";
+    const char *       provisioningUrl = "";
+    JoinerType         joinerType;
+    Error              error;
+
+    GET_APP(aSelf);
+    PARSE_ARGS(aArgs, "iK|ss", &type, &eui64, &pskd, &provisioningUrl);
+
+    SuccessOrExit(error = GetJoinerType(joinerType, type));
+    error = CallWithoutGil(app, [&]() { return app.EnableJoiner(joinerType, eui64, pskd, provisioningUrl); });
+
+exit:
+    return NoneOrRaise(error);
+}
+
+static PyObject *DisableJoiner(CommissionerObject *aSelf, PyObject *aArgs)
+{
+    int                type;
+    unsigned long long eui64;
+    JoinerType         joinerType;
+    Error              error;
+
+    GET_APP(aSelf);
+    PARSE_ARGS(aArgs, "iK", &type, &eui64);
+
+    SuccessOrExit(error = GetJoinerType(joinerType, type));
+    error = CallWithoutGil(app, [&]() { return app.DisableJoiner(joinerType, eui64); });
+
+exit:
+    return NoneOrRaise(error);
+}
+
+static PyObject *EnableAllJoiners(CommissionerObject *aSelf, PyObject *aArgs)
+{
+    int         type;
+    const char *pskd            = "";
+    const char *provisioningUrl = "";
+    JoinerType  joinerType;
+    Error       error;
+
+    GET_APP(aSelf);
+    PARSE_ARGS(aArgs, "i|ss", &type, &pskd, &provisioningUrl);
+
+    SuccessOrExit(error = GetJoinerType(joinerType, type));
+    error = CallWithoutGil(app, [&]() { return app.EnableAllJoiners(joinerType, pskd, provisioningUrl); });
+
+exit:
+    return NoneOrRaise(error);
+}
+
+static PyObject *DisableAllJoiners(CommissionerObject *aSelf, PyObject *aArgs)
+{
+    int        type;
+    JoinerType joinerType;
+    Error      error;
+
+    GET_APP(aSelf);
+    PARSE_ARGS(aArgs, "i", &type);
+
+    SuccessOrExit(error = GetJoinerType(joinerType, type));
+    error = CallWithoutGil(app, [&]() { return app.DisableAllJoiners(joinerType); });
+
+exit:
+    return NoneOrRaise(error);
+}
+
+static PyObject *GetJoinerUdpPort(CommissionerObject *aSelf, PyObject *aArgs)
+{
+    int        type;
+    uint16_t   port;
+    JoinerType joinerType;
+    Error      error;
+
+    GET_APP(aSelf);
+    PARSE_ARGS(aArgs, "i", &type);
+
+    SuccessOrExit(error = GetJoinerType(joinerType, type));
+    SuccessOrExit(error = CallWithoutGil(app, [&]() { return app.GetJoinerUdpPort(port, joinerType); }));
+
+exit:
+    return error == ErrorCode::kNone ? PyLong_FromUnsignedLong(port) : RaiseError(error);
+}
+
+static PyObject *SetJoinerUdpPort(CommissionerObject *aSelf, PyObject *aArgs)
+{
+    int        type;
+    uint16_t   port;
+    JoinerType joinerType;
+    Error      error;
+
+    GET_APP(aSelf);
+    PARSE_ARGS(aArgs, "iH", &type, &port);
+
+    SuccessOrExit(error = GetJoinerType(joinerType, type));
+    error = CallWithoutGil(app, [&]() { return app.SetJoinerUdpPort(joinerType, port); });
+
+exit:
+    return NoneOrRaise(error);
+}
+
+// Datasets are exchanged in the JSON format of the CLI.
+template <typename Dataset, typename Getter, typename ToJson>
+static PyObject *GetDataset(CommissionerObject *aSelf, PyObject *aArgs, Getter aGetter, ToJson aToJson)
+{
+    uint16_t flags = 0xFFFF;
+    Dataset  dataset;
+    Error    error;
+
+    GET_APP(aSelf);
+    PARSE_ARGS(aArgs, "|H", &flags);
+
+    SuccessOrExit(error = CallWithoutGil(app, [&]() { return (app.*aGetter)(dataset, flags); }));
+
+exit:
+    return error == ErrorCode::kNone ? PyUnicode_FromString(aToJson(dataset).c_str()) : RaiseError(error);
+}
+
+template <typename Dataset, typename Setter, typename FromJson>
+static PyObject *SetDataset(CommissionerObject *aSelf, PyObject *aArgs, Setter aSetter, FromJson aFromJson)
+{
+    const char *json;
+    Dataset     dataset;
+    Error       error;
+
+    GET_APP(aSelf);
+    PARSE_ARGS(aArgs, "s", &json);
+
+    SuccessOrExit(error = aFromJson(dataset, json));
+    error = CallWithoutGil(app, [&]() { return (app.*aSetter)(dataset); });
+
+exit:
+    return NoneOrRaise(error);
+}
+
+static PyObject *GetCommissionerDataset(CommissionerObject *aSelf, PyObject *aArgs)
+{
+    return GetDataset<CommissionerDataset>(aSelf, aArgs, &CommissionerApp::GetCommissionerDataset,
+                                           CommissionerDatasetToJson);
+}
+
+static PyObject *SetCommissionerDataset(CommissionerObject *aSelf, PyObject *aArgs)
+{
+    return SetDataset<CommissionerDataset>(aSelf, aArgs, &CommissionerApp::SetCommissionerDataset,
+                                           CommissionerDatasetFromJson);
+}
+
+static PyObject *GetActiveDataset(CommissionerObject *aSelf, PyObject *aArgs)
+{
+    return GetDataset<ActiveOperationalDataset>(aSelf, aArgs, &CommissionerApp::GetActiveDataset,
+                                                ActiveDatasetToJson);
+}
+
+static PyObject *SetActiveDataset(CommissionerObject *aSelf, PyObject *aArgs)
+{
+    return SetDataset<ActiveOperationalDataset>(aSelf, aArgs, &CommissionerApp::SetActiveDataset,
+                                                ActiveDatasetFromJson);
+}
+
+static PyObject *GetPendingDataset(CommissionerObject *aSelf, PyObject *aArgs)
+{
+    return GetDataset<PendingOperationalDataset>(aSelf, aArgs, &CommissionerApp::GetPendingDataset,
+                                                 PendingDatasetToJson);
+}
+
+static PyObject *SetPendingDataset(CommissionerObject *aSelf, PyObject *aArgs)
+{
+    return SetDataset<PendingOperationalDataset>(aSelf, aArgs, &CommissionerApp::SetPendingDataset,
+                                                 PendingDatasetFromJson);
+}
+
+static PyObject *GetBbrDataset(CommissionerObject *aSelf, PyObject *aArgs)
+{
+    return GetDataset<BbrDataset>(aSelf, aArgs, &CommissionerApp::GetBbrDataset, BbrDatasetToJson);
+}
+
+static PyObject *SetBbrDataset(CommissionerObject *aSelf, PyObject *aArgs)
+{
+    return SetDataset<BbrDataset>(aSelf, aArgs, &CommissionerApp::SetBbrDataset, BbrDatasetFromJson);
+}
+
+static PyObject *Reenroll(CommissionerObject *aSelf, PyObject *aArgs)
+{
+    const char *dstAddr;
+
+    GET_APP(aSelf);
+    PARSE_ARGS(aArgs, "s", &dstAddr);
+
+    return NoneOrRaise(CallWithoutGil(app, [&]() { return app.Reenroll(dstAddr); }));
+}
+
+static PyObject *DomainReset(CommissionerObject *aSelf, PyObject *aArgs)
+{
+    const char *dstAddr;
+
+    GET_APP(aSelf);
+    PARSE_ARGS(aArgs, "s", &dstAddr);
+
+    return NoneOrRaise(CallWithoutGil(app, [&]() { return app.DomainReset(dstAddr); }));
+}
+
+static PyObject *Migrate(CommissionerObject *aSelf, PyObject *aArgs)
+{
+    const char *dstAddr;
+    const char *designatedNetwork;
+
+    GET_APP(aSelf);
+    PARSE_ARGS(aArgs, "ss", &dstAddr, &designatedNetwork);
+
+    return NoneOrRaise(CallWithoutGil(app, [&]() { return app.Migrate(dstAddr, designatedNetwork); }));
+}
+
+static PyObject *GetToken(CommissionerObject *aSelf, PyObject *)
+{
+    ByteArray token;
+
+    GET_APP(aSelf);
+
+    IgnoreError(CallWithoutGil(app, [&]() {
+        token = app.GetToken();
+        return ERROR_NONE;
+    }));
+    return PythonCommissionerApp::ToPython(token);
+}
+
+static PyObject *RequestToken(CommissionerObject *aSelf, PyObject *aArgs)
+{
+    const char *addr;
+    uint16_t    port;
+
+    GET_APP(aSelf);
+    PARSE_ARGS(aArgs, "sH", &addr, &port);
+
+    return NoneOrRaise(CallWithoutGil(app, [&]() { return app.RequestToken(addr, port); }));
+}
+
+static PyObject *SetToken(CommissionerObject *aSelf, PyObject *aArgs)
+{
+    const char *token;
+    Py_ssize_t  tokenLength;
+    const char *signerCert;
+    Py_ssize_t  signerCertLength;
+
+    GET_APP(aSelf);
+    PARSE_ARGS(aArgs, "y#y#", &token, &tokenLength, &signerCert, &signerCertLength);
+
+    return NoneOrRaise(CallWithoutGil(app, [&]() {
+        return app.SetToken({token, token + tokenLength}, {signerCert, signerCert + signerCertLength});
+    }));
+}
+
+static PyObject *RegisterMulticastListener(CommissionerObject *aSelf, PyObject *aArgs)
+{
+    PyObject *               addrs;
+    unsigned int             timeout;
+    PyObject *               iterator = nullptr;
+    PyObject *               item;
+    std::vector<std::string> multicastAddrList;
+
+    GET_APP(aSelf);
+    PARSE_ARGS(aArgs, "OI", &addrs, &timeout);
+
+    VerifyOrExit((iterator = PyObject_GetIter(addrs)) != nullptr);
+    while ((item = PyIter_Next(iterator)) != nullptr)
+    {
+        const char *addr = PyUnicode_AsUTF8(item);
+
+        if (addr != nullptr)
+        {
+            multicastAddrList.emplace_back(addr);
+        }
+        Py_DECREF(item);
+        VerifyOrExit(addr != nullptr);
+    }
+
+exit:
+    Py_XDECREF(iterator);
+    if (PyErr_Occurred())
+    {
+        return nullptr;
+    }
+
+    return NoneOrRaise(CallWithoutGil(app, [&]() {
+        return app.RegisterMulticastListener(multicastAddrList, CommissionerApp::Seconds(timeout));
+    }));
+}
+
+static PyObject *AnnounceBegin(CommissionerObject *aSelf, PyObject *aArgs)
+{
+    unsigned int  channelMask;
+    unsigned char count;
+    unsigned int  period;
+    const char *  dstAddr;
+
+    GET_APP(aSelf);
+    PARSE_ARGS(aArgs, "IbIs", &channelMask, &count, &period, &dstAddr);
+
+    return NoneOrRaise(CallWithoutGil(
+        app, [&]() { return app.AnnounceBegin(channelMask, count, CommissionerApp::MilliSeconds(period), dstAddr); }));
+}
+
+static PyObject *PanIdQuery(CommissionerObject *aSelf, PyObject *aArgs)
+{
+    unsigned int channelMask;
+    uint16_t     panId;
+    const char * dstAddr;
+
+    GET_APP(aSelf);
+    PARSE_ARGS(aArgs, "IHs", &channelMask, &panId, &dstAddr);
+
+    return NoneOrRaise(CallWithoutGil(app, [&]() { return app.PanIdQuery(channelMask, panId, dstAddr); }));
+}
+
+static PyObject *HasPanIdConflict(CommissionerObject *aSelf, PyObject *aArgs)
+{
+    uint16_t panId;
+    bool     hasConflict;
+
+    GET_APP(aSelf);
+    PARSE_ARGS(aArgs, "H", &panId);
+
+    IgnoreError(CallWithoutGil(app, [&]() {
+        hasConflict = app.HasPanIdConflict(panId);
+        return ERROR_NONE;
+    }));
+    return PyBool_FromLong(hasConflict);
+}
+
+static PyObject *EnergyScan(CommissionerObject *aSelf, PyObject *aArgs)
+{
+    unsigned int  channelMask;
+    unsigned char count;
+    uint16_t      period;
+    uint16_t      scanDuration;
+    const char *  dstAddr;
+
+    GET_APP(aSelf);
+    PARSE_ARGS(aArgs, "IbHHs", &channelMask, &count, &period, &scanDuration, &dstAddr);
+
+    return NoneOrRaise(
+        CallWithoutGil(app, [&]() { return app.EnergyScan(channelMask, count, period, scanDuration, dstAddr); }));
+}
+
+static PyObject *GetEnergyReport(CommissionerObject *aSelf, PyObject *aArgs)
+{
+    const char * dstAddr;
+    Address      addr;
+    bool         hasReport = false;
+    EnergyReport report;
+    Error        error;
+
+    GET_APP(aSelf);
+    PARSE_ARGS(aArgs, "s", &dstAddr);
+
+    SuccessOrExit(error = addr.Set(dstAddr));
+
+    // The report is copied, it may be replaced once the call returns.
+    IgnoreError(CallWithoutGil(app, [&]() {
+        const EnergyReport *energyReport = app.GetEnergyReport(addr);
+
+        if (energyReport != nullptr)
+        {
+            report    = *energyReport;
+            hasReport = true;
+        }
+        return ERROR_NONE;
+    }));
+    if (!hasReport)
+    {
+        Py_RETURN_NONE;
+    }
+
+exit:
+    return error == ErrorCode::kNone ? PyUnicode_FromString(EnergyReportToJson(report).c_str()) : RaiseError(error);
+}
+
+static PyObject *ProbeLink(CommissionerObject *aSelf, PyObject *aArgs)
+{
+    const char *    dstAddr = "";
+    uint16_t        count   = 100;
+    uint16_t        window  = 1;
+    LinkProbeResult result;
+    Error           error;
+
+    GET_APP(aSelf);
+    PARSE_ARGS(aArgs, "|sHH", &dstAddr, &count, &window);
+
+    SuccessOrExit(error = CallWithoutGil(app, [&]() { return app.ProbeLink(result, dstAddr, count, window); }));
+
+exit:
+    return error == ErrorCode::kNone ? PyUnicode_FromString(LinkProbeResultToJson(result).c_str())
+                                     : RaiseError(error);
+}
+
+static PyObject *GetEvent(CommissionerObject *aSelf, PyObject *aArgs)
+{
+    PyObject *  timeout = Py_None;
+    double      seconds = -1;
+    bool        hasEvent;
+    PythonEvent event;
+    PyObject *  args;
+
+    GET_APP(aSelf);
+    PARSE_ARGS(aArgs, "|O", &timeout);
+
+    if (timeout != Py_None && ((seconds = PyFloat_AsDouble(timeout)) == -1 && PyErr_Occurred()))
+    {
+        return nullptr;
+    }
+
+    Py_BEGIN_ALLOW_THREADS;
+    hasEvent = app.PopEvent(event, std::chrono::milliseconds(seconds < 0 ? -1 : static_cast<int64_t>(seconds * 1000)));
+    Py_END_ALLOW_THREADS;
+
+    if (!hasEvent)
+    {
+        Py_RETURN_NONE;
+    }
+
+    if ((args = event.mMakeArgs()) == nullptr)
+    {
+        return nullptr;
+    }
+    return Py_BuildValue("(sN)", event.mName.c_str(), args);
+}
+
+#undef GET_APP
+#undef PARSE_ARGS
+
+#define METHOD(aName, aFunction, aFlags, aDoc) \
+    {                                          \
+        aName, reinterpret_cast<PyCFunction>(aFunction), aFlags, aDoc \
+    }
+
+static PyMethodDef sCommissionerMethods[] = {
+    METHOD("start", Start, METH_VARARGS, "start(border_agent_addr, border_agent_port)"),
+    METHOD("stop", Stop, METH_NOARGS, "stop()"),
+    METHOD("cancel_requests", CancelRequests, METH_NOARGS, "cancel_requests()"),
+    METHOD("is_active", IsActive, METH_NOARGS, "is_active() -> bool"),
+    METHOD("is_ccm_mode", IsCcmMode, METH_NOARGS, "is_ccm_mode() -> bool"),
+    METHOD("get_session_id", GetSessionId, METH_NOARGS, "get_session_id() -> int"),
+    METHOD("get_border_agent_locator", GetBorderAgentLocator, METH_NOARGS, "get_border_agent_locator() -> int"),
+    METHOD("enable_joiner", EnableJoiner, METH_VARARGS, "enable_joiner(type, eui64, pskd='', provisioning_url='')"),
+    METHOD("disable_joiner", DisableJoiner, METH_VARARGS, "disable_joiner(type, eui64)"),
+    METHOD("enable_all_joiners", EnableAllJoiners, METH_VARARGS,
+           "enable_all_joiners(type, pskd='', provisioning_url='')"),
+    METHOD("disable_all_joiners", DisableAllJoiners, METH_VARARGS, "disable_all_joiners(type)"),
+    METHOD("get_joiner_udp_port", GetJoinerUdpPort, METH_VARARGS, "get_joiner_udp_port(type) -> int"),
+    METHOD("set_joiner_udp_port", SetJoinerUdpPort, METH_VARARGS, "set_joiner_udp_port(type, port)"),
+    METHOD("get_commissioner_dataset", GetCommissionerDataset, METH_VARARGS,
+           "get_commissioner_dataset(flags=0xFFFF) -> str"),
+    METHOD("set_commissioner_dataset", SetCommissionerDataset, METH_VARARGS, "set_commissioner_dataset(json)"),
+    METHOD("get_active_dataset", GetActiveDataset, METH_VARARGS, "get_active_dataset(flags=0xFFFF) -> str"),
+    METHOD("set_active_dataset", SetActiveDataset, METH_VARARGS, "set_active_dataset(json)"),
+    METHOD("get_pending_dataset", GetPendingDataset, METH_VARARGS, "get_pending_dataset(flags=0xFFFF) -> str"),
+    METHOD("set_pending_dataset", SetPendingDataset, METH_VARARGS, "set_pending_dataset(json)"),
+    METHOD("get_bbr_dataset", GetBbrDataset, METH_VARARGS, "get_bbr_dataset(flags=0xFFFF) -> str"),
+    METHOD("set_bbr_dataset", SetBbrDataset, METH_VARARGS, "set_bbr_dataset(json)"),
+    METHOD("reenroll", Reenroll, METH_VARARGS, "reenroll(dst_addr)"),
+    METHOD("domain_reset", DomainReset, METH_VARARGS, "domain_reset(dst_addr)"),
+    METHOD("migrate", Migrate, METH_VARARGS, "migrate(dst_addr, designated_network_name)"),
+    METHOD("get_token", GetToken, METH_NOARGS, "get_token() -> bytes"),
+    METHOD("request_token", RequestToken, METH_VARARGS, "request_token(registrar_addr, registrar_port)"),
+    METHOD("set_token", SetToken, METH_VARARGS, "set_token(signed_token, signer_cert)"),
+    METHOD("register_multicast_listener", RegisterMulticastListener, METH_VARARGS,
+           "register_multicast_listener(multicast_addrs, timeout_in_seconds)"),
+    METHOD("announce_begin", AnnounceBegin, METH_VARARGS,
+           "announce_begin(channel_mask, count, period_in_milliseconds, dst_addr)"),
+    METHOD("panid_query", PanIdQuery, METH_VARARGS, "panid_query(channel_mask, panid, dst_addr)"),
+    METHOD("has_panid_conflict", HasPanIdConflict, METH_VARARGS, "has_panid_conflict(panid) -> bool"),
+    METHOD("energy_scan", EnergyScan, METH_VARARGS,
+           "energy_scan(channel_mask, count, period, scan_duration, dst_addr)"),
+    METHOD("get_energy_report", GetEnergyReport, METH_VARARGS, "get_energy_report(dst_addr) -> str or None"),
+    METHOD("probe_link", ProbeLink, METH_VARARGS, "probe_link(dst_addr='', count=100, window=1) -> str"),
+    METHOD("get_event", GetEvent, METH_VARARGS,
+           "get_event(timeout=None) -> (name, args) or None\n\n"
+           "Takes the next event handled by the commissioner, waiting at most `timeout` seconds."),
+    {nullptr, nullptr, 0, nullptr},
+};
+
+#undef METHOD
+
+static PyTypeObject sCommissionerType;
+
+static PyModuleDef sModule = {
+    PyModuleDef_HEAD_INIT, "otcommissioner", "OT Commissioner, driven in-process.", -1, nullptr, nullptr, nullptr,
+    nullptr,               nullptr,
+};
+
+} // namespace commissioner
+
+} // namespace ot
+
+PyMODINIT_FUNC PyInit_otcommissioner(void)
+{
+    using namespace ot::commissioner;
+
+    PyObject *  module = nullptr;
+    PyVarObject head   = {PyObject_HEAD_INIT(nullptr) 0};
+
+    sCommissionerType.ob_base      = head;
+    sCommissionerType.tp_name      = "otcommissioner.Commissioner";
+    sCommissionerType.tp_doc       = "Commissioner(config_file)\n\nThe commissioner app of the CLI.";
+    sCommissionerType.tp_basicsize = sizeof(CommissionerObject);
+    sCommissionerType.tp_flags     = Py_TPFLAGS_DEFAULT;
+    sCommissionerType.tp_new       = CommissionerNew;
+    sCommissionerType.tp_init      = reinterpret_cast<initproc>(CommissionerInit);
+    sCommissionerType.tp_dealloc   = reinterpret_cast<destructor>(CommissionerDealloc);
+    sCommissionerType.tp_methods   = sCommissionerMethods;
+
+    VerifyOrExit(PyType_Ready(&sCommissionerType) == 0);
+    VerifyOrExit((module = PyModule_Create(&sModule)) != nullptr);
+
+    // Raised with (error_code, message).
+    VerifyOrExit((sErrorType = PyErr_NewException("otcommissioner.Error", PyExc_RuntimeError, nullptr)) != nullptr);
+
+    Py_INCREF(sErrorType);
+    Py_INCREF(&sCommissionerType);
+    VerifyOrExit(PyModule_AddObject(module, "Error", sErrorType) == 0);
+    VerifyOrExit(PyModule_AddObject(module, "Commissioner", reinterpret_cast<PyObject *>(&sCommissionerType)) == 0);
+
+    VerifyOrExit(PyModule_AddIntConstant(module, "JOINER_TYPE_MESHCOP", static_cast<int>(JoinerType::kMeshCoP)) == 0);
+    VerifyOrExit(PyModule_AddIntConstant(module, "JOINER_TYPE_CCM_AE", static_cast<int>(JoinerType::kAE)) == 0);
+    VerifyOrExit(PyModule_AddIntConstant(module, "JOINER_TYPE_CCM_NMKP", static_cast<int>(JoinerType::kNMKP)) == 0);
+
+    return module;
+
+exit:
+    Py_XDECREF(module);
+    return nullptr;
+}
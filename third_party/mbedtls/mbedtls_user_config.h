@@ -12,6 +12,13 @@
 
 #define MBEDTLS_SSL_MAX_CONTENT_LEN (1024)
 
+// Shrink the record buffers of a connected session to its Max Fragment Length.
+#define MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH
+
 #undef MBEDTLS_SSL_RENEGOTIATION
 
+// Protect DTLS records with the crypto provider of the commissioner,
+// the AES-CCM context is defined in alt/ccm_alt.h.
+#define MBEDTLS_CCM_ALT
+
 #endif // MBEDTLS_USER_CONFIG_H
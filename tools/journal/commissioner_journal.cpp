@@ -0,0 +1,304 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   The file prints the commissioning funnel of joiners from journal files of commissioners.
+ *
+ *   It reads the files while commissioners append them, without involving
+ *   the commissioners. The funnel counts joiner sessions reaching each
+ *   stage of commissioning, and the latencies between stages show where
+ *   joiners are slow, e.g. a lossy mesh or a slow approval by the user.
+ */
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "common/utils.hpp"
+#include "library/journal.hpp"
+
+using namespace ot::commissioner;
+using namespace ot::commissioner::journal;
+
+static constexpr size_t kEventNum = static_cast<size_t>(Event::kSessionRemoved) + 1;
+
+// A joiner session, from its first RLY_RX.ntf to its removal.
+struct Session
+{
+    Session() { std::fill(mTimes, mTimes + kEventNum, -1); }
+
+    bool Has(Event aEvent) const { return mTimes[static_cast<size_t>(aEvent)] >= 0; }
+
+    int64_t mTimes[kEventNum]; ///< The time of the first occurrence of each event, -1 if none.
+    bool    mHandshakeFailed = false;
+};
+
+struct Stage
+{
+    const char *mName;
+    Event       mEvent;
+};
+
+struct Latency
+{
+    const char *mName;
+    Event       mFrom;
+    Event       mTo;
+};
+
+static const Stage kStages[] = {
+    {"session created", Event::kSessionCreated},     {"handshake succeeded", Event::kHandshakeFinished},
+    {"JOIN_FIN received", Event::kJoinFinReceived}, {"joiner accepted", Event::kJoinerAccepted},
+    {"KEK sent", Event::kKekSent},
+};
+
+static const Latency kLatencies[] = {
+    {"first relay -> handshake", Event::kSessionCreated, Event::kHandshakeFinished},
+    {"handshake -> JOIN_FIN", Event::kHandshakeFinished, Event::kJoinFinReceived},
+    {"JOIN_FIN -> accepted", Event::kJoinFinReceived, Event::kJoinerAccepted},
+    {"first relay -> KEK sent", Event::kSessionCreated, Event::kKekSent},
+};
+
+static void AddEntry(std::map<ByteArray, Session> &aActive, std::vector<Session> &aSessions, const Entry &aEntry)
+{
+    auto it = aActive.find(aEntry.mJoinerId);
+
+    if (aEntry.mEvent == Event::kSessionCreated)
+    {
+        if (it != aActive.end())
+        {
+            aSessions.push_back(it->second);
+            aActive.erase(it);
+        }
+        it = aActive.emplace(aEntry.mJoinerId, Session{}).first;
+    }
+
+    // Sessions created before the oldest entry are not counted.
+    if (it == aActive.end())
+    {
+        return;
+    }
+
+    {
+        Session &session = it->second;
+        int64_t &time    = session.mTimes[static_cast<size_t>(aEntry.mEvent)];
+
+        if (aEntry.mEvent == Event::kHandshakeFinished && aEntry.mValue != 0)
+        {
+            session.mHandshakeFailed = true;
+        }
+        else if (time < 0)
+        {
+            time = aEntry.mTime;
+        }
+    }
+
+    if (aEntry.mEvent == Event::kSessionRemoved)
+    {
+        aSessions.push_back(it->second);
+        aActive.erase(it);
+    }
+}
+
+static double Percentile(const std::vector<int64_t> &aSorted, double aRatio)
+{
+    size_t index = static_cast<size_t>(aRatio * aSorted.size() + 0.5);
+
+    return aSorted[std::min(std::max(index, static_cast<size_t>(1)), aSorted.size()) - 1] / 1000.0;
+}
+
+static double Percent(size_t aCount, size_t aTotal)
+{
+    return aTotal == 0 ? 0 : 100.0 * aCount / aTotal;
+}
+
+static void PrintFunnel(const std::vector<Session> &aSessions)
+{
+    size_t previous = aSessions.size();
+    size_t failed   = 0;
+    size_t rejected = 0;
+    size_t expired  = 0;
+    size_t ongoing  = 0;
+
+    printf("%-24s %10s %12s %8s\n", "stage", "sessions", "of previous", "of all");
+    for (const auto &stage : kStages)
+    {
+        size_t count = std::count_if(aSessions.begin(), aSessions.end(),
+                                     [&stage](const Session &aSession) { return aSession.Has(stage.mEvent); });
+
+        printf("%-24s %10zu %11.1f%% %7.1f%%\n", stage.mName, count, Percent(count, previous),
+               Percent(count, aSessions.size()));
+        previous = count;
+    }
+
+    for (const auto &session : aSessions)
+    {
+        if (session.mHandshakeFailed && !session.Has(Event::kHandshakeFinished))
+        {
+            ++failed;
+        }
+        else if (session.Has(Event::kJoinerRejected))
+        {
+            ++rejected;
+        }
+        else if (session.Has(Event::kJoinerAccepted))
+        {
+            continue;
+        }
+        else if (session.Has(Event::kSessionRemoved))
+        {
+            ++expired;
+        }
+        else
+        {
+            ++ongoing;
+        }
+    }
+
+    printf("\n%-24s %10s\n", "dropped", "sessions");
+    printf("%-24s %10zu\n", "handshake failed", failed);
+    printf("%-24s %10zu\n", "joiner rejected", rejected);
+    printf("%-24s %10zu\n", "expired", expired);
+    printf("%-24s %10zu\n", "in progress", ongoing);
+}
+
+static void PrintLatencies(const std::vector<Session> &aSessions)
+{
+    printf("\n%-24s %10s %10s %10s %10s %10s\n", "latency (ms)", "count", "p50", "p90", "p99", "max");
+    for (const auto &latency : kLatencies)
+    {
+        std::vector<int64_t> values;
+
+        for (const auto &session : aSessions)
+        {
+            if (session.Has(latency.mFrom) && session.Has(latency.mTo))
+            {
+                values.push_back(session.mTimes[static_cast<size_t>(latency.mTo)] -
+                                 session.mTimes[static_cast<size_t>(latency.mFrom)]);
+            }
+        }
+
+        if (values.empty())
+        {
+            printf("%-24s %10d %10s %10s %10s %10s\n", latency.mName, 0, "-", "-", "-", "-");
+            continue;
+        }
+
+        std::sort(values.begin(), values.end());
+        printf("%-24s %10zu %10.1f %10.1f %10.1f %10.1f\n", latency.mName, values.size(), Percentile(values, 0.5),
+               Percentile(values, 0.9), Percentile(values, 0.99), values.back() / 1000.0);
+    }
+}
+
+static void PrintEntry(const std::string &aCommissionerId, const Entry &aEntry)
+{
+    time_t    seconds = static_cast<time_t>(aEntry.mTime / 1000000);
+    struct tm utc;
+    char      timeStr[32];
+
+    gmtime_r(&seconds, &utc);
+    strftime(timeStr, sizeof(timeStr), "%Y-%m-%dT%H:%M:%S", &utc);
+
+    printf("%s.%06lldZ %s %s %s value=%d", timeStr, static_cast<long long>(aEntry.mTime % 1000000),
+           aCommissionerId.c_str(), utils::Hex(aEntry.mJoinerId).c_str(), GetName(aEntry.mEvent), aEntry.mValue);
+    if (!aEntry.mDetail.empty())
+    {
+        printf(" detail=\"%s\"", aEntry.mDetail.c_str());
+    }
+    printf("\n");
+}
+
+int main(int argc, char *argv[])
+{
+    std::vector<Session> sessions;
+    ByteArray            joinerId;
+    int                  exitCode = 0;
+    int                  i        = 1;
+
+    if (argc > 2 && strcmp(argv[1], "--joiner") == 0)
+    {
+        if (utils::Hex(joinerId, argv[2]) != ErrorCode::kNone || joinerId.size() != kJoinerIdLength)
+        {
+            fprintf(stderr, "invalid joiner ID: %s\n", argv[2]);
+            return 1;
+        }
+        i = 3;
+    }
+
+    if (i >= argc)
+    {
+        fprintf(stderr, "usage: %s [--joiner <joiner-id>] <journal-file>...\n", argv[0]);
+        return 1;
+    }
+
+    for (; i < argc; ++i)
+    {
+        std::vector<Entry>           entries;
+        std::map<ByteArray, Session> active;
+        std::string                  id;
+        Error                        error = Read(entries, id, argv[i]);
+
+        if (error != ErrorCode::kNone)
+        {
+            fprintf(stderr, "%s\n", error.ToString().c_str());
+            exitCode = 1;
+            continue;
+        }
+
+        for (const auto &entry : entries)
+        {
+            if (joinerId.empty())
+            {
+                AddEntry(active, sessions, entry);
+            }
+            else if (entry.mJoinerId == joinerId)
+            {
+                PrintEntry(id, entry);
+            }
+        }
+
+        for (const auto &session : active)
+        {
+            sessions.push_back(session.second);
+        }
+    }
+
+    if (joinerId.empty())
+    {
+        PrintFunnel(sessions);
+        PrintLatencies(sessions);
+    }
+
+    return exitCode;
+}
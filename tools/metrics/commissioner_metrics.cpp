@@ -0,0 +1,235 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   The file prints metrics files of commissioners in the Prometheus text format.
+ *
+ *   It only maps the files read-only, so it can sample commissioners at
+ *   any rate without involving them, even when they are overloaded.
+ */
+
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "library/metrics.hpp"
+
+using namespace ot::commissioner::metrics;
+
+static const char *kPrefix = "ot_commissioner_";
+
+// A newer commissioner may append metrics of each kind, so the
+// metrics are located by the counts in the header of the file.
+struct MappedSegment
+{
+    const Segment *              mSegment;
+    const std::atomic<uint64_t> *mCounters;
+    const std::atomic<int64_t> * mGauges;
+    const HistogramData *        mHistograms;
+    std::string                  mLabels;
+};
+
+static std::string EscapeLabelValue(const std::string &aValue)
+{
+    std::string escaped;
+
+    for (char c : aValue)
+    {
+        if (c == '\\' || c == '"')
+        {
+            escaped.push_back('\\');
+            escaped.push_back(c);
+        }
+        else if (c == '\n')
+        {
+            escaped += "\\n";
+        }
+        else
+        {
+            escaped.push_back(c);
+        }
+    }
+    return escaped;
+}
+
+static bool MapSegment(MappedSegment &aMapped, const char *aFileName)
+{
+    const Segment *segment = nullptr;
+    void *         mapped  = MAP_FAILED;
+    size_t         size    = 0;
+    struct stat    fileStat;
+    int            fd = open(aFileName, O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0 || fstat(fd, &fileStat) != 0)
+    {
+        fprintf(stderr, "failed to open %s: %s\n", aFileName, strerror(errno));
+        goto exit;
+    }
+    if (static_cast<size_t>(fileStat.st_size) < sizeof(Segment))
+    {
+        fprintf(stderr, "%s is not a metrics file of this version\n", aFileName);
+        goto exit;
+    }
+    size = static_cast<size_t>(fileStat.st_size);
+    if ((mapped = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0)) == MAP_FAILED)
+    {
+        fprintf(stderr, "failed to map %s: %s\n", aFileName, strerror(errno));
+        goto exit;
+    }
+
+    segment = static_cast<const Segment *>(mapped);
+
+    // The magic is written last, after the header. Histograms of other
+    // buckets cannot be read, metrics appended to the known ones are skipped.
+    if (segment->mMagic != kMagic || segment->mVersion != kVersion || segment->mCounterNum < kCounterNum ||
+        segment->mGaugeNum < kGaugeNum || segment->mHistogramNum < kHistogramNum ||
+        segment->mBucketNum != kBucketNum ||
+        size < sizeof(Segment) + (segment->mCounterNum - kCounterNum) * sizeof(segment->mCounters[0]) +
+                   (segment->mGaugeNum - kGaugeNum) * sizeof(segment->mGauges[0]) +
+                   (segment->mHistogramNum - kHistogramNum) * sizeof(segment->mHistograms[0]))
+    {
+        fprintf(stderr, "%s is not a metrics file of this version\n", aFileName);
+        munmap(mapped, size);
+        segment = nullptr;
+        goto exit;
+    }
+
+    aMapped.mSegment    = segment;
+    aMapped.mCounters   = segment->mCounters;
+    aMapped.mGauges     = reinterpret_cast<const std::atomic<int64_t> *>(aMapped.mCounters + segment->mCounterNum);
+    aMapped.mHistograms = reinterpret_cast<const HistogramData *>(aMapped.mGauges + segment->mGaugeNum);
+
+exit:
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+    return segment != nullptr;
+}
+
+static void PrintHistogram(const char *aName, const std::vector<MappedSegment> &aSegments, Histogram aHistogram)
+{
+    printf("# TYPE %s%s histogram\n", kPrefix, aName);
+    for (const auto &segment : aSegments)
+    {
+        const HistogramData &histogram = segment.mHistograms[static_cast<size_t>(aHistogram)];
+        uint64_t             count     = 0;
+
+        for (size_t i = 0; i < kBucketNum; ++i)
+        {
+            std::string bound = i < kBucketNum - 1 ? std::to_string(kBucketBounds[i]) : "+Inf";
+
+            count += histogram.mBuckets[i].load(std::memory_order_relaxed);
+            printf("%s%s_bucket{%s,le=\"%s\"} %llu\n", kPrefix, aName, segment.mLabels.c_str(), bound.c_str(),
+                   static_cast<unsigned long long>(count));
+        }
+
+        // Buckets are read one by one, the sum may be a bit ahead of the count.
+        printf("%s%s_sum{%s} %llu\n", kPrefix, aName, segment.mLabels.c_str(),
+               static_cast<unsigned long long>(histogram.mSum.load(std::memory_order_relaxed)));
+        printf("%s%s_count{%s} %llu\n", kPrefix, aName, segment.mLabels.c_str(),
+               static_cast<unsigned long long>(count));
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    std::vector<MappedSegment> segments;
+    int                        exitCode = 0;
+
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s <metrics-file>...\n", argv[0]);
+        return 1;
+    }
+
+    for (int i = 1; i < argc; ++i)
+    {
+        MappedSegment segment;
+
+        if (!MapSegment(segment, argv[i]))
+        {
+            exitCode = 1;
+            continue;
+        }
+
+        std::string id(segment.mSegment->mId, strnlen(segment.mSegment->mId, sizeof(segment.mSegment->mId)));
+
+        segment.mLabels =
+            "id=\"" + EscapeLabelValue(id) + "\",pid=\"" + std::to_string(segment.mSegment->mProcessId) + "\"";
+        segments.push_back(segment);
+    }
+
+    if (!segments.empty())
+    {
+        printf("# TYPE %sstart_time_seconds gauge\n", kPrefix);
+        for (const auto &segment : segments)
+        {
+            printf("%sstart_time_seconds{%s} %lld\n", kPrefix, segment.mLabels.c_str(),
+                   static_cast<long long>(segment.mSegment->mStartTime));
+        }
+    }
+
+    for (size_t i = 0; i < kCounterNum && !segments.empty(); ++i)
+    {
+        const char *name = GetName(static_cast<Counter>(i));
+
+        printf("# TYPE %s%s counter\n", kPrefix, name);
+        for (const auto &segment : segments)
+        {
+            printf("%s%s{%s} %llu\n", kPrefix, name, segment.mLabels.c_str(),
+                   static_cast<unsigned long long>(segment.mCounters[i].load(std::memory_order_relaxed)));
+        }
+    }
+
+    for (size_t i = 0; i < kGaugeNum && !segments.empty(); ++i)
+    {
+        const char *name = GetName(static_cast<Gauge>(i));
+
+        printf("# TYPE %s%s gauge\n", kPrefix, name);
+        for (const auto &segment : segments)
+        {
+            printf("%s%s{%s} %lld\n", kPrefix, name, segment.mLabels.c_str(),
+                   static_cast<long long>(segment.mGauges[i].load(std::memory_order_relaxed)));
+        }
+    }
+
+    for (size_t i = 0; i < kHistogramNum && !segments.empty(); ++i)
+    {
+        PrintHistogram(GetName(static_cast<Histogram>(i)), segments, static_cast<Histogram>(i));
+    }
+
+    return exitCode;
+}